@@ -57,6 +57,7 @@ typedef enum statementType
 	Other,
 	Transaction,
 	AggregatePushdown,
+	SingleShardTransaction,
 	kMaxStatementType
 } statementType;
 int num_entries = kMaxStatementType;
@@ -159,6 +160,8 @@ set_metric_names(void)
   strcpy(ybpgm_table[Other].name, YSQL_METRIC_PREFIX "OtherStmts");
   strcpy(ybpgm_table[Transaction].name, YSQL_METRIC_PREFIX "Transactions");
   strcpy(ybpgm_table[AggregatePushdown].name, YSQL_METRIC_PREFIX "AggregatePushdowns");
+  strcpy(ybpgm_table[SingleShardTransaction].name,
+         YSQL_METRIC_PREFIX "SingleShardTransactions");
 }
 
 /*
@@ -549,6 +552,13 @@ ybpgm_ExecutorEnd(QueryDesc *queryDesc)
 	if (!queryDesc->estate->es_yb_is_single_row_modify_txn)
 	  ybpgm_Store(Transaction, time);
 
+	/*
+	 * Multi-row inserts into a single tablet are committed without a distributed
+	 * transaction, but that is only known once their writes are flushed.
+	 */
+	if (YBCPgIsSingleShardTxnFastPathUsed())
+	  ybpgm_Store(SingleShardTransaction, time);
+
 	if (IsA(queryDesc->planstate, AggState) &&
 		castNode(AggState, queryDesc->planstate)->yb_pushdown_supported)
 	  ybpgm_Store(AggregatePushdown, time);
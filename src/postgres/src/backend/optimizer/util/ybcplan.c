@@ -461,6 +461,70 @@ static bool ModifyTableIsSingleRowWrite(ModifyTable *modifyTable)
 	return true;
 }
 
+/*
+ * Is the expression computed without reading the database: a constant, a bind
+ * marker or an immutable function of those.
+ */
+static bool YBCIsReadFreeExpr(Expr *expr)
+{
+	bool has_vars = false;
+	bool has_docdb_unsupported_funcs = false;
+	return YBCAnalyzeExpression(expr, InvalidAttrNumber, &has_vars, &has_docdb_unsupported_funcs) &&
+	       !has_vars;
+}
+
+/*
+ * Returns true if the following are all true:
+ *  - is insert command.
+ *  - only one target table.
+ *  - there are no ON CONFLICT or WITH clauses.
+ *  - source data is a VALUES clause with multiple value sets.
+ *  - all values are either constants, bind markers or immutable functions of them.
+ *
+ * Such a statement performs no reads, so if it is the only statement of its
+ * transaction and all of its rows land in the same tablet, pggate may commit
+ * it as a single-shard write rather than a distributed transaction.
+ */
+bool YBCIsMultiRowValuesInsert(PlannedStmt *pstmt)
+{
+	ModifyTable *modifyTable;
+	ValuesScan  *values;
+	ListCell    *lc;
+
+	if (!pstmt->planTree || !IsA(pstmt->planTree, ModifyTable))
+		return false;
+
+	modifyTable = castNode(ModifyTable, pstmt->planTree);
+	if (modifyTable->operation != CMD_INSERT ||
+		list_length(modifyTable->resultRelations) != 1 ||
+		modifyTable->onConflictAction != ONCONFLICT_NONE ||
+		modifyTable->plan.initPlan != NIL ||
+		list_length(modifyTable->plans) != 1 ||
+		!IsA(linitial(modifyTable->plans), ValuesScan))
+		return false;
+
+	values = castNode(ValuesScan, linitial(modifyTable->plans));
+	foreach(lc, values->scan.plan.targetlist)
+	{
+		TargetEntry *target = (TargetEntry *) lfirst(lc);
+		/* References to the VALUES columns are checked below. */
+		if (!IsA(target->expr, Var) && !YBCIsReadFreeExpr(target->expr))
+			return false;
+	}
+
+	foreach(lc, values->values_lists)
+	{
+		ListCell *lc2;
+		foreach(lc2, (List *) lfirst(lc))
+		{
+			if (!YBCIsReadFreeExpr((Expr *) lfirst(lc2)))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 bool YBCIsSingleRowModify(PlannedStmt *pstmt)
 {
 	if (pstmt->planTree && IsA(pstmt->planTree, ModifyTable))
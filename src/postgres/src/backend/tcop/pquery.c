@@ -45,7 +45,8 @@ static void ProcessQuery(PlannedStmt *plan,
 			 QueryEnvironment *queryEnv,
 			 DestReceiver *dest,
 			 char *completionTag,
-			 bool isSingleRowModifyTxn);
+			 bool isSingleRowModifyTxn,
+			 bool isSingleShardTxnCandidate);
 static void FillPortalStore(Portal portal, bool isTopLevel);
 static uint64 RunFromStore(Portal portal, ScanDirection direction, uint64 count,
 			 DestReceiver *dest);
@@ -145,7 +146,8 @@ ProcessQuery(PlannedStmt *plan,
 			 QueryEnvironment *queryEnv,
 			 DestReceiver *dest,
 			 char *completionTag,
-			 bool isSingleRowModifyTxn)
+			 bool isSingleRowModifyTxn,
+			 bool isSingleShardTxnCandidate)
 {
 	QueryDesc  *queryDesc;
 
@@ -166,6 +168,15 @@ ProcessQuery(PlannedStmt *plan,
 		isSingleRowModifyTxn && queryDesc->estate->es_num_result_relations == 1 &&
 		YBCIsSingleRowTxnCapableRel(&queryDesc->estate->es_result_relations[0]);
 
+	/*
+	 * A single-stmt multi-row insert could still be committed without a
+	 * distributed transaction if all its rows land in one tablet, which
+	 * pggate checks once the buffered writes are flushed.
+	 */
+	if (isSingleShardTxnCandidate && queryDesc->estate->es_num_result_relations == 1 &&
+		YBCIsSingleRowTxnCapableRel(&queryDesc->estate->es_result_relations[0]))
+		YBCPgSetSingleShardTxnCandidate();
+
 	/*
 	 * Run the plan to completion.
 	 */
@@ -1220,6 +1231,7 @@ PortalRunMulti(Portal portal,
 {
 	bool		active_snapshot_set = false;
 	bool        is_single_row_modify_txn = false;
+	bool        is_single_shard_txn_candidate = false;
 	ListCell   *stmtlist_item;
 
 	/*
@@ -1243,6 +1255,8 @@ PortalRunMulti(Portal portal,
 		{
 			PlannedStmt *pstmt = linitial_node(PlannedStmt, portal->stmts);
 			is_single_row_modify_txn = YBCIsSingleRowModify(pstmt);
+			is_single_shard_txn_candidate =
+				!is_single_row_modify_txn && YBCIsMultiRowValuesInsert(pstmt);
 		}
 	}
 
@@ -1310,7 +1324,8 @@ PortalRunMulti(Portal portal,
 							 portal->queryEnv,
 							 dest,
 							 completionTag,
-							 is_single_row_modify_txn);
+							 is_single_row_modify_txn,
+							 is_single_shard_txn_candidate);
 			}
 			else
 			{
@@ -1321,7 +1336,8 @@ PortalRunMulti(Portal portal,
 							 portal->queryEnv,
 							 altdest,
 							 NULL,
-							 is_single_row_modify_txn);
+							 is_single_row_modify_txn,
+							 is_single_shard_txn_candidate);
 			}
 
 			if (log_executor_stats)
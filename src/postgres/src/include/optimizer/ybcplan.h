@@ -39,6 +39,8 @@ bool YBCIsSupportedSingleRowModifyAssignExpr(Expr *expr,
 
 bool YBCIsSingleRowModify(PlannedStmt *pstmt);
 
+bool YBCIsMultiRowValuesInsert(PlannedStmt *pstmt);
+
 bool YBCIsSingleRowUpdateOrDelete(ModifyTable *modifyTable);
 
 bool YBCAllPrimaryKeysProvided(Relation rel, Bitmapset *attrs);
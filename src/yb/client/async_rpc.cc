@@ -62,6 +62,12 @@ METRIC_DEFINE_counter(server, consistent_prefix_failed_reads,
     yb::MetricUnit::kRequests,
     "Number of consistent prefix reads that failed to be served by the closest replica.");
 
+METRIC_DEFINE_counter(server, batcher_resolved_tablet_reuses,
+    "Number of operations routed to a tablet already resolved by the same batch.",
+    yb::MetricUnit::kOperations,
+    "Number of operations routed to a tablet already resolved by the same batch, without a meta "
+    "cache lookup.");
+
 DECLARE_bool(rpc_dump_all_traces);
 DECLARE_bool(collect_end_to_end_traces);
 
@@ -117,7 +123,8 @@ AsyncRpcMetrics::AsyncRpcMetrics(const scoped_refptr<yb::MetricEntity>& entity)
       time_to_send(METRIC_handler_latency_yb_client_time_to_send.Instantiate(entity)),
       consistent_prefix_successful_reads(
           METRIC_consistent_prefix_successful_reads.Instantiate(entity)),
-      consistent_prefix_failed_reads(METRIC_consistent_prefix_failed_reads.Instantiate(entity)) {
+      consistent_prefix_failed_reads(METRIC_consistent_prefix_failed_reads.Instantiate(entity)),
+      batcher_resolved_tablet_reuses(METRIC_batcher_resolved_tablet_reuses.Instantiate(entity)) {
 }
 
 AsyncRpc::AsyncRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
@@ -46,6 +46,7 @@ struct AsyncRpcMetrics {
   scoped_refptr<Histogram> time_to_send;
   scoped_refptr<Counter> consistent_prefix_successful_reads;
   scoped_refptr<Counter> consistent_prefix_failed_reads;
+  scoped_refptr<Counter> batcher_resolved_tablet_reuses;
 };
 
 struct AsyncRpcData {
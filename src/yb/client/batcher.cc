@@ -71,6 +71,12 @@
 DEFINE_test_flag(bool, combine_batcher_errors, false,
                  "Whether combine errors into batcher status.");
 
+DEFINE_int32(batcher_max_resolved_tablets, 64,
+             "Max number of tablets resolved by a batch that are remembered to route following "
+             "operations of the same batch without a meta cache lookup. 0 disables reuse.");
+TAG_FLAG(batcher_max_resolved_tablets, advanced);
+TAG_FLAG(batcher_max_resolved_tablets, runtime);
+
 using std::pair;
 using std::set;
 using std::unique_ptr;
@@ -292,6 +298,8 @@ Status Batcher::Add(shared_ptr<YBOperation> yb_op) {
 
   if (VERIFY_RESULT(yb_op->MaybeRefreshTablePartitions())) {
     client_->data_->meta_cache_->InvalidateTableCache(yb_op->table()->id());
+    std::lock_guard<std::mutex> lock(resolved_tablets_mutex_);
+    resolved_tablets_.clear();
   }
 
   if (yb_op->table()->partition_schema().IsHashPartitioning()) {
@@ -334,6 +342,11 @@ Status Batcher::Add(shared_ptr<YBOperation> yb_op) {
 
   if (yb_op->tablet()) {
     TabletLookupFinished(std::move(in_flight_op), yb_op->tablet());
+  } else if (auto tablet = FindResolvedTablet(*yb_op->table(), in_flight_op->partition_key)) {
+    if (async_rpc_metrics_) {
+      async_rpc_metrics_->batcher_resolved_tablet_reuses->Increment();
+    }
+    TabletLookupFinished(std::move(in_flight_op), tablet);
   } else {
     // deadline_ is set in FlushAsync(), after all Add() calls are done, so
     // here we're forced to create a new deadline.
@@ -345,6 +358,40 @@ Status Batcher::Add(shared_ptr<YBOperation> yb_op) {
   return Status::OK();
 }
 
+internal::RemoteTabletPtr Batcher::FindResolvedTablet(
+    const YBTable& table, const std::string& partition_key) const {
+  if (table.ArePartitionsStale()) {
+    return nullptr;
+  }
+  // Use the same partition list the meta cache would use for this lookup, so a tablet resolved
+  // for an older partitions version, e.g. a split parent, is never reused.
+  const auto partitions = table.GetVersionedPartitions();
+  const auto& partition_start =
+      partitions->keys[FindPartitionStartIndex(partitions->keys, partition_key)];
+  std::lock_guard<std::mutex> lock(resolved_tablets_mutex_);
+  const auto it = resolved_tablets_.find(ResolvedTabletKey{&table, partition_start});
+  if (it == resolved_tablets_.end() || it->second.partitions_version != partitions->version) {
+    return nullptr;
+  }
+  const auto& tablet = it->second.tablet;
+  if (tablet->stale() || tablet->is_split() || !tablet->partition().ContainsKey(partition_key)) {
+    return nullptr;
+  }
+  return tablet;
+}
+
+void Batcher::AddResolvedTablet(const YBTable& table, const internal::RemoteTabletPtr& tablet) {
+  const auto partitions_version = table.GetPartitionsVersion();
+  std::lock_guard<std::mutex> lock(resolved_tablets_mutex_);
+  if (resolved_tablets_.size() >=
+          static_cast<size_t>(std::max(FLAGS_batcher_max_resolved_tablets, 0))) {
+    return;
+  }
+  resolved_tablets_.emplace(
+      ResolvedTabletKey{&table, tablet->partition().partition_key_start()},
+      ResolvedTablet{tablet, partitions_version});
+}
+
 void Batcher::AddInFlightOp(const InFlightOpPtr& op) {
   LOG_IF(DFATAL, op->state != InFlightOpState::kLookingUpTablet)
       << "Adding in flight op in a wrong state: " << op->state;
@@ -449,6 +496,10 @@ void Batcher::TabletLookupFinished(
     if (lookup_result.ok()) {
       CHECK(*lookup_result);
 
+      if (!op->partition_key.empty()) {
+        AddResolvedTablet(*op->yb_op->table(), *lookup_result);
+      }
+
       auto expected_state = InFlightOpState::kLookingUpTablet;
       if (op->state.compare_exchange_strong(
           expected_state, InFlightOpState::kBufferedToTabletServer, std::memory_order_acq_rel)) {
@@ -32,6 +32,8 @@
 #ifndef YB_CLIENT_BATCHER_H_
 #define YB_CLIENT_BATCHER_H_
 
+#include <map>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -251,6 +253,13 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   // Async Callbacks.
   void TabletLookupFinished(InFlightOpPtr op, const Result<internal::RemoteTabletPtr>& result);
 
+  // Returns tablet already resolved in this batch that contains partition_key of table, or null if
+  // there is no such tablet or it was resolved for another version of table partitions.
+  internal::RemoteTabletPtr FindResolvedTablet(
+      const YBTable& table, const std::string& partition_key) const;
+
+  void AddResolvedTablet(const YBTable& table, const internal::RemoteTabletPtr& tablet);
+
   // Compute a new deadline based on timeout_. If no timeout_ has been set,
   // uses a hard-coded default and issues periodic warnings.
   CoarseTimePoint ComputeDeadlineUnlocked() const;
@@ -306,6 +315,18 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   // Number of outstanding lookups across all in-flight ops.
   int outstanding_lookups_ = 0;
 
+  // Tablets resolved for operations of this batch. Large batches usually contain many operations
+  // per tablet, so following operations are routed to already resolved tablets without a meta
+  // cache lookup.
+  // Keyed by table and tablet partition start.
+  using ResolvedTabletKey = std::pair<const YBTable*, std::string>;
+  struct ResolvedTablet {
+    internal::RemoteTabletPtr tablet;
+    int32_t partitions_version;
+  };
+  mutable std::mutex resolved_tablets_mutex_;
+  std::map<ResolvedTabletKey, ResolvedTablet> resolved_tablets_ GUARDED_BY(resolved_tablets_mutex_);
+
   // If true, we might allow the local calls to be run in the same IPC thread.
   bool allow_local_calls_in_curr_thread_ = true;
 
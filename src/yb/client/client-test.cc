@@ -99,6 +99,7 @@
 DECLARE_bool(enable_data_block_fsync);
 DECLARE_bool(log_inject_latency);
 DECLARE_double(leader_failure_max_missed_heartbeat_periods);
+DECLARE_int32(batcher_max_resolved_tablets);
 DECLARE_int32(heartbeat_interval_ms);
 DECLARE_int32(log_inject_latency_ms_mean);
 DECLARE_int32(log_inject_latency_ms_stddev);
@@ -116,6 +117,7 @@ DECLARE_int32(max_backoff_ms_exponent);
 DECLARE_bool(TEST_force_master_lookup_all_tablets);
 DECLARE_double(TEST_simulate_lookup_timeout_probability);
 
+METRIC_DECLARE_counter(batcher_resolved_tablet_reuses);
 METRIC_DECLARE_counter(rpcs_queue_overflow);
 
 DEFINE_CAPABILITY(ClientTest, 0x1523c5ae);
@@ -2516,5 +2518,38 @@ TEST_F(ClientTest, RefreshPartitions) {
   LOG(INFO) << "num_lookups_done: " << num_lookups_done;
 }
 
+
+// Checks that operations of a batch are routed to tablets already resolved by the same batch, and
+// that resolved tablets are not reused after table partitions are refreshed.
+TEST_F(ClientTest, BatcherReusesResolvedTablets) {
+  constexpr int kNumRows = 100;
+  auto* server = cluster_->mini_tablet_server(0)->server();
+  // Use tablet server client, since it has metric entity.
+  auto* client = server->client();
+  TableHandle table;
+  ASSERT_OK(table.Open(kTableName, client));
+  auto reuses = METRIC_batcher_resolved_tablet_reuses.Instantiate(server->metric_entity());
+
+  FLAGS_batcher_max_resolved_tablets = 0;
+  ASSERT_NO_FATALS(InsertTestRows(client, table, kNumRows));
+  ASSERT_EQ(reuses->value(), 0);
+
+  // Meta cache is already filled, so only the first operation for each tablet is looked up.
+  FLAGS_batcher_max_resolved_tablets = 64;
+  ASSERT_NO_FATALS(InsertTestRows(client, table, kNumRows, kNumRows));
+  ASSERT_GE(reuses->value(), kNumRows - kNumTablets);
+
+  const auto reuses_before_refresh = reuses->value();
+  auto session = CreateSession(client);
+  for (int i = 2 * kNumRows; i != 3 * kNumRows; ++i) {
+    table->MarkPartitionsAsStale();
+    ASSERT_OK(session->Apply(BuildTestRow(table, i)));
+  }
+  FlushSessionOrDie(session);
+  ASSERT_EQ(reuses->value(), reuses_before_refresh);
+
+  ASSERT_EQ(CountRowsFromClient(table), 3 * kNumRows);
+}
+
 }  // namespace client
 }  // namespace yb
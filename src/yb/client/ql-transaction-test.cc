@@ -13,6 +13,9 @@
 //
 //
 
+#include <future>
+#include <unordered_set>
+
 #include "yb/client/txn-test-base.h"
 
 #include "yb/client/session.h"
@@ -24,10 +27,14 @@
 
 #include "yb/consensus/consensus.h"
 
+#include "yb/rocksdb/db.h"
+
 #include "yb/rpc/rpc.h"
 
+#include "yb/tablet/finished_transactions.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/transaction_coordinator.h"
+#include "yb/tablet/transaction_participant.h"
 
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/tserver/tablet_server.h"
@@ -48,8 +55,12 @@ using yb::tablet::GetTransactionTimeout;
 using yb::tablet::TabletPeer;
 
 DECLARE_bool(TEST_disable_proactive_txn_cleanup_on_abort);
+DECLARE_bool(cleanup_intents_by_compaction);
 DECLARE_bool(TEST_fail_in_apply_if_no_metadata);
 DECLARE_bool(TEST_master_fail_transactional_tablet_lookups);
+DECLARE_bool(use_local_transaction_status_tablets);
+DECLARE_bool(enable_transaction_heartbeat_batching);
+DECLARE_int32(transaction_status_tablets_refresh_interval_ms);
 DECLARE_bool(TEST_transaction_allow_rerequest_status);
 DECLARE_bool(delete_intents_sst_files);
 DECLARE_bool(enable_load_balancing);
@@ -60,11 +71,15 @@ DECLARE_int32(TEST_delay_init_tablet_peer_ms);
 DECLARE_int32(log_min_seconds_to_retain);
 DECLARE_int32(remote_bootstrap_max_chunk_size);
 DECLARE_int64(transaction_rpc_timeout_ms);
+DECLARE_double(transaction_max_missed_heartbeat_periods);
 DECLARE_uint64(TEST_transaction_delay_status_reply_usec_in_tests);
 DECLARE_uint64(aborted_intent_cleanup_ms);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_uint64(transaction_heartbeat_usec);
 
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_UpdateTransaction);
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_UpdateTransactions);
+
 namespace yb {
 namespace client {
 
@@ -114,6 +129,75 @@ TEST_F(QLTransactionTest, Simple) {
   AssertNoRunningTransactions();
 }
 
+TEST_F(QLTransactionTest, LocalStatusTablets) {
+  // Refresh leader locations of status tablets on every pick.
+  FLAGS_transaction_status_tablets_refresh_interval_ms = 0;
+  // Create the transaction status table.
+  ASSERT_NO_FATALS(WriteData(WriteOpType::INSERT, 0));
+
+  // Turned on after status tablets were resolved, so leader locations should be fetched on the
+  // next pick.
+  FLAGS_use_local_transaction_status_tablets = true;
+
+  // Each mini tablet server is placed in its own region. So use the client in the region of the
+  // tablet server that leads the most status tablets.
+  auto status_tablet_leaders = [this](size_t ts_idx) {
+    std::unordered_set<TabletId> result;
+    const auto& uuid = cluster_->mini_tablet_server(ts_idx)->server()->permanent_uuid();
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders)) {
+      if (peer->permanent_uuid() == uuid &&
+          peer->tablet_metadata()->table_name() == kTransactionsTableName) {
+        result.insert(peer->tablet_id());
+      }
+    }
+    return result;
+  };
+  size_t local_ts_idx = 0;
+  for (size_t i = 1; i != cluster_->num_tablet_servers(); ++i) {
+    if (status_tablet_leaders(i).size() > status_tablet_leaders(local_ts_idx).size()) {
+      local_ts_idx = i;
+    }
+  }
+  ASSERT_FALSE(status_tablet_leaders(local_ts_idx).empty());
+
+  YBClientBuilder builder;
+  builder.set_cloud_info_pb(
+      cluster_->mini_tablet_server(local_ts_idx)->server()->options().MakeCloudInfoPB());
+  auto client = ASSERT_RESULT(cluster_->CreateClient(&builder));
+  TransactionManager manager(client.get(), clock_, LocalTabletFilter());
+
+  auto pick = [&manager](TransactionLocality locality) -> Result<TabletId> {
+    std::promise<Result<TabletId>> promise;
+    manager.PickStatusTablet(locality, [&promise](const Result<TabletId>& result) {
+      promise.set_value(result);
+    });
+    return promise.get_future().get();
+  };
+
+  // Leaders could move, so retry until all picks are local.
+  ASSERT_OK(WaitFor([&]() -> Result<bool> {
+    auto local_tablets = status_tablet_leaders(local_ts_idx);
+    for (int i = 0; i != 10; ++i) {
+      auto tablet_id = VERIFY_RESULT(pick(TransactionLocality::kLocal));
+      if (!local_tablets.count(tablet_id)) {
+        LOG(INFO) << "Picked not local status tablet: " << tablet_id;
+        return false;
+      }
+    }
+    return true;
+  }, 30s, "Pick local status tablets"));
+
+  // Global transactions could use any status tablet.
+  ASSERT_RESULT(pick(TransactionLocality::kGlobal));
+
+  constexpr size_t kNumTransactions = 3;
+  for (size_t i = 1; i != kNumTransactions; ++i) {
+    ASSERT_NO_FATALS(WriteData(WriteOpType::INSERT, i));
+  }
+  ASSERT_NO_FATALS(VerifyData(kNumTransactions));
+  AssertNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, LookupTabletFailure) {
   FLAGS_TEST_master_fail_transactional_tablet_lookups = true;
 
@@ -431,6 +515,96 @@ TEST_F(QLTransactionTest, Heartbeat) {
   AssertNoRunningTransactions();
 }
 
+// Several concurrent transactions that outlive transaction timeout, so they are kept alive only by
+// batched heartbeats.
+TEST_F(QLTransactionTest, BatchedHeartbeat) {
+  FLAGS_enable_transaction_heartbeat_batching = true;
+  constexpr size_t kTransactions = 5;
+  std::vector<YBTransactionPtr> transactions;
+  std::unordered_set<TabletId> status_tablets;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    auto txn = CreateTransaction();
+    auto session = CreateSession(txn);
+    ASSERT_OK(WriteRows(session, i));
+    status_tablets.insert(ASSERT_RESULT(txn->GetMetadata().get()).status_tablet);
+    transactions.push_back(std::move(txn));
+  }
+
+  auto calls = [this](auto* metric) {
+    uint64_t result = 0;
+    for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      result += metric->Instantiate(cluster_->mini_tablet_server(i)->server()->metric_entity())
+                    ->TotalCount();
+    }
+    return result;
+  };
+  auto* single_metric = &METRIC_handler_latency_yb_tserver_TabletServerService_UpdateTransaction;
+  auto* batch_metric = &METRIC_handler_latency_yb_tserver_TabletServerService_UpdateTransactions;
+  const auto single_calls = calls(single_metric);
+
+  // Each heartbeat tick sends one UpdateTransactions RPC per status tablet. So after the number of
+  // RPCs below, at least one status tablet received more ticks than transaction could miss, i.e.
+  // transactions would be expired without heartbeats.
+  const auto min_batch_calls =
+      calls(batch_metric) +
+      (static_cast<size_t>(FLAGS_transaction_max_missed_heartbeat_periods) + 2) *
+          status_tablets.size();
+  ASSERT_OK(WaitFor([&] { return calls(batch_metric) >= min_batch_calls; },
+                    GetTransactionTimeout() * 4, "Batched heartbeats"));
+  // All heartbeats were sent in batches.
+  ASSERT_EQ(calls(single_metric), single_calls);
+
+  for (const auto& txn : transactions) {
+    ASSERT_OK(txn->CommitFuture().get());
+  }
+  VerifyData(kTransactions);
+  AssertNoRunningTransactions();
+}
+
+// Intents of applied transaction are dropped by intents DB compaction only after the apply was
+// flushed to regular DB, otherwise they would be missing for apply replay during bootstrap.
+TEST_F(QLTransactionTest, CleanupIntentsByCompaction) {
+  FLAGS_cleanup_intents_by_compaction = true;
+  ASSERT_NO_FATALS(WriteData());
+  ASSERT_NO_FATALS(AssertNoRunningTransactions());
+
+  std::vector<tablet::TabletPeerPtr> peers;
+  for (auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+    if (peer->tablet()->transaction_participant()) {
+      peers.push_back(std::move(peer));
+    }
+  }
+  auto count_intents = [&peers]() -> Result<int64_t> {
+    int64_t result = 0;
+    for (const auto& peer : peers) {
+      result += VERIFY_RESULT(peer->tablet()->CountIntents());
+    }
+    return result;
+  };
+  auto compact_intents = [&peers]() -> Status {
+    for (const auto& peer : peers) {
+      RETURN_NOT_OK(peer->tablet()->TEST_intents_db()->CompactRange(
+          rocksdb::CompactRangeOptions(), /* begin = */ nullptr, /* end = */ nullptr));
+    }
+    return Status::OK();
+  };
+
+  ASSERT_GT(ASSERT_RESULT(count_intents()), 0);
+  ASSERT_OK(compact_intents());
+  ASSERT_GT(ASSERT_RESULT(count_intents()), 0);
+
+  for (const auto& peer : peers) {
+    ASSERT_OK(peer->tablet()->Flush(tablet::FlushMode::kSync, tablet::FlushFlags::kRegular));
+  }
+  ASSERT_OK(compact_intents());
+  ASSERT_EQ(ASSERT_RESULT(count_intents()), 0);
+  for (const auto& peer : peers) {
+    ASSERT_EQ(peer->tablet()->transaction_participant()->finished_transactions().size(), 0);
+  }
+
+  ASSERT_NO_FATALS(VerifyData());
+}
+
 TEST_F(QLTransactionTest, Expire) {
   SetDisableHeartbeatInTests(true);
   auto txn = CreateTransaction();
@@ -64,6 +64,10 @@ void YBSession::DeferReadPoint() {
   read_point_->Defer();
 }
 
+void YBSession::BackdateReadPoint() {
+  read_point_->Backdate();
+}
+
 void YBSession::SetTransaction(YBTransactionPtr transaction) {
   transaction_ = std::move(transaction);
   internal::BatcherPtr old_batcher;
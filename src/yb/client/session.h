@@ -108,6 +108,10 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
   // session, this call is idempotent.
   void DeferReadPoint();
 
+  // Move the read hybrid time to the past by the max clock skew, so reads never require restart.
+  // Idempotent.
+  void BackdateReadPoint();
+
   // Used for backfilling the index, where we may want to write with a historic timestamp.
   void SetHybridTimeForWrite(const HybridTime ht);
 
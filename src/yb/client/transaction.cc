@@ -23,6 +23,7 @@
 #include "yb/client/meta_cache.h"
 #include "yb/client/tablet_rpc.h"
 #include "yb/client/transaction_cleanup.h"
+#include "yb/client/transaction_heartbeat_batcher.h"
 #include "yb/client/transaction_manager.h"
 #include "yb/client/transaction_rpc.h"
 #include "yb/client/yb_op.h"
@@ -47,7 +48,14 @@ using namespace std::placeholders;
 DEFINE_uint64(transaction_heartbeat_usec, 500000 * yb::kTimeMultiplier,
               "Interval of transaction heartbeat in usec.");
 DEFINE_bool(transaction_disable_heartbeat_in_tests, false, "Disable heartbeat during test.");
+DEFINE_bool(enable_transaction_heartbeat_batching, false,
+            "Send registrations and heartbeats of transactions that use the same status tablet "
+            "as a single UpdateTransactions RPC per status tablet. Requires all tablet servers to "
+            "support UpdateTransactions RPC.");
+TAG_FLAG(enable_transaction_heartbeat_batching, runtime);
+TAG_FLAG(enable_transaction_heartbeat_batching, advanced);
 DECLARE_uint64(max_clock_skew_usec);
+DECLARE_bool(use_local_transaction_status_tablets);
 
 DEFINE_test_flag(int32, transaction_inject_flushed_delay_ms, 0,
                  "Inject delay before processing flushed operations by transaction.");
@@ -243,6 +251,9 @@ class YBTransaction::Impl final {
         if (waiter) {
           waiters_.push_back(std::move(waiter));
         }
+        if (FLAGS_use_local_transaction_status_tablets && metadata_.status_tablet.empty()) {
+          UpdateStatusTabletLocalityUnlocked(*ops_info);
+        }
         lock.unlock();
         VLOG_WITH_PREFIX(2) << "Prepare, rejected (not ready, requesting status tablet)";
         RequestStatusTablet(deadline);
@@ -733,6 +744,19 @@ class YBTransaction::Impl final {
     manager_->rpcs().Unregister(&abort_handle_);
   }
 
+  // Transaction becomes global when any of its first operations goes to a tablet with leader in
+  // another region, so its status tablet is picked among all status tablets.
+  void UpdateStatusTabletLocalityUnlocked(const InFlightOpsGroupsWithMetadata& ops_info) {
+    const auto& cloud_info = manager_->client()->cloud_info();
+    for (const auto& group : ops_info.groups) {
+      auto* leader = (**group.begin).tablet->LeaderTServer();
+      if (leader && leader->cloud_info().placement_region() != cloud_info.placement_region()) {
+        status_tablet_locality_.store(TransactionLocality::kGlobal, std::memory_order_release);
+        return;
+      }
+    }
+  }
+
   void RequestStatusTablet(const CoarseTimePoint& deadline) {
     bool expected = false;
     if (!requested_status_tablet_.compare_exchange_strong(
@@ -743,6 +767,7 @@ class YBTransaction::Impl final {
     auto transaction = transaction_->shared_from_this();
     if (metadata_.status_tablet.empty()) {
       manager_->PickStatusTablet(
+          status_tablet_locality_.load(std::memory_order_acquire),
           std::bind(&Impl::StatusTabletPicked, this, _1, deadline, transaction));
     } else {
       LookupStatusTablet(metadata_.status_tablet, deadline, transaction);
@@ -852,6 +877,11 @@ class YBTransaction::Impl final {
       timeout = TransactionRpcTimeout();
     }
 
+    if (GetAtomicFlag(&FLAGS_enable_transaction_heartbeat_batching)) {
+      SendBatchedHeartbeat(timeout, status, transaction);
+      return;
+    }
+
     tserver::UpdateTransactionRequestPB req;
     req.set_tablet_id(status_tablet_->tablet_id());
     req.set_propagated_hybrid_time(manager_->Now().ToUint64());
@@ -868,6 +898,34 @@ class YBTransaction::Impl final {
         &heartbeat_handle_);
   }
 
+  // Queues heartbeat to the batcher, that sends it with heartbeats of other transactions using
+  // the same status tablet.
+  void SendBatchedHeartbeat(
+      MonoDelta timeout, TransactionStatus status, const YBTransactionPtr& transaction) {
+    UpdateTransactionCallback callback;
+    if (status == TransactionStatus::CREATED) {
+      callback = std::bind(&Impl::HeartbeatDone, this, _1, _2, status, transaction);
+    } else {
+      // Heartbeat waits in the batcher for the heartbeat tick of the status tablet, so the same
+      // as the scheduled heartbeat of the non batched path, it does not keep transaction alive.
+      // If transaction is destroyed meanwhile, its destructor aborts the queued heartbeat.
+      std::weak_ptr<YBTransaction> weak_transaction(transaction);
+      callback = [this, weak_transaction, status](
+          const Status& rpc_status, const tserver::UpdateTransactionResponsePB& response) {
+        auto transaction = weak_transaction.lock();
+        if (!transaction) {
+          manager_->rpcs().Unregister(&heartbeat_handle_);
+          return;
+        }
+        HeartbeatDone(rpc_status, response, status, transaction);
+      };
+    }
+    manager_->rpcs().RegisterAndStart(
+        manager_->heartbeat_batcher().UpdateTransaction(
+            timeout, status_tablet_, metadata_.transaction_id, status, std::move(callback)),
+        &heartbeat_handle_);
+  }
+
   static bool AllowHeartbeat(TransactionState current_state, TransactionStatus status) {
     switch (current_state) {
       case TransactionState::kRunning:
@@ -896,6 +954,12 @@ class YBTransaction::Impl final {
       if (transaction_status == TransactionStatus::CREATED) {
         NotifyWaiters(Status::OK());
       }
+      if (GetAtomicFlag(&FLAGS_enable_transaction_heartbeat_batching) &&
+          !GetAtomicFlag(&FLAGS_transaction_disable_heartbeat_in_tests)) {
+        // Batcher delays heartbeat till the next heartbeat tick of the status tablet.
+        SendHeartbeat(TransactionStatus::PENDING, metadata_.transaction_id, transaction);
+        return;
+      }
       std::weak_ptr<YBTransaction> weak_transaction(transaction);
       manager_->client()->messenger()->scheduler().Schedule(
           [this, weak_transaction, id = metadata_.transaction_id](const Status&) {
@@ -989,6 +1053,7 @@ class YBTransaction::Impl final {
 
   std::string log_prefix_;
   std::atomic<bool> requested_status_tablet_{false};
+  std::atomic<TransactionLocality> status_tablet_locality_{TransactionLocality::kLocal};
   internal::RemoteTabletPtr status_tablet_;
   std::atomic<TransactionState> state_{TransactionState::kRunning};
   // Transaction is successfully initialized and ready to process intents.
@@ -0,0 +1,353 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/client/transaction_heartbeat_batcher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/client/client.h"
+#include "yb/client/meta_cache.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/rpc.h"
+#include "yb/rpc/scheduler.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/thread_annotations.h"
+
+DEFINE_int64(transaction_registration_batch_window_usec, 1000,
+             "Time during which registrations of new transactions with the same status tablet "
+             "are accumulated before being sent as a single RPC.");
+TAG_FLAG(transaction_registration_batch_window_usec, runtime);
+TAG_FLAG(transaction_registration_batch_window_usec, advanced);
+
+DECLARE_uint64(transaction_heartbeat_usec);
+
+namespace yb {
+namespace client {
+
+class TransactionHeartbeatBatcher::Impl : public std::enable_shared_from_this<Impl> {
+ public:
+  // Status update of a single transaction, queued in the batcher until the batch is sent.
+  class Request : public rpc::RpcCommand {
+   public:
+    Request(std::shared_ptr<Impl> impl, MonoDelta timeout,
+            const internal::RemoteTabletPtr& status_tablet, const TransactionId& transaction_id,
+            TransactionStatus status, UpdateTransactionCallback callback)
+        : impl_(std::move(impl)), timeout_(timeout), status_tablet_(status_tablet),
+          transaction_id_(transaction_id), status_(status), callback_(std::move(callback)) {}
+
+    void SendRpc() override {
+      impl_->Add(std::static_pointer_cast<Request>(shared_from_this()));
+    }
+
+    std::string ToString() const override {
+      return Format(
+          "BatchedUpdateTransaction: { status_tablet: $0 transaction_id: $1 status: $2 }",
+          status_tablet_->tablet_id(), transaction_id_, TransactionStatus_Name(status_));
+    }
+
+    void Finished(const Status& status) override {
+      Complete(status, tserver::UpdateTransactionResponsePB());
+    }
+
+    void Abort() override {
+      Finished(STATUS(Aborted, "Transaction update aborted"));
+    }
+
+    CoarseTimePoint deadline() const override {
+      return deadline_;
+    }
+
+    // Invokes callback, unless it was already invoked, i.e. request was aborted while batch
+    // containing it was in flight.
+    void Complete(const Status& status, const tserver::UpdateTransactionResponsePB& response) {
+      if (completed_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+      }
+      auto callback = std::move(callback_);
+      callback(status, response);
+    }
+
+    bool completed() const {
+      return completed_.load(std::memory_order_acquire);
+    }
+
+    // Should be invoked before request is queued, send_time is the time when the batch containing
+    // this request is expected to be sent.
+    void SetSendTime(CoarseTimePoint send_time) {
+      deadline_ = send_time + timeout_;
+    }
+
+    MonoDelta timeout() const {
+      return timeout_;
+    }
+
+    const internal::RemoteTabletPtr& status_tablet() const {
+      return status_tablet_;
+    }
+
+    const TransactionId& transaction_id() const {
+      return transaction_id_;
+    }
+
+    TransactionStatus status() const {
+      return status_;
+    }
+
+   private:
+    std::shared_ptr<Impl> impl_;
+    const MonoDelta timeout_;
+    const internal::RemoteTabletPtr status_tablet_;
+    const TransactionId transaction_id_;
+    const TransactionStatus status_;
+    CoarseTimePoint deadline_ = CoarseTimePoint::max();
+    UpdateTransactionCallback callback_;
+    std::atomic<bool> completed_{false};
+  };
+
+  using RequestPtr = std::shared_ptr<Request>;
+
+  Impl(YBClient* client, const scoped_refptr<ClockBase>& clock)
+      : client_(client), clock_(clock) {}
+
+  void Shutdown() {
+    std::vector<RequestPtr> requests;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closing_) {
+        return;
+      }
+      closing_ = true;
+      for (auto* queues : {&registration_queues_, &heartbeat_queues_}) {
+        for (auto& tablet_and_queue : *queues) {
+          auto& queue_requests = tablet_and_queue.second.requests;
+          requests.insert(requests.end(), queue_requests.begin(), queue_requests.end());
+        }
+        queues->clear();
+      }
+    }
+    for (const auto& request : requests) {
+      request->Abort();
+    }
+    rpcs_.Shutdown();
+  }
+
+  void Add(const RequestPtr& request) {
+    const auto& tablet_id = request->status_tablet()->tablet_id();
+    const auto status = request->status();
+    bool added = false;
+    bool schedule_flush = false;
+    CoarseTimePoint flush_time;
+    CoarseDuration flush_delay = CoarseDuration::zero();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!closing_) {
+        auto& queue = Queues(status)[tablet_id];
+        if (!queue.status_tablet) {
+          queue.status_tablet = request->status_tablet();
+        }
+        auto now = CoarseMonoClock::now();
+        CoarseTimePoint send_time;
+        if (status == TransactionStatus::CREATED) {
+          // Registration blocks the transaction, so it is delayed only for the short batching
+          // window.
+          send_time = now + std::chrono::microseconds(
+              std::max<int64_t>(FLAGS_transaction_registration_batch_window_usec, 0));
+        } else {
+          // Heartbeat is aligned to the heartbeat tick of its status tablet.
+          send_time = std::max(
+              now, queue.last_flush_time + std::chrono::microseconds(
+                  FLAGS_transaction_heartbeat_usec));
+        }
+        request->SetSendTime(std::min(queue.flush_time, send_time));
+        queue.requests.push_back(request);
+        if (send_time < queue.flush_time) {
+          // Flush scheduled for a later time becomes stale and would be ignored.
+          schedule_flush = true;
+          queue.flush_time = send_time;
+          flush_time = send_time;
+          flush_delay = send_time - now;
+        }
+        added = true;
+      }
+    }
+    if (!added) {
+      request->Abort();
+      return;
+    }
+    if (schedule_flush) {
+      client_->messenger()->scheduler().Schedule(
+          [self = shared_from_this(), tablet_id, status, flush_time](const Status&) {
+            self->Flush(tablet_id, status, flush_time);
+          },
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(flush_delay));
+    }
+  }
+
+ private:
+  struct TabletQueue {
+    internal::RemoteTabletPtr status_tablet;
+    std::vector<RequestPtr> requests;
+    // Time of the scheduled flush, max when queue is empty.
+    CoarseTimePoint flush_time = CoarseTimePoint::max();
+    CoarseTimePoint last_flush_time;
+  };
+
+  using TabletQueues = std::unordered_map<TabletId, TabletQueue>;
+  using Batch = std::vector<RequestPtr>;
+  using BatchPtr = std::shared_ptr<Batch>;
+
+  // Registrations and heartbeats are queued separately, so a heartbeat is not sent before the
+  // heartbeat tick of its status tablet just because a registration to this tablet is flushed.
+  TabletQueues& Queues(TransactionStatus status) REQUIRES(mutex_) {
+    return status == TransactionStatus::CREATED ? registration_queues_ : heartbeat_queues_;
+  }
+
+  // Sends requests queued for the status tablet with the specified status, if the flush at
+  // flush_time is still actual. It is not after shutdown, or when an earlier flush was scheduled.
+  void Flush(const TabletId& tablet_id, TransactionStatus status, CoarseTimePoint flush_time) {
+    auto batch = std::make_shared<Batch>();
+    internal::RemoteTabletPtr status_tablet;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& queues = Queues(status);
+      auto it = queues.find(tablet_id);
+      if (it == queues.end() || it->second.flush_time != flush_time) {
+        return;
+      }
+      auto& queue = it->second;
+      batch->swap(queue.requests);
+      queue.flush_time = CoarseTimePoint::max();
+      queue.last_flush_time = CoarseMonoClock::now();
+      status_tablet = queue.status_tablet;
+    }
+    // Requests that were aborted while queued do not need to be sent.
+    batch->erase(std::remove_if(batch->begin(), batch->end(), [](const auto& request) {
+      return request->completed();
+    }), batch->end());
+    if (!batch->empty()) {
+      Send(status_tablet, batch);
+    }
+  }
+
+  void Send(const internal::RemoteTabletPtr& status_tablet, const BatchPtr& batch) {
+    tserver::UpdateTransactionsRequestPB req;
+    req.set_tablet_id(status_tablet->tablet_id());
+    req.set_propagated_hybrid_time(clock_->Now().ToUint64());
+    auto timeout = MonoDelta::kZero;
+    for (const auto& request : *batch) {
+      auto& state = *req.add_states();
+      const auto& id = request->transaction_id();
+      state.set_transaction_id(id.data(), id.size());
+      state.set_status(request->status());
+      timeout = std::max(timeout, request->timeout());
+    }
+
+    VLOG(4) << "Sending " << batch->size() << " transaction updates to "
+            << status_tablet->tablet_id();
+
+    auto handle = rpcs_.Prepare();
+    if (handle == rpcs_.InvalidHandle()) {
+      CompleteBatch(*batch, STATUS(Aborted, "Aborted because cannot start RPC"),
+                    tserver::UpdateTransactionResponsePB());
+      return;
+    }
+    *handle = UpdateTransactions(
+        CoarseMonoClock::now() + timeout,
+        status_tablet.get(),
+        client_,
+        &req,
+        [self = shared_from_this(), handle, batch](
+            const Status& status, const tserver::UpdateTransactionsResponsePB& response) {
+          self->rpcs_.Unregister(handle);
+          self->BatchReceived(status, response, *batch);
+        });
+    (**handle).SendRpc();
+  }
+
+  // Splits response to the batched RPC into per transaction responses.
+  void BatchReceived(Status status, const tserver::UpdateTransactionsResponsePB& response,
+                     const Batch& batch) {
+    VLOG(4) << "Batched updates of " << batch.size() << " transactions done: " << status;
+
+    if (status.ok() && static_cast<size_t>(response.statuses().size()) != batch.size()) {
+      status = STATUS_FORMAT(
+          IllegalState, "Bad response size, expected $0 entries, but found: $1",
+          batch.size(), response.statuses().size());
+    }
+
+    tserver::UpdateTransactionResponsePB single_response;
+    if (response.has_propagated_hybrid_time()) {
+      single_response.set_propagated_hybrid_time(response.propagated_hybrid_time());
+    }
+    if (!status.ok()) {
+      if (response.has_error()) {
+        *single_response.mutable_error() = response.error();
+      }
+      CompleteBatch(batch, status, single_response);
+      return;
+    }
+
+    for (size_t i = 0; i != batch.size(); ++i) {
+      batch[i]->Complete(StatusFromPB(response.statuses(i)), single_response);
+    }
+  }
+
+  void CompleteBatch(const Batch& batch, const Status& status,
+                     const tserver::UpdateTransactionResponsePB& response) {
+    for (const auto& request : batch) {
+      request->Complete(status, response);
+    }
+  }
+
+  YBClient* const client_;
+  scoped_refptr<ClockBase> clock_;
+  rpc::Rpcs rpcs_;
+
+  std::mutex mutex_;
+  bool closing_ GUARDED_BY(mutex_) = false;
+  TabletQueues registration_queues_ GUARDED_BY(mutex_);
+  TabletQueues heartbeat_queues_ GUARDED_BY(mutex_);
+};
+
+TransactionHeartbeatBatcher::TransactionHeartbeatBatcher(
+    YBClient* client, const scoped_refptr<ClockBase>& clock)
+    : impl_(std::make_shared<Impl>(client, clock)) {
+}
+
+TransactionHeartbeatBatcher::~TransactionHeartbeatBatcher() {
+  Shutdown();
+}
+
+void TransactionHeartbeatBatcher::Shutdown() {
+  impl_->Shutdown();
+}
+
+rpc::RpcCommandPtr TransactionHeartbeatBatcher::UpdateTransaction(
+    MonoDelta timeout, const internal::RemoteTabletPtr& status_tablet,
+    const TransactionId& transaction_id, TransactionStatus status,
+    UpdateTransactionCallback callback) {
+  return std::make_shared<Impl::Request>(
+      impl_, timeout, status_tablet, transaction_id, status, std::move(callback));
+}
+
+} // namespace client
+} // namespace yb
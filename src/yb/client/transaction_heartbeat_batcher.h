@@ -0,0 +1,63 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CLIENT_TRANSACTION_HEARTBEAT_BATCHER_H
+#define YB_CLIENT_TRANSACTION_HEARTBEAT_BATCHER_H
+
+#include <memory>
+
+#include "yb/client/client_fwd.h"
+#include "yb/client/transaction_rpc.h"
+
+#include "yb/common/clock.h"
+#include "yb/common/transaction.h"
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace client {
+
+// Combines registrations (CREATED) and heartbeats (PENDING) of transactions that use the same
+// status tablet into UpdateTransactions RPCs.
+//
+// Registrations are accumulated for FLAGS_transaction_registration_batch_window_usec.
+// Heartbeats are sent collectively, once per FLAGS_transaction_heartbeat_usec for each status
+// tablet, so heartbeat RPC rate does not depend on the number of running transactions.
+class TransactionHeartbeatBatcher {
+ public:
+  TransactionHeartbeatBatcher(YBClient* client, const scoped_refptr<ClockBase>& clock);
+  ~TransactionHeartbeatBatcher();
+
+  void Shutdown();
+
+  // Returns RPC command that sends new status of transaction to its status tablet, as part of the
+  // next UpdateTransactions RPC to this tablet. Callback is invoked with the response that
+  // contains only propagated hybrid time of the batch.
+  // The command should be started and tracked by the caller, the same way as RPC command returned
+  // by client::UpdateTransaction.
+  MUST_USE_RESULT rpc::RpcCommandPtr UpdateTransaction(
+      MonoDelta timeout, const internal::RemoteTabletPtr& status_tablet,
+      const TransactionId& transaction_id, TransactionStatus status,
+      UpdateTransactionCallback callback);
+
+ private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+} // namespace client
+} // namespace yb
+
+#endif // YB_CLIENT_TRANSACTION_HEARTBEAT_BATCHER_H
@@ -15,6 +15,8 @@
 
 #include "yb/client/transaction_manager.h"
 
+#include "yb/client/transaction_heartbeat_batcher.h"
+
 #include "yb/rpc/rpc.h"
 #include "yb/rpc/thread_pool.h"
 #include "yb/rpc/tasks_pool.h"
@@ -26,14 +28,32 @@
 
 #include "yb/common/transaction.h"
 
+#include "yb/master/master.pb.h"
 #include "yb/master/master_defaults.h"
 
+#include "yb/util/flag_tags.h"
+
 DEFINE_uint64(transaction_manager_workers_limit, 50,
               "Max number of workers used by transaction manager");
 
 DEFINE_uint64(transaction_manager_queue_limit, 500,
               "Max number of tasks used by transaction manager");
 
+DEFINE_bool(use_local_transaction_status_tablets, false,
+            "Prefer transaction status tablets whose leader is in the same zone, or at least in "
+            "the same region, as the client. Transactions whose first operations touch tablets "
+            "with leaders in other regions pick any status tablet.");
+TAG_FLAG(use_local_transaction_status_tablets, runtime);
+TAG_FLAG(use_local_transaction_status_tablets, advanced);
+
+DEFINE_int32(transaction_status_tablets_refresh_interval_ms, 60000,
+             "Interval at which leader locations of transaction status tablets are refreshed, "
+             "when local transaction status tablets are preferred.");
+TAG_FLAG(transaction_status_tablets_refresh_interval_ms, runtime);
+TAG_FLAG(transaction_status_tablets_refresh_interval_ms, advanced);
+
+using namespace std::literals;
+
 namespace yb {
 namespace client {
 
@@ -43,16 +63,27 @@ const YBTableName kTransactionTableName(
     YQL_DATABASE_CQL, master::kSystemNamespaceName, kTransactionsTableName);
 
 // Exists - table exists.
-// Updating - intermediate state, we are currently updating local cache of tablets.
 // Resolved - final state, when all tablets are resolved and written to cache.
-YB_DEFINE_ENUM(TransactionTableStatus, (kExists)(kUpdating)(kResolved));
+YB_DEFINE_ENUM(TransactionTableStatus, (kExists)(kResolved));
+
+struct StatusTablets {
+  std::vector<TabletId> all;
+  // Tablets whose leader was in the same zone or the same region as the client, filled only when
+  // local transaction status tablets are preferred.
+  std::vector<TabletId> zone_local;
+  std::vector<TabletId> region_local;
+  // Whether leader locations were fetched, i.e. local tablets are filled.
+  bool has_leader_locations = false;
+};
 
-void InvokeCallback(const LocalTabletFilter& filter, const std::vector<TabletId>& tablets,
-                    const PickStatusTabletCallback& callback) {
+using StatusTabletsPtr = std::shared_ptr<const StatusTablets>;
+
+void InvokeCallback(const LocalTabletFilter& filter, const StatusTablets& tablets,
+                    TransactionLocality locality, const PickStatusTabletCallback& callback) {
   if (filter) {
     std::vector<const TabletId*> ids;
-    ids.reserve(tablets.size());
-    for (const auto& id : tablets) {
+    ids.reserve(tablets.all.size());
+    for (const auto& id : tablets.all) {
       ids.push_back(&id);
     }
     filter(&ids);
@@ -62,13 +93,30 @@ void InvokeCallback(const LocalTabletFilter& filter, const std::vector<TabletId>
     }
     YB_LOG_EVERY_N_SECS(WARNING, 1) << "No local transaction status tablet";
   }
-  callback(RandomElement(tablets));
+  if (locality == TransactionLocality::kLocal && FLAGS_use_local_transaction_status_tablets) {
+    for (const auto* local_tablets : {&tablets.zone_local, &tablets.region_local}) {
+      if (!local_tablets->empty()) {
+        callback(RandomElement(*local_tablets));
+        return;
+      }
+    }
+  }
+  callback(RandomElement(tablets.all));
 }
 
 struct TransactionTableState {
   LocalTabletFilter local_tablet_filter;
   std::atomic<TransactionTableStatus> status{TransactionTableStatus::kExists};
-  std::vector<TabletId> tablets;
+  // Replaced as a whole when leader locations are refreshed, so should be accessed with
+  // std::atomic_load/std::atomic_store.
+  StatusTabletsPtr tablets;
+  // Time after which leader locations of status tablets should be refreshed.
+  std::atomic<CoarseTimePoint> refresh_time{CoarseTimePoint::max()};
+  std::atomic<bool> refreshing{false};
+
+  StatusTabletsPtr GetTablets() const {
+    return std::atomic_load(&tablets);
+  }
 };
 
 // Picks status tablet for transaction.
@@ -76,32 +124,40 @@ class PickStatusTabletTask {
  public:
   PickStatusTabletTask(YBClient* client,
                        TransactionTableState* table_state,
+                       TransactionLocality locality,
                        PickStatusTabletCallback callback)
-      : client_(client), table_state_(table_state),
+      : client_(client), table_state_(table_state), locality_(locality),
         callback_(std::move(callback)) {
   }
 
   void Run() {
     // TODO(dtxn) async
     auto tablets_result = GetTransactionTableTablets();
+    table_state_->refreshing.store(false, std::memory_order_release);
     if (!tablets_result) {
       VLOG(1) << "Failed to get tablets of txn status table: " << tablets_result.status();
-      callback_(tablets_result.status());
+      if (callback_) {
+        callback_(tablets_result.status());
+      }
       return;
     }
     const auto tablets = std::move(*tablets_result);
-    auto expected = TransactionTableStatus::kExists;
-    if (table_state_->status.compare_exchange_strong(
-        expected, TransactionTableStatus::kUpdating, std::memory_order_acq_rel)) {
-      table_state_->tablets = tablets;
-      table_state_->status.store(TransactionTableStatus::kResolved, std::memory_order_release);
+    std::atomic_store(&table_state_->tablets, tablets);
+    if (FLAGS_use_local_transaction_status_tablets) {
+      table_state_->refresh_time.store(
+          CoarseMonoClock::now() + FLAGS_transaction_status_tablets_refresh_interval_ms * 1ms,
+          std::memory_order_release);
     }
+    table_state_->status.store(TransactionTableStatus::kResolved, std::memory_order_release);
 
-    InvokeCallback(table_state_->local_tablet_filter, tablets, callback_);
+    // Background refresh of leader locations does not have a callback.
+    if (callback_) {
+      InvokeCallback(table_state_->local_tablet_filter, *tablets, locality_, callback_);
+    }
   }
 
   void Done(const Status& status) {
-    if (!status.ok()) {
+    if (!status.ok() && callback_) {
       callback_(status);
     }
     callback_ = PickStatusTabletCallback();
@@ -109,41 +165,80 @@ class PickStatusTabletTask {
   }
 
  private:
-  Result<std::vector<TabletId>> GetTransactionTableTablets() {
-    std::vector<TabletId> tablets;
-    if (!FetchTransactionTableTablets(&tablets).ok()) {
+  Result<StatusTabletsPtr> GetTransactionTableTablets() {
+    auto tablets = std::make_shared<StatusTablets>();
+    if (!FetchTransactionTableTablets(tablets.get()).ok()) {
       // Tablets for txn status table are not ready yet.
       // Wait for table creation completion and try again.
       RETURN_NOT_OK(client_->WaitForCreateTableToFinish(kTransactionTableName));
-      RETURN_NOT_OK(FetchTransactionTableTablets(&tablets));
+      RETURN_NOT_OK(FetchTransactionTableTablets(tablets.get()));
     }
-    SCHECK(!tablets.empty(), IllegalState, Format("No tablets in table $0", kTransactionTableName));
-    return std::move(tablets);
+    SCHECK(!tablets->all.empty(), IllegalState,
+           Format("No tablets in table $0", kTransactionTableName));
+    return tablets;
   }
 
-  CHECKED_STATUS FetchTransactionTableTablets(std::vector<TabletId>* tablets) {
-    return client_->GetTablets(kTransactionTableName,
-                               0 /* max_tablets */,
-                               tablets,
-                               nullptr /* ranges */,
-                               nullptr /* locations */,
-                               RequireTabletsRunning::kTrue);
+  CHECKED_STATUS FetchTransactionTableTablets(StatusTablets* tablets) {
+    if (!FLAGS_use_local_transaction_status_tablets) {
+      return client_->GetTablets(kTransactionTableName,
+                                 0 /* max_tablets */,
+                                 &tablets->all,
+                                 nullptr /* ranges */,
+                                 nullptr /* locations */,
+                                 RequireTabletsRunning::kTrue);
+    }
+
+    std::vector<master::TabletLocationsPB> locations;
+    RETURN_NOT_OK(client_->GetTablets(kTransactionTableName,
+                                      0 /* max_tablets */,
+                                      &tablets->all,
+                                      nullptr /* ranges */,
+                                      &locations,
+                                      RequireTabletsRunning::kTrue));
+    tablets->has_leader_locations = true;
+    const auto& cloud_info = client_->cloud_info();
+    if (!cloud_info.has_placement_region()) {
+      return Status::OK();
+    }
+    for (const auto& location : locations) {
+      for (const auto& replica : location.replicas()) {
+        if (replica.role() != consensus::RaftPeerPB::LEADER) {
+          continue;
+        }
+        const auto& leader_cloud_info = replica.ts_info().cloud_info();
+        if (leader_cloud_info.placement_region() != cloud_info.placement_region()) {
+          continue;
+        }
+        tablets->region_local.push_back(location.tablet_id());
+        if (cloud_info.has_placement_zone() &&
+            leader_cloud_info.placement_zone() == cloud_info.placement_zone()) {
+          tablets->zone_local.push_back(location.tablet_id());
+        }
+      }
+    }
+    VLOG(1) << "Status tablets, total: " << tablets->all.size()
+            << ", zone local: " << tablets->zone_local.size()
+            << ", region local: " << tablets->region_local.size();
+    return Status::OK();
   }
 
   YBClient* client_;
   TransactionTableState* table_state_;
+  TransactionLocality locality_;
   PickStatusTabletCallback callback_;
 };
 
 class InvokeCallbackTask {
  public:
   InvokeCallbackTask(TransactionTableState* table_state,
+                     TransactionLocality locality,
                      PickStatusTabletCallback callback)
-      : table_state_(table_state), callback_(std::move(callback)) {
+      : table_state_(table_state), locality_(locality), callback_(std::move(callback)) {
   }
 
   void Run() {
-    InvokeCallback(table_state_->local_tablet_filter, table_state_->tablets, callback_);
+    InvokeCallback(
+        table_state_->local_tablet_filter, *table_state_->GetTablets(), locality_, callback_);
   }
 
   void Done(const Status& status) {
@@ -155,6 +250,7 @@ class InvokeCallbackTask {
 
  private:
   TransactionTableState* table_state_;
+  TransactionLocality locality_;
   PickStatusTabletCallback callback_;
 };
 
@@ -171,7 +267,8 @@ class TransactionManager::Impl {
             "TransactionManager", FLAGS_transaction_manager_queue_limit,
             FLAGS_transaction_manager_workers_limit),
         tasks_pool_(FLAGS_transaction_manager_queue_limit),
-        invoke_callback_tasks_(FLAGS_transaction_manager_queue_limit) {
+        invoke_callback_tasks_(FLAGS_transaction_manager_queue_limit),
+        heartbeat_batcher_(client, clock) {
     CHECK(clock);
   }
 
@@ -179,26 +276,55 @@ class TransactionManager::Impl {
     Shutdown();
   }
 
-  void PickStatusTablet(PickStatusTabletCallback callback) {
+  void PickStatusTablet(TransactionLocality locality, PickStatusTabletCallback callback) {
     if (table_state_.status.load(std::memory_order_acquire) == TransactionTableStatus::kResolved) {
+      if (ShouldRefreshTablets()) {
+        RefreshTablets();
+      }
+      // Picked from the cached tablets, while leader locations are refreshed in background.
       if (ThreadRestrictions::IsWaitAllowed()) {
-        InvokeCallback(table_state_.local_tablet_filter, table_state_.tablets, callback);
-      } else if (!invoke_callback_tasks_.Enqueue(&thread_pool_, &table_state_, callback)) {
+        InvokeCallback(
+            table_state_.local_tablet_filter, *table_state_.GetTablets(), locality, callback);
+      } else if (!invoke_callback_tasks_.Enqueue(
+                     &thread_pool_, &table_state_, locality, callback)) {
         callback(STATUS_FORMAT(ServiceUnavailable,
                               "Invoke callback queue overflow, number of tasks: $0",
                               invoke_callback_tasks_.size()));
       }
       return;
     }
-    if (!tasks_pool_.Enqueue(&thread_pool_, client_, &table_state_, std::move(callback))) {
+    if (!tasks_pool_.Enqueue(
+            &thread_pool_, client_, &table_state_, locality, std::move(callback))) {
       callback(STATUS_FORMAT(ServiceUnavailable, "Tasks overflow, exists: $0", tasks_pool_.size()));
     }
   }
 
+  void RefreshTablets() {
+    if (!tasks_pool_.Enqueue(
+            &thread_pool_, client_, &table_state_, TransactionLocality::kLocal,
+            PickStatusTabletCallback())) {
+      table_state_.refreshing.store(false, std::memory_order_release);
+    }
+  }
+
   const scoped_refptr<ClockBase>& clock() const {
     return clock_;
   }
 
+  // Returns true if this caller should refresh leader locations of resolved status tablets, so
+  // local status tablets are picked according to current leaders.
+  bool ShouldRefreshTablets() {
+    if (!FLAGS_use_local_transaction_status_tablets) {
+      return false;
+    }
+    // Leader locations are missing when tablets were fetched before the flag was turned on.
+    if (table_state_.GetTablets()->has_leader_locations &&
+        CoarseMonoClock::now() < table_state_.refresh_time.load(std::memory_order_acquire)) {
+      return false;
+    }
+    return !table_state_.refreshing.exchange(true, std::memory_order_acq_rel);
+  }
+
   YBClient* client() const {
     return client_;
   }
@@ -207,6 +333,10 @@ class TransactionManager::Impl {
     return rpcs_;
   }
 
+  TransactionHeartbeatBatcher& heartbeat_batcher() {
+    return heartbeat_batcher_;
+  }
+
   HybridTime Now() const {
     return clock_->Now();
   }
@@ -221,6 +351,7 @@ class TransactionManager::Impl {
 
   void Shutdown() {
     rpcs_.Shutdown();
+    heartbeat_batcher_.Shutdown();
     thread_pool_.Shutdown();
   }
 
@@ -233,6 +364,7 @@ class TransactionManager::Impl {
   yb::rpc::TasksPool<PickStatusTabletTask> tasks_pool_;
   yb::rpc::TasksPool<InvokeCallbackTask> invoke_callback_tasks_;
   yb::rpc::Rpcs rpcs_;
+  TransactionHeartbeatBatcher heartbeat_batcher_;
 };
 
 TransactionManager::TransactionManager(
@@ -242,8 +374,9 @@ TransactionManager::TransactionManager(
 
 TransactionManager::~TransactionManager() = default;
 
-void TransactionManager::PickStatusTablet(PickStatusTabletCallback callback) {
-  impl_->PickStatusTablet(std::move(callback));
+void TransactionManager::PickStatusTablet(
+    TransactionLocality locality, PickStatusTabletCallback callback) {
+  impl_->PickStatusTablet(locality, std::move(callback));
 }
 
 YBClient* TransactionManager::client() const {
@@ -254,6 +387,10 @@ rpc::Rpcs& TransactionManager::rpcs() {
   return impl_->rpcs();
 }
 
+TransactionHeartbeatBatcher& TransactionManager::heartbeat_batcher() {
+  return impl_->heartbeat_batcher();
+}
+
 const scoped_refptr<ClockBase>& TransactionManager::clock() const {
   return impl_->clock();
 }
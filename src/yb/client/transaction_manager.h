@@ -26,6 +26,7 @@
 
 #include "yb/rpc/rpc_fwd.h"
 
+#include "yb/util/enums.h"
 #include "yb/util/result.h"
 
 namespace yb {
@@ -33,6 +34,11 @@ namespace client {
 
 typedef std::function<void(const Result<std::string>&)> PickStatusTabletCallback;
 
+// Local - all tablets touched by the transaction so far have leaders in the region of the client,
+//         so a status tablet with local leader could be used.
+// Global - transaction touches tablets with leaders in other regions.
+YB_DEFINE_ENUM(TransactionLocality, (kLocal)(kGlobal));
+
 // TransactionManager manages multiple transactions. It lives at the YQL engine layer.
 class TransactionManager {
  public:
@@ -43,11 +49,16 @@ class TransactionManager {
   TransactionManager(TransactionManager&& rhs);
   TransactionManager& operator=(TransactionManager&& rhs);
 
-  void PickStatusTablet(PickStatusTabletCallback callback);
+  // Picks status tablet for a new transaction. When FLAGS_use_local_transaction_status_tablets is
+  // set, local transactions prefer status tablets with leaders in the zone or region of the client.
+  void PickStatusTablet(TransactionLocality locality, PickStatusTabletCallback callback);
 
   rpc::Rpcs& rpcs();
   YBClient* client() const;
 
+  // Batcher for registrations and heartbeats of transactions managed by this manager.
+  TransactionHeartbeatBatcher& heartbeat_batcher();
+
   const scoped_refptr<ClockBase>& clock() const;
   HybridTime Now() const;
   HybridTimeRange NowRange() const;
@@ -33,6 +33,7 @@ class HybridTime;
 
 #define TRANSACTION_RPCS \
     (UpdateTransaction) \
+    (UpdateTransactions) \
     (GetTransactionStatus) \
     (GetTransactionStatusAtParticipant) \
     (AbortTransaction)
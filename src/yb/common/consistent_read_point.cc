@@ -79,6 +79,19 @@ void ConsistentReadPoint::Defer() {
   read_time_.read = read_time_.global_limit;
 }
 
+void ConsistentReadPoint::Backdate() {
+  if (!read_time_ || read_time_.global_limit <= read_time_.read) {
+    return;
+  }
+  auto read_micros = read_time_.read.GetPhysicalValueMicros();
+  auto uncertainty = std::min<MicrosTime>(
+      read_time_.global_limit.GetPhysicalValueMicros() - read_micros, read_micros);
+  read_time_ = ReadHybridTime::FromMicros(read_micros - uncertainty);
+  restart_read_ht_ = read_time_.read;
+  local_limits_.clear();
+  restarts_.clear();
+}
+
 void ConsistentReadPoint::UpdateClock(HybridTime propagated_hybrid_time) {
   clock_->Update(propagated_hybrid_time);
 }
@@ -57,6 +57,11 @@ class ConsistentReadPoint {
   // Defer read hybrid time to global limit.
   void Defer();
 
+  // Move read hybrid time to the past by the size of the uncertainty window, and close the window.
+  // Reads at such time never require restart, but could miss writes committed during the last
+  // max clock skew interval before the read point was picked. Idempotent.
+  void Backdate();
+
   // Update the clock used by this consistent read point with the propagated time.
   void UpdateClock(HybridTime propagated_hybrid_time);
 
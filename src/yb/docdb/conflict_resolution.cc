@@ -610,11 +610,14 @@ class ConflictResolverContextBase : public ConflictResolverContext {
   }
 
  protected:
+  // If blockers is not null, it is filled with all conflicting transactions with higher priority,
+  // otherwise conflict status is returned as soon as first such transaction is found.
   CHECKED_STATUS CheckPriorityInternal(
       ConflictResolver* resolver,
       std::vector<TransactionData>* transactions,
       const TransactionId& our_transaction_id,
-      uint64_t our_priority) {
+      uint64_t our_priority,
+      std::vector<TransactionId>* blockers = nullptr) {
 
     if (!fetched_metadata_for_transactions_) {
       boost::container::small_vector<std::pair<TransactionId, uint64_t>, 8> ids_and_priorities;
@@ -627,14 +630,21 @@ class ConflictResolverContextBase : public ConflictResolverContext {
         (*transactions)[i].priority = ids_and_priorities[i].second;
       }
     }
+    fetched_metadata_for_transactions_ = true;
     for (const auto& transaction : *transactions) {
       auto their_priority = transaction.priority;
       if (our_priority < their_priority) {
-        return MakeConflictStatus(
-            our_transaction_id, transaction.id, "higher priority", GetConflictsMetric());
+        if (!blockers) {
+          return MakeConflictStatus(
+              our_transaction_id, transaction.id, "higher priority", GetConflictsMetric());
+        }
+        blockers->push_back(transaction.id);
       }
     }
-    fetched_metadata_for_transactions_ = true;
+    if (blockers && !blockers->empty()) {
+      return MakeConflictStatus(
+          our_transaction_id, blockers->front(), "higher priority", GetConflictsMetric());
+    }
 
     return Status::OK();
   }
@@ -657,11 +667,13 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
                                      const KeyValueWriteBatchPB& write_batch,
                                      HybridTime resolution_ht,
                                      HybridTime read_time,
-                                     Counter* conflicts_metric)
+                                     Counter* conflicts_metric,
+                                     std::vector<TransactionId>* blockers)
       : ConflictResolverContextBase(doc_ops, resolution_ht, conflicts_metric),
         write_batch_(write_batch),
         read_time_(read_time),
-        transaction_id_(FullyDecodeTransactionId(write_batch.transaction().transaction_id()))
+        transaction_id_(FullyDecodeTransactionId(write_batch.transaction().transaction_id())),
+        blockers_(blockers)
   {}
 
   virtual ~TransactionConflictResolverContext() {}
@@ -750,8 +762,11 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
 
   CHECKED_STATUS CheckPriority(ConflictResolver* resolver,
                                std::vector<TransactionData>* transactions) override {
+    if (blockers_) {
+      blockers_->clear();
+    }
     return CheckPriorityInternal(resolver, transactions, metadata_.transaction_id,
-                                 metadata_.priority);
+                                 metadata_.priority, blockers_);
   }
 
   Result<bool> CheckConflictWithCommitted(
@@ -798,6 +813,9 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
 
   TransactionMetadata metadata_;
 
+  // Higher priority transactions that we conflict with, filled if not null.
+  std::vector<TransactionId>* blockers_;
+
   Status result_ = Status::OK();
 };
 
@@ -883,10 +901,11 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
                                  Counter* conflicts_metric,
+                                 std::vector<TransactionId>* blockers,
                                  ResolutionCallback callback) {
   DCHECK(hybrid_time.is_valid());
   auto context = std::make_unique<TransactionConflictResolverContext>(
-      doc_ops, write_batch, hybrid_time, read_time, conflicts_metric);
+      doc_ops, write_batch, hybrid_time, read_time, conflicts_metric, blockers);
   auto resolver = std::make_shared<ConflictResolver>(
       doc_db, status_manager, partial_range_key_intents, std::move(context), std::move(callback));
   // Resolve takes a self reference to extend lifetime.
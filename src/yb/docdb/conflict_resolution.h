@@ -16,6 +16,8 @@
 
 #include <boost/function.hpp>
 
+#include "yb/common/transaction.h"
+
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/doc_operation.h"
 #include "yb/docdb/value_type.h"
@@ -50,6 +52,9 @@ using ResolutionCallback = boost::function<void(const Result<HybridTime>&)>;
 // db - db that contains tablet data.
 // status_manager - status manager that should be used during this conflict resolution.
 // conflicts_metric - transaction_conflicts metric to update.
+// blockers - if not null and resolution fails because of conflicts with higher priority
+//            transactions, filled with ids of those transactions, so the caller could wait for
+//            them to finish and retry.
 void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  const KeyValueWriteBatchPB& write_batch,
                                  HybridTime resolution_ht,
@@ -58,6 +63,7 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
                                  Counter* conflicts_metric,
+                                 std::vector<TransactionId>* blockers,
                                  ResolutionCallback callback);
 
 // Resolves conflicts for doc operations.
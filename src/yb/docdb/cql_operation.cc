@@ -55,6 +55,13 @@ DEFINE_bool(ycql_disable_index_updating_optimization, false,
             "the index data.");
 TAG_FLAG(ycql_disable_index_updating_optimization, advanced);
 
+DEFINE_bool(ycql_enable_blind_write_fast_path, true,
+            "Apply INSERT and UPDATE statements that only assign constant values to regular "
+            "columns without evaluating expressions or building the existing and new row, when "
+            "the statement needs no read and there are no secondary indexes to update.");
+TAG_FLAG(ycql_enable_blind_write_fast_path, runtime);
+TAG_FLAG(ycql_enable_blind_write_fast_path, advanced);
+
 DECLARE_bool(trace_docdb_calls);
 
 namespace yb {
@@ -260,6 +267,7 @@ Status QLWriteOperation::Init(QLWriteRequestPB* request, QLResponsePB* response)
                               unique_index_key_schema_ != nullptr;
   require_read_ = RequireRead(request_, *schema_) || insert_into_unique_index_;
   update_indexes_ = !request_.update_index_ids().empty();
+  blind_write_ = FLAGS_ycql_enable_blind_write_fast_path && IsBlindWrite();
 
   // Determine if static / non-static columns are being written.
   bool write_static_columns = false;
@@ -292,6 +300,37 @@ Status QLWriteOperation::Init(QLWriteRequestPB* request, QLResponsePB* response)
       schema_->num_range_key_columns() == 0);
 }
 
+bool QLWriteOperation::IsBlindWrite() const {
+  if (request_.type() != QLWriteRequestPB::QL_STMT_INSERT &&
+      request_.type() != QLWriteRequestPB::QL_STMT_UPDATE) {
+    return false;
+  }
+  if (require_read_ || update_indexes_ || request_.returns_status()) {
+    return false;
+  }
+  // Value with user timestamp cannot be written blindly, see DocWriteBatch::SetPrimitiveBlind.
+  if (request_.has_user_timestamp_usec()) {
+    return false;
+  }
+  for (const auto& column_value : request_.column_values()) {
+    if (!column_value.has_column_id() || !column_value.json_args().empty() ||
+        !column_value.subscript_args().empty() || !column_value.expr().has_value()) {
+      return false;
+    }
+    // Collections are written as subdocuments, that could require extra entries and reads.
+    switch (column_value.expr().value().value_case()) {
+      case QLValuePB::kMapValue: FALLTHROUGH_INTENDED;
+      case QLValuePB::kSetValue: FALLTHROUGH_INTENDED;
+      case QLValuePB::kListValue: FALLTHROUGH_INTENDED;
+      case QLValuePB::kVirtualValue:
+        return false;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
 Status QLWriteOperation::InitializeKeys(const bool hashed_key, const bool primary_key) {
   // Populate the hashed and range components in the same order as they are in the table schema.
   const auto& hashed_column_values = request_.hashed_column_values();
@@ -801,7 +840,38 @@ Status QLWriteOperation::ApplyForRegularColumns(const QLColumnValuePB& column_va
   return Status::OK();
 }
 
+Status QLWriteOperation::ApplyBlindWrite(const DocOperationApplyData& data) {
+  const MonoDelta ttl =
+      request_.has_ttl() ? MonoDelta::FromMilliseconds(request_.ttl()) : Value::kMaxTtl;
+
+  if (request_.type() == QLWriteRequestPB::QL_STMT_INSERT && encoded_pk_doc_key_) {
+    const DocPath sub_path(encoded_pk_doc_key_.as_slice(),
+                           PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn));
+    RETURN_NOT_OK(data.doc_write_batch->SetPrimitiveBlind(sub_path, Value(PrimitiveValue(), ttl)));
+  }
+
+  for (const auto& column_value : request_.column_values()) {
+    const ColumnId column_id(column_value.column_id());
+    const auto& column = VERIFY_RESULT_REF(schema_->column_by_id(column_id));
+    const DocPath sub_path(
+        column.is_static() ?
+            encoded_hashed_doc_key_.as_slice() : encoded_pk_doc_key_.as_slice(),
+        PrimitiveValue(column_id));
+    RETURN_NOT_OK(data.doc_write_batch->SetPrimitiveBlind(
+        sub_path,
+        Value(PrimitiveValue::FromQLValuePB(column_value.expr().value(), column.sorting_type()),
+              ttl)));
+  }
+
+  response_->set_status(QLResponsePB::YQL_STATUS_OK);
+  return Status::OK();
+}
+
 Status QLWriteOperation::Apply(const DocOperationApplyData& data) {
+  if (blind_write_) {
+    return ApplyBlindWrite(data);
+  }
+
   QLTableRow existing_row;
   if (request_.has_if_expr()) {
     // Check if the if-condition is satisfied.
@@ -103,6 +103,14 @@ class QLWriteOperation :
   // Initialize hashed_doc_key_ and/or pk_doc_key_.
   CHECKED_STATUS InitializeKeys(bool hashed_key, bool primary_key);
 
+  // Whether this is an upsert that only assigns constant primitive values to columns, so its
+  // result does not depend on the existing row.
+  bool IsBlindWrite() const;
+
+  // Applies upsert without evaluating expressions against the existing row and building the new
+  // row, used when IsBlindWrite() is true.
+  CHECKED_STATUS ApplyBlindWrite(const DocOperationApplyData& data);
+
   CHECKED_STATUS ReadColumns(const DocOperationApplyData& data,
                              Schema *static_projection,
                              Schema *non_static_projection,
@@ -168,6 +176,9 @@ class QLWriteOperation :
   // Any indexes that may need update?
   bool update_indexes_ = false;
 
+  // Could this write operation be applied without reading or evaluating anything?
+  bool blind_write_ = false;
+
   // Is this an insert into a unique index?
   bool insert_into_unique_index_ = false;
 
@@ -17,6 +17,18 @@
 
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/value.h"
+
+#include "yb/gutil/endian.h"
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(enable_sst_file_expiration_tracking, false,
+            "Store expiration and merge record flag of entries in boundary values of new SST "
+            "files, so delete_expired_sst_files could delete whole expired files. Versions "
+            "released before these values were added cannot open a DB that has such files, so "
+            "enable it only after all servers are upgraded. Changing it requires restart.");
+TAG_FLAG(enable_sst_file_expiration_tracking, advanced);
 
 namespace yb {
 namespace docdb {
@@ -30,8 +42,12 @@ Status GetPrimitiveValue(const rocksdb::UserBoundaryValues& values,
 namespace {
 
 constexpr rocksdb::UserBoundaryTag kDocHybridTimeTag = 1;
+constexpr rocksdb::UserBoundaryTag kExpirationTag = 2;
+constexpr rocksdb::UserBoundaryTag kMergeRecordTag = 3;
 // Here we reserve some tags for future use.
 // Because Tag is persistent.
+// Unknown tags from this range are skipped during decoding, so values added by newer versions do
+// not prevent older versions from opening the DB.
 constexpr rocksdb::UserBoundaryTag kRangeComponentsStart = 10;
 
 // Wrapper for UserBoundaryValue that stores DocHybridTime.
@@ -80,6 +96,116 @@ class DocHybridTimeValue : public rocksdb::UserBoundaryValue {
   Slice encoded_;
 };
 
+// Wrapper for UserBoundaryValue that stores hybrid time when entry expires.
+// HybridTime::kMin means that entry expires according to the table default TTL, HybridTime::kMax
+// means that entry never expires, or its expiration could not be determined from the entry alone.
+class ExpirationValue : public rocksdb::UserBoundaryValue {
+ public:
+  explicit ExpirationValue(HybridTime expiration) {
+    BigEndian::Store64(buffer_, expiration.ToUint64());
+  }
+
+  static CHECKED_STATUS Create(Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+    if (data.size() != sizeof(buffer_)) {
+      return STATUS_FORMAT(Corruption, "Wrong size of encoded expiration: $0", data.size());
+    }
+
+    *value = std::make_shared<ExpirationValue>(HybridTime(BigEndian::Load64(data.data())));
+    return Status::OK();
+  }
+
+  virtual ~ExpirationValue() {}
+
+  rocksdb::UserBoundaryTag Tag() override {
+    return kExpirationTag;
+  }
+
+  Slice Encode() override {
+    return Slice(buffer_, sizeof(buffer_));
+  }
+
+  int CompareTo(const UserBoundaryValue& pre_rhs) override {
+    const auto* rhs = down_cast<const ExpirationValue*>(&pre_rhs);
+    return Slice(buffer_, sizeof(buffer_)).compare(Slice(rhs->buffer_, sizeof(rhs->buffer_)));
+  }
+
+  HybridTime value() const {
+    return HybridTime(BigEndian::Load64(buffer_));
+  }
+
+ private:
+  char buffer_[sizeof(uint64_t)];
+};
+
+// Wrapper for UserBoundaryValue that stores whether entry is a merge record, so the largest value
+// of a file tells whether the file contains merge records.
+class MergeRecordValue : public rocksdb::UserBoundaryValue {
+ public:
+  explicit MergeRecordValue(bool is_merge_record) : encoded_(is_merge_record ? 1 : 0) {}
+
+  static CHECKED_STATUS Create(Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+    if (data.size() != 1) {
+      return STATUS_FORMAT(Corruption, "Wrong size of encoded merge record flag: $0", data.size());
+    }
+
+    *value = std::make_shared<MergeRecordValue>(data[0] != 0);
+    return Status::OK();
+  }
+
+  virtual ~MergeRecordValue() {}
+
+  rocksdb::UserBoundaryTag Tag() override {
+    return kMergeRecordTag;
+  }
+
+  Slice Encode() override {
+    return Slice(&encoded_, 1);
+  }
+
+  int CompareTo(const UserBoundaryValue& pre_rhs) override {
+    const auto* rhs = down_cast<const MergeRecordValue*>(&pre_rhs);
+    return static_cast<int>(encoded_) - static_cast<int>(rhs->encoded_);
+  }
+
+  bool value() const {
+    return encoded_ != 0;
+  }
+
+ private:
+  uint8_t encoded_;
+};
+
+// Returns expiration of the entry, as stored by ExpirationValue.
+Result<HybridTime> EntryExpiration(Slice encoded_doc_ht, Slice value) {
+  // TTL merge record changes expiration of entries written before it. Entries of the intents DB
+  // are never expired.
+  if (IsMergeRecord(value) || DecodeValueType(value) == ValueType::kTransactionId) {
+    return HybridTime::kMax;
+  }
+  Value decoded_value;
+  RETURN_NOT_OK(decoded_value.DecodeControlFields(&value));
+  if (!decoded_value.has_ttl()) {
+    return HybridTime::kMin;
+  }
+  // TTL of collection is inherited by its elements that don't have own TTL, and they could be
+  // written later, i.e. to other files.
+  if (IsCollectionType(DecodeValueType(value)) || decoded_value.ttl().ToNanoseconds() <= 0) {
+    return HybridTime::kMax;
+  }
+  DocHybridTime doc_ht;
+  RETURN_NOT_OK(doc_ht.FullyDecodeFrom(encoded_doc_ht));
+  // Round TTL up, so expiration is never earlier than the one used by the compaction filter.
+  const MicrosTime ttl_micros = (decoded_value.ttl().ToNanoseconds() + 999) / 1000;
+  const auto write_ht = doc_ht.hybrid_time();
+  if (ttl_micros >= (HybridTime::kMax.ToUint64() - write_ht.ToUint64()) >>
+                        HybridTime::kBitsForLogicalComponent) {
+    return HybridTime::kMax;
+  }
+  return write_ht.AddMicroseconds(ttl_micros);
+}
+
 // Wrapper for UserBoundaryValue that stores PrimitiveValue with index.
 class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
  public:
@@ -147,9 +273,20 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     if (tag == kDocHybridTimeTag) {
       return DocHybridTimeValue::Create(data, value);
     }
+    if (tag == kExpirationTag) {
+      return ExpirationValue::Create(data, value);
+    }
+    if (tag == kMergeRecordTag) {
+      return MergeRecordValue::Create(data, value);
+    }
     if (tag >= kRangeComponentsStart) {
       return PrimitiveBoundaryValue::Create(tag - kRangeComponentsStart, data, value);
     }
+    if (tag > kDocHybridTimeTag) {
+      // Reserved tag written by a newer version.
+      value->reset();
+      return Status::OK();
+    }
 
     return STATUS_SUBSTITUTE(NotFound, "Unknown tag: $0", tag);
   }
@@ -182,6 +319,12 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     RETURN_NOT_OK(DocHybridTimeValue::Create(slices.back(), &temp));
     values->push_back(std::move(temp));
 
+    if (FLAGS_enable_sst_file_expiration_tracking) {
+      values->push_back(std::make_shared<ExpirationValue>(
+          VERIFY_RESULT(EntryExpiration(slices.back(), value))));
+      values->push_back(std::make_shared<MergeRecordValue>(IsMergeRecord(value)));
+    }
+
     for (size_t i = 0; i != size; ++i) {
       RETURN_NOT_OK(PrimitiveBoundaryValue::Create(i, slices[i], &temp));
       values->push_back(std::move(temp));
@@ -257,6 +400,22 @@ Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime
   return time_value->value(out);
 }
 
+Result<HybridTime> GetExpiration(const rocksdb::UserBoundaryValues& values) {
+  auto value = rocksdb::UserValueWithTag(values, kExpirationTag);
+  if (!value) {
+    return STATUS(NotFound, "Not found value for expiration");
+  }
+  return down_cast<ExpirationValue*>(value.get())->value();
+}
+
+Result<bool> GetHasMergeRecords(const rocksdb::UserBoundaryValues& values) {
+  auto value = rocksdb::UserValueWithTag(values, kMergeRecordTag);
+  if (!value) {
+    return STATUS(NotFound, "Not found value for merge record flag");
+  }
+  return down_cast<MergeRecordValue*>(value.get())->value();
+}
+
 rocksdb::UserBoundaryTag TagForRangeComponent(size_t index) {
   return PrimitiveBoundaryValue::TagForIndex(index);
 }
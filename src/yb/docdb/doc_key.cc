@@ -1048,6 +1048,27 @@ class DocKeyComponentsExtractor : public rocksdb::FilterPolicy::KeyTransformer {
 
 } // namespace
 
+DocDbAwareFilterPolicyBase::DocDbAwareFilterPolicyBase(
+    size_t filter_block_size_bits, rocksdb::Logger* logger, DocDbFilterFormat format)
+    : format_(format) {
+  const auto error_rate = rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate;
+  switch (format) {
+    case DocDbFilterFormat::kBloom:
+      builtin_policy_.reset(rocksdb::NewFixedSizeFilterPolicy(
+          filter_block_size_bits, error_rate, logger));
+      return;
+    case DocDbFilterFormat::kBlockedBloom:
+      builtin_policy_.reset(rocksdb::NewFixedSizeBlockedBloomFilterPolicy(
+          filter_block_size_bits, error_rate, logger));
+      return;
+    case DocDbFilterFormat::kRibbon:
+      builtin_policy_.reset(rocksdb::NewFixedSizeRibbonFilterPolicy(
+          filter_block_size_bits, error_rate, logger));
+      return;
+  }
+  FATAL_INVALID_ENUM_VALUE(DocDbFilterFormat, format);
+}
+
 void DocDbAwareFilterPolicyBase::CreateFilter(
     const rocksdb::Slice* keys, int n, std::string* dst) const {
   CHECK_GT(n, 0);
@@ -1084,6 +1105,18 @@ DocDbAwareV2FilterPolicy::GetKeyTransformer() const {
   return &DocKeyComponentsExtractor<DocKeyPart::kUpToHash>::GetInstance();
 }
 
+const char* DocDbAwareV3FilterPolicy::Name() const {
+  switch (format()) {
+    case DocDbFilterFormat::kBloom:
+      return "DocKeyV3Filter";
+    case DocDbFilterFormat::kBlockedBloom:
+      return "DocKeyV3BlockedBloomFilter";
+    case DocDbFilterFormat::kRibbon:
+      return "DocKeyV3RibbonFilter";
+  }
+  FATAL_INVALID_ENUM_VALUE(DocDbFilterFormat, format());
+}
+
 const rocksdb::FilterPolicy::KeyTransformer*
 DocDbAwareV3FilterPolicy::GetKeyTransformer() const {
   return &DocKeyComponentsExtractor<DocKeyPart::kUpToHashOrFirstRange>::GetInstance();
@@ -829,12 +829,14 @@ inline std::ostream& operator <<(std::ostream& out, const SubDocKey& subdoc_key)
 std::string BestEffortDocDBKeyToStr(const KeyBytes &key_bytes);
 std::string BestEffortDocDBKeyToStr(const rocksdb::Slice &slice);
 
+// Format of fixed-size filter blocks built by DocDB aware filter policies.
+YB_DEFINE_ENUM(DocDbFilterFormat, (kBloom)(kBlockedBloom)(kRibbon));
+
 class DocDbAwareFilterPolicyBase : public rocksdb::FilterPolicy {
  public:
-  explicit DocDbAwareFilterPolicyBase(size_t filter_block_size_bits, rocksdb::Logger* logger) {
-    builtin_policy_.reset(rocksdb::NewFixedSizeFilterPolicy(
-        filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger));
-  }
+  DocDbAwareFilterPolicyBase(
+      size_t filter_block_size_bits, rocksdb::Logger* logger,
+      DocDbFilterFormat format = DocDbFilterFormat::kBloom);
 
   void CreateFilter(const rocksdb::Slice* keys, int n, std::string* dst) const override;
 
@@ -846,7 +848,11 @@ class DocDbAwareFilterPolicyBase : public rocksdb::FilterPolicy {
 
   FilterType GetFilterType() const override;
 
+ protected:
+  DocDbFilterFormat format() const { return format_; }
+
  private:
+  const DocDbFilterFormat format_;
   std::unique_ptr<const rocksdb::FilterPolicy> builtin_policy_;
 };
 
@@ -880,12 +886,16 @@ class DocDbAwareV2FilterPolicy : public DocDbAwareFilterPolicyBase {
 // use all hash components of the doc key.
 // - For hash-based partitioned tables (such tables have >0 hashed components):
 // use first range component of the doc key.
+// Each filter format has its own name, so SST files store format of their filter blocks and could
+// be read after format is changed.
 class DocDbAwareV3FilterPolicy : public DocDbAwareFilterPolicyBase {
  public:
-  DocDbAwareV3FilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger)
-      : DocDbAwareFilterPolicyBase(filter_block_size_bits, logger) {}
+  DocDbAwareV3FilterPolicy(
+      size_t filter_block_size_bits, rocksdb::Logger* logger,
+      DocDbFilterFormat format = DocDbFilterFormat::kBloom)
+      : DocDbAwareFilterPolicyBase(filter_block_size_bits, logger, format) {}
 
-  const char* Name() const override { return "DocKeyV3Filter"; }
+  const char* Name() const override;
 
   const KeyTransformer* GetKeyTransformer() const override;
 };
@@ -37,8 +37,10 @@
 
 #include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/tostring.h"
 
+DECLARE_bool(ycql_enable_blind_write_fast_path);
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
@@ -179,6 +181,26 @@ SubDocKey(DocKey(0x0000, [1], []), [ColumnId(3); HT{ <max> w: 2 }]) -> 4
     }
   }
 
+  // Applies each request to an empty DB with the blind write fast path off and on, and checks
+  // that both produce the same records.
+  void AssertBlindWritesMatchGeneralPath(
+      const Schema& schema, const std::vector<QLWriteRequestPB>& requests) {
+    for (const auto& request : requests) {
+      std::string dumps[2];
+      for (bool fast_path : {false, true}) {
+        FLAGS_ycql_enable_blind_write_fast_path = fast_path;
+        ASSERT_OK(DestroyRocksDB());
+        ASSERT_OK(ReopenRocksDB());
+        auto write_request = request;
+        QLResponsePB response;
+        ASSERT_NO_FATALS(WriteQL(&write_request, schema, &response));
+        ASSERT_EQ(QLResponsePB::YQL_STATUS_OK, response.status());
+        dumps[fast_path] = DocDBDebugDumpToStr();
+      }
+      ASSERT_EQ(dumps[false], dumps[true]) << request.ShortDebugString();
+    }
+  }
+
   yb::QLWriteRequestPB WriteQLRowReq(QLWriteRequestPB_QLStmtType stmt_type, const Schema& schema,
                   const vector<int32_t>& column_values, const HybridTime& hybrid_time,
                   const TransactionOperationContextOpt& txn_op_content =
@@ -310,6 +332,96 @@ TEST_F(DocOperationTest, TestQLUpdateWithoutTTL) {
   RunTestQLInsertUpdate(QLWriteRequestPB_QLStmtType_QL_STMT_UPDATE);
 }
 
+// Blind write fast path should write the same records as the general write path.
+TEST_F(DocOperationTest, QLBlindWriteMatchesGeneralPath) {
+  Schema schema = CreateSchema();
+  std::vector<QLWriteRequestPB> requests;
+  for (auto stmt_type : {QLWriteRequestPB::QL_STMT_INSERT, QLWriteRequestPB::QL_STMT_UPDATE}) {
+    auto request = WriteQLRowReq(stmt_type, schema, {1, 2, 3, 4}, HybridTime::kMax);
+    requests.push_back(request);
+    // Null value.
+    request.mutable_column_values(1)->mutable_expr()->mutable_value()->Clear();
+    requests.push_back(request);
+    request.set_ttl(2000);
+    requests.push_back(request);
+    // USING TIMESTAMP.
+    request.set_user_timestamp_usec(1000);
+    requests.push_back(request);
+  }
+
+  ASSERT_NO_FATALS(AssertBlindWritesMatchGeneralPath(schema, requests));
+}
+
+// Static columns are written under the hashed key by both paths.
+TEST_F(DocOperationTest, QLBlindWriteStaticColumn) {
+  SchemaBuilder builder;
+  builder.set_next_column_id(ColumnId(0));
+  ASSERT_OK(builder.AddHashKeyColumn("k", INT32));
+  ASSERT_OK(builder.AddKeyColumn("r", INT32));
+  ASSERT_OK(builder.AddColumn(ColumnSchema("s", INT32, false, false, true), false));
+  ASSERT_OK(builder.AddColumn(ColumnSchema("v", INT32), false));
+  Schema schema = builder.Build();
+
+  std::vector<QLWriteRequestPB> requests;
+  for (auto stmt_type : {QLWriteRequestPB::QL_STMT_INSERT, QLWriteRequestPB::QL_STMT_UPDATE}) {
+    // Static and regular column together.
+    auto request = WriteQLRowReq(stmt_type, schema, {1, 2, 3, 4}, HybridTime::kMax);
+    requests.push_back(request);
+    request.set_ttl(2000);
+    requests.push_back(request);
+
+    // Static column only, addressed by the hash key.
+    QLWriteRequestPB static_request;
+    static_request.set_type(stmt_type);
+    static_request.set_hash_code(0);
+    AddPrimaryKeyColumn(&static_request, 1);
+    auto column = static_request.add_column_values();
+    column->set_column_id(2);
+    column->mutable_expr()->mutable_value()->set_int32_value(3);
+    requests.push_back(static_request);
+  }
+
+  ASSERT_NO_FATALS(AssertBlindWritesMatchGeneralPath(schema, requests));
+}
+
+// Compares CPU time spent applying plain inserts with and without the blind write fast path.
+TEST_F(DocOperationTest, QLBlindWritePerf) {
+  constexpr int kNumWrites = RegularBuildVsSanitizers(100000, 10000);
+  Schema schema = CreateSchema();
+  std::vector<QLWriteRequestPB> requests;
+  requests.reserve(kNumWrites);
+  for (int i = 0; i != kNumWrites; ++i) {
+    requests.push_back(WriteQLRowReq(
+        QLWriteRequestPB::QL_STMT_INSERT, schema, {i, i + 1, i + 2, i + 3}, HybridTime::kMax));
+  }
+
+  for (bool fast_path : {false, true}) {
+    FLAGS_ycql_enable_blind_write_fast_path = fast_path;
+    auto write_requests = requests;
+    Stopwatch stopwatch;
+    stopwatch.start();
+    for (auto& request : write_requests) {
+      QLResponsePB response;
+      QLWriteOperation ql_write_op(
+          std::shared_ptr<const Schema>(&schema, [](const Schema*){}), IndexMap(),
+          nullptr /* unique_index_key_schema */, kNonTransactionalOperationContext);
+      ASSERT_OK(ql_write_op.Init(&request, &response));
+      auto doc_write_batch = MakeDocWriteBatch();
+      HybridTime restart_read_ht;
+      ASSERT_OK(ql_write_op.Apply(
+          {&doc_write_batch, CoarseTimePoint::max() /* deadline */, ReadHybridTime(),
+           &restart_read_ht}));
+      ASSERT_EQ(4, doc_write_batch.size());
+    }
+    stopwatch.stop();
+    auto times = stopwatch.elapsed();
+    LOG(INFO) << "Blind write fast path " << (fast_path ? "enabled" : "disabled")
+              << ", CPU time per write: "
+              << (times.user_cpu_seconds() + times.system_cpu_seconds()) * 1e6 / kNumWrites
+              << "us";
+  }
+}
+
 TEST_F(DocOperationTest, TestQLWriteNulls) {
   yb::QLWriteRequestPB ql_writereq_pb;
   yb::QLResponsePB ql_writeresp_pb;
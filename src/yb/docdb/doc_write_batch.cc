@@ -349,8 +349,9 @@ Status DocWriteBatch::SetPrimitive(const DocPath& doc_path,
   DOCDB_DEBUG_LOG("Called with doc_path=$0, value=$1",
                   doc_path.ToString(), value.ToString());
 
+  // The iterator is created only during this call, so doc_path does not have to be copied.
   std::function<std::unique_ptr<IntentAwareIterator>()> createrator =
-    [doc_path, query_id, deadline, read_ht, this]() {
+    [&doc_path, query_id, deadline, read_ht, this]() {
       return yb::docdb::CreateIntentAwareIterator(
           doc_db_,
           BloomFilterMode::USE_BLOOM_FILTER,
@@ -366,6 +367,15 @@ Status DocWriteBatch::SetPrimitive(const DocPath& doc_path,
   return SetPrimitive(doc_path, value, &iter);
 }
 
+Status DocWriteBatch::SetPrimitiveBlind(const DocPath& doc_path, const Value& value) {
+  if (!optional_init_markers() || value.has_user_timestamp()) {
+    return STATUS_FORMAT(IllegalState, "Write to $0 requires read", doc_path);
+  }
+  std::function<std::unique_ptr<IntentAwareIterator>()>* no_iterator_creator = nullptr;
+  LazyIterator iter(no_iterator_creator);
+  return SetPrimitive(doc_path, value, &iter);
+}
+
 Status DocWriteBatch::ExtendSubDocument(
     const DocPath& doc_path,
     const SubDocument& value,
@@ -97,6 +97,10 @@ class DocWriteBatch {
       const CoarseTimePoint deadline = CoarseTimePoint::max(),
       rocksdb::QueryId query_id = rocksdb::kDefaultQueryId);
 
+  // Set the primitive at the given path without reading the existing document. Only valid when
+  // init markers are optional and the value has no user timestamp, i.e. nothing has to be read.
+  CHECKED_STATUS SetPrimitiveBlind(const DocPath& doc_path, const Value& value);
+
   CHECKED_STATUS SetPrimitive(
       const DocPath& doc_path,
       const Value& value,
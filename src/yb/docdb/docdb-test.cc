@@ -13,7 +13,9 @@
 
 #include "yb/docdb/docdb.h"
 
+#include <algorithm>
 #include <memory>
+#include <set>
 #include <string>
 
 #include "yb/common/doc_hybrid_time.h"
@@ -52,6 +54,7 @@
 #include "yb/util/string_trim.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
 #include "yb/util/strongly_typed_bool.h"
 #include "yb/util/yb_partition.h"
 
@@ -74,6 +77,10 @@ using namespace std::chrono_literals;
 DECLARE_bool(use_docdb_aware_bloom_filter);
 DECLARE_int32(max_nexts_to_avoid_seek);
 DECLARE_bool(TEST_docdb_sort_weak_intents_in_tests);
+DECLARE_bool(rocksdb_use_doc_key_hash_index_memtable);
+DECLARE_string(db_filter_format);
+DECLARE_bool(docdb_compaction_filter_fast_path);
+DECLARE_bool(enable_sst_file_expiration_tracking);
 
 #define ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(str) ASSERT_NO_FATALS(AssertDocDbDebugDumpStrEq(str))
 
@@ -84,6 +91,8 @@ CHECKED_STATUS GetPrimitiveValue(const rocksdb::UserBoundaryValues &values,
     size_t index,
     PrimitiveValue *out);
 CHECKED_STATUS GetDocHybridTime(const rocksdb::UserBoundaryValues &values, DocHybridTime *out);
+Result<HybridTime> GetExpiration(const rocksdb::UserBoundaryValues& values);
+std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance();
 
 YB_STRONGLY_TYPED_BOOL(InitMarkerExpired);
 YB_STRONGLY_TYPED_BOOL(UseIntermediateFlushes);
@@ -2237,6 +2246,104 @@ SubDocKey(DocKey(PgTableId=16385, [], ["r1"]), [SystemColumnId(0); HT{ physical:
       )#");
 }
 
+TEST_P(DocDBTestWrapper, DeleteExpiredFiles) {
+  FLAGS_enable_sst_file_expiration_tracking = true;
+  SetHistoryCutoffHybridTime(4500_usec_ht);
+  // The oldest two files expire before the history cutoff, other files never expire.
+  for (int i = 1; i <= 5; ++i) {
+    const DocKey doc_key(PrimitiveValues(Format("k$0", i)));
+    const auto ttl = i <= 2 ? MonoDelta::FromMilliseconds(1) : Value::kMaxTtl;
+    ASSERT_OK(SetPrimitive(
+        DocPath(doc_key.Encode()), Value(PrimitiveValue(Format("v$0", i)), ttl),
+        HybridTime::FromMicros(i * 1000)));
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+  ASSERT_OK(down_cast<rocksdb::DBImpl*>(rocksdb())->TEST_WaitForCompact());
+
+  // Expired files are deleted without being rewritten, and other files are not compacted.
+  ASSERT_EQ(3, NumSSTableFiles());
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+SubDocKey(DocKey([], ["k3"]), [HT{ physical: 3000 }]) -> "v3"
+SubDocKey(DocKey([], ["k4"]), [HT{ physical: 4000 }]) -> "v4"
+SubDocKey(DocKey([], ["k5"]), [HT{ physical: 5000 }]) -> "v5"
+      )#");
+}
+
+// TTL merge record written by Redis EXPIRE extends expiration of an entry in an older file, so that
+// file should not be deleted even though all its own entries have expired.
+TEST_P(DocDBTestWrapper, DontDeleteFilesExtendedByMergeRecord) {
+  FLAGS_enable_sst_file_expiration_tracking = true;
+  SetHistoryCutoffHybridTime(4500_usec_ht);
+  const DocKey doc_key(PrimitiveValues("k1"));
+  // SET with TTL, expires at 3000.
+  ASSERT_OK(SetPrimitive(
+      DocPath(doc_key.Encode()), Value(PrimitiveValue("v1"), MonoDelta::FromMilliseconds(2)),
+      HybridTime::FromMicros(1000)));
+  ASSERT_OK(FlushRocksDbAndWait());
+  // EXPIRE extends expiration to 12000.
+  ASSERT_OK(SetPrimitive(
+      DocPath(doc_key.Encode()),
+      Value(PrimitiveValue(ValueType::kString), MonoDelta::FromMilliseconds(10),
+            Value::kInvalidUserTimestamp, Value::kTtlFlag),
+      HybridTime::FromMicros(2000)));
+  ASSERT_OK(FlushRocksDbAndWait());
+  // Files that never expire, so number of files reaches compaction trigger.
+  for (int i = 3; i <= 5; ++i) {
+    const DocKey other_doc_key(PrimitiveValues(Format("k$0", i)));
+    ASSERT_OK(SetPrimitive(
+        DocPath(other_doc_key.Encode()), Value(PrimitiveValue(Format("v$0", i))),
+        HybridTime::FromMicros(i * 1000)));
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+  ASSERT_OK(down_cast<rocksdb::DBImpl*>(rocksdb())->TEST_WaitForCompact());
+
+  ASSERT_STR_CONTAINS(
+      DocDBDebugDumpToStr(), R"#(SubDocKey(DocKey([], ["k1"]), [HT{ physical: 1000 }]) -> "v1")#");
+}
+
+// Compacts collection-heavy documents, most of whose entries were overwritten by later inserts of
+// the whole document, with and without the compaction filter fast path.
+TEST_P(DocDBTestWrapper, CompactionFilterFastPathPerf) {
+  constexpr int kNumDocs = RegularBuildVsSanitizers(1000, 100);
+  constexpr int kNumEntries = 100;
+  constexpr int kNumOverwrites = 5;
+
+  std::string dumps[2];
+  for (bool fast_path : {false, true}) {
+    FLAGS_docdb_compaction_filter_fast_path = fast_path;
+    ASSERT_OK(DestroyRocksDB());
+    ASSERT_OK(ReopenRocksDB());
+
+    HybridTime ht = 1000_usec_ht;
+    for (int overwrite = 0; overwrite != kNumOverwrites; ++overwrite) {
+      for (int doc = 0; doc != kNumDocs; ++doc) {
+        const DocKey doc_key(PrimitiveValues(Format("doc$0", doc)));
+        SubDocument collection;
+        for (int entry = 0; entry != kNumEntries; ++entry) {
+          collection.SetChildPrimitive(
+              PrimitiveValue(Format("k$0", entry)), PrimitiveValue(Format("v$0", overwrite)));
+        }
+        ASSERT_OK(InsertSubDocument(DocPath(doc_key.Encode()), collection, ht));
+        ht = server::HybridClock::AddPhysicalTimeToHybridTime(ht, 1ms);
+      }
+      ASSERT_OK(FlushRocksDbAndWait());
+    }
+
+    auto start = MonoTime::Now();
+    FullyCompactHistoryBefore(ht);
+    auto passed = MonoTime::Now() - start;
+    LOG(INFO) << "Compaction filter fast path " << (fast_path ? "enabled" : "disabled")
+              << ", compaction time: " << passed;
+
+    dumps[fast_path] = DocDBDebugDumpToStr();
+  }
+
+  // Only the last insert of every document is left, and both paths produce the same result.
+  ASSERT_EQ(kNumDocs * (kNumEntries + 1),
+            std::count(dumps[true].begin(), dumps[true].end(), '\n'));
+  ASSERT_EQ(dumps[false], dumps[true]);
+}
+
 TEST_P(DocDBTestWrapper, MinorCompactionNoDeletions) {
   ASSERT_OK(DisableCompactions());
   const DocKey doc_key(PrimitiveValues("k"));
@@ -2746,6 +2853,31 @@ TEST_F_EX(DocDBTest, BoundaryValuesMultiFiles, DocDBTestBoundaryValues) {
   TestBoundaryValues(350);
 }
 
+// Expiration values are stored only when enabled, because older versions fail to decode them.
+// Values with tags reserved for future use are skipped by decoding.
+TEST_P(DocDBTestWrapper, ExpirationBoundaryValuesCompatibility) {
+  auto extractor = DocBoundaryValuesExtractorInstance();
+  const auto key = SubDocKey(DocKey(PrimitiveValues("k")), 1000_usec_ht).Encode();
+  const auto value = Value(PrimitiveValue("v"), MonoDelta::FromMilliseconds(1)).Encode();
+
+  rocksdb::UserBoundaryValues values;
+  ASSERT_OK(extractor->Extract(key.AsSlice(), value, &values));
+  DocHybridTime doc_ht;
+  ASSERT_OK(GetDocHybridTime(values, &doc_ht));
+  ASSERT_NOK(GetExpiration(values));
+
+  FLAGS_enable_sst_file_expiration_tracking = true;
+  values.clear();
+  ASSERT_OK(extractor->Extract(key.AsSlice(), value, &values));
+  ASSERT_EQ(2000_usec_ht, ASSERT_RESULT(GetExpiration(values)));
+
+  for (rocksdb::UserBoundaryTag tag = 4; tag != 10; ++tag) {
+    rocksdb::UserBoundaryValuePtr decoded;
+    ASSERT_OK(extractor->Decode(tag, Slice("future value"), &decoded));
+    ASSERT_EQ(nullptr, decoded) << "Tag: " << tag;
+  }
+}
+
 TEST_P(DocDBTestWrapper, BloomFilterTest) {
   // Turn off "next instead of seek" optimization, because this test rely on DocDB to do seeks.
   FLAGS_max_nexts_to_avoid_seek = 0;
@@ -2911,6 +3043,50 @@ TEST_P(DocDBTestWrapper, BloomFilterCorrectness) {
   }
 }
 
+TEST_P(DocDBTestWrapper, FilterFormatChange) {
+  constexpr int kNumKeysPerFormat = 1000;
+  const std::vector<std::string> kFormats = {"bloom", "ribbon", "blocked_bloom"};
+
+  const auto get_sub_doc_key = [](int i) {
+    return SubDocKey(DocKey(PrimitiveValues(i)), PrimitiveValue(ColumnId(11)));
+  };
+
+  // Each SST file is written with a different filter format, but all of them should be readable
+  // with any format used for new files.
+  int num_keys = 0;
+  for (const auto& format : kFormats) {
+    FLAGS_db_filter_format = format;
+    ASSERT_OK(ReinitDBOptions());
+    ASSERT_OK(DisableCompactions());
+    for (int i = 0; i != kNumKeysPerFormat; ++i, ++num_keys) {
+      const auto sub_doc_key = get_sub_doc_key(num_keys);
+      ASSERT_OK(SetPrimitive(
+          DocPath(sub_doc_key.doc_key().Encode(), sub_doc_key.subkeys()),
+          PrimitiveValue::Int32(num_keys), 1000_usec_ht));
+    }
+    ASSERT_OK(FlushRocksDbAndWait());
+
+    for (int i = 0; i != num_keys; ++i) {
+      SubDocument sub_doc;
+      bool sub_doc_found;
+      GetSubDoc(get_sub_doc_key(i).EncodeWithoutHt(), &sub_doc, &sub_doc_found);
+      ASSERT_TRUE(sub_doc_found) << "Key #" << i << " not found, format: " << format;
+      ASSERT_EQ(static_cast<PrimitiveValue>(sub_doc), PrimitiveValue::Int32(i));
+    }
+  }
+
+  if (FLAGS_use_docdb_aware_bloom_filter) {
+    rocksdb::TablePropertiesCollection props;
+    ASSERT_OK(rocksdb()->GetPropertiesOfAllTables(&props));
+    std::set<std::string> filter_policies;
+    for (const auto& prop : props) {
+      filter_policies.insert(prop.second->filter_policy_name);
+    }
+    ASSERT_EQ(filter_policies, std::set<std::string>(
+        {"DocKeyV3Filter", "DocKeyV3RibbonFilter", "DocKeyV3BlockedBloomFilter"}));
+  }
+}
+
 TEST_P(DocDBTestWrapper, MergingIterator) {
   // Test for the case described in https://yugabyte.atlassian.net/browse/ENG-1677.
 
@@ -3635,6 +3811,122 @@ TEST_P(DocDBTestWrapper, ForceFlushedFrontier) {
   ASSERT_EQ(*new_user_frontier_ptr, *regular_db_->GetFlushedFrontier());
 }
 
+TEST_P(DocDBTestWrapper, DocKeyHashIndexMemTable) {
+  constexpr int kNumDocKeys = 100;
+  constexpr int kSubKeysPerDocKey = 40;
+
+  FLAGS_rocksdb_use_doc_key_hash_index_memtable = true;
+  ASSERT_OK(ReinitDBOptions());
+  ASSERT_OK(DisableCompactions());
+
+  // Write subkeys of each DocKey in different batches, so entries with the same DocKey are
+  // inserted out of order.
+  std::map<std::string, std::string> expected;
+  for (int sub_key = kSubKeysPerDocKey; sub_key-- > 0;) {
+    rocksdb::WriteBatch batch;
+    for (int doc_key = 0; doc_key != kNumDocKeys; ++doc_key) {
+      const auto key = SubDocKey(
+          DocKey(PrimitiveValues(doc_key)), PrimitiveValue(sub_key),
+          HybridTime::FromMicros(1000)).Encode().ToStringBuffer();
+      const auto value = Value(PrimitiveValue(sub_key)).Encode();
+      batch.Put(key, value);
+      expected.emplace(key, value);
+    }
+    // Key that is not in DocKey format is not indexed, but still should be found.
+    batch.Put(Format("not_a_doc_key_$0", sub_key), "value");
+    expected.emplace(Format("not_a_doc_key_$0", sub_key), "value");
+    ASSERT_OK(regular_db_->Write(write_options(), &batch));
+  }
+
+  for (const auto& entry : expected) {
+    std::string value;
+    ASSERT_OK(regular_db_->Get(rocksdb::ReadOptions(), entry.first, &value));
+    ASSERT_EQ(entry.second, value);
+  }
+
+  std::unique_ptr<rocksdb::Iterator> iter(regular_db_->NewIterator(rocksdb::ReadOptions()));
+  for (int doc_key = 0; doc_key != kNumDocKeys + 1; ++doc_key) {
+    // Seek to DocKey itself, to its subkey and past all its subkeys.
+    const auto encoded_doc_key = DocKey(PrimitiveValues(doc_key)).Encode().ToStringBuffer();
+    for (const auto& target : {
+        encoded_doc_key,
+        SubDocKey(DocKey(PrimitiveValues(doc_key)), PrimitiveValue(kSubKeysPerDocKey / 2))
+            .EncodeWithoutHt().ToStringBuffer(),
+        encoded_doc_key + static_cast<char>(ValueType::kMaxByte)}) {
+      iter->Seek(target);
+      auto it = expected.lower_bound(target);
+      ASSERT_EQ(it != expected.end(), iter->Valid()) << Slice(target).ToDebugHexString();
+      if (it != expected.end()) {
+        ASSERT_EQ(it->first, iter->key().ToBuffer()) << Slice(target).ToDebugHexString();
+      }
+    }
+  }
+  ASSERT_OK(iter->status());
+
+  size_t num_records = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ++num_records;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(expected.size(), num_records);
+}
+
+// Compares memtable inserts, point reads and seeks to DocKey, with and without DocKey hash index
+// in memtable. Results are logged, correctness is checked by DocKeyHashIndexMemTable.
+TEST_P(DocDBTestWrapper, DocKeyHashIndexMemTablePerf) {
+  constexpr int kNumDocKeys = RegularBuildVsSanitizers(20000, 2000);
+  constexpr int kSubKeysPerDocKey = 10;
+
+  std::vector<std::string> keys;
+  keys.reserve(kNumDocKeys * kSubKeysPerDocKey);
+  for (int doc_key = 0; doc_key != kNumDocKeys; ++doc_key) {
+    for (int sub_key = 0; sub_key != kSubKeysPerDocKey; ++sub_key) {
+      keys.push_back(SubDocKey(
+          DocKey(PrimitiveValues(Format("doc_key_$0", doc_key), doc_key)),
+          PrimitiveValue(sub_key), HybridTime::FromMicros(1000)).Encode().ToStringBuffer());
+    }
+  }
+  std::shuffle(keys.begin(), keys.end(), ThreadLocalRandom());
+  const auto value = Value(PrimitiveValue(1)).Encode();
+
+  for (bool use_index : {false, true}) {
+    FLAGS_rocksdb_use_doc_key_hash_index_memtable = use_index;
+    ASSERT_OK(DestroyRocksDB());
+    ASSERT_OK(ReinitDBOptions());
+    ASSERT_OK(ReopenRocksDB());
+    ASSERT_OK(DisableCompactions());
+
+    auto start = MonoTime::Now();
+    for (const auto& key : keys) {
+      rocksdb::WriteBatch batch;
+      batch.Put(key, value);
+      ASSERT_OK(regular_db_->Write(write_options(), &batch));
+    }
+    const auto insert_time = MonoTime::Now() - start;
+
+    start = MonoTime::Now();
+    std::string read_value;
+    for (const auto& key : keys) {
+      ASSERT_OK(regular_db_->Get(rocksdb::ReadOptions(), key, &read_value));
+    }
+    const auto get_time = MonoTime::Now() - start;
+
+    std::unique_ptr<rocksdb::Iterator> iter(regular_db_->NewIterator(rocksdb::ReadOptions()));
+    start = MonoTime::Now();
+    for (int doc_key = 0; doc_key != kNumDocKeys; ++doc_key) {
+      iter->Seek(DocKey(PrimitiveValues(Format("doc_key_$0", doc_key), doc_key)).Encode()
+                     .AsSlice());
+      ASSERT_TRUE(iter->Valid());
+    }
+    const auto seek_time = MonoTime::Now() - start;
+    ASSERT_OK(iter->status());
+
+    LOG(INFO) << "DocKey hash index: " << use_index << ", entries: " << keys.size()
+              << ", insert: " << insert_time << ", get: " << get_time
+              << ", seek to " << kNumDocKeys << " DocKeys: " << seek_time;
+  }
+}
+
 // Handy code to analyze some DB.
 TEST_P(DocDBTestWrapper, DISABLED_DumpDB) {
   tablet::TabletOptions tablet_options;
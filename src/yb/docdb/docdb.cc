@@ -83,10 +83,6 @@ DEFINE_bool(enable_transaction_sealing, false,
             "Whether transaction sealing is enabled.");
 DEFINE_test_flag(bool, fail_on_replicated_batch_idx_set_in_txn_record, false,
                  "Fail when a set of replicated batch indexes is found in txn record.");
-DEFINE_int32(txn_max_apply_batch_records, 100000,
-             "Max number of apply records allowed in single RocksDB batch. "
-             "When a transaction's data in one tablet does not fit into specified number of "
-             "records, it will be applied using multiple RocksDB write batches.");
 
 namespace yb {
 namespace docdb {
@@ -1089,6 +1085,7 @@ Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     HybridTime commit_ht,
     const KeyBounds* key_bounds,
     const ApplyTransactionState* apply_state,
+    uint64_t max_records,
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db,
     rocksdb::WriteBatch* intents_batch) {
@@ -1141,7 +1138,6 @@ Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     }
   }
 
-  const uint64_t max_records = FLAGS_txn_max_apply_batch_records;
   const uint64_t write_id_limit = write_id + max_records;
   while (reverse_index_iter.Valid()) {
     const Slice key_slice(reverse_index_iter.key());
@@ -240,11 +240,15 @@ struct ApplyTransactionState {
   }
 };
 
+// Fills exactly one of regular_batch or intents_batch with at most max_records records for
+// applying or removing intents of the specified transaction, starting from apply_state if
+// specified. Returns active apply state if there are more intents left.
 Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     const TransactionId& transaction_id,
     HybridTime commit_ht,
     const KeyBounds* key_bounds,
     const ApplyTransactionState* apply_state,
+    uint64_t max_records,
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db,
     rocksdb::WriteBatch* intents_batch);
@@ -18,6 +18,8 @@
 #include <glog/logging.h>
 
 #include "yb/rocksdb/compaction_filter.h"
+#include "yb/rocksdb/db/version_edit.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/string_util.h"
 
 #include "yb/docdb/doc_key.h"
@@ -34,9 +36,35 @@ using rocksdb::CompactionFilter;
 using rocksdb::VectorToString;
 using rocksdb::FilterDecision;
 
+DEFINE_bool(delete_expired_sst_files, true,
+            "Delete SST files, all entries of which have expired at the history cutoff, without "
+            "rewriting them. Only files written with enable_sst_file_expiration_tracking are "
+            "deleted.");
+TAG_FLAG(delete_expired_sst_files, runtime);
+TAG_FLAG(delete_expired_sst_files, advanced);
+
+DEFINE_int32(compaction_windows_per_table_ttl, 0,
+             "For tables with default TTL, compactions do not merge SST files written in different "
+             "time windows of table TTL / this value length, so whole files expire together. "
+             "0 to disable, which is the default: windows only help when expired files are "
+             "deleted, which requires enable_sst_file_expiration_tracking, and they increase the "
+             "number of SST files.");
+TAG_FLAG(compaction_windows_per_table_ttl, runtime);
+TAG_FLAG(compaction_windows_per_table_ttl, advanced);
+
+DEFINE_bool(docdb_compaction_filter_fast_path, true,
+            "Discard entries overwritten by an init marker or tombstone of their table, document "
+            "or parent subdocument without decoding their subkeys during compaction.");
+TAG_FLAG(docdb_compaction_filter_fast_path, runtime);
+TAG_FLAG(docdb_compaction_filter_fast_path, advanced);
+
 namespace yb {
 namespace docdb {
 
+Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime* out);
+Result<HybridTime> GetExpiration(const rocksdb::UserBoundaryValues& values);
+Result<bool> GetHasMergeRecords(const rocksdb::UserBoundaryValues& values);
+
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilter::DocDBCompactionFilter(
@@ -107,6 +135,23 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
     --num_shared_components;
   }
 
+  DocHybridTime ht;
+  RETURN_NOT_OK(ht.DecodeFromEnd(key));
+  // TODO: When more merge records are supported, isTtlRow should be redefined appropriately.
+  bool isTtlRow = IsMergeRecord(existing_value);
+
+  // Fast path for entries overwritten by one of the shared components, i.e. by an init marker or
+  // tombstone of the table, document or parent subdocument. It makes the same decision as the
+  // check below, but does not decode the rest of the key. State is left intact, so the next key
+  // is compared with the last kept key, and its shared components are calculated the same way
+  // as they would be after the regular path.
+  if (FLAGS_docdb_compaction_filter_fast_path && !isTtlRow) {
+    const size_t num_shared_overwrites = min(overwrite_.size(), num_shared_components);
+    if (num_shared_overwrites != 0 && ht < overwrite_[num_shared_overwrites - 1].doc_ht) {
+      return FilterDecision::kDiscard;
+    }
+  }
+
   sub_key_ends_.resize(num_shared_components);
 
   RETURN_NOT_OK(SubDocKey::DecodeDocKeyAndSubKeyEnds(key, &sub_key_ends_));
@@ -115,8 +160,6 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
   // Remove overwrite hybrid_times for components that are no longer relevant for the current
   // SubDocKey.
   overwrite_.resize(min(overwrite_.size(), num_shared_components));
-  DocHybridTime ht;
-  RETURN_NOT_OK(ht.DecodeFromEnd(key));
   // We're comparing the hybrid time in this key with the stack top of overwrite_ht_ after
   // truncating the stack to the number of components in the common prefix of previous and current
   // key.
@@ -156,9 +199,6 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
   // than prev_overwrite_ht, we'll end up adding more prev_overwrite_ht values to the overwrite
   // hybrid_time stack, and we might as well do that while handling the next key/value pair that
   // does not get cleaned up the same way as this one.
-  //
-  // TODO: When more merge records are supported, isTtlRow should be redefined appropriately.
-  bool isTtlRow = IsMergeRecord(existing_value);
   if (ht < prev_overwrite_ht && !isTtlRow) {
     return FilterDecision::kDiscard;
   }
@@ -345,9 +385,136 @@ Slice DocDBCompactionFilter::DropKeysGreaterOrEqual() const {
 
 // ------------------------------------------------------------------------------------------------
 
+namespace {
+
+// Decides which SST files of regular DB could be deleted without being rewritten, using expiration
+// of their entries tracked by DocBoundaryValuesExtractor.
+class DocDBCompactionFileFilter : public rocksdb::CompactionFileFilter {
+ public:
+  explicit DocDBCompactionFileFilter(HistoryRetentionDirective retention)
+      : retention_(std::move(retention)) {
+    const auto windows = FLAGS_compaction_windows_per_table_ttl;
+    if (windows > 0 && !retention_.table_ttl.Equals(Value::kMaxTtl)) {
+      window_micros_ = std::max<MicrosTime>(retention_.table_ttl.ToMicroseconds() / windows, 1);
+    }
+  }
+
+  size_t NumExpiredFiles(const std::vector<rocksdb::FileMetaData*>& files) override {
+    if (!FLAGS_delete_expired_sst_files || !retention_.history_cutoff.is_valid() ||
+        retention_.retain_delete_markers_in_major_compaction) {
+      return 0;
+    }
+
+    // TTL merge record extends expiration of the entry it was written for, which could be in an
+    // older file. So no file is deleted while any file could contain merge records.
+    for (const auto* file : files) {
+      if (FileMayHaveMergeRecords(*file)) {
+        return 0;
+      }
+    }
+
+    // Deleted files should not contain entries written after entries of remaining files. Otherwise
+    // deleting expired entry could expose an older entry that it overwrote.
+    std::vector<DocHybridTime> min_write_times(files.size());
+    for (size_t i = 0; i != files.size(); ++i) {
+      auto min_write_time = WriteTime(files[i]->smallest);
+      if (!min_write_time.is_valid()) {
+        min_write_time = DocHybridTime::kMin;
+      }
+      min_write_times[i] =
+          i == 0 ? min_write_time : std::min(min_write_times[i - 1], min_write_time);
+    }
+
+    size_t result = 0;
+    DocHybridTime max_deleted_write_time = DocHybridTime::kMin;
+    for (size_t i = files.size(); i-- > 0;) {
+      const auto& file = *files[i];
+      const auto max_write_time = WriteTime(file.largest);
+      if (!max_write_time.is_valid() || !Expired(file, max_write_time)) {
+        break;
+      }
+      max_deleted_write_time = std::max(max_deleted_write_time, max_write_time);
+      if (i == 0 || max_deleted_write_time < min_write_times[i - 1]) {
+        result = files.size() - i;
+      }
+    }
+    return result;
+  }
+
+  rocksdb::UserFrontierPtr GetLargestUserFrontier() const override {
+    // Deleted entries are not visible at hybrid times before history cutoff anymore.
+    auto* consensus_frontier = new ConsensusFrontier();
+    consensus_frontier->set_history_cutoff(retention_.history_cutoff);
+    return rocksdb::UserFrontierPtr(consensus_frontier);
+  }
+
+  bool IsCompactionBoundary(
+      const rocksdb::FileMetaData& newer, const rocksdb::FileMetaData& older) override {
+    if (window_micros_ == 0) {
+      return false;
+    }
+    const auto newer_write_time = WriteTime(newer.largest);
+    const auto older_write_time = WriteTime(older.largest);
+    if (!newer_write_time.is_valid() || !older_write_time.is_valid()) {
+      return false;
+    }
+    return Window(newer_write_time) != Window(older_write_time);
+  }
+
+ private:
+  template <class Boundary>
+  static DocHybridTime WriteTime(const Boundary& boundary) {
+    DocHybridTime result;
+    if (!GetDocHybridTime(boundary.user_values, &result).ok()) {
+      return DocHybridTime::kInvalid;
+    }
+    return result;
+  }
+
+  // Files written before merge record tracking do not have merge record flag.
+  static bool FileMayHaveMergeRecords(const rocksdb::FileMetaData& file) {
+    auto has_merge_records = GetHasMergeRecords(file.largest.user_values);
+    return !has_merge_records.ok() || *has_merge_records;
+  }
+
+  // Returns true if all entries of the file have expired at history cutoff.
+  bool Expired(const rocksdb::FileMetaData& file, const DocHybridTime& max_write_time) const {
+    // Files written before expiration tracking do not have expiration values.
+    auto max_expiration = GetExpiration(file.largest.user_values);
+    auto min_expiration = GetExpiration(file.smallest.user_values);
+    if (!max_expiration.ok() || !min_expiration.ok() ||
+        *max_expiration >= retention_.history_cutoff) {
+      return false;
+    }
+    if (*min_expiration != HybridTime::kMin) {
+      return true;
+    }
+    // There are entries that expire according to the table default TTL.
+    if (retention_.table_ttl.Equals(Value::kMaxTtl)) {
+      return false;
+    }
+    bool has_expired = false;
+    return HasExpiredTTL(max_write_time.hybrid_time(), retention_.table_ttl,
+                         retention_.history_cutoff, &has_expired).ok() && has_expired;
+  }
+
+  MicrosTime Window(const DocHybridTime& write_time) const {
+    return write_time.hybrid_time().GetPhysicalValueMicros() / window_micros_;
+  }
+
+  const HistoryRetentionDirective retention_;
+  MicrosTime window_micros_ = 0;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+
 DocDBCompactionFilterFactory::DocDBCompactionFilterFactory(
-    std::shared_ptr<HistoryRetentionPolicy> retention_policy, const KeyBounds* key_bounds)
-    : retention_policy_(std::move(retention_policy)), key_bounds_(key_bounds) {
+    std::shared_ptr<HistoryRetentionPolicy> retention_policy, const KeyBounds* key_bounds,
+    MayHaveMergeRecords may_have_merge_records)
+    : retention_policy_(std::move(retention_policy)), key_bounds_(key_bounds),
+      may_have_merge_records_(may_have_merge_records) {
 }
 
 DocDBCompactionFilterFactory::~DocDBCompactionFilterFactory() {
@@ -361,6 +528,15 @@ unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilte
       key_bounds_);
 }
 
+std::unique_ptr<rocksdb::CompactionFileFilter>
+    DocDBCompactionFilterFactory::CreateCompactionFileFilter() {
+  // Merge records that are not flushed yet are not visible to the file filter.
+  if (may_have_merge_records_) {
+    return nullptr;
+  }
+  return std::make_unique<DocDBCompactionFileFilter>(retention_policy_->GetRetentionDirective());
+}
+
 const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
@@ -37,6 +37,7 @@ namespace docdb {
 
 YB_STRONGLY_TYPED_BOOL(IsMajorCompaction);
 YB_STRONGLY_TYPED_BOOL(ShouldRetainDeleteMarkersInMajorCompaction);
+YB_STRONGLY_TYPED_BOOL(MayHaveMergeRecords);
 
 struct Expiration;
 
@@ -163,16 +164,21 @@ class HistoryRetentionPolicy {
 
 class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
  public:
-  explicit DocDBCompactionFilterFactory(
-      std::shared_ptr<HistoryRetentionPolicy> retention_policy, const KeyBounds* key_bounds);
+  // may_have_merge_records should be set for tables that write TTL merge records, i.e. Redis
+  // tables. SST files of such tables are never deleted without being rewritten.
+  DocDBCompactionFilterFactory(
+      std::shared_ptr<HistoryRetentionPolicy> retention_policy, const KeyBounds* key_bounds,
+      MayHaveMergeRecords may_have_merge_records = MayHaveMergeRecords::kFalse);
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
+  std::unique_ptr<rocksdb::CompactionFileFilter> CreateCompactionFileFilter() override;
   const char* Name() const override;
 
  private:
   std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
   const KeyBounds* key_bounds_;
+  const MayHaveMergeRecords may_have_merge_records_;
 };
 
 // A history retention policy that can be configured manually. Useful in tests. This class is
@@ -18,6 +18,7 @@
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
+#include "yb/gutil/macros.h"
 #include "yb/rocksdb/compaction_filter.h"
 #include "yb/util/string_util.h"
 
@@ -28,6 +29,7 @@
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rpc/rpc.h"
 #include "yb/rpc/thread_pool.h"
+#include "yb/tablet/finished_transactions.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/util/flag_tags.h"
 
@@ -52,8 +54,8 @@ namespace {
 
 class DocDBIntentsCompactionFilter : public rocksdb::CompactionFilter {
  public:
-  explicit DocDBIntentsCompactionFilter(tablet::Tablet* tablet, const KeyBounds* key_bounds)
-      : tablet_(tablet), compaction_start_time_(tablet->clock()->Now().GetPhysicalValueMicros()) {}
+  DocDBIntentsCompactionFilter(
+      tablet::Tablet* tablet, const KeyBounds* key_bounds, bool is_full_compaction);
 
   ~DocDBIntentsCompactionFilter() override;
 
@@ -70,9 +72,21 @@ class DocDBIntentsCompactionFilter : public rocksdb::CompactionFilter {
   void AddToSet(const TransactionId& transaction_id);
 
  private:
+  // Returns true if key belongs to transaction, whose intents should be dropped.
+  bool IsFinishedTransactionRecord(KeyType key_type, const Slice& key, const Slice& value) const;
+
   tablet::Tablet* const tablet_;
   const MicrosTime compaction_start_time_;
 
+  // Finished transactions, whose intents are dropped by this compaction.
+  tablet::FinishedTransactions* finished_transactions_ = nullptr;
+  tablet::FinishedTransactions::MapPtr finished_snapshot_;
+  // Set only for full compaction, see FinishedTransactions::FullCompactionDone.
+  HybridTime flushed_time_;
+  // Intents of applied transactions are dropped only when the apply is flushed to regular DB.
+  OpId regular_flushed_op_id_ = OpId::Invalid();
+  size_t num_dropped_records_ = 0;
+
   TransactionIdSet transactions_to_cleanup_;
   int rejected_transactions_ = 0;
 
@@ -82,8 +96,42 @@ class DocDBIntentsCompactionFilter : public rocksdb::CompactionFilter {
 };
 
 
+DocDBIntentsCompactionFilter::DocDBIntentsCompactionFilter(
+    tablet::Tablet* tablet, const KeyBounds* key_bounds, bool is_full_compaction)
+    : tablet_(tablet), compaction_start_time_(tablet->clock()->Now().GetPhysicalValueMicros()) {
+  auto* participant = tablet->transaction_participant();
+  if (!participant) {
+    return;
+  }
+  // Flushed op id of regular DB only grows, so it is safe to use value obtained at start for the
+  // whole compaction.
+  auto op_ids = tablet->MaxPersistentOpId();
+  if (!op_ids.ok()) {
+    return;
+  }
+  regular_flushed_op_id_ = op_ids->regular;
+  finished_transactions_ = &participant->finished_transactions();
+  if (is_full_compaction) {
+    // Flushed time should be obtained before snapshot, so any transaction from snapshot removed
+    // after flushed time would be kept.
+    auto flushed_time = tablet->IntentsDbMaxPersistentHybridTime();
+    if (flushed_time.ok()) {
+      flushed_time_ = *flushed_time;
+    }
+  }
+  finished_snapshot_ = finished_transactions_->Snapshot();
+}
+
 DocDBIntentsCompactionFilter::~DocDBIntentsCompactionFilter() {
   VLOG(3) << "DocDB intents compaction filter is being deleted";
+  if (num_dropped_records_) {
+    VLOG(2) << "Dropped " << num_dropped_records_ << " records of "
+            << finished_snapshot_->size() << " finished transactions";
+  }
+  if (finished_snapshot_ && flushed_time_.is_valid() && !finished_snapshot_->empty()) {
+    finished_transactions_->FullCompactionDone(
+        *finished_snapshot_, flushed_time_, regular_flushed_op_id_);
+  }
   if (transactions_to_cleanup_.empty()) {
     return;
   }
@@ -103,8 +151,15 @@ rocksdb::FilterDecision DocDBIntentsCompactionFilter::Filter(
     filter_usage_logged_ = true;
   }
 
+  auto key_type = GetKeyType(key, StorageDbType::kIntents);
+  if (finished_snapshot_ && !finished_snapshot_->empty() &&
+      IsFinishedTransactionRecord(key_type, key, existing_value)) {
+    ++num_dropped_records_;
+    return rocksdb::FilterDecision::kDiscard;
+  }
+
   // Find transaction metadata row.
-  if (GetKeyType(key, StorageDbType::kIntents) == KeyType::kTransactionMetadata) {
+  if (key_type == KeyType::kTransactionMetadata) {
     TransactionMetadataPB metadata_pb;
     if (!metadata_pb.ParseFromArray(existing_value.cdata(), existing_value.size())) {
       LOG(ERROR) << "Transaction metadata failed to parse.";
@@ -125,13 +180,42 @@ rocksdb::FilterDecision DocDBIntentsCompactionFilter::Filter(
     AddToSet(*result);
   }
 
-  // TODO(dtxn): If/when we add processing of reverse index or intents here - we will need to
-  // respect key_bounds passed to constructor in order to ignore/delete non-relevant keys. As of
-  // 2019/06/19, intents and reverse indexes are being deleted by docdb::PrepareApplyIntentsBatch.
+  // Records of finished transactions are dropped above regardless of key_bounds passed to
+  // constructor. It is safe, since records outside of key bounds are not relevant for this tablet,
+  // while tablet that owns them after split has its own set of finished transactions.
+  // Other intents and reverse indexes are being deleted by docdb::PrepareApplyIntentsBatch.
 
   return rocksdb::FilterDecision::kKeep;
 }
 
+bool DocDBIntentsCompactionFilter::IsFinishedTransactionRecord(
+    KeyType key_type, const Slice& key, const Slice& value) const {
+  Slice id_slice;
+  switch (key_type) {
+    case KeyType::kTransactionMetadata: FALLTHROUGH_INTENDED;
+    case KeyType::kReverseTxnKey:
+      // Transaction id follows value type in both metadata and reverse index keys.
+      id_slice = key;
+      id_slice.consume_byte();
+      break;
+    case KeyType::kIntentKey:
+      // Transaction id is stored in intent value.
+      id_slice = value;
+      if (!id_slice.TryConsumeByte(ValueTypeAsChar::kTransactionId)) {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+  auto id = DecodeTransactionId(&id_slice);
+  if (!id.ok()) {
+    return false;
+  }
+  auto it = finished_snapshot_->find(*id);
+  return it != finished_snapshot_->end() && it->second.CanDrop(regular_flushed_op_id_);
+}
+
 void DocDBIntentsCompactionFilter::AddToSet(const TransactionId& transaction_id) {
   if (transactions_to_cleanup_.size() <= FLAGS_aborted_intent_cleanup_max_batch_size) {
     transactions_to_cleanup_.insert(transaction_id);
@@ -156,7 +240,8 @@ DocDBIntentsCompactionFilterFactory::~DocDBIntentsCompactionFilterFactory() {}
 
 std::unique_ptr<CompactionFilter> DocDBIntentsCompactionFilterFactory::CreateCompactionFilter(
     const CompactionFilter::Context& context) {
-  return std::make_unique<DocDBIntentsCompactionFilter>(tablet_, key_bounds_);
+  return std::make_unique<DocDBIntentsCompactionFilter>(
+      tablet_, key_bounds_, context.is_full_compaction);
 }
 
 const char* DocDBIntentsCompactionFilterFactory::Name() const {
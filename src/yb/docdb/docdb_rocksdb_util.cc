@@ -13,6 +13,7 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 
+#include <atomic>
 #include <thread>
 #include <memory>
 
@@ -20,6 +21,7 @@
 
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/rate_limiter.h"
+#include "yb/rocksdb/slice_transform.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/db/db_impl.h"
 #include "yb/rocksdb/db/version_edit.h"
@@ -30,6 +32,7 @@
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
 #include "yb/docdb/consensus_frontier.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/rocksutil/yb_rocksdb.h"
@@ -68,6 +71,24 @@ DEFINE_int32(rocksdb_universal_compaction_min_merge_width, 4,
              "The minimum number of files in a single compaction run.");
 DEFINE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec, 256_MB,
              "Use to control write rate of flush and compaction.");
+DEFINE_int64(rocksdb_flush_rate_limit_bytes_per_sec, 0,
+             "Use to control write rate of flush separately from compaction. 0 - flushes share "
+             "rocksdb_compact_flush_rate_limit_bytes_per_sec with compactions.");
+DEFINE_string(rocksdb_compact_flush_rate_limit_sharing_mode, "none",
+              "How rate limits of flushes and compactions are shared across RocksDB instances. "
+              "none - every RocksDB instance has its own rate limiter, tserver - all RocksDB "
+              "instances of the process share the same rate limiter, so rate limit is the I/O "
+              "budget of the whole node. Shared rate limiters are created at tablet server "
+              "startup, so later changes of rate limit flags do not affect them.");
+TAG_FLAG(rocksdb_compact_flush_rate_limit_sharing_mode, advanced);
+DEFINE_bool(rocksdb_use_direct_io_for_compaction, false,
+            "Whether compactions should read and write SST files with direct I/O, so they do not "
+            "evict pages of other files from OS page cache.");
+DEFINE_bool(rocksdb_use_doc_key_hash_index_memtable, false,
+            "Whether memtable of the regular RocksDB maintains hash index from DocKey to its first "
+            "entry, used to speed up point reads and seeks to DocKey.");
+DEFINE_uint64(rocksdb_doc_key_hash_index_initial_bucket_count, 1024,
+              "Initial number of buckets in the DocKey hash index of memtable.");
 DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024,
              "Threshold beyond which compaction is considered large.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
@@ -87,6 +108,19 @@ DEFINE_int64(db_index_block_size_bytes, 32_KB,
 DEFINE_int64(db_min_keys_per_index_block, 100,
              "Minimum number of keys per index block.");
 
+DEFINE_bool(db_pin_top_level_index, false,
+            "Whether top-level index block of each SST file is kept in memory for the lifetime of "
+            "the table reader, instead of the block cache.");
+
+DEFINE_int64(db_initial_auto_readahead_size_bytes, 32_KB,
+             "Size of the first readahead (in bytes) issued by iterator that reads RocksDB data "
+             "blocks sequentially. Each following readahead doubles the size up to "
+             "db_max_auto_readahead_size_bytes.");
+
+DEFINE_int64(db_max_auto_readahead_size_bytes, 256_KB,
+             "Maximal size of readahead (in bytes) issued by iterator that reads RocksDB data "
+             "blocks sequentially. 0 to disable readahead.");
+
 DEFINE_int64(db_write_buffer_size, -1,
              "Size of RocksDB write buffer (in bytes). -1 to use default.");
 
@@ -95,6 +129,12 @@ DEFINE_int32(memstore_size_mb, 128,
 
 DEFINE_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
+DEFINE_string(db_filter_format, "bloom",
+              "Format of DocDB aware filter blocks in new SST files: bloom, blocked_bloom (all "
+              "bits of a key are located in a single cache line) or ribbon (uses less memory for "
+              "the same false positive rate, but is slower to build). SST files written using any "
+              "format remain readable after this flag is changed.");
+TAG_FLAG(db_filter_format, advanced);
 // Empirically 2 is a minimal value that provides best performance on sequential scan.
 DEFINE_int32(max_nexts_to_avoid_seek, 2,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
@@ -114,6 +154,46 @@ DEFINE_int32(priority_thread_pool_size, -1,
              "If -1 and max_background_compactions is specified - use max_background_compactions. "
              "If -1 and max_background_compactions is not specified - use sqrt(num_cpus).");
 
+namespace {
+
+bool FilterFormatFromString(const std::string& value, yb::docdb::DocDbFilterFormat* format) {
+  if (value == "bloom") {
+    *format = yb::docdb::DocDbFilterFormat::kBloom;
+  } else if (value == "blocked_bloom") {
+    *format = yb::docdb::DocDbFilterFormat::kBlockedBloom;
+  } else if (value == "ribbon") {
+    *format = yb::docdb::DocDbFilterFormat::kRibbon;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool ValidateFilterFormat(const char* flagname, const std::string& value) {
+  yb::docdb::DocDbFilterFormat format;
+  if (!FilterFormatFromString(value, &format)) {
+    LOG(ERROR) << "Unknown " << flagname << ": " << value
+               << ", expected one of: bloom, blocked_bloom, ribbon";
+    return false;
+  }
+  return true;
+}
+
+bool ValidateRateLimitSharingMode(const char* flagname, const std::string& value) {
+  if (value != "none" && value != "tserver") {
+    LOG(ERROR) << "Unknown " << flagname << ": " << value << ", expected one of: none, tserver";
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+__attribute__((unused))
+DEFINE_validator(db_filter_format, &ValidateFilterFormat);
+__attribute__((unused))
+DEFINE_validator(rocksdb_compact_flush_rate_limit_sharing_mode, &ValidateRateLimitSharingMode);
+
 using std::shared_ptr;
 using std::string;
 using std::unique_ptr;
@@ -267,6 +347,9 @@ namespace {
 
 std::mutex rocksdb_flags_mutex;
 
+// Set when the first RocksDB instance is initialized.
+std::atomic<PriorityThreadPool*> global_priority_thread_pool{nullptr};
+
 // Auto initialize some of the RocksDB flags that are defaulted to -1.
 void AutoInitRocksDBFlags(rocksdb::Options* options) {
   const int kNumCpus = base::NumCPUs();
@@ -386,8 +469,34 @@ void AddSupportedFilterPolicy(
   table_options->supported_filter_policies->emplace(filter_policy->Name(), filter_policy);
 }
 
+// Extracts encoded DocKey from the key, used as prefix for memtable hash index.
+// Keys that are not in DocKey format get empty prefix, so they are not indexed.
+class DocKeyPrefixExtractor : public rocksdb::SliceTransform {
+ public:
+  const char* Name() const override {
+    return "DocKeyPrefixExtractor";
+  }
+
+  Slice Transform(const Slice& key) const override {
+    auto size_result = DocKey::EncodedSize(key, DocKeyPart::kWholeDocKey);
+    return size_result.ok() ? Slice(key.data(), *size_result) : Slice();
+  }
+
+  bool InDomain(const Slice& key) const override {
+    return true;
+  }
+
+  bool InRange(const Slice& prefix) const override {
+    return false;
+  }
+};
+
 } // namespace
 
+PriorityThreadPool* GetGlobalPriorityThreadPool() {
+  return global_priority_thread_pool.load(std::memory_order_acquire);
+}
+
 void InitRocksDBOptions(
     rocksdb::Options* options, const string& log_prefix,
     const shared_ptr<rocksdb::Statistics>& statistics,
@@ -413,6 +522,8 @@ void InitRocksDBOptions(
       FLAGS_priority_thread_pool_size);
   options->priority_thread_pool_for_compactions_and_flushes =
       &priority_thread_pool_for_compactions_and_flushes;
+  global_priority_thread_pool.store(
+      &priority_thread_pool_for_compactions_and_flushes, std::memory_order_release);
 
   if (FLAGS_num_reserved_small_compaction_threads != -1) {
     options->num_reserved_small_compaction_threads = FLAGS_num_reserved_small_compaction_threads;
@@ -429,8 +540,10 @@ void InitRocksDBOptions(
   rocksdb::BlockBasedTableOptions table_options;
   if (tablet_options.block_cache) {
     table_options.block_cache = tablet_options.block_cache;
+    table_options.metadata_block_cache = tablet_options.metadata_block_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
+    table_options.pin_top_level_index = FLAGS_db_pin_top_level_index;
   } else {
     table_options.no_block_cache = true;
     table_options.cache_index_and_filter_blocks = false;
@@ -439,18 +552,30 @@ void InitRocksDBOptions(
   table_options.filter_block_size = FLAGS_db_filter_block_size_bytes;
   table_options.index_block_size = FLAGS_db_index_block_size_bytes;
   table_options.min_keys_per_index_block = FLAGS_db_min_keys_per_index_block;
+  table_options.initial_auto_readahead_size = FLAGS_db_initial_auto_readahead_size_bytes;
+  table_options.max_auto_readahead_size = FLAGS_db_max_auto_readahead_size_bytes;
 
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
     const auto filter_block_size_bits = table_options.filter_block_size * 8;
+    auto filter_format = DocDbFilterFormat::kBloom;
+    LOG_IF(DFATAL, !FilterFormatFromString(FLAGS_db_filter_format, &filter_format))
+        << "Unknown filter format: " << FLAGS_db_filter_format;
     table_options.filter_policy = std::make_unique<const DocDbAwareV3FilterPolicy>(
-        filter_block_size_bits, options->info_log.get());
+        filter_block_size_bits, options->info_log.get(), filter_format);
     table_options.supported_filter_policies =
         std::make_shared<rocksdb::BlockBasedTableOptions::FilterPoliciesMap>();
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareHashedComponentsFilterPolicy>(
             filter_block_size_bits, options->info_log.get()), &table_options);
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareV2FilterPolicy>(
             filter_block_size_bits, options->info_log.get()), &table_options);
+    // Files could be written using filter format that was used before the flag was changed.
+    for (auto format : kDocDbFilterFormatList) {
+      if (format != filter_format) {
+        AddSupportedFilterPolicy(std::make_shared<const DocDbAwareV3FilterPolicy>(
+            filter_block_size_bits, options->info_log.get(), format), &table_options);
+      }
+    }
   }
 
   if (FLAGS_use_multi_level_index) {
@@ -488,10 +613,19 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
-    if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
+    if (tablet_options.rate_limiter) {
+      options->rate_limiter = tablet_options.rate_limiter;
+    } else if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
       options->rate_limiter.reset(
           rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
     }
+    if (tablet_options.flush_rate_limiter) {
+      options->flush_rate_limiter = tablet_options.flush_rate_limiter;
+    } else if (FLAGS_rocksdb_flush_rate_limit_bytes_per_sec > 0) {
+      options->flush_rate_limiter.reset(
+          rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_flush_rate_limit_bytes_per_sec));
+    }
+    options->use_direct_io_for_compaction = FLAGS_rocksdb_use_direct_io_for_compaction;
   } else {
     options->level0_slowdown_writes_trigger = std::numeric_limits<int>::max();
     options->level0_stop_writes_trigger = std::numeric_limits<int>::max();
@@ -504,12 +638,38 @@ void InitRocksDBOptions(
 
   options->max_write_buffer_number = FLAGS_rocksdb_max_write_buffer_number;
 
-  options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
-      0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+  SetMemTableFactory(options, StorageDbType::kRegular);
 
   options->iterator_replacer = std::make_shared<rocksdb::IteratorReplacer>(&WrapIterator);
 }
 
+void InitSharedRateLimiters(tablet::TabletOptions* tablet_options) {
+  if (FLAGS_rocksdb_compact_flush_rate_limit_sharing_mode != "tserver") {
+    return;
+  }
+  if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
+    tablet_options->rate_limiter.reset(
+        rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
+  }
+  if (FLAGS_rocksdb_flush_rate_limit_bytes_per_sec > 0) {
+    tablet_options->flush_rate_limiter.reset(
+        rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_flush_rate_limit_bytes_per_sec));
+  }
+}
+
+void SetMemTableFactory(rocksdb::Options* options, StorageDbType db_type) {
+  // Tablet applies Raft operations to RocksDB one by one, so memtables are not configured for
+  // concurrent inserts.
+  if (db_type == StorageDbType::kRegular && FLAGS_rocksdb_use_doc_key_hash_index_memtable) {
+    options->memtable_factory.reset(rocksdb::NewPrefixHashIndexRepFactory(
+        std::make_shared<DocKeyPrefixExtractor>(),
+        FLAGS_rocksdb_doc_key_hash_index_initial_bucket_count));
+    return;
+  }
+  options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
+      0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+}
+
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix) {
   options->log_prefix = log_prefix;
   options->info_log = std::make_shared<YBRocksDBLogger>(options->log_prefix);
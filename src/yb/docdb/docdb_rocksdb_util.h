@@ -21,6 +21,7 @@
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/docdb_types.h"
 #include "yb/docdb/value.h"
 
 #include "yb/rocksdb/cache.h"
@@ -113,6 +114,19 @@ void InitRocksDBOptions(
     const std::shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options);
 
+// Creates rate limiters shared by all RocksDB instances that are initialized with these tablet
+// options, if rocksdb_compact_flush_rate_limit_sharing_mode is "tserver". Called once at tablet
+// server startup.
+void InitSharedRateLimiters(tablet::TabletOptions* tablet_options);
+
+// Returns priority thread pool used by compactions and flushes of all RocksDB instances of the
+// process, nullptr if no RocksDB instance was initialized yet.
+PriorityThreadPool* GetGlobalPriorityThreadPool();
+
+// Configures the memtable of the RocksDB of the specified type. Memtable of the regular RocksDB
+// could maintain DocKey hash index, see rocksdb_use_doc_key_hash_index_memtable.
+void SetMemTableFactory(rocksdb::Options* options, StorageDbType db_type);
+
 // Sets logs prefix for RocksDB options. This will also reinitialize options->info_log.
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix);
 
@@ -398,6 +398,7 @@ Status DocDBRocksDBUtil::ReinitDBOptions() {
   docdb::InitRocksDBOptions(
       &intents_db_options_, "[I] " /* log_prefix */, intents_db_options_.statistics,
       tablet_options);
+  docdb::SetMemTableFactory(&intents_db_options_, StorageDbType::kIntents);
   regular_db_options_.compaction_filter_factory =
       std::make_shared<docdb::DocDBCompactionFilterFactory>(
           retention_policy_, &KeyBounds::kNoBounds);
@@ -73,6 +73,12 @@ DEFINE_string(fs_wal_dirs, "",
                   "also and that's a reasonable default for most use cases.");
 TAG_FLAG(fs_wal_dirs, stable);
 
+DEFINE_string(fs_slow_data_dirs, "",
+              "Comma-separated list of directories on slower and cheaper storage. When specified, "
+              "SST files of new tablets containing only data older than "
+              "tablet_slow_tier_data_age_sec are placed to these directories.");
+TAG_FLAG(fs_slow_data_dirs, advanced);
+
 DEFINE_string(instance_uuid_override, "",
               "When creating local instance metadata (for master or tserver) in an empty data "
               "directory, use this UUID instead of randomly-generated one. Can be used to replace "
@@ -116,6 +122,7 @@ FsManagerOpts::FsManagerOpts()
   }
   wal_paths = strings::Split(FLAGS_fs_wal_dirs, ",", strings::SkipEmpty());
   data_paths = strings::Split(FLAGS_fs_data_dirs, ",", strings::SkipEmpty());
+  slow_data_paths = strings::Split(FLAGS_fs_slow_data_dirs, ",", strings::SkipEmpty());
 }
 
 FsManagerOpts::~FsManagerOpts() {
@@ -137,6 +144,7 @@ FsManager::FsManager(Env* env,
       read_only_(opts.read_only),
       wal_fs_roots_(opts.wal_paths),
       data_fs_roots_(opts.data_paths),
+      slow_data_fs_roots_(opts.slow_data_paths),
       server_type_(opts.server_type),
       metric_entity_(opts.metric_entity),
       parent_mem_tracker_(opts.parent_mem_tracker),
@@ -164,6 +172,9 @@ Status FsManager::Init() {
   for (const string& data_fs_root : data_fs_roots_) {
     all_roots.insert(data_fs_root);
   }
+  for (const string& slow_data_fs_root : slow_data_fs_roots_) {
+    all_roots.insert(slow_data_fs_root);
+  }
 
   // Build a map of original root --> canonicalized root, sanitizing each
   // root a bit as we go.
@@ -214,14 +225,25 @@ Status FsManager::Init() {
     LOG(FATAL) << "Data directories (fs_data_dirs) must be specified";
   }
 
-  for (const RootMap::value_type& e : canonicalized_roots) {
-    canonicalized_all_fs_roots_.insert(e.second);
+  canonicalized_all_fs_roots_.insert(
+      canonicalized_wal_fs_roots_.begin(), canonicalized_wal_fs_roots_.end());
+  canonicalized_all_fs_roots_.insert(
+      canonicalized_data_fs_roots_.begin(), canonicalized_data_fs_roots_.end());
+  for (const auto& slow_data_fs_root : slow_data_fs_roots_) {
+    const auto& canonicalized = FindOrDie(canonicalized_roots, slow_data_fs_root);
+    if (canonicalized_all_fs_roots_.count(canonicalized)) {
+      return STATUS_FORMAT(
+          InvalidArgument, "Slow data directory $0 is also used for data or WALs",
+          slow_data_fs_root);
+    }
+    canonicalized_slow_data_fs_roots_.insert(canonicalized);
   }
 
   if (VLOG_IS_ON(1)) {
     VLOG(1) << "WAL roots: " << canonicalized_wal_fs_roots_;
     VLOG(1) << "Metadata root: " << canonicalized_metadata_fs_root_;
     VLOG(1) << "Data roots: " << canonicalized_data_fs_roots_;
+    VLOG(1) << "Slow data roots: " << canonicalized_slow_data_fs_roots_;
     VLOG(1) << "All roots: " << canonicalized_all_fs_roots_;
   }
 
@@ -297,6 +319,8 @@ Status FsManager::DeleteFileSystemLayout(ShouldDeleteLogs also_delete_logs) {
     removal_list.insert(removal_list.begin(), data_dirs.begin(), data_dirs.end());
     removal_set.insert(removal_list.begin(), removal_list.end());
   }
+  auto slow_data_dirs = GetSlowDataRootDirs();
+  removal_set.insert(slow_data_dirs.begin(), slow_data_dirs.end());
 
   for (const string& target : removal_set) {
     bool is_dir = false;
@@ -508,6 +532,15 @@ vector<string> FsManager::GetDataRootDirs() const {
   return data_paths;
 }
 
+vector<string> FsManager::GetSlowDataRootDirs() const {
+  vector<string> data_paths;
+  for (const string& data_fs_root : canonicalized_slow_data_fs_roots_) {
+    data_paths.push_back(
+        JoinPathSegments(GetServerTypeDataPath(data_fs_root, server_type_), kDataDirName));
+  }
+  return data_paths;
+}
+
 vector<string> FsManager::GetWalRootDirs() const {
   DCHECK(initted_);
   vector<string> wal_dirs;
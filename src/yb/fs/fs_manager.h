@@ -90,6 +90,10 @@ struct FsManagerOpts {
   // The paths where data blocks will be stored. Cannot be empty.
   std::vector<std::string> data_paths;
 
+  // The paths on slower and cheaper storage, where older data of tablets could be placed.
+  // Optional.
+  std::vector<std::string> slow_data_paths;
+
   // Whether or not read-write operations should be allowed. Defaults to false.
   bool read_only;
 
@@ -112,6 +116,8 @@ struct FsManagerOpts {
 //     tablet-meta/<tablet>
 //     data/rocksdb/<table>/<tablet>/
 //     consensus-meta/<tablet>
+//
+// Slow data roots, when configured, contain only data/rocksdb/<table>/<tablet>/ subdirs.
 
 class FsManager {
  public:
@@ -158,6 +164,9 @@ class FsManager {
   // ==========================================================================
   std::vector<std::string> GetDataRootDirs() const;
 
+  // Data root dirs on slow storage, empty if slow storage is not configured.
+  std::vector<std::string> GetSlowDataRootDirs() const;
+
   std::vector<std::string> GetWalRootDirs() const;
 
   // Used for tests only. If GetWalRootDirs returns an empty vector, we will crash the process.
@@ -275,6 +284,7 @@ class FsManager {
   // as-is; they are first canonicalized during Init().
   const std::vector<std::string> wal_fs_roots_;
   const std::vector<std::string> data_fs_roots_;
+  const std::vector<std::string> slow_data_fs_roots_;
   const std::string server_type_;
 
   scoped_refptr<MetricEntity> metric_entity_;
@@ -291,6 +301,10 @@ class FsManager {
   std::set<std::string> canonicalized_data_fs_roots_;
   std::set<std::string> canonicalized_all_fs_roots_;
 
+  // Canonicalized form of 'slow_data_fs_roots_'. They do not contain instance metadata and are not
+  // included to 'canonicalized_all_fs_roots_', so slow storage could be added to existing server.
+  std::set<std::string> canonicalized_slow_data_fs_roots_;
+
   gscoped_ptr<InstanceMetadataPB> metadata_;
 
   bool initted_;
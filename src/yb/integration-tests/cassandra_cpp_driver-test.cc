@@ -70,6 +70,8 @@ METRIC_DECLARE_histogram(handler_latency_yb_client_write_remote);
 METRIC_DECLARE_histogram(handler_latency_yb_client_read_remote);
 METRIC_DECLARE_histogram(handler_latency_yb_client_write_local);
 METRIC_DECLARE_histogram(handler_latency_yb_client_read_local);
+METRIC_DECLARE_counter(index_writes_batched);
+METRIC_DECLARE_counter(index_write_batches);
 
 DECLARE_int64(external_mini_cluster_max_log_bytes);
 
@@ -278,6 +280,16 @@ class CppCassandraDriverTestUserEnforcedIndex : public CppCassandraDriverTestInd
   }
 };
 
+class CppCassandraDriverTestIndexWriteBatching : public CppCassandraDriverTestIndex {
+ public:
+  std::vector<std::string> ExtraTServerFlags() override {
+    auto flags = CppCassandraDriverTestIndex::ExtraTServerFlags();
+    flags.push_back("--enable_index_write_batching=true");
+    flags.push_back("--index_write_batch_window_usec=5000");
+    return flags;
+  }
+};
+
 class CppCassandraDriverTestIndexNonResponsiveTServers : public CppCassandraDriverTestIndexSlow {
  public:
   std::vector<std::string> ExtraMasterFlags() override {
@@ -992,6 +1004,56 @@ TEST_F_EX(CppCassandraDriverTest, TestTableCreateUniqueIndexUserEnforced,
                          IncludeAllColumns::kTrue, UserEnforced::kTrue);
 }
 
+TEST_F_EX(CppCassandraDriverTest, BatchedUserEnforcedIndexWrites,
+          CppCassandraDriverTestIndexWriteBatching) {
+  constexpr int kNumRows = 500;
+  constexpr int kNumIndexes = 3;
+  constexpr auto kNamespace = "test";
+  ASSERT_OK(session_.ExecuteQuery(
+      "create table test.t (k int primary key, v1 int, v2 int, v3 int) "
+      "with transactions = { 'enabled' : false };"));
+  const YBTableName table_name(YQL_DATABASE_CQL, kNamespace, "t");
+  for (int i = 1; i <= kNumIndexes; ++i) {
+    ASSERT_OK(session_.ExecuteQuery(Format(
+        "create index t_by_v$0 on test.t (v$0) with transactions = { 'enabled' : false, "
+        "'consistency_level' : 'user_enforced' };", i)));
+    const YBTableName index_table_name(YQL_DATABASE_CQL, kNamespace, Format("t_by_v$0", i));
+    auto perm = ASSERT_RESULT(client_->WaitUntilIndexPermissionsAtLeast(
+        table_name, index_table_name, IndexPermissions::INDEX_PERM_READ_WRITE_AND_DELETE));
+    ASSERT_EQ(IndexPermissions::INDEX_PERM_READ_WRITE_AND_DELETE, perm);
+  }
+
+  // Concurrent writes, so index writes produced by different statements share batches.
+  std::vector<CassandraFuture> futures;
+  for (int key = 0; key != kNumRows; ++key) {
+    futures.push_back(session_.ExecuteGetFuture(Format(
+        "insert into test.t (k, v1, v2, v3) values ($0, $1, $2, $3);",
+        key, key + 1, key + 2, key + 3)));
+  }
+  for (auto& future : futures) {
+    ASSERT_OK(future.Wait());
+  }
+
+  ASSERT_EQ(kNumRows, ASSERT_RESULT(GetTableSize(&session_, "test.t")));
+  for (int i = 1; i <= kNumIndexes; ++i) {
+    ASSERT_EQ(kNumRows, ASSERT_RESULT(GetTableSize(&session_, Format("test.t_by_v$0", i))));
+  }
+
+  int64_t num_batched_writes = 0;
+  int64_t num_batches = 0;
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    auto* ts = cluster_->tablet_server(i);
+    num_batched_writes += ASSERT_RESULT(ts->GetInt64Metric(
+        &METRIC_ENTITY_server, "yb.tabletserver", &METRIC_index_writes_batched, "value"));
+    num_batches += ASSERT_RESULT(ts->GetInt64Metric(
+        &METRIC_ENTITY_server, "yb.tabletserver", &METRIC_index_write_batches, "value"));
+  }
+  LOG(INFO) << "Batched index writes: " << num_batched_writes << ", batches: " << num_batches;
+  ASSERT_GE(num_batched_writes, kNumRows * kNumIndexes);
+  // Without batching there would be one batch per inserted row.
+  ASSERT_LT(num_batches, kNumRows);
+}
+
 bool CreateTableSuccessOrTimedOut(const Status& s) {
   // We sometimes get a Runtime Error from cql_test_util wrapping the actual Timeout.
   return s.ok() || s.IsTimedOut() ||
@@ -13,12 +13,22 @@
 
 #include "yb/integration-tests/cql_test_base.h"
 
+#include "yb/tserver/mini_tablet_server.h"
+#include "yb/tserver/tablet_server.h"
+
+#include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
 
 using namespace std::literals;
 
+DECLARE_int32(batcher_max_resolved_tablets);
 DECLARE_int64(cql_processors_limit);
+DECLARE_int64(cql_requests_memory_limit);
+
+METRIC_DECLARE_counter(batcher_resolved_tablet_reuses);
 
 namespace yb {
 
@@ -47,6 +57,26 @@ TEST_F(CqlTest, ProcessorsLimit) {
   ASSERT_TRUE(has_failures);
 }
 
+TEST_F(CqlTest, RequestsMemoryLimit) {
+  constexpr int64_t kLimit = 1024 * 1024;
+  auto session = ASSERT_RESULT(EstablishSession(driver_.get()));
+  ASSERT_OK(session.ExecuteQuery("CREATE TABLE t (k INT PRIMARY KEY, v INT)"));
+
+  auto tracker = cql_server_->mem_tracker()->FindChild("CQL requests");
+  ASSERT_NE(tracker, nullptr);
+  // Simulate in-flight requests that use more memory than the limit.
+  tracker->Consume(2 * kLimit);
+  ASSERT_OK(session.ExecuteQuery("INSERT INTO t (k, v) VALUES (1, 1)"));
+
+  FLAGS_cql_requests_memory_limit = kLimit;
+  auto status = session.ExecuteQuery("INSERT INTO t (k, v) VALUES (2, 2)");
+  LOG(INFO) << "Insert over the limit: " << status;
+  ASSERT_NOK(status);
+
+  tracker->Release(2 * kLimit);
+  ASSERT_OK(session.ExecuteQuery("INSERT INTO t (k, v) VALUES (3, 3)"));
+}
+
 // Execute delete in parallel to transactional update of the same row.
 TEST_F(CqlTest, ConcurrentDeleteRowAndUpdateColumn) {
   constexpr int kIterations = 70;
@@ -110,4 +140,49 @@ TEST_F(CqlTest, ConcurrentDeleteRowAndUpdateColumn) {
   ASSERT_EQ(num_even, 0);
 }
 
+// Measures throughput of unlogged batches of different sizes, with and without reusing tablets
+// resolved by a batch for its following operations.
+TEST_F(CqlTest, UnloggedBatchPerformance) {
+  constexpr int kRowsPerRun = RegularBuildVsSanitizers(20000, 2000);
+  auto session = ASSERT_RESULT(EstablishSession(driver_.get()));
+  ASSERT_OK(session.ExecuteQuery("CREATE TABLE t (k INT PRIMARY KEY, v INT)"));
+  auto prepared = ASSERT_RESULT(session.Prepare("INSERT INTO t (k, v) VALUES (?, ?)"));
+
+  // CQL server uses client of the first tablet server.
+  auto reuses = METRIC_batcher_resolved_tablet_reuses.Instantiate(
+      cluster_->mini_tablet_server(0)->server()->metric_entity());
+  int key = 0;
+  for (int max_resolved_tablets : {0, 64}) {
+    FLAGS_batcher_max_resolved_tablets = max_resolved_tablets;
+    const auto reuses_before = reuses->value();
+    for (int batch_size : {10, 100, 1000}) {
+      const auto start = MonoTime::Now();
+      for (int row = 0; row < kRowsPerRun; row += batch_size) {
+        CassandraBatch batch(CassBatchType::CASS_BATCH_TYPE_UNLOGGED);
+        for (int i = 0; i != batch_size; ++i) {
+          auto stmt = prepared.Bind();
+          stmt.Bind(0, ++key);
+          stmt.Bind(1, key);
+          batch.Add(&stmt);
+        }
+        ASSERT_OK(session.ExecuteBatch(batch));
+      }
+      const auto passed = MonoTime::Now() - start;
+      LOG(INFO) << "Max resolved tablets: " << max_resolved_tablets << ", batch size: "
+                << batch_size << ", time: " << passed << ", rows/s: "
+                << kRowsPerRun / passed.ToSeconds();
+    }
+    if (max_resolved_tablets == 0) {
+      ASSERT_EQ(reuses->value(), reuses_before);
+    } else {
+      ASSERT_GT(reuses->value(), reuses_before);
+    }
+  }
+
+  auto result = ASSERT_RESULT(session.ExecuteWithResult("SELECT COUNT(*) FROM t"));
+  auto iterator = result.CreateIterator();
+  ASSERT_TRUE(iterator.Next());
+  ASSERT_EQ(iterator.Row().Value(0).As<int64_t>(), key);
+}
+
 } // namespace yb
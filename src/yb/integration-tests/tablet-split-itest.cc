@@ -12,6 +12,7 @@
 //
 
 #include <chrono>
+#include <map>
 #include <thread>
 #include "yb/client/client-test-util.h"
 #include "yb/client/error.h"
@@ -30,6 +31,7 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 
 #include "yb/gutil/dynamic_annotations.h"
+#include "yb/gutil/strings/util.h"
 #include "yb/integration-tests/mini_cluster.h"
 #include "yb/integration-tests/test_workload.h"
 
@@ -49,6 +51,7 @@
 #include "yb/tserver/tserver_admin.proxy.h"
 #include "yb/tserver/ts_tablet_manager.h"
 
+#include "yb/util/path_util.h"
 #include "yb/util/protobuf_util.h"
 #include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
@@ -71,6 +74,11 @@ DECLARE_bool(TEST_skip_deleting_split_tablets);
 DECLARE_int32(replication_factor);
 DECLARE_int32(tablet_split_limit_per_table);
 DECLARE_bool(TEST_pause_before_post_split_compation);
+DECLARE_string(fs_slow_data_dirs);
+DECLARE_int64(tablet_slow_tier_data_age_sec);
+DECLARE_double(tablet_split_ops_per_sec_threshold);
+DECLARE_int32(tablet_split_monitor_heartbeat_interval_ms);
+DECLARE_int32(tablet_split_load_rate_window_ms);
 
 namespace yb {
 
@@ -1022,6 +1030,203 @@ TEST_F(TabletSplitITest, SplitDuringReplicaOffline) {
     }, 30s * kTimeMultiplier, "Waiting for TS-1 to catch up ..."), AsString(s));
 }
 
+class TabletSplitByLoadITest : public TabletSplitITest {
+ public:
+  void SetUp() override {
+    FLAGS_tablet_split_monitor_heartbeat_interval_ms = 100;
+    FLAGS_tablet_split_load_rate_window_ms = 1000;
+    TabletSplitITest::SetUp();
+  }
+};
+
+// Checks that sustained load on a single tablet triggers its split, while size based splitting is
+// disabled.
+TEST_F(TabletSplitByLoadITest, SplitSingleTabletByLoad) {
+  constexpr auto kNumRows = 100;
+  constexpr auto kOpsPerSecThreshold = 50;
+
+  CreateSingleTablet();
+  ASSERT_OK(WriteRows(kNumRows, 1));
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_ops_per_sec_threshold) = kOpsPerSecThreshold;
+
+  ASSERT_OK(WaitFor([&]() -> Result<bool> {
+    // Keep overwriting the same rows, so the number of rows stays the same.
+    const auto status = ResultToStatus(WriteRows(kNumRows, 1));
+    if (!status.ok()) {
+      LOG(WARNING) << "Write failed: " << status;
+    }
+    return ListTableActiveTabletPeers(cluster_.get(), table_->id()).size() >
+           static_cast<size_t>(FLAGS_replication_factor);
+  }, 60s * kTimeMultiplier, "Wait for tablet split by load"));
+
+  // Stop the load based splitting, so children are not split further.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_ops_per_sec_threshold) = 0;
+  ASSERT_NO_FATALS(WaitForTabletSplitCompletion(/* expected_non_split_tablets =*/ 2));
+  ASSERT_OK(CheckRowsCount(kNumRows));
+}
+
+namespace {
+
+Result<size_t> CountSstFiles(Env* env, const std::string& dir) {
+  std::vector<std::string> children;
+  RETURN_NOT_OK(env->GetChildren(dir, &children));
+  return std::count_if(children.begin(), children.end(), [](const std::string& name) {
+    return HasSuffixString(name, ".sst");
+  });
+}
+
+// Returns map from "<tablet id>/<peer uuid>" to the tablet peer.
+std::map<std::string, tablet::TabletPeerPtr> MapByTabletAndPeerId(
+    const std::vector<tablet::TabletPeerPtr>& peers) {
+  std::map<std::string, tablet::TabletPeerPtr> result;
+  for (const auto& peer : peers) {
+    result.emplace(peer->tablet_id() + "/" + peer->permanent_uuid(), peer);
+  }
+  return result;
+}
+
+} // namespace
+
+class TabletSplitSlowDataDirsITest : public TabletSplitITest {
+ public:
+  void SetUp() override {
+    // Each tablet server uses its own subdir of this dir, see MiniTabletServer.
+    FLAGS_fs_slow_data_dirs = GetTestPath("slow-data");
+    TabletSplitITest::SetUp();
+  }
+
+  // Flushes and compacts regular DBs of all post-split tablet peers, and checks that their SST
+  // files are placed to the slow data dir only.
+  void CompactToSlowTier() {
+    for (const auto& peer : ASSERT_RESULT(ListPostSplitChildrenTabletPeers())) {
+      auto* tablet = peer->tablet();
+      ASSERT_OK(tablet->Flush(tablet::FlushMode::kSync));
+      ASSERT_OK(tablet->ForceFullRocksDBCompact());
+      const auto* metadata = tablet->metadata();
+      ASSERT_EQ(ASSERT_RESULT(CountSstFiles(env_.get(), metadata->rocksdb_dir())), 0)
+          << peer->LogPrefix();
+      ASSERT_GT(ASSERT_RESULT(CountSstFiles(env_.get(), metadata->slow_rocksdb_dir())), 0)
+          << peer->LogPrefix();
+    }
+  }
+};
+
+// Checks placement of old data to slow data dirs:
+// - Data younger than tablet_slow_tier_data_age_sec stays in the regular data dir.
+// - Split children get slow data dir next to the one of their parent.
+// - Once data is old enough, compaction places it to the slow data dir.
+// - slow_rocksdb_dir is persisted in tablet metadata, and data is readable after restart.
+// - Tombstoning a replica deletes its slow data dir, remote bootstrap keeps using it.
+// - Deleting a split parent deletes its slow data dir.
+TEST_F(TabletSplitSlowDataDirsITest, PlaceOldDataToSlowDataDirs) {
+  constexpr auto kNumRows = 500;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_slow_tier_data_age_sec) = 24 * 60 * 60;
+
+  CreateSingleTablet();
+  const auto split_hash_code = ASSERT_RESULT(WriteRowsAndGetMiddleHashCode(kNumRows));
+
+  std::map<std::string, std::string> parent_slow_dirs;
+  for (const auto& peer : ASSERT_RESULT(ListPostSplitChildrenTabletPeers())) {
+    const auto* metadata = peer->tablet()->metadata();
+    const auto slow_dir = metadata->slow_rocksdb_dir();
+    ASSERT_TRUE(HasPrefixString(
+        slow_dir, JoinPathSegments(FLAGS_fs_slow_data_dirs, "ts-"))) << slow_dir;
+    ASSERT_TRUE(env_->DirExists(slow_dir)) << slow_dir;
+    parent_slow_dirs.emplace(peer->permanent_uuid(), slow_dir);
+  }
+  ASSERT_EQ(parent_slow_dirs.size(), static_cast<size_t>(FLAGS_replication_factor));
+
+  ASSERT_OK(SplitTabletAndValidate(split_hash_code, kNumRows));
+  ASSERT_NO_FATALS(WaitForTestTableTabletsCompactionFinish(5s * kTimeMultiplier));
+
+  for (const auto& peer_and_dir : parent_slow_dirs) {
+    ASSERT_FALSE(env_->DirExists(peer_and_dir.second)) << peer_and_dir.second;
+  }
+
+  // Post split compaction was done with data younger than the threshold, so it should stay in the
+  // regular data dir.
+  auto peers = ASSERT_RESULT(ListPostSplitChildrenTabletPeers());
+  ASSERT_EQ(peers.size(), 2 * static_cast<size_t>(FLAGS_replication_factor));
+  for (const auto& peer : peers) {
+    const auto* metadata = peer->tablet()->metadata();
+    const auto slow_dir = metadata->slow_rocksdb_dir();
+    ASSERT_EQ(DirName(slow_dir), DirName(parent_slow_dirs[peer->permanent_uuid()]));
+    ASSERT_TRUE(env_->DirExists(slow_dir)) << slow_dir;
+    ASSERT_GT(ASSERT_RESULT(CountSstFiles(env_.get(), metadata->rocksdb_dir())), 0)
+        << peer->LogPrefix();
+    ASSERT_EQ(ASSERT_RESULT(CountSstFiles(env_.get(), slow_dir)), 0) << peer->LogPrefix();
+  }
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_slow_tier_data_age_sec) = 1;
+  std::this_thread::sleep_for(2s);
+  ASSERT_NO_FATALS(CompactToSlowTier());
+  ASSERT_OK(CheckPostSplitTabletReplicasData(kNumRows));
+
+  // slow_rocksdb_dir should be loaded from tablet metadata, and data from the slow data dir should
+  // be readable.
+  const auto peers_before_restart = MapByTabletAndPeerId(peers);
+  peers.clear();
+  ASSERT_OK(cluster_->RestartSync());
+  peers = ASSERT_RESULT(ListPostSplitChildrenTabletPeers());
+  ASSERT_EQ(peers.size(), peers_before_restart.size());
+  for (const auto& peer_and_id : MapByTabletAndPeerId(peers)) {
+    const auto it = peers_before_restart.find(peer_and_id.first);
+    ASSERT_NE(it, peers_before_restart.end()) << peer_and_id.first;
+    const auto* metadata = peer_and_id.second->tablet()->metadata();
+    ASSERT_EQ(metadata->slow_rocksdb_dir(), it->second->tablet()->metadata()->slow_rocksdb_dir());
+    ASSERT_EQ(ASSERT_RESULT(CountSstFiles(env_.get(), metadata->rocksdb_dir())), 0)
+        << peer_and_id.first;
+  }
+  ASSERT_OK(CheckPostSplitTabletReplicasData(kNumRows));
+
+  // Tombstone a follower replica of the post split tablet, so it is remote bootstrapped.
+  tablet::TabletPeerPtr follower;
+  for (const auto& peer : peers) {
+    if (peer->LeaderStatus() == consensus::LeaderStatus::NOT_LEADER) {
+      follower = peer;
+      break;
+    }
+  }
+  ASSERT_NE(follower, nullptr);
+  const auto tablet_id = follower->tablet_id();
+  const auto slow_dir = follower->tablet()->metadata()->slow_rocksdb_dir();
+  tserver::MiniTabletServer* follower_ts = nullptr;
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    if (cluster_->mini_tablet_server(i)->server()->permanent_uuid() ==
+            follower->permanent_uuid()) {
+      follower_ts = cluster_->mini_tablet_server(i);
+    }
+  }
+  ASSERT_NE(follower_ts, nullptr);
+  follower.reset();
+  peers.clear();
+
+  boost::optional<tserver::TabletServerErrorPB::Code> error_code;
+  ASSERT_OK(follower_ts->server()->tablet_manager()->DeleteTablet(
+      tablet_id, tablet::TABLET_DATA_TOMBSTONED, boost::none, &error_code));
+  ASSERT_FALSE(env_->DirExists(slow_dir)) << slow_dir;
+
+  ASSERT_OK(WaitFor([follower_ts, &tablet_id] {
+    tablet::TabletPeerPtr peer;
+    if (!follower_ts->server()->tablet_manager()->LookupTablet(tablet_id, &peer)) {
+      return false;
+    }
+    return peer->state() == tablet::RUNNING && peer->tablet() != nullptr &&
+           peer->tablet()->metadata()->tablet_data_state() == tablet::TABLET_DATA_READY;
+  }, 30s * kTimeMultiplier, "Wait for remote bootstrap"));
+
+  auto bootstrapped = ASSERT_RESULT(
+      follower_ts->server()->tablet_manager()->LookupTablet(tablet_id));
+  ASSERT_EQ(bootstrapped->tablet()->metadata()->slow_rocksdb_dir(), slow_dir);
+  ASSERT_TRUE(env_->DirExists(slow_dir)) << slow_dir;
+  bootstrapped.reset();
+
+  // Remote bootstrap downloads SST files to the regular data dir, so they are moved to the slow
+  // data dir by the next compaction.
+  ASSERT_NO_FATALS(CompactToSlowTier());
+  ASSERT_OK(CheckPostSplitTabletReplicasData(kNumRows));
+}
+
 namespace {
 
 PB_ENUM_FORMATTERS(IsolationLevel);
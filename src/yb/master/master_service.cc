@@ -56,6 +56,12 @@ DEFINE_int64(tablet_split_size_threshold_bytes, 0,
              "Threshold on tablet size after which tablet should be split. Automated splitting is "
              "disabled if this value is set to 0");
 
+DEFINE_double(tablet_split_ops_per_sec_threshold, 0,
+              "Threshold on tablet load (read and write requests per second) after which tablet "
+              "should be split. Load based automated splitting is disabled if this value is set "
+              "to 0");
+TAG_FLAG(tablet_split_ops_per_sec_threshold, runtime);
+
 DEFINE_int32(master_inject_latency_on_tablet_lookups_ms, 0,
              "Number of milliseconds that the master will sleep before responding to "
              "requests for tablet locations.");
@@ -252,6 +258,9 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
   if (FLAGS_tablet_split_size_threshold_bytes > 0) {
     resp->set_tablet_split_size_threshold_bytes(FLAGS_tablet_split_size_threshold_bytes);
   }
+  if (FLAGS_tablet_split_ops_per_sec_threshold > 0) {
+    resp->set_tablet_split_ops_per_sec_threshold(FLAGS_tablet_split_ops_per_sec_threshold);
+  }
 
   rpc.RespondSuccess();
 }
@@ -35,6 +35,8 @@ namespace rocksdb {
 
 class SliceTransform;
 
+struct FileMetaData;
+
 // Context information of a compaction run
 struct CompactionFilterContext {
   // Does this compaction run include all data files
@@ -153,6 +155,25 @@ class CompactionFilter {
   virtual Slice DropKeysGreaterOrEqual() const { return Slice(); }
 };
 
+// Allows the application to decide which SST files could be deleted as a whole, because all their
+// entries have expired, and which files should not be compacted together, so whole files expire
+// together. Used by universal compaction. A new instance is created for every compaction pick.
+class CompactionFileFilter {
+ public:
+  virtual ~CompactionFileFilter() {}
+
+  // Files are ordered from the newest to the oldest. Returns the number of the oldest files that
+  // could be deleted without being rewritten.
+  virtual size_t NumExpiredFiles(const std::vector<FileMetaData*>& files) = 0;
+
+  // Returns "user frontier" that should be applied to the flushed frontier when expired files are
+  // deleted. See CompactionFilter::GetLargestUserFrontier.
+  virtual UserFrontierPtr GetLargestUserFrontier() const = 0;
+
+  // Returns true if the newer file should not be compacted together with the adjacent older one.
+  virtual bool IsCompactionBoundary(const FileMetaData& newer, const FileMetaData& older) = 0;
+};
+
 // Each compaction will create a new CompactionFilter allowing the
 // application to know about different compactions
 class CompactionFilterFactory {
@@ -162,6 +183,9 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Returns nullptr if SST files should never be deleted without being rewritten.
+  virtual std::unique_ptr<CompactionFileFilter> CreateCompactionFileFilter() { return nullptr; }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
@@ -300,6 +300,16 @@ class Compaction {
   yb::PriorityThreadPoolSuspender* suspender() { return suspender_; }
   void SetSuspender(yb::PriorityThreadPoolSuspender* value) { suspender_ = value; }
 
+  // Counter of raw input bytes processed by compaction, used to report progress of the compaction
+  // task. Owned by the task, so it could be read after the compaction is destroyed.
+  void SetProgressCounter(std::atomic<uint64_t>* value) { progress_counter_ = value; }
+
+  void AddProcessedInputBytes(uint64_t bytes) {
+    if (progress_counter_) {
+      progress_counter_->fetch_add(bytes, std::memory_order_relaxed);
+    }
+  }
+
  private:
   // mark (or clear) all files that are being compacted
   void MarkFilesBeingCompacted(bool mark_as_compacted);
@@ -379,6 +389,8 @@ class Compaction {
   CompactionReason compaction_reason_;
 
   yb::PriorityThreadPoolSuspender* suspender_ = nullptr;
+
+  std::atomic<uint64_t>* progress_counter_ = nullptr;
 };
 
 // Utility function
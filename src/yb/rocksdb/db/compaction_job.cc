@@ -245,6 +245,8 @@ CompactionJob::CompactionJob(
       dbname_(dbname),
       db_options_(db_options),
       env_options_(env_options),
+      env_options_for_write_(db_options.env->OptimizeForCompactionTableWrite(
+          env_options, db_options)),
       env_(db_options.env),
       versions_(versions),
       shutting_down_(shutting_down),
@@ -691,6 +693,13 @@ void CompactionJob::ProcessKeyValueCompaction(
   auto c_iter = sub_compact->c_iter.get();
   c_iter->SeekToFirst();
   const auto& c_iter_stats = c_iter->iter_stats();
+  uint64_t reported_input_bytes = 0;
+  auto report_progress = [&c_iter_stats, sub_compact, &reported_input_bytes] {
+    auto input_bytes =
+        c_iter_stats.total_input_raw_key_bytes + c_iter_stats.total_input_raw_value_bytes;
+    sub_compact->compaction->AddProcessedInputBytes(input_bytes - reported_input_bytes);
+    reported_input_bytes = input_bytes;
+  };
   // TODO(noetzli): check whether we could check !shutting_down_->... only
   // only occasionally (see diff D42687)
   while (status.ok() && !shutting_down_->load(std::memory_order_acquire) &&
@@ -718,6 +727,7 @@ void CompactionJob::ProcessKeyValueCompaction(
       RecordDroppedKeys(c_iter_stats, &sub_compact->compaction_job_stats);
       c_iter->ResetRecordCounts();
       RecordCompactionIOStats();
+      report_progress();
     }
 
     // Open output file if necessary
@@ -755,6 +765,7 @@ void CompactionJob::ProcessKeyValueCompaction(
     c_iter->Next();
   }
 
+  report_progress();
   sub_compact->num_input_records = c_iter_stats.num_input_records;
   sub_compact->compaction_job_stats.num_input_deletion_records =
       c_iter_stats.num_input_deletion_records;
@@ -997,7 +1008,7 @@ void CompactionJob::RecordCompactionIOStats() {
 Status CompactionJob::OpenFile(const std::string table_name, uint64_t file_number,
     const std::string file_type_label, const std::string fname,
     std::unique_ptr<WritableFile>* writable_file) {
-  Status s = NewWritableFile(env_, fname, writable_file, env_options_);
+  Status s = NewWritableFile(env_, fname, writable_file, env_options_for_write_);
   if (!s.ok()) {
     RLOG(InfoLogLevel::ERROR_LEVEL, db_options_.info_log,
         "[%s] [JOB %d] OpenCompactionOutputFiles for table #%" PRIu64
@@ -1049,7 +1060,8 @@ Status CompactionJob::OpenCompactionOutputFile(
         (*writable_file)->SetPreallocationBlockSize(preallocation_block_size);
       }
       writer->reset(new WritableFileWriter(
-          std::move(*writable_file), env_options_, sub_compact->compaction->suspender()));
+          std::move(*writable_file), env_options_for_write_,
+          sub_compact->compaction->suspender()));
     };
 
     const bool is_split_sst = cfd->ioptions()->table_factory->IsSplitSstForWriteSupported();
@@ -152,6 +152,8 @@ class CompactionJob {
   const std::string& dbname_;
   const DBOptions& db_options_;
   const EnvOptions& env_options_;
+  // Options used to write output files, see DBOptions::use_direct_io_for_compaction.
+  const EnvOptions env_options_for_write_;
   Env* env_;
   VersionSet* versions_;
   std::atomic<bool>* shutting_down_;
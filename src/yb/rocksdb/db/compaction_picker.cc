@@ -35,6 +35,7 @@
 
 #include <gflags/gflags.h>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/column_family.h"
 #include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/util/log_buffer.h"
@@ -462,6 +463,25 @@ void CompactionPicker::GetGrandparents(
   }
 }
 
+uint32_t CompactionPicker::SelectOutputPathId(
+    const std::vector<CompactionInputFiles>& inputs, uint32_t default_path_id) const {
+  const auto& selector = ioptions_.compaction_output_path_selector;
+  if (!selector || ioptions_.db_paths.size() <= 1) {
+    return default_path_id;
+  }
+  const auto last_path_id = static_cast<uint32_t>(ioptions_.db_paths.size() - 1);
+  UserFrontierPtr largest;
+  for (const auto& level_inputs : inputs) {
+    for (const auto* file : level_inputs.files) {
+      if (!file->largest.user_frontier) {
+        return std::min((*selector)(nullptr), last_path_id);
+      }
+      UpdateUserFrontier(&largest, file->largest.user_frontier, UpdateUserValueType::kLargest);
+    }
+  }
+  return std::min((*selector)(largest.get()), last_path_id);
+}
+
 std::unique_ptr<Compaction> CompactionPicker::CompactRange(
     const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage, int input_level, int output_level,
@@ -511,6 +531,7 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
         return nullptr;
       }
     }
+    output_path_id = SelectOutputPathId(inputs, output_path_id);
     auto c = std::make_unique<Compaction>(
         vstorage, mutable_cf_options, std::move(inputs), output_level,
         mutable_cf_options.MaxFileSizeForLevel(output_level),
@@ -609,6 +630,10 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
     }
   }
 
+  if (ioptions_.compaction_style == kCompactionStyleUniversal) {
+    output_path_id = SelectOutputPathId(compaction_inputs, output_path_id);
+  }
+
   std::vector<FileMetaData*> grandparents;
   GetGrandparents(vstorage, inputs, output_level_inputs, &grandparents);
   auto compaction = std::make_unique<Compaction>(
@@ -1223,10 +1248,15 @@ void UniversalCompactionPicker::SortedRun::DumpSizeInfo(
 std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
     UniversalCompactionPicker::CalculateSortedRuns(const VersionStorageInfo& vstorage,
                                                    const ImmutableCFOptions& ioptions,
-                                                   uint64_t max_file_size) {
+                                                   uint64_t max_file_size,
+                                                   CompactionFileFilter* file_filter) {
   std::vector<std::vector<SortedRun>> ret(1);
   for (FileMetaData* f : vstorage.LevelFiles(0)) {
     if (f->fd.GetTotalFileSize() <= max_file_size) {
+      if (file_filter && !ret.back().empty() &&
+          file_filter->IsCompactionBoundary(*ret.back().back().file, *f)) {
+        ret.emplace_back();
+      }
       ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
           f->being_compacted);
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
@@ -1353,10 +1383,21 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompaction(
     const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage,
     LogBuffer* log_buffer) {
+  auto file_filter = ioptions_.compaction_filter_factory
+      ? ioptions_.compaction_filter_factory->CreateCompactionFileFilter() : nullptr;
+  if (file_filter) {
+    auto result = PickCompactionUniversalExpiredFiles(
+        cf_name, mutable_cf_options, vstorage, file_filter.get(), log_buffer);
+    if (result != nullptr) {
+      return result;
+    }
+  }
+
   std::vector<std::vector<SortedRun>> sorted_runs = CalculateSortedRuns(
       *vstorage,
       ioptions_,
-      mutable_cf_options.max_file_size_for_compaction);
+      mutable_cf_options.max_file_size_for_compaction,
+      file_filter.get());
 
   for (const auto& block : sorted_runs) {
     auto result = DoPickCompaction(cf_name, mutable_cf_options, vstorage, log_buffer, block);
@@ -1496,6 +1537,56 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::DoPickCompaction(
   return c;
 }
 
+std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalExpiredFiles(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, CompactionFileFilter* file_filter, LogBuffer* log_buffer) {
+  const int kLevel0 = 0;
+  // Files of other levels are older than level 0 files, so they should be deleted first.
+  for (int level = 1; level < vstorage->num_levels(); level++) {
+    if (!vstorage->LevelFiles(level).empty()) {
+      return nullptr;
+    }
+  }
+
+  const std::vector<FileMetaData*>& level_files = vstorage->LevelFiles(kLevel0);
+  const size_t num_expired_files = file_filter->NumExpiredFiles(level_files);
+  if (num_expired_files == 0) {
+    return nullptr;
+  }
+  assert(num_expired_files <= level_files.size());
+
+  std::vector<CompactionInputFiles> inputs(1);
+  inputs[0].level = kLevel0;
+  for (auto it = level_files.end() - num_expired_files; it != level_files.end(); ++it) {
+    auto* f = *it;
+    if (f->being_compacted) {
+      // Will be deleted after the current compaction, if its output is still expired.
+      return nullptr;
+    }
+    inputs[0].files.push_back(f);
+  }
+  for (auto* f : inputs[0].files) {
+    char tmp_fsize[16];
+    AppendHumanBytes(f->fd.GetTotalFileSize(), tmp_fsize, sizeof(tmp_fsize));
+    LOG_TO_BUFFER(log_buffer, "[%s] Universal: picking expired file %" PRIu64
+                            " with size %s for deletion",
+                cf_name.c_str(), f->fd.GetNumber(), tmp_fsize);
+  }
+
+  auto c = std::make_unique<Compaction>(
+      vstorage, mutable_cf_options, std::move(inputs), 0 /* output_level */,
+      0 /* target_file_size */, 0 /* max_grandparent_overlap_bytes */, 0 /* output_path_id */,
+      kNoCompression, std::vector<FileMetaData*>(), /* is manual */ false,
+      vstorage->CompactionScore(kLevel0),
+      /* is deletion compaction */ true, CompactionReason::kUniversalExpiredFiles);
+  auto frontier = file_filter->GetLargestUserFrontier();
+  if (frontier) {
+    c->edit()->UpdateFlushedFrontier(std::move(frontier));
+  }
+  level0_compactions_in_progress_.insert(c.get());
+  return c;
+}
+
 uint32_t UniversalCompactionPicker::GetPathId(
     const ImmutableCFOptions& ioptions, uint64_t file_size) {
   // Two conditions need to be satisfied:
@@ -1712,6 +1803,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   } else {
     compaction_reason = CompactionReason::kUniversalSizeRatio;
   }
+  path_id = SelectOutputPathId(inputs, path_id);
   return std::make_unique<Compaction>(
       vstorage, mutable_cf_options, std::move(inputs), output_level,
       mutable_cf_options.MaxFileSizeForLevel(output_level), LLONG_MAX, path_id,
@@ -1832,6 +1924,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
                 cf_name.c_str(), file_num_buf);
   }
 
+  path_id = SelectOutputPathId(inputs, path_id);
   return std::make_unique<Compaction>(
       vstorage, mutable_cf_options, std::move(inputs),
       vstorage->num_levels() - 1,
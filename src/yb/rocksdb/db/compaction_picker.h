@@ -42,6 +42,7 @@
 
 namespace rocksdb {
 
+class CompactionFileFilter;
 class LogBuffer;
 class Compaction;
 class VersionStorageInfo;
@@ -186,6 +187,11 @@ class CompactionPicker {
                        const CompactionInputFiles& output_level_inputs,
                        std::vector<FileMetaData*>* grandparents);
 
+  // Returns output path for compaction of specified inputs, taking into account
+  // compaction_output_path_selector. default_path_id is used when selector is not specified.
+  uint32_t SelectOutputPathId(
+      const std::vector<CompactionInputFiles>& inputs, uint32_t default_path_id) const;
+
   const ImmutableCFOptions& ioptions_;
 
   // A helper function to SanitizeCompactionInputFiles() that
@@ -284,8 +290,14 @@ class UniversalCompactionPicker : public CompactionPicker {
       VersionStorageInfo* vstorage, double score,
       const std::vector<SortedRun>& sorted_runs, LogBuffer* log_buffer);
 
+  // Pick deletion of the oldest files, all entries of which have expired.
+  std::unique_ptr<Compaction> PickCompactionUniversalExpiredFiles(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage, CompactionFileFilter* file_filter, LogBuffer* log_buffer);
+
   // At level 0 we could compact only continuous sequence of files.
-  // Since there could be too-large-to-compact files, we could get several such sequences.
+  // Since there could be too-large-to-compact files, or compaction boundaries specified by
+  // file_filter, we could get several such sequences.
   // Files from one sequence are compacted together, and files from different sequences are not
   // compacted.
   // One sequence is std::vector<SortedRun>.
@@ -293,7 +305,8 @@ class UniversalCompactionPicker : public CompactionPicker {
   static std::vector<std::vector<SortedRun>> CalculateSortedRuns(
       const VersionStorageInfo& vstorage,
       const ImmutableCFOptions& ioptions,
-      uint64_t max_file_size);
+      uint64_t max_file_size,
+      CompactionFileFilter* file_filter);
 
   // Pick a path ID to place a newly generated file, with its estimated file
   // size.
@@ -21,19 +21,28 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#include <algorithm>
 #include <atomic>
+#include <limits>
 
 #include "yb/rocksdb/db/db_test_util.h"
 #include "yb/rocksdb/port/stack_trace.h"
 #include "yb/rocksdb/experimental.h"
 #include "yb/rocksdb/utilities/convenience.h"
+#include "yb/rocksdb/util/histogram.h"
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/rocksdb/util/testutil.h"
 
+#include "yb/util/countdown_latch.h"
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/random_util.h"
 #include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
 
 DECLARE_bool(flush_rocksdb_on_shutdown);
+DECLARE_int32(compaction_priority_penalty_per_pending_task);
+DECLARE_int32(compaction_priority_write_stall_margin);
+DECLARE_int32(small_compaction_extra_priority);
 
 using std::atomic;
 using namespace std::literals;
@@ -951,6 +960,193 @@ TEST_F(DBCompactionTest, MinorCompactionsHappen) {
   } while (ChangeCompactOptions());
 }
 
+TEST_F(DBCompactionTest, DirectIOForCompaction) {
+  Options options = CurrentOptions();
+  options.use_direct_io_for_compaction = true;
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  // Values are not a multiple of the direct I/O alignment, so both reads and writes of compaction
+  // are unaligned at the file level.
+  const int kNumFiles = 4;
+  const int kKeysPerFile = 300;
+  for (int file = 0; file < kNumFiles; ++file) {
+    for (int i = 0; i < kKeysPerFile; ++i) {
+      ASSERT_OK(Put(Key(file * kKeysPerFile + i), RandomString(&rnd, 333)));
+    }
+    ASSERT_OK(Flush());
+  }
+  std::vector<std::string> expected;
+  for (int i = 0; i < kNumFiles * kKeysPerFile; ++i) {
+    expected.push_back(Get(Key(i)));
+  }
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ("0,1", FilesPerLevel());
+
+  for (int i = 0; i < kNumFiles * kKeysPerFile; ++i) {
+    ASSERT_EQ(expected[i], Get(Key(i)));
+  }
+
+  Reopen(options);
+  for (int i = 0; i < kNumFiles * kKeysPerFile; ++i) {
+    ASSERT_EQ(expected[i], Get(Key(i)));
+  }
+}
+
+// Compares duration of full compaction and latency of concurrent point reads, when compaction uses
+// buffered and direct I/O. Results are logged, correctness is checked by DirectIOForCompaction.
+TEST_F(DBCompactionTest, DirectIOForCompactionPerf) {
+  constexpr int kNumFiles = 8;
+  constexpr int kKeysPerFile = yb::RegularBuildVsSanitizers(20000, 2000);
+  constexpr int kValueSize = 1000;
+  constexpr int kNumKeys = kNumFiles * kKeysPerFile;
+
+  for (bool direct_io : {false, true}) {
+    Options options = CurrentOptions();
+    options.use_direct_io_for_compaction = direct_io;
+    options.disable_auto_compactions = true;
+    DestroyAndReopen(options);
+
+    Random rnd(301);
+    for (int file = 0; file < kNumFiles; ++file) {
+      for (int i = 0; i < kKeysPerFile; ++i) {
+        ASSERT_OK(Put(Key(file * kKeysPerFile + i), RandomString(&rnd, kValueSize)));
+      }
+      ASSERT_OK(Flush());
+    }
+
+    std::atomic<bool> stop{false};
+    HistogramImpl read_latency;
+    std::thread reader([this, &stop, &read_latency] {
+      Random reader_rnd(17);
+      while (!stop.load(std::memory_order_acquire)) {
+        auto start = env_->NowMicros();
+        Get(Key(reader_rnd.Uniform(kNumKeys)));
+        read_latency.Add(env_->NowMicros() - start);
+      }
+    });
+
+    auto start = env_->NowMicros();
+    ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+    auto compaction_us = env_->NowMicros() - start;
+    stop.store(true, std::memory_order_release);
+    reader.join();
+    ASSERT_EQ("0,1", FilesPerLevel());
+
+    LOG(INFO) << (direct_io ? "Direct" : "Buffered") << " I/O compaction of "
+              << kNumKeys / 1024 * kValueSize / 1024 << "MB took " << compaction_us
+              << "us, latency of concurrent reads in us:\n" << read_latency.ToString();
+  }
+}
+
+namespace {
+
+// Occupies a thread of priority thread pool until released.
+class BlockingTask : public yb::PriorityThreadPoolTask {
+ public:
+  explicit BlockingTask(yb::CountDownLatch* release) : release_(release) {}
+
+  void Run(const Status& status, yb::PriorityThreadPoolSuspender* suspender) override {
+    if (status.ok()) {
+      release_->Wait();
+    }
+  }
+
+  bool BelongsTo(void* key) override {
+    return false;
+  }
+
+  std::string ToString() const override {
+    return "{ blocking task }";
+  }
+
+ private:
+  yb::CountDownLatch* release_;
+};
+
+// Returns priorities of compaction tasks in the pool, ordered by submission.
+std::vector<int> CompactionTaskPriorities(yb::PriorityThreadPool* pool) {
+  std::vector<std::pair<size_t, int>> tasks;
+  for (const auto& info : pool->TaskInfos()) {
+    if (info.description.find("compact db") != std::string::npos) {
+      tasks.emplace_back(info.serial_no, info.priority);
+    }
+  }
+  std::sort(tasks.begin(), tasks.end());
+  std::vector<int> result;
+  for (const auto& task : tasks) {
+    result.push_back(task.second);
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_F(DBCompactionTest, CompactionTaskPriority) {
+  // See kWriteStallPreventionPriority in db_impl.cc.
+  constexpr int kWriteStallPreventionPriority = 50;
+  constexpr int kSmallCompactionExtraPriority = 5;
+  constexpr int kPenaltyPerPendingTask = 2;
+  FLAGS_small_compaction_extra_priority = kSmallCompactionExtraPriority;
+  FLAGS_compaction_priority_penalty_per_pending_task = kPenaltyPerPendingTask;
+  FLAGS_compaction_priority_write_stall_margin = 4;
+
+  // Keep compaction tasks queued, so their priorities could be checked.
+  yb::PriorityThreadPool pool(1);
+  yb::CountDownLatch release(1);
+  auto blocking_task = std::make_unique<BlockingTask>(&release);
+  ASSERT_OK(pool.Submit(1000, &blocking_task));
+
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.level0_file_num_compaction_trigger = 2;
+  // Like in YB, writes are throttled by the user of DB based on number of SST files, instead of
+  // RocksDB write slowdown.
+  options.level0_slowdown_writes_trigger = std::numeric_limits<int>::max();
+  options.level0_stop_writes_trigger = std::numeric_limits<int>::max();
+  options.sst_files_write_stall_trigger = std::make_shared<SstFilesWriteStallTrigger>([] {
+    return 8;
+  });
+  options.priority_thread_pool_for_compactions_and_flushes = &pool;
+  DestroyAndReopen(options);
+
+  auto wait_priorities = [&pool](const std::vector<int>& expected) {
+    return yb::WaitFor([&pool, &expected] {
+      return CompactionTaskPriorities(&pool) == expected;
+    }, 10s * yb::kTimeMultiplier, yb::Format("Wait for compaction priorities: $0", expected));
+  };
+
+  for (int i = 0; i != 2; ++i) {
+    ASSERT_OK(Put(Key(i), "value"));
+    ASSERT_OK(Flush());
+  }
+  // The only task of the DB, 2 SST files are far from the write stall trigger.
+  ASSERT_OK(wait_priorities({kSmallCompactionExtraPriority}));
+
+  for (int i = 2; i != 4; ++i) {
+    ASSERT_OK(Put(Key(i), "value"));
+    ASSERT_OK(Flush());
+  }
+  // 4 SST files are within the margin of the write stall trigger, so both tasks get write stall
+  // prevention priority. The second task is penalized for the first one that is not complete.
+  ASSERT_OK(wait_priorities({
+      kWriteStallPreventionPriority + kSmallCompactionExtraPriority,
+      kWriteStallPreventionPriority + kSmallCompactionExtraPriority - kPenaltyPerPendingTask}));
+
+  release.CountDown();
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_OK(wait_priorities({}));
+  for (int i = 0; i != 4; ++i) {
+    ASSERT_EQ("value", Get(Key(i)));
+  }
+
+  Close();
+  pool.Shutdown();
+}
+
 TEST_F(DBCompactionTest, ZeroSeqIdCompaction) {
   Options options;
   options.compaction_style = kCompactionStyleLevel;
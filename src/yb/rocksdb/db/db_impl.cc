@@ -156,6 +156,21 @@ DEFINE_int32(compaction_priority_step_size, 5,
 DEFINE_int32(small_compaction_extra_priority, 1,
              "Small compaction will get small_compaction_extra_priority extra priority.");
 
+DEFINE_int32(compaction_priority_penalty_per_pending_task, 1,
+             "Compaction task loses this much priority for every other compaction task of the "
+             "same DB that was scheduled before it and is not complete yet. So a DB with many "
+             "compactions does not starve compactions of other DBs.");
+TAG_FLAG(compaction_priority_penalty_per_pending_task, runtime);
+TAG_FLAG(compaction_priority_penalty_per_pending_task, advanced);
+
+DEFINE_int32(compaction_priority_write_stall_margin, 4,
+             "Compaction task of DB whose number of files is within this margin of the point "
+             "where writes are throttled gets write stall prevention priority, that is higher "
+             "than priority of regular compactions, so they are paused in favor of it. For "
+             "tablets this point is sst_files_soft_limit. Negative value disables it.");
+TAG_FLAG(compaction_priority_write_stall_margin, runtime);
+TAG_FLAG(compaction_priority_write_stall_margin, advanced);
+
 DEFINE_bool(rocksdb_use_logging_iterator, false,
             "Wrap newly created RocksDB iterators in a logging wrapper");
 
@@ -245,24 +260,28 @@ class DBImpl::ThreadPoolTask : public yb::PriorityThreadPoolTask {
 
 constexpr int kShuttingDownPriority = 200;
 constexpr int kFlushPriority = 100;
+constexpr int kWriteStallPreventionPriority = 50;
 
 class DBImpl::CompactionTask : public ThreadPoolTask {
  public:
   CompactionTask(DBImpl* db_impl, DBImpl::ManualCompaction* manual_compaction)
       : ThreadPoolTask(db_impl), manual_compaction_(manual_compaction),
-        compaction_(manual_compaction->compaction.get()), priority_(CalcPriority()) {
+        compaction_(manual_compaction->compaction.get()), priority_(CalcPriority()),
+        input_files_(NumInputFiles()), input_size_(compaction_->CalculateTotalInputSize()) {
     db_impl->mutex_.AssertHeld();
   }
 
   CompactionTask(DBImpl* db_impl, std::unique_ptr<Compaction> compaction)
       : ThreadPoolTask(db_impl), manual_compaction_(nullptr),
         compaction_holder_(std::move(compaction)), compaction_(compaction_holder_.get()),
-        priority_(CalcPriority()) {
+        priority_(CalcPriority()), input_files_(NumInputFiles()),
+        input_size_(compaction_->CalculateTotalInputSize()) {
     db_impl->mutex_.AssertHeld();
   }
 
   void DoRun(yb::PriorityThreadPoolSuspender* suspender) override {
     compaction_->SetSuspender(suspender);
+    compaction_->SetProgressCounter(&processed_input_bytes_);
     db_impl_->BackgroundCallCompaction(manual_compaction_, std::move(compaction_holder_), this);
   }
 
@@ -284,7 +303,15 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
   }
 
   std::string ToString() const override {
-    return yb::Format("{ compact db: $0 }", db_impl_->GetName());
+    return yb::Format(
+        "{ compact db: $0 manual: $1 input_files: $2 input_size: $3 }",
+        db_impl_->GetName(), manual_compaction_ != nullptr, input_files_, input_size_);
+  }
+
+  std::string ProgressToString() const override {
+    return yb::Format(
+        "$0 raw input bytes processed",
+        processed_input_bytes_.load(std::memory_order_relaxed));
   }
 
   bool UpdatePriority() override {
@@ -320,11 +347,14 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
       return kShuttingDownPriority;
     }
 
-    auto* current_version = compaction_->column_family_data()->GetSuperVersion()->current;
-    auto num_files = current_version->storage_info()->l0_delay_trigger_count();
+    auto* storage_info =
+        compaction_->column_family_data()->GetSuperVersion()->current->storage_info();
+    auto num_files = storage_info->l0_delay_trigger_count();
 
     int result = 0;
-    if (num_files >= FLAGS_compaction_priority_start_bound) {
+    if (IsCloseToWriteStall(*storage_info)) {
+      result = kWriteStallPreventionPriority;
+    } else if (num_files >= FLAGS_compaction_priority_start_bound) {
       result =
           1 +
           (num_files - FLAGS_compaction_priority_start_bound) / FLAGS_compaction_priority_step_size;
@@ -334,6 +364,51 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
       result += FLAGS_small_compaction_extra_priority;
     }
 
+    // Priority should not be negative, since it is compared with priority of empty queue in
+    // priority thread pool.
+    return std::max(
+        result - FLAGS_compaction_priority_penalty_per_pending_task * NumPrecedingTasks(), 0);
+  }
+
+  // Whether number of files of DB is within compaction_priority_write_stall_margin of the point
+  // where writes are throttled. Inside RocksDB it is level0_slowdown_writes_trigger, while YB
+  // disables it and throttles writes by number of SST files, see sst_files_write_stall_trigger.
+  bool IsCloseToWriteStall(const VersionStorageInfo& storage_info) const {
+    const int margin = FLAGS_compaction_priority_write_stall_margin;
+    if (margin < 0) {
+      return false;
+    }
+    auto slowdown_trigger = compaction_->mutable_cf_options()->level0_slowdown_writes_trigger;
+    if (slowdown_trigger > 0 &&
+        storage_info.l0_delay_trigger_count() + margin >= slowdown_trigger) {
+      return true;
+    }
+    const auto& sst_files_trigger = db_impl_->db_options_.sst_files_write_stall_trigger;
+    if (!sst_files_trigger) {
+      return false;
+    }
+    auto num_sst_files_limit = (*sst_files_trigger)();
+    return num_sst_files_limit > 0 &&
+           storage_info.NumFiles() + static_cast<uint64_t>(margin) >= num_sst_files_limit;
+  }
+
+  // Returns number of incomplete compaction tasks of the same DB, that were scheduled before
+  // this one.
+  int NumPrecedingTasks() const {
+    int result = 0;
+    for (auto* task : db_impl_->compaction_tasks_) {
+      if (task->SerialNo() < SerialNo() && task->compaction_ != nullptr) {
+        ++result;
+      }
+    }
+    return result;
+  }
+
+  size_t NumInputFiles() const {
+    size_t result = 0;
+    for (size_t i = 0; i != compaction_->num_input_levels(); ++i) {
+      result += compaction_->num_input_files(i);
+    }
     return result;
   }
 
@@ -342,6 +417,9 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
   std::unique_ptr<Compaction> compaction_holder_;
   Compaction* compaction_;
   int priority_;
+  const size_t input_files_;
+  const uint64_t input_size_;
+  std::atomic<uint64_t> processed_input_bytes_{0};
 };
 
 class DBImpl::FlushTask : public ThreadPoolTask {
@@ -466,7 +544,7 @@ DBOptions SanitizeOptions(const std::string& dbname, const DBOptions& src) {
   result.env->IncBackgroundThreadsIfNeeded(
       src.max_background_flushes, Env::Priority::HIGH);
 
-  if (result.rate_limiter.get() != nullptr) {
+  if (result.rate_limiter.get() != nullptr || result.flush_rate_limiter.get() != nullptr) {
     if (result.bytes_per_sync == 0) {
       result.bytes_per_sync = 1024 * 1024;
     }
@@ -488,7 +566,7 @@ DBOptions SanitizeOptions(const std::string& dbname, const DBOptions& src) {
     result.db_paths.emplace_back(dbname, std::numeric_limits<uint64_t>::max());
   }
 
-  if (result.compaction_readahead_size > 0) {
+  if (result.compaction_readahead_size > 0 || result.use_direct_io_for_compaction) {
     result.new_table_reader_for_compaction_inputs = true;
   }
 
@@ -1781,7 +1859,7 @@ Status DBImpl::WriteLevel0TableForRecovery(int job_id, ColumnFamilyData* cfd,
         s = BuildTable(dbname_,
                        env_,
                        *cfd->ioptions(),
-                       env_options_,
+                       env_->OptimizeForFlushTableWrite(env_options_, db_options_),
                        cfd->table_cache(),
                        iter.get(),
                        &meta,
@@ -1951,7 +2029,29 @@ void DBImpl::SetSSTFileTickers() {
         stats_, CURRENT_VERSION_SST_FILES_UNCOMPRESSED_SIZE, uncompressed_sst_files_size);
     auto num_sst_files = GetCurrentVersionNumSSTFiles();
     SetTickerCount(stats_, CURRENT_VERSION_NUM_SST_FILES, num_sst_files);
+    SetSSTFileTierTickers(sst_files_size);
+  }
+}
+
+void DBImpl::SetSSTFileTierTickers(uint64_t sst_files_size) {
+  if (db_options_.db_paths.size() <= 1) {
+    SetTickerCount(stats_, CURRENT_VERSION_SST_FILES_SIZE_FAST_TIER, sst_files_size);
+    SetTickerCount(stats_, CURRENT_VERSION_SST_FILES_SIZE_SLOW_TIER, 0);
+    return;
+  }
+  std::vector<rocksdb::LiveFileMetaData> file_metadata;
+  GetLiveFilesMetaData(&file_metadata);
+  uint64_t fast_tier_size = 0;
+  uint64_t slow_tier_size = 0;
+  for (const auto& meta : file_metadata) {
+    if (meta.db_path == db_options_.db_paths[0].path) {
+      fast_tier_size += meta.total_size;
+    } else {
+      slow_tier_size += meta.total_size;
+    }
   }
+  SetTickerCount(stats_, CURRENT_VERSION_SST_FILES_SIZE_FAST_TIER, fast_tier_size);
+  SetTickerCount(stats_, CURRENT_VERSION_SST_FILES_SIZE_SLOW_TIER, slow_tier_size);
 }
 
 uint64_t DBImpl::GetCurrentVersionDataSstFilesSize() {
@@ -3497,8 +3597,8 @@ Result<FileNumbersHolder> DBImpl::BackgroundCompaction(
     // file if there is alive snapshot pointing to it
     assert(c->num_input_files(1) == 0);
     assert(c->level() == 0);
-    assert(c->column_family_data()->ioptions()->compaction_style ==
-           kCompactionStyleFIFO);
+    assert(c->column_family_data()->ioptions()->compaction_style == kCompactionStyleFIFO ||
+           c->column_family_data()->ioptions()->compaction_style == kCompactionStyleUniversal);
 
     compaction_job_stats.num_input_files = c->num_input_files(0);
 
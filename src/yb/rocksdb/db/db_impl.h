@@ -641,6 +641,9 @@ class DBImpl : public DB {
   // Updates stats_ object with SST files size metrics.
   void SetSSTFileTickers();
 
+  // Updates stats_ object with size of SST files placed to the first and the other db_paths.
+  void SetSSTFileTierTickers(uint64_t sst_files_size);
+
   void PrintStatistics();
 
   // dump rocksdb.stats to LOG
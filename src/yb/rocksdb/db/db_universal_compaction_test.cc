@@ -25,6 +25,7 @@
 #include "yb/rocksdb/port/stack_trace.h"
 #if !defined(ROCKSDB_LITE)
 #include "yb/rocksdb/util/sync_point.h"
+#include "yb/rocksdb/utilities/checkpoint.h"
 
 namespace rocksdb {
 
@@ -1417,6 +1418,123 @@ TEST_F(DBTestUniversalCompaction, DontDeleteOutput) {
   purge_thread.join();
 }
 
+TEST_F(DBTestUniversalCompaction, CompactionOutputPathSelector) {
+  constexpr int kNumFiles = 3;
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.level0_file_num_compaction_trigger = kNumFiles + 1;
+  options.statistics = rocksdb::CreateDBStatistics();
+  options.db_paths.emplace_back(dbname_, std::numeric_limits<uint64_t>::max());
+  options.db_paths.emplace_back(dbname_ + "_slow", std::numeric_limits<uint64_t>::max());
+  std::atomic<int> num_selector_calls(0);
+  options.compaction_output_path_selector = std::make_shared<CompactionOutputPathSelector>(
+      [&num_selector_calls](const UserFrontier* largest) -> uint32_t {
+        // Files written by this test don't have user frontiers.
+        EXPECT_EQ(largest, nullptr);
+        ++num_selector_calls;
+        // Should be capped by the last path.
+        return 10;
+      });
+  Destroy(options);
+  DestroyAndReopen(options);
+
+  for (int i = 0; i != kNumFiles; ++i) {
+    ASSERT_OK(Put(Key(i), "value"));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(kNumFiles, GetSstFileCount(dbname_));
+  ASSERT_EQ(0, num_selector_calls.load());
+  ASSERT_EQ(0, TestGetTickerCount(options, CURRENT_VERSION_SST_FILES_SIZE_SLOW_TIER));
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_GT(num_selector_calls.load(), 0);
+  ASSERT_EQ(0, GetSstFileCount(dbname_));
+  ASSERT_EQ(1, GetSstFileCount(options.db_paths[1].path));
+  ASSERT_EQ(0, TestGetTickerCount(options, CURRENT_VERSION_SST_FILES_SIZE_FAST_TIER));
+  ASSERT_GT(TestGetTickerCount(options, CURRENT_VERSION_SST_FILES_SIZE_SLOW_TIER), 0);
+
+  // Move table files to the first path, as they are placed by checkpoint. Paths of such files
+  // should be resolved during DB open.
+  Close();
+  std::vector<std::string> files;
+  ASSERT_OK(env_->GetChildren(options.db_paths[1].path, &files));
+  for (const auto& file : files) {
+    uint64_t number;
+    FileType type;
+    if (ParseFileName(file, &number, &type) &&
+        (type == kTableFile || type == kTableSBlockFile)) {
+      ASSERT_OK(env_->RenameFile(
+          options.db_paths[1].path + "/" + file, dbname_ + "/" + file));
+    }
+  }
+  Reopen(options);
+  ASSERT_EQ(1, TotalLiveFiles());
+  ASSERT_EQ(1, GetSstFileCount(dbname_));
+  for (int i = 0; i != kNumFiles; ++i) {
+    ASSERT_EQ("value", Get(Key(i)));
+  }
+}
+
+// Checkpoint layout is flat, so table files of the slow path are placed to the first (fast) path
+// of the DB opened from the checkpoint. They are moved to the slow path by the next compaction.
+TEST_F(DBTestUniversalCompaction, CheckpointOfSlowPathFiles) {
+  constexpr int kNumFiles = 3;
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.level0_file_num_compaction_trigger = kNumFiles + 1;
+  options.db_paths.emplace_back(dbname_, std::numeric_limits<uint64_t>::max());
+  options.db_paths.emplace_back(dbname_ + "_slow", std::numeric_limits<uint64_t>::max());
+  options.compaction_output_path_selector = std::make_shared<CompactionOutputPathSelector>(
+      [](const UserFrontier* largest) -> uint32_t {
+        return 1;
+      });
+  Destroy(options);
+  DestroyAndReopen(options);
+
+  for (int i = 0; i != kNumFiles; ++i) {
+    ASSERT_OK(Put(Key(i), "value"));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(0, GetSstFileCount(dbname_));
+  ASSERT_EQ(1, GetSstFileCount(options.db_paths[1].path));
+
+  const std::string checkpoint_dir = dbname_ + "_checkpoint";
+  const std::string checkpoint_slow_dir = checkpoint_dir + "_slow";
+  Options checkpoint_options = options;
+  checkpoint_options.create_if_missing = false;
+  checkpoint_options.db_paths = {
+      DbPath(checkpoint_dir, std::numeric_limits<uint64_t>::max()),
+      DbPath(checkpoint_slow_dir, std::numeric_limits<uint64_t>::max())};
+  ASSERT_OK(DestroyDB(checkpoint_dir, checkpoint_options));
+  ASSERT_OK(checkpoint::CreateCheckpoint(db_, checkpoint_dir));
+  ASSERT_EQ(1, GetSstFileCount(checkpoint_dir));
+
+  DB* checkpoint_db = nullptr;
+  ASSERT_OK(DB::Open(checkpoint_options, checkpoint_dir, &checkpoint_db));
+  std::unique_ptr<DB> checkpoint_db_holder(checkpoint_db);
+  ASSERT_EQ(1, GetSstFileCount(checkpoint_dir));
+  ASSERT_EQ(0, GetSstFileCount(checkpoint_slow_dir));
+  for (int i = 0; i != kNumFiles; ++i) {
+    std::string value;
+    ASSERT_OK(checkpoint_db->Get(ReadOptions(), Key(i), &value));
+    ASSERT_EQ("value", value);
+  }
+
+  ASSERT_OK(checkpoint_db->Put(WriteOptions(), Key(kNumFiles), "value"));
+  ASSERT_OK(checkpoint_db->Flush(FlushOptions()));
+  ASSERT_OK(checkpoint_db->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(0, GetSstFileCount(checkpoint_dir));
+  ASSERT_EQ(1, GetSstFileCount(checkpoint_slow_dir));
+
+  checkpoint_db_holder.reset();
+  ASSERT_OK(DestroyDB(checkpoint_dir, checkpoint_options));
+}
+
 TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   const auto value_size = 10_KB;
   Options options;
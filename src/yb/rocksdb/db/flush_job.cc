@@ -100,7 +100,7 @@ FlushJob::FlushJob(const std::string& dbname, ColumnFamilyData* cfd,
       cfd_(cfd),
       db_options_(db_options),
       mutable_cf_options_(mutable_cf_options),
-      env_options_(env_options),
+      env_options_(db_options.env->OptimizeForFlushTableWrite(env_options, db_options)),
       versions_(versions),
       db_mutex_(db_mutex),
       shutting_down_(shutting_down),
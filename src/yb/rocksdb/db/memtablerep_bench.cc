@@ -79,11 +79,13 @@ DEFINE_string(memtablerep, "skiplist",
               "\tskiplist            -- backed by a skiplist\n"
               "\tvector              -- backed by an std::vector\n"
               "\thashskiplist        -- backed by a hash skip list\n"
-              "\thashlinklist        -- backed by a hash linked list\n");
+              "\thashlinklist        -- backed by a hash linked list\n"
+              "\tprefixhashindex     -- backed by a skiplist with a prefix hash "
+              "index\n");
 
 DEFINE_int64(bucket_count, 1000000,
-             "bucket_count parameter to pass into NewHashSkiplistRepFactory or "
-             "NewHashLinkListRepFactory");
+             "bucket_count parameter to pass into NewHashSkiplistRepFactory, "
+             "NewHashLinkListRepFactory or NewPrefixHashIndexRepFactory");
 
 DEFINE_int32(
     hashskiplist_height, 4,
@@ -608,6 +610,11 @@ int main(int argc, char** argv) {
         FLAGS_if_log_bucket_dist_when_flash, FLAGS_threshold_use_skiplist));
     options.prefix_extractor.reset(
         rocksdb::NewFixedPrefixTransform(FLAGS_prefix_length));
+  } else if (FLAGS_memtablerep == "prefixhashindex") {
+    factory.reset(rocksdb::NewPrefixHashIndexRepFactory(
+        std::shared_ptr<const rocksdb::SliceTransform>(
+            rocksdb::NewFixedPrefixTransform(FLAGS_prefix_length)),
+        FLAGS_bucket_count));
   } else {
     fprintf(stdout, "Unknown memtablerep: %s\n", FLAGS_memtablerep.c_str());
     exit(1);
@@ -217,6 +217,10 @@ class PrefixTest : public testing::Test {
           options.memtable_factory.reset(
               NewHashLinkListRepFactory(bucket_count, 0, 3));
           return true;
+        case kPrefixHashIndex:
+          options.memtable_factory.reset(NewPrefixHashIndexRepFactory(
+              std::shared_ptr<const SliceTransform>(NewFixedPrefixTransform(8)), bucket_count));
+          return true;
         default:
           return false;
       }
@@ -237,6 +241,7 @@ class PrefixTest : public testing::Test {
     kHashLinkList,
     kHashLinkListHugePageTlb,
     kHashLinkListTriggerSkipList,
+    kPrefixHashIndex,
     kEnd
   };
   int option_config_;
@@ -122,6 +122,10 @@ class SkipListBase {
     // Final state of iterator is Valid() iff list is not empty.
     void SeekToLast();
 
+    // Position at the entry with the specified key, that was inserted into this list.
+    // Available only for lists that store keys inside nodes.
+    void SeekToKey(Key key);
+
    private:
     const SkipListBase* list_;
     Node* node_;
@@ -320,6 +324,11 @@ void SkipListBase<Key, Comparator, NodeType>::Iterator::SeekToFirst() {
   node_ = list_->head_->Next(0);
 }
 
+template<class Key, class Comparator, class NodeType>
+void SkipListBase<Key, Comparator, NodeType>::Iterator::SeekToKey(Key key) {
+  node_ = NodeType::FromKey(key);
+}
+
 template<class Key, class Comparator, class NodeType>
 void SkipListBase<Key, Comparator, NodeType>::Iterator::SeekToLast() {
   node_ = list_->FindLast();
@@ -616,6 +625,11 @@ struct SingleWriterInlineSkipListNode {
   static SingleWriterInlineSkipListNode* CreateHead(Allocator* allocator, int height) {
     return Create(allocator, 0 /* key_size */, height);
   }
+
+  static SingleWriterInlineSkipListNode* FromKey(const char* key) {
+    return reinterpret_cast<SingleWriterInlineSkipListNode*>(
+        const_cast<char*>(key) - offsetof(SingleWriterInlineSkipListNode, key));
+  }
 };
 
 // Skip list designed for using variable size byte arrays as a key.
@@ -640,8 +654,7 @@ class SingleWriterInlineSkipList :
 
   void Insert(const char* key) {
     Base::PrepareInsert(key);
-    auto node = reinterpret_cast<SingleWriterInlineSkipListNode*>(
-        const_cast<char*>(key) - offsetof(SingleWriterInlineSkipListNode, key));
+    auto node = SingleWriterInlineSkipListNode::FromKey(key);
     Base::CompleteInsert(node, node->UnstashHeight());
   }
 
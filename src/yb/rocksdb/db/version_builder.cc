@@ -38,6 +38,7 @@
 #include <vector>
 
 #include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/db/internal_stats.h"
 #include "yb/rocksdb/db/table_cache.h"
 #include "yb/rocksdb/db/version_set.h"
@@ -345,6 +346,31 @@ class VersionBuilder::Rep {
     }
   }
 
+  // Files could be placed to a path different from the one recorded in the MANIFEST, when they
+  // were copied to a single directory, e.g. by checkpoint or remote bootstrap, or when db_paths
+  // was reconfigured. Updated path ids are persisted with the next MANIFEST snapshot.
+  void ResolveFilePaths(Env* env, const std::vector<DbPath>& db_paths) {
+    for (int level = 0; level < base_vstorage_->num_levels(); level++) {
+      for (auto& file_meta_pair : levels_[level].added_files) {
+        auto& fd = file_meta_pair.second->fd;
+        const auto number = fd.GetNumber();
+        if (env->FileExists(TableFileName(db_paths, number, fd.GetPathId())).ok()) {
+          continue;
+        }
+        for (uint32_t path_id = 0; path_id < db_paths.size(); ++path_id) {
+          if (path_id != fd.GetPathId() &&
+              env->FileExists(TableFileName(db_paths, number, path_id)).ok()) {
+            RLOG(InfoLogLevel::INFO_LEVEL, info_log_,
+                 "Table file %" PRIu64 " found at path %" PRIu32 " instead of %" PRIu32,
+                 number, path_id, fd.GetPathId());
+            fd.packed_number_and_path_id = PackFileNumberAndPathId(number, path_id);
+            break;
+          }
+        }
+      }
+    }
+  }
+
   void MaybeAddFile(VersionStorageInfo* vstorage, int level, FileMetaData* f) {
     if (levels_[level].deleted_files.count(f->fd.GetNumber()) > 0) {
       // f is to-be-delected table file
@@ -376,6 +402,9 @@ void VersionBuilder::LoadTableHandlers(InternalStats* internal_stats,
                                        int max_threads) {
   rep_->LoadTableHandlers(internal_stats, max_threads);
 }
+void VersionBuilder::ResolveFilePaths(Env* env, const std::vector<DbPath>& db_paths) {
+  rep_->ResolveFilePaths(env, db_paths);
+}
 void VersionBuilder::MaybeAddFile(VersionStorageInfo* vstorage, int level,
                                   FileMetaData* f) {
   rep_->MaybeAddFile(vstorage, level, f);
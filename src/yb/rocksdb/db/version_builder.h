@@ -26,10 +26,13 @@
 #define YB_ROCKSDB_DB_VERSION_BUILDER_H
 
 #pragma once
+#include <vector>
+
 #include "yb/rocksdb/env.h"
 
 namespace rocksdb {
 
+struct DbPath;
 class TableCache;
 class VersionStorageInfo;
 class VersionEdit;
@@ -50,6 +53,9 @@ class VersionBuilder {
   void Apply(VersionEdit* edit);
   void SaveTo(VersionStorageInfo* vstorage);
   void LoadTableHandlers(InternalStats* internal_stats, int max_threads = 1);
+  // Updates path ids of added files that are missing at their recorded path, but present at
+  // another path from db_paths.
+  void ResolveFilePaths(Env* env, const std::vector<DbPath>& db_paths);
   void MaybeAddFile(VersionStorageInfo* vstorage, int level, FileMetaData* f);
 
  private:
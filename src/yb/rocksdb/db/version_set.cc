@@ -2110,7 +2110,8 @@ VersionSet::VersionSet(const std::string& dbname, const DBOptions* db_options,
       dbname_(dbname),
       db_options_(db_options),
       env_options_(storage_options),
-      env_options_compactions_(env_options_) {}
+      env_options_compactions_(
+          db_options->env->OptimizeForCompactionTableRead(env_options_, *db_options)) {}
 
 VersionSet::~VersionSet() {
   // we need to delete column_family_set_ because its destructor depends on
@@ -2802,6 +2803,10 @@ Status VersionSet::Recover(
       assert(builders_iter != builders.end());
       auto* builder = builders_iter->second->version_builder();
 
+      if (cfd->ioptions()->db_paths.size() > 1) {
+        builder->ResolveFilePaths(db_options_->env, cfd->ioptions()->db_paths);
+      }
+
       if (db_options_->max_open_files == -1) {
         // unlimited table cache. Pre-load table handle now.
         // Need to do it out of the mutex.
@@ -133,6 +133,12 @@ struct EnvOptions : public yb::FileSystemOptions {
 
   // If not nullptr, write rate limiting is enabled for flush and compaction
   RateLimiter* rate_limiter = nullptr;
+
+  // If true, then random access files are opened with O_DIRECT, so reads bypass OS page cache.
+  bool use_direct_reads = false;
+
+  // If true, then writable files are opened with O_DIRECT, so writes bypass OS page cache.
+  bool use_direct_writes = false;
 };
 
 // RocksDBFileFactory is the implementation of all NewxxxFile Env methods as well as any methods
@@ -460,6 +466,18 @@ class Env {
   // files. Default implementation returns the copy of the same object.
   virtual EnvOptions OptimizeForManifestWrite(const EnvOptions& env_options)
       const;
+  // OptimizeForCompactionTableWrite will create a new EnvOptions object that is a copy of the
+  // EnvOptions in the parameters, but is optimized for writing table files by compaction.
+  virtual EnvOptions OptimizeForCompactionTableWrite(const EnvOptions& env_options,
+                                                     const DBOptions& db_options) const;
+  // OptimizeForCompactionTableRead will create a new EnvOptions object that is a copy of the
+  // EnvOptions in the parameters, but is optimized for reading table files by compaction.
+  virtual EnvOptions OptimizeForCompactionTableRead(const EnvOptions& env_options,
+                                                    const DBOptions& db_options) const;
+  // OptimizeForFlushTableWrite will create a new EnvOptions object that is a copy of the
+  // EnvOptions in the parameters, but is optimized for writing table files by flush.
+  virtual EnvOptions OptimizeForFlushTableWrite(const EnvOptions& env_options,
+                                                const DBOptions& db_options) const;
 
   // Returns the status of all threads that belong to the current Env.
   virtual Status GetThreadList(std::vector<ThreadStatus>* thread_list) {
@@ -1017,6 +1035,11 @@ class WritableFileWrapper : public WritableFile {
  public:
   explicit WritableFileWrapper(std::unique_ptr<WritableFile> t) : target_(std::move(t)) { }
 
+  bool UseOSBuffer() const override { return target_->UseOSBuffer(); }
+  size_t GetRequiredBufferAlignment() const override {
+    return target_->GetRequiredBufferAlignment();
+  }
+  bool UseDirectIO() const override { return target_->UseDirectIO(); }
   Status Append(const Slice& data) override { return target_->Append(data); }
   Status PositionedAppend(const Slice& data, uint64_t offset) override {
     return target_->PositionedAppend(data, offset);
@@ -215,6 +215,24 @@ extern const FilterPolicy* NewBloomFilterPolicy(int bits_per_key,
 extern const FilterPolicy* NewFixedSizeFilterPolicy(uint32_t total_bits,
                                                     double error_rate,
                                                     Logger* logger);
+
+// Same as NewFixedSizeFilterPolicy, but uses blocked Bloom filter: all bits of a key are located in
+// a single 64-byte line, so each probe touches exactly one cache line and checks the whole line at
+// once. Uses a bit more memory than NewFixedSizeFilterPolicy for the same error rate.
+extern const FilterPolicy* NewFixedSizeBlockedBloomFilterPolicy(uint32_t total_bits,
+                                                                double error_rate,
+                                                                Logger* logger);
+
+// Same as NewFixedSizeFilterPolicy, but uses Ribbon filter, that stores more keys in the same
+// number of bits than Bloom filter for the same error rate, at the cost of slower filter
+// construction. Actual error rate is the nearest power of 2 not greater than error_rate.
+extern const FilterPolicy* NewFixedSizeRibbonFilterPolicy(uint32_t total_bits,
+                                                          double error_rate,
+                                                          Logger* logger);
+
+// Returns number of Ribbon filters built by this process that match any key, because banding
+// failed for all seeds.
+extern uint64_t NumFixedSizeRibbonFilterFallbacks();
 }  // namespace rocksdb
 
 #endif  // YB_ROCKSDB_FILTER_POLICY_H
@@ -74,6 +74,8 @@ enum class CompactionReason {
   kManualCompaction,
   // DB::SuggestCompactRange() marked files for compaction
   kFilesMarkedForCompaction,
+  // [Universal] all entries of the oldest files have expired
+  kUniversalExpiredFiles,
 };
 
 #ifndef ROCKSDB_LITE
@@ -0,0 +1,272 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/memtable/prefix_hash_index_rep.h"
+
+#include <atomic>
+
+#include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/db/skiplist.h"
+#include "yb/rocksdb/util/arena.h"
+#include "yb/rocksdb/util/hash.h"
+
+namespace rocksdb {
+namespace {
+
+// Max number of entries that are checked starting from the first entry with the target prefix,
+// before falling back to a regular skip list search.
+constexpr size_t kMaxPrefixWalk = 16;
+
+constexpr size_t kMinBucketCount = 16;
+
+// Skip list with an additional hash index, that maps key prefix to the first entry with this
+// prefix.
+//
+// All entries with the same prefix are adjacent in the skip list. So when the target of a search
+// has a prefix that is present in the index, and the first entry with this prefix is not less than
+// the target, this entry is the result of the search. Otherwise the result is found by a short walk
+// from the first entry with this prefix, or by a regular skip list search when the walk is too
+// long. Targets with unknown prefix are searched in the skip list.
+//
+// Like the skip list, the index supports a single writer and concurrent readers. It is grown by
+// building a twice larger table, while readers could still use the old one.
+// Memory of the index is taken from the memtable allocator, so it is accounted with the memtable.
+class PrefixHashIndexRep : public MemTableRep {
+ public:
+  PrefixHashIndexRep(
+      const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator,
+      const SliceTransform* prefix_extractor, size_t initial_bucket_count)
+      : MemTableRep(allocator), skip_list_(compare, allocator), cmp_(compare),
+        prefix_extractor_(prefix_extractor) {
+    size_t bucket_count = kMinBucketCount;
+    while (bucket_count < initial_bucket_count) {
+      bucket_count <<= 1;
+    }
+    table_.store(NewTable(bucket_count), std::memory_order_release);
+  }
+
+  KeyHandle Allocate(const size_t len, char** buf) override {
+    *buf = skip_list_.AllocateKey(len);
+    return static_cast<KeyHandle>(*buf);
+  }
+
+  void Insert(KeyHandle handle) override {
+    const char* key = static_cast<char*>(handle);
+    skip_list_.Insert(key);
+    auto prefix = Prefix(UserKey(key));
+    if (!prefix.empty()) {
+      UpdateIndex(prefix, key);
+    }
+  }
+
+  bool Contains(const char* key) const override {
+    return skip_list_.Contains(key);
+  }
+
+  size_t ApproximateMemoryUsage() override {
+    // All memory is allocated through allocator; nothing to report here
+    return 0;
+  }
+
+  void Get(const LookupKey& k, void* callback_args,
+           bool (*callback_func)(void* arg, const char* entry)) override {
+    SkipList::Iterator iter(&skip_list_);
+    for (Seek(k.internal_key(), k.memtable_key().cdata(), &iter);
+         iter.Valid() && callback_func(callback_args, iter.key());
+         iter.Next()) {
+    }
+  }
+
+  uint64_t ApproximateNumEntries(const Slice& start_ikey, const Slice& end_ikey) override {
+    std::string tmp;
+    uint64_t start_count = skip_list_.EstimateCount(EncodeKey(&tmp, start_ikey));
+    uint64_t end_count = skip_list_.EstimateCount(EncodeKey(&tmp, end_ikey));
+    return (end_count >= start_count) ? (end_count - start_count) : 0;
+  }
+
+  MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override {
+    void* mem = arena ? arena->AllocateAligned(sizeof(PrefixHashIndexRep::Iterator))
+                      : operator new(sizeof(PrefixHashIndexRep::Iterator));
+    return new (mem) PrefixHashIndexRep::Iterator(*this);
+  }
+
+ private:
+  typedef SingleWriterInlineSkipList<const MemTableRep::KeyComparator&> SkipList;
+
+  struct Entry {
+    Entry(Slice prefix_, uint32_t hash_, const char* first_key_, Entry* next_)
+        : prefix(prefix_), hash(hash_), first_key(first_key_), next(next_) {}
+
+    // Points to the key of the entry that was first inserted with this prefix.
+    const Slice prefix;
+    const uint32_t hash;
+    std::atomic<const char*> first_key;
+    // Immutable after entry is published.
+    Entry* const next;
+  };
+
+  struct Table {
+    size_t mask;
+    std::atomic<Entry*>* buckets;
+  };
+
+  class Iterator : public MemTableRep::Iterator {
+   public:
+    explicit Iterator(const PrefixHashIndexRep& rep) : rep_(rep), iter_(&rep.skip_list_) {}
+
+    bool Valid() const override {
+      return iter_.Valid();
+    }
+
+    const char* key() const override {
+      return iter_.key();
+    }
+
+    void Next() override {
+      iter_.Next();
+    }
+
+    void Prev() override {
+      iter_.Prev();
+    }
+
+    void Seek(const Slice& internal_key, const char* memtable_key) override {
+      rep_.Seek(
+          internal_key, memtable_key ? memtable_key : EncodeKey(&tmp_, internal_key), &iter_);
+    }
+
+    void SeekToFirst() override {
+      iter_.SeekToFirst();
+    }
+
+    void SeekToLast() override {
+      iter_.SeekToLast();
+    }
+
+   private:
+    const PrefixHashIndexRep& rep_;
+    SkipList::Iterator iter_;
+    std::string tmp_;       // For passing to EncodeKey
+  };
+
+  // Returns empty slice for keys that should not be indexed.
+  Slice Prefix(const Slice& user_key) const {
+    return prefix_extractor_->InDomain(user_key) ? prefix_extractor_->Transform(user_key)
+                                                 : Slice();
+  }
+
+  // Positions iter at the first entry that is not less than memtable_key.
+  void Seek(const Slice& internal_key, const char* memtable_key, SkipList::Iterator* iter) const {
+    auto prefix = Prefix(ExtractUserKey(internal_key));
+    const char* first_key = prefix.empty() ? nullptr : FindFirstKey(prefix);
+    if (first_key) {
+      iter->SeekToKey(first_key);
+      for (size_t step = 0; step != kMaxPrefixWalk; ++step) {
+        if (!iter->Valid() || cmp_(iter->key(), memtable_key) >= 0) {
+          return;
+        }
+        iter->Next();
+      }
+    }
+    iter->Seek(memtable_key);
+  }
+
+  const char* FindFirstKey(Slice prefix) const {
+    auto* entry = Find(*table_.load(std::memory_order_acquire), prefix, GetSliceHash(prefix));
+    return entry ? entry->first_key.load(std::memory_order_acquire) : nullptr;
+  }
+
+  static Entry* Find(const Table& table, Slice prefix, uint32_t hash) {
+    for (auto* entry = table.buckets[hash & table.mask].load(std::memory_order_acquire);
+         entry; entry = entry->next) {
+      if (entry->hash == hash && entry->prefix == prefix) {
+        return entry;
+      }
+    }
+    return nullptr;
+  }
+
+  // Index is grown when number of prefixes exceeds number of buckets.
+  void UpdateIndex(Slice prefix, const char* key) {
+    auto hash = GetSliceHash(prefix);
+    // Only writer changes the index, so relaxed loads are enough here.
+    auto* table = table_.load(std::memory_order_relaxed);
+    auto* entry = Find(*table, prefix, hash);
+    if (entry) {
+      if (cmp_(key, entry->first_key.load(std::memory_order_relaxed)) < 0) {
+        entry->first_key.store(key, std::memory_order_release);
+      }
+      return;
+    }
+
+    auto& bucket = table->buckets[hash & table->mask];
+    bucket.store(NewEntry(prefix, hash, key, bucket.load(std::memory_order_relaxed)),
+                 std::memory_order_release);
+    if (++num_prefixes_ > table->mask + 1) {
+      Grow(*table);
+    }
+  }
+
+  void Grow(const Table& old_table) {
+    auto* new_table = NewTable((old_table.mask + 1) << 1);
+    for (size_t i = 0; i <= old_table.mask; ++i) {
+      for (auto* entry = old_table.buckets[i].load(std::memory_order_relaxed); entry;
+           entry = entry->next) {
+        auto& bucket = new_table->buckets[entry->hash & new_table->mask];
+        bucket.store(
+            NewEntry(entry->prefix, entry->hash, entry->first_key.load(std::memory_order_relaxed),
+                     bucket.load(std::memory_order_relaxed)),
+            std::memory_order_relaxed);
+      }
+    }
+    table_.store(new_table, std::memory_order_release);
+  }
+
+  Table* NewTable(size_t bucket_count) {
+    auto* buckets = reinterpret_cast<std::atomic<Entry*>*>(
+        allocator_->AllocateAligned(sizeof(std::atomic<Entry*>) * bucket_count));
+    for (size_t i = 0; i != bucket_count; ++i) {
+      new (&buckets[i]) std::atomic<Entry*>(nullptr);
+    }
+    return new (allocator_->AllocateAligned(sizeof(Table))) Table{bucket_count - 1, buckets};
+  }
+
+  Entry* NewEntry(Slice prefix, uint32_t hash, const char* first_key, Entry* next) {
+    return new (allocator_->AllocateAligned(sizeof(Entry))) Entry(prefix, hash, first_key, next);
+  }
+
+  SkipList skip_list_;
+  const MemTableRep::KeyComparator& cmp_;
+  const SliceTransform* const prefix_extractor_;
+
+  std::atomic<Table*> table_{nullptr};
+  // Number of prefixes in the index, modified only by writer.
+  size_t num_prefixes_ = 0;
+};
+
+} // namespace
+
+MemTableRep* PrefixHashIndexRepFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator,
+    const SliceTransform* transform, Logger* logger) {
+  return new PrefixHashIndexRep(
+      compare, allocator, prefix_extractor_.get(), initial_bucket_count_);
+}
+
+MemTableRepFactory* NewPrefixHashIndexRepFactory(
+    std::shared_ptr<const SliceTransform> prefix_extractor, size_t initial_bucket_count) {
+  return new PrefixHashIndexRepFactory(std::move(prefix_extractor), initial_bucket_count);
+}
+
+} // namespace rocksdb
@@ -0,0 +1,46 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_MEMTABLE_PREFIX_HASH_INDEX_REP_H
+#define YB_ROCKSDB_MEMTABLE_PREFIX_HASH_INDEX_REP_H
+
+#include <memory>
+
+#include "yb/rocksdb/memtablerep.h"
+#include "yb/rocksdb/slice_transform.h"
+
+namespace rocksdb {
+
+class PrefixHashIndexRepFactory : public MemTableRepFactory {
+ public:
+  PrefixHashIndexRepFactory(
+      std::shared_ptr<const SliceTransform> prefix_extractor, size_t initial_bucket_count)
+      : prefix_extractor_(std::move(prefix_extractor)),
+        initial_bucket_count_(initial_bucket_count) {}
+
+  MemTableRep* CreateMemTableRep(
+      const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator,
+      const SliceTransform* transform, Logger* logger) override;
+
+  const char* Name() const override {
+    return "PrefixHashIndexRepFactory";
+  }
+
+ private:
+  const std::shared_ptr<const SliceTransform> prefix_extractor_;
+  const size_t initial_bucket_count_;
+};
+
+} // namespace rocksdb
+
+#endif // YB_ROCKSDB_MEMTABLE_PREFIX_HASH_INDEX_REP_H
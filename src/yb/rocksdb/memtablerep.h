@@ -335,6 +335,16 @@ extern MemTableRepFactory* NewHashLinkListRepFactory(
     bool if_log_bucket_dist_when_flash = true,
     uint32_t threshold_use_skiplist = 256);
 
+// This creates MemTableReps that are backed by a skip list with an additional hash index, that
+// maps key prefix to the first entry with this prefix. Point lookups and seeks to keys with prefix
+// present in the index start from this entry instead of the head of the skip list.
+// Could be used when most lookups target a few entries with the same prefix, for instance the same
+// document in DocDB.
+// @prefix_extractor: extracts prefix from user key, keys with empty prefix are not indexed.
+// @initial_bucket_count: initial number of index buckets, index grows with the number of prefixes.
+extern MemTableRepFactory* NewPrefixHashIndexRepFactory(
+    std::shared_ptr<const SliceTransform> prefix_extractor, size_t initial_bucket_count = 1024);
+
 #endif  // ROCKSDB_LITE
 }  // namespace rocksdb
 
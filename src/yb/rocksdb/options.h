@@ -73,6 +73,7 @@ class SliceTransform;
 class Statistics;
 class InternalIterator;
 class InternalKeyComparator;
+class UserFrontier;
 class WalFilter;
 class MemoryMonitor;
 
@@ -827,6 +828,13 @@ struct ColumnFamilyOptions {
 };
 
 typedef std::function<yb::Result<bool>(const MemTable&)> MemTableFilter;
+
+// Returns index in db_paths where output of compaction should be placed. Receives the largest
+// user frontier of all compaction inputs, or nullptr if some input file does not have it.
+typedef std::function<uint32_t(const UserFrontier* largest)> CompactionOutputPathSelector;
+// Returns number of SST files at which user of DB starts throttling writes to it, 0 if there is no
+// such limit.
+typedef std::function<uint64_t()> SstFilesWriteStallTrigger;
 using IteratorReplacer =
     std::function<InternalIterator*(InternalIterator*, Arena*, const Slice&)>;
 
@@ -882,6 +890,11 @@ struct DBOptions {
   // Default: nullptr
   std::shared_ptr<RateLimiter> rate_limiter;
 
+  // If not nullptr, it is used to control write rate of flush instead of rate_limiter, so flushes
+  // do not share the write budget with compactions.
+  // Default: nullptr
+  std::shared_ptr<RateLimiter> flush_rate_limiter;
+
   // Use to track SST files and control their file deletion rate, can be used
   // among multiple RocksDB instances, sst_file_manager only track and throttle
   // deletes of SST files in first db_path (db_name if db_paths is empty), other
@@ -1174,6 +1187,16 @@ struct DBOptions {
   // Default: 0
   size_t compaction_readahead_size;
 
+  // If true, compaction reads its input files and writes its output files with direct I/O, so
+  // large compactions do not evict pages of other files from OS page cache.
+  // Falls back to buffered I/O when file system does not support direct I/O.
+  //
+  // When true, we also force new_table_reader_for_compaction_inputs to true, so table readers
+  // opened by compaction are never used by other reads.
+  //
+  // Default: false
+  bool use_direct_io_for_compaction;
+
   // This is a maximum buffer size that is used by WinMmapReadableFile in
   // unbuffered disk I/O mode. We need to maintain an aligned buffer for
   // reads. We allow the buffer to grow until the specified value and then
@@ -1347,9 +1370,23 @@ struct DBOptions {
   // Specific mem tracker for block based tables created by this RocksDB instance.
   std::shared_ptr<yb::MemTracker> block_based_table_mem_tracker;
 
+  // Mem tracker for index and filter blocks of block based tables created by this RocksDB
+  // instance. If not set, they are tracked by block_based_table_mem_tracker.
+  std::shared_ptr<yb::MemTracker> block_based_table_metadata_mem_tracker;
+
   // Adds ability to modify iterator created for SST file.
   // For instance some additional filtering could be added.
   std::shared_ptr<IteratorReplacer> iterator_replacer;
+
+  // Overrides path selection for output of universal compactions, when db_paths contains more
+  // than one path. Returned index is capped by the last path. Flush output is always placed to
+  // the first path.
+  std::shared_ptr<CompactionOutputPathSelector> compaction_output_path_selector;
+
+  // Write throttling done outside of RocksDB, based on total number of SST files. Compactions of DB
+  // whose number of SST files is close to it get write stall prevention priority, in the same way
+  // as for level0_slowdown_writes_trigger.
+  std::shared_ptr<SstFilesWriteStallTrigger> sst_files_write_stall_trigger;
 };
 
 // Options to control the behavior of a database (passed to DB::Open)
@@ -187,6 +187,10 @@ enum Tickers : uint32_t {
   CURRENT_VERSION_SST_FILES_SIZE,
   CURRENT_VERSION_SST_FILES_UNCOMPRESSED_SIZE,
   CURRENT_VERSION_NUM_SST_FILES,
+  // Size of the SST files for the current version placed to the first of db_paths (fast tier)
+  // and to the other db_paths (slow tier).
+  CURRENT_VERSION_SST_FILES_SIZE_FAST_TIER,
+  CURRENT_VERSION_SST_FILES_SIZE_SLOW_TIER,
   MERGE_OPERATION_TOTAL_TIME,
   FILTER_OPERATION_TOTAL_TIME,
 
@@ -207,6 +211,15 @@ enum Tickers : uint32_t {
   BLOCK_CACHE_MULTI_TOUCH_BYTES_READ,
   BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE,
 
+  // Readahead of data blocks issued by iterators that read blocks sequentially.
+  // Number of bytes requested to be read ahead.
+  READAHEAD_BYTES_REQUESTED,
+  // Number of data blocks read by iterators from ranges that were read ahead.
+  READAHEAD_BLOCKS_HIT,
+  // Number of read ahead bytes that were not read by the iterator, because it was repositioned
+  // or destroyed.
+  READAHEAD_BYTES_WASTED,
+
   // End of ticker enum.
   TICKER_ENUM_MAX,
 };
@@ -299,6 +312,10 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {CURRENT_VERSION_SST_FILES_UNCOMPRESSED_SIZE, "rocksdb_total_uncompressed_size"},
 
     {CURRENT_VERSION_NUM_SST_FILES, "rocksdb_current_version_num_sst_files"},
+    {CURRENT_VERSION_SST_FILES_SIZE_FAST_TIER,
+          "rocksdb_current_version_sst_files_size_fast_tier"},
+    {CURRENT_VERSION_SST_FILES_SIZE_SLOW_TIER,
+          "rocksdb_current_version_sst_files_size_slow_tier"},
     {MERGE_OPERATION_TOTAL_TIME, "rocksdb_merge_operation_time_nanos"},
     {FILTER_OPERATION_TOTAL_TIME, "rocksdb_filter_operation_time_nanos"},
     {ROW_CACHE_HIT, "rocksdb_row_cache_hit"},
@@ -311,7 +328,10 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {BLOCK_CACHE_MULTI_TOUCH_HIT, "rocksdb_block_cache_multi_touch_hit"},
     {BLOCK_CACHE_MULTI_TOUCH_ADD, "rocksdb_block_cache_multi_touch_add"},
     {BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, "rocksdb_block_cache_multi_touch_bytes_read"},
-    {BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, "rocksdb_block_cache_multi_touch_bytes_write"}
+    {BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, "rocksdb_block_cache_multi_touch_bytes_write"},
+    {READAHEAD_BYTES_REQUESTED, "rocksdb_readahead_bytes_requested"},
+    {READAHEAD_BLOCKS_HIT, "rocksdb_readahead_blocks_hit"},
+    {READAHEAD_BYTES_WASTED, "rocksdb_readahead_bytes_wasted"}
 };
 
 /**
@@ -96,6 +96,11 @@ struct BlockBasedTableOptions {
   // Note: Fixed-size bloom filter data blocks are never pre-loaded.
   bool cache_index_and_filter_blocks = false;
 
+  // If true, top-level data index block is kept by table reader for its whole lifetime, even if
+  // cache_index_and_filter_blocks is set. So lookups never miss the top level of the index.
+  // Lower levels of multi-level index and filter blocks are still read through the cache.
+  bool pin_top_level_index = false;
+
   IndexType index_type = IndexType::kMultiLevelBinarySearch;
 
   // Influence the behavior when kHashSearch is used.
@@ -122,6 +127,11 @@ struct BlockBasedTableOptions {
   // If NULL, rocksdb will not use a compressed block cache.
   std::shared_ptr<Cache> block_cache_compressed = nullptr;
 
+  // If non-NULL use the specified cache for index and filter blocks, instead of block_cache.
+  // So they don't compete with data blocks and are not evicted by scans.
+  // Requires block_cache to be set.
+  std::shared_ptr<Cache> metadata_block_cache = nullptr;
+
   // Approximate size of user data packed per block, in bytes. Note that the
   // block size specified here corresponds to uncompressed data.  The
   // actual size of the unit read from disk may be smaller if
@@ -193,6 +203,14 @@ struct BlockBasedTableOptions {
   // Default: false
   bool skip_table_builder_flush = false;
 
+  // Iterator that reads data blocks of a file sequentially starts reading ahead upcoming blocks in
+  // background. Readahead window starts from initial_auto_readahead_size and doubles on each
+  // readahead up to max_auto_readahead_size. Repositioning iterator to non adjacent block resets
+  // the window.
+  // Readahead is disabled when max_auto_readahead_size is 0.
+  size_t initial_auto_readahead_size = 8_KB;
+  size_t max_auto_readahead_size = 0;
+
   // We currently have three versions:
   // 0 -- This version is currently written out by all RocksDB's versions by
   // default.  Can be read by really old RocksDB's. Doesn't support changing
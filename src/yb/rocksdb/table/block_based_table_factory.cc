@@ -115,6 +115,10 @@ Status BlockBasedTableFactory::SanitizeOptions(
     return STATUS(InvalidArgument, "Enable cache_index_and_filter_blocks, "
         ", but block cache is disabled");
   }
+  if (table_options_.metadata_block_cache && !table_options_.block_cache) {
+    return STATUS(InvalidArgument, "Metadata block cache is specified, "
+        "but block cache is disabled");
+  }
   if (!BlockBasedTableSupportedVersion(table_options_.format_version)) {
     return STATUS(InvalidArgument,
         "Unsupported BlockBasedTable format_version. Please check "
@@ -136,6 +140,9 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
   snprintf(buffer, kBufferSize, "  cache_index_and_filter_blocks: %d\n",
            table_options_.cache_index_and_filter_blocks);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  pin_top_level_index: %d\n",
+           table_options_.pin_top_level_index);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  index_type: %d\n",
            yb::to_underlying(table_options_.index_type));
   ret.append(buffer);
@@ -165,6 +172,14 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
              table_options_.block_cache_compressed->GetCapacity());
     ret.append(buffer);
   }
+  snprintf(buffer, kBufferSize, "  metadata_block_cache: %p\n",
+           table_options_.metadata_block_cache.get());
+  ret.append(buffer);
+  if (table_options_.metadata_block_cache) {
+    snprintf(buffer, kBufferSize, "  metadata_block_cache_size: %" ROCKSDB_PRIszt "\n",
+             table_options_.metadata_block_cache->GetCapacity());
+    ret.append(buffer);
+  }
   snprintf(buffer, kBufferSize, "  block_size: %" ROCKSDB_PRIszt "\n",
            table_options_.block_size);
   ret.append(buffer);
@@ -187,6 +202,12 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
   snprintf(buffer, kBufferSize, "  skip_table_builder_flush: %d\n",
            table_options_.skip_table_builder_flush);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  initial_auto_readahead_size: %" ROCKSDB_PRIszt "\n",
+           table_options_.initial_auto_readahead_size);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  max_auto_readahead_size: %" ROCKSDB_PRIszt "\n",
+           table_options_.max_auto_readahead_size);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  format_version: %d\n",
            table_options_.format_version);
   ret.append(buffer);
@@ -26,6 +26,7 @@
 #include <string>
 #include <utility>
 #include <cinttypes>
+#include <limits>
 
 #include "yb/rocksdb/db/dbformat.h"
 
@@ -200,6 +201,36 @@ struct BlockBasedTable::Rep {
     } else if (ioptions.mem_tracker) {
       mem_tracker = yb::MemTracker::FindOrCreateTracker("BlockBasedTable", ioptions.mem_tracker);
     }
+    metadata_mem_tracker = ioptions.block_based_table_metadata_mem_tracker
+        ? ioptions.block_based_table_metadata_mem_tracker : mem_tracker;
+  }
+
+  // Returns cache used for blocks of specified type.
+  Cache* GetBlockCache(BlockType block_type) const {
+    switch (block_type) {
+      case BlockType::kData:
+        return table_options.block_cache.get();
+      case BlockType::kIndex:
+        return metadata_block_cache();
+    }
+    FATAL_INVALID_ENUM_VALUE(BlockType, block_type);
+  }
+
+  // Returns mem tracker for blocks of specified type.
+  const yb::MemTrackerPtr& GetMemTracker(BlockType block_type) const {
+    switch (block_type) {
+      case BlockType::kData:
+        return mem_tracker;
+      case BlockType::kIndex:
+        return metadata_mem_tracker;
+    }
+    FATAL_INVALID_ENUM_VALUE(BlockType, block_type);
+  }
+
+  // Cache used for index and filter blocks.
+  Cache* metadata_block_cache() const {
+    return table_options.metadata_block_cache ? table_options.metadata_block_cache.get()
+                                              : table_options.block_cache.get();
   }
 
   const ImmutableCFOptions& ioptions;
@@ -240,11 +271,15 @@ struct BlockBasedTable::Rep {
 
   DataIndexLoadMode data_index_load_mode = static_cast<DataIndexLoadMode>(0);
   yb::MemTrackerPtr mem_tracker;
+  // Tracks memory of index and filter blocks.
+  yb::MemTrackerPtr metadata_mem_tracker;
 };
 
-// BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
-// to BlockBasedTable. It is used by TwoLevelIterator and MultiLevelIterator to call BlockBasedTable
-// functions in order to check if prefix may match or to create a secondary iterator.
+// BlockEntryIteratorState is used as an adapter to BlockBasedTable. It is used by TwoLevelIterator
+// and MultiLevelIterator to call BlockBasedTable functions in order to check if prefix may match
+// or to create a secondary iterator.
+// The only iterator state it stores is readahead state of data block iterator, see
+// BlockBasedTableOptions::max_auto_readahead_size.
 class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
  public:
   BlockEntryIteratorState(
@@ -254,9 +289,24 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         table_(table),
         read_options_(read_options),
         skip_filters_(skip_filters),
-        block_type_(block_type) {}
+        block_type_(block_type) {
+    const auto& table_options = table->rep_->table_options;
+    if (block_type == BlockType::kData && read_options.read_tier != kBlockCacheTier) {
+      max_readahead_size_ = table_options.max_auto_readahead_size;
+      initial_readahead_size_ = std::min(
+          table_options.initial_auto_readahead_size, max_readahead_size_);
+      readahead_size_ = initial_readahead_size_;
+    }
+  }
+
+  ~BlockEntryIteratorState() {
+    ResetReadahead();
+  }
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
+    if (readahead_size_ > 0) {
+      UpdateReadahead(index_value);
+    }
     return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
   }
 
@@ -268,6 +318,62 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   }
 
  private:
+  // Number of adjacent data blocks that should be read by iterator before readahead is started.
+  static constexpr size_t kMinSequentialBlocksForReadahead = 2;
+
+  // Detects that data blocks are read sequentially and asks file to read ahead the upcoming range,
+  // so following blocks are already in OS cache when iterator reaches them.
+  void UpdateReadahead(const Slice& index_value) {
+    BlockHandle handle;
+    Slice input = index_value;
+    if (!handle.DecodeFrom(&input).ok()) {
+      // Error will be reported by NewDataBlockIterator.
+      return;
+    }
+    if (handle.offset() != next_block_offset_) {
+      ResetReadahead();
+    }
+    ++num_sequential_blocks_;
+    next_block_offset_ = handle.offset() + handle.size() + kBlockTrailerSize;
+
+    Statistics* statistics = table_->rep_->ioptions.statistics;
+    if (next_block_offset_ <= readahead_limit_) {
+      RecordTick(statistics, READAHEAD_BLOCKS_HIT);
+    }
+    if (num_sequential_blocks_ < kMinSequentialBlocksForReadahead) {
+      return;
+    }
+    // Read ahead the next window once at least half of the previous one was consumed.
+    if (readahead_limit_ > next_block_offset_ &&
+        readahead_limit_ - next_block_offset_ >= readahead_size_ / 2) {
+      return;
+    }
+    uint64_t start = std::max(readahead_limit_, next_block_offset_);
+    uint64_t end = start + readahead_size_;
+    const auto& properties = table_->rep_->table_properties;
+    if (properties && properties->data_size) {
+      end = std::min<uint64_t>(end, properties->data_size);
+    }
+    if (end <= start) {
+      return;
+    }
+    table_->GetBlockReader(BlockType::kData)->reader->file()->Readahead(start, end - start);
+    RecordTick(statistics, READAHEAD_BYTES_REQUESTED, end - start);
+    readahead_limit_ = end;
+    readahead_size_ = std::min(readahead_size_ * 2, max_readahead_size_);
+  }
+
+  // Invoked when iterator is repositioned to non adjacent block.
+  void ResetReadahead() {
+    if (readahead_limit_ > next_block_offset_) {
+      RecordTick(table_->rep_->ioptions.statistics, READAHEAD_BYTES_WASTED,
+                 readahead_limit_ - next_block_offset_);
+    }
+    readahead_limit_ = 0;
+    readahead_size_ = initial_readahead_size_;
+    num_sequential_blocks_ = 0;
+  }
+
   // Don't own table_. BlockEntryIteratorState should only be stored in iterators or in
   // corresponding BlockBasedTable. TableReader (superclass of BlockBasedTable) is only destroyed
   // after iterator is deleted.
@@ -275,6 +381,16 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   const ReadOptions read_options_;
   const bool skip_filters_;
   const BlockType block_type_;
+
+  // Readahead is disabled when readahead_size_ is 0.
+  size_t initial_readahead_size_ = 0;
+  size_t max_readahead_size_ = 0;
+  size_t readahead_size_ = 0;
+  size_t num_sequential_blocks_ = 0;
+  // Offset of the block that follows the last block read by iterator.
+  uint64_t next_block_offset_ = std::numeric_limits<uint64_t>::max();
+  // End of the range that was already requested to be read ahead.
+  uint64_t readahead_limit_ = 0;
 };
 
 
@@ -342,7 +458,7 @@ bool BloomFilterAwareFileFilter::Filter(TableReader* reader) const {
       // Record that the bloom filter was useful.
       RecordTick(table->rep_->ioptions.statistics, BLOOM_FILTER_USEFUL);
     }
-    filter_entry.Release(table->rep_->table_options.block_cache.get());
+    filter_entry.Release(table->rep_->metadata_block_cache());
     return use_file;
   } else {
     // For non fixed-size filters - take file into account. We are only using fixed-size bloom
@@ -417,7 +533,7 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
 
   if (data_index_load_mode == DataIndexLoadMode::PRELOAD_ON_OPEN) {
     // Will use block cache for data index access?
-    if (table_options.cache_index_and_filter_blocks) {
+    if (table_options.cache_index_and_filter_blocks && !table_options.pin_top_level_index) {
       DCHECK_ONLY_NOTNULL(table_options.block_cache.get());
       // Hack: Call NewIndexIterator() to implicitly add index to the
       // block_cache
@@ -452,7 +568,7 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
         case FilterType::kBlockBasedFilter: {
           // Hack: Call GetFilter() to implicitly add filter to the block_cache
           auto filter_entry = new_table->GetFilter(kDefaultQueryId);
-          filter_entry.Release(table_options.block_cache.get());
+          filter_entry.Release(rep->metadata_block_cache());
           corrupted_filter_type = false;
           break;
         }
@@ -869,7 +985,7 @@ Status BlockBasedTable::CreateFilterIndexReader(std::unique_ptr<IndexReader>* fi
   auto env = rep_->ioptions.env;
   auto footer = rep_->footer;
   return BinarySearchIndexReader::Create(base_file_reader, footer, rep_->filter_handle, env,
-      SharedBytewiseComparator(), filter_index_reader, rep_->mem_tracker);
+      SharedBytewiseComparator(), filter_index_reader, rep_->metadata_mem_tracker);
 }
 
 FilterBlockReader* BlockBasedTable::ReadFilterBlock(const BlockHandle& filter_handle, Rep* rep,
@@ -882,7 +998,7 @@ FilterBlockReader* BlockBasedTable::ReadFilterBlock(const BlockHandle& filter_ha
   BlockContents block;
   if (!ReadBlockContents(
            rep->base_reader_with_cache_prefix->reader.get(), rep->footer, ReadOptions::kDefault,
-           filter_handle, &block, rep->ioptions.env, rep->mem_tracker, false).ok()) {
+           filter_handle, &block, rep->ioptions.env, rep->metadata_mem_tracker, false).ok()) {
     // Error reading the block
     return nullptr;
   }
@@ -973,7 +1089,7 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
 
   PERF_TIMER_GUARD(read_filter_block_nanos);
 
-  Cache* block_cache = rep_->table_options.block_cache.get();
+  Cache* block_cache = rep_->metadata_block_cache();
   if (rep_->filter_policy == nullptr /* do not use filter */ ||
       block_cache == nullptr /* no block cache at all */) {
     // If we get here, we have:
@@ -1069,7 +1185,9 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
   PERF_TIMER_GUARD(read_index_block_nanos);
 
   const bool no_io = read_options.read_tier == kBlockCacheTier;
-  Cache* const block_cache = rep_->table_options.block_cache.get();
+  // Pinned top-level index is loaded once and kept in table reader.
+  Cache* const block_cache =
+      rep_->table_options.pin_top_level_index ? nullptr : rep_->metadata_block_cache();
 
   if (block_cache && (rep_->data_index_load_mode == DataIndexLoadMode::USE_CACHE ||
       rep_->table_options.cache_index_and_filter_blocks)) {
@@ -1134,8 +1252,7 @@ InternalIterator* BlockBasedTable::NewIndexIterator(
   if (index_reader_result->cache_handle) {
     auto iter = new_iter ? new_iter : input_iter;
     iter->RegisterCleanup(
-        &ReleaseCachedEntry, rep_->table_options.block_cache.get(),
-        index_reader_result->cache_handle);
+        &ReleaseCachedEntry, rep_->metadata_block_cache(), index_reader_result->cache_handle);
   }
 
   return new_iter;
@@ -1150,9 +1267,10 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   PERF_TIMER_GUARD(new_table_block_iter_nanos);
 
   const bool no_io = (ro.read_tier == kBlockCacheTier);
-  Cache* block_cache = rep_->table_options.block_cache.get();
+  Cache* block_cache = rep_->GetBlockCache(block_type);
   Cache* block_cache_compressed =
       rep_->table_options.block_cache_compressed.get();
+  const auto& mem_tracker = rep_->GetMemTracker(block_type);
   CachableEntry<Block> block;
 
   BlockHandle handle;
@@ -1191,7 +1309,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
     s = GetDataBlockFromCache(
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        rep_->table_options.format_version, block_type, mem_tracker);
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
@@ -1199,13 +1317,13 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr);
+            mem_tracker, block_cache_compressed == nullptr);
       }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                 ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                rep_->table_options.format_version, mem_tracker);
       }
     }
   }
@@ -1224,7 +1342,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
         reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-        rep_->mem_tracker);
+        mem_tracker);
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -1344,7 +1462,7 @@ bool BlockBasedTable::PrefixMayMatch(const Slice& internal_key) {
     RecordTick(statistics, BLOOM_FILTER_PREFIX_USEFUL);
   }
 
-  filter_entry.Release(rep_->table_options.block_cache.get());
+  filter_entry.Release(rep_->metadata_block_cache());
   return may_match;
 }
 
@@ -1466,7 +1584,7 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& intern
     }
   }
 
-  filter_entry.Release(rep_->table_options.block_cache.get());
+  filter_entry.Release(rep_->metadata_block_cache());
   return s;
 }
 
@@ -1579,7 +1697,8 @@ Status BlockBasedTable::CreateDataBlockIndexReader(
   switch (index_type_on_file) {
     case IndexType::kBinarySearch: {
       return BinarySearchIndexReader::Create(
-          file, footer, footer.index_handle(), env, comparator, index_reader, rep_->mem_tracker);
+          file, footer, footer.index_handle(), env, comparator, index_reader,
+          rep_->metadata_mem_tracker);
     }
     case IndexType::kHashSearch: {
       std::unique_ptr<Block> meta_guard;
@@ -1594,7 +1713,8 @@ Status BlockBasedTable::CreateDataBlockIndexReader(
               "Unable to read the metaindex block."
               " Fall back to binary search index.");
           return BinarySearchIndexReader::Create(
-            file, footer, footer.index_handle(), env, comparator, index_reader, rep_->mem_tracker);
+            file, footer, footer.index_handle(), env, comparator, index_reader,
+            rep_->metadata_mem_tracker);
         }
         meta_index_iter = meta_iter_guard.get();
       }
@@ -1606,7 +1726,7 @@ Status BlockBasedTable::CreateDataBlockIndexReader(
       return HashIndexReader::Create(
           rep_->internal_prefix_transform.get(), footer, file, env, comparator,
           footer.index_handle(), meta_index_iter, index_reader,
-          rep_->hash_index_allow_collision, rep_->mem_tracker);
+          rep_->hash_index_allow_collision, rep_->metadata_mem_tracker);
     }
     case IndexType::kMultiLevelBinarySearch: {
       auto& props = DCHECK_NOTNULL(rep_->table_properties.get())->user_collected_properties;
@@ -1618,7 +1738,8 @@ Status BlockBasedTable::CreateDataBlockIndexReader(
       }
       int num_levels = DecodeFixed32(pos->second.c_str());
       auto result = MultiLevelIndexReader::Create(
-          file, footer, num_levels, footer.index_handle(), env, comparator, rep_->mem_tracker);
+          file, footer, num_levels, footer.index_handle(), env, comparator,
+          rep_->metadata_mem_tracker);
       RETURN_NOT_OK(result);
       *index_reader = std::move(*result);
       return Status::OK();
@@ -1896,7 +2017,7 @@ yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
 
   // TODO: remove this trick after https://github.com/yugabyte/yugabyte-db/issues/4720 is resolved.
   auto se = yb::ScopeExit([this, &index_reader] {
-    index_reader.Release(rep_->table_options.block_cache.get());
+    index_reader.Release(rep_->metadata_block_cache());
   });
 
   const auto index_middle_key = VERIFY_RESULT(index_reader.value->GetMiddleKey());
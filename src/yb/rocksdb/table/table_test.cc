@@ -63,6 +63,7 @@
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/testutil.h"
 #include "yb/util/enums.h"
+#include "yb/util/mem_tracker.h"
 
 DECLARE_double(cache_single_touch_ratio);
 
@@ -1570,6 +1571,60 @@ TEST_F(BlockBasedTableTest, NumBlockStat) {
             c.GetTableReader()->GetTableProperties()->num_data_blocks);
 }
 
+TEST_F(BlockBasedTableTest, AutoReadahead) {
+  Random rnd(test::RandomSeed());
+  TableConstructor c(BytewiseComparator());
+  Options options;
+  options.compression = kNoCompression;
+  options.statistics = CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  table_options.block_restart_interval = 1;
+  table_options.block_size = 1000;
+  table_options.initial_auto_readahead_size = 2_KB;
+  table_options.max_auto_readahead_size = 8_KB;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  // Each block holds one key/value pair.
+  constexpr int kNumBlocks = 100;
+  for (int i = 0; i < kNumBlocks; ++i) {
+    c.Add(RandomString(&rnd, 900), "val");
+  }
+
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+  auto* statistics = options.statistics.get();
+
+  {
+    std::unique_ptr<InternalIterator> iter(c.GetTableReader()->NewIterator(ReadOptions()));
+    int num_keys = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++num_keys;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kNumBlocks, num_keys);
+  }
+  // Readahead is limited by the end of data blocks, so full scan does not waste anything.
+  ASSERT_GT(statistics->getTickerCount(READAHEAD_BYTES_REQUESTED), 0);
+  ASSERT_GT(statistics->getTickerCount(READAHEAD_BLOCKS_HIT), kNumBlocks / 2);
+  ASSERT_EQ(0, statistics->getTickerCount(READAHEAD_BYTES_WASTED));
+
+  {
+    std::unique_ptr<InternalIterator> iter(c.GetTableReader()->NewIterator(ReadOptions()));
+    iter->Seek(keys[kNumBlocks / 4]);
+    for (int i = 0; i != 3; ++i) {
+      ASSERT_TRUE(iter->Valid());
+      iter->Next();
+    }
+    // Repositioning cancels readahead, so the range that was not read is wasted.
+    iter->Seek(keys[kNumBlocks * 3 / 4]);
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_GT(statistics->getTickerCount(READAHEAD_BYTES_WASTED), 0);
+  }
+}
+
 // A simple tool that takes the snapshot of block cache statistics.
 class BlockCachePropertiesSnapshot {
  public:
@@ -1840,6 +1895,71 @@ TEST_F(BlockBasedTableTest, FilterBlockInBlockCache) {
   props.AssertFilterBlockStat(0, 0);
 }
 
+// Index blocks should be cached in metadata block cache, and pinned top-level index should be kept
+// by table reader.
+TEST_F(BlockBasedTableTest, MetadataBlockCache) {
+  constexpr int kNumKeys = 100;
+  constexpr size_t kCacheSize = 1024 * 1024;
+
+  Options options;
+  options.block_based_table_metadata_mem_tracker = yb::MemTracker::CreateTracker("Metadata");
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(kCacheSize);
+  table_options.metadata_block_cache = NewLRUCache(kCacheSize);
+  table_options.cache_index_and_filter_blocks = true;
+  // Use small blocks, so multi-level index is built.
+  table_options.block_size = 64;
+  table_options.index_block_size = 128;
+  table_options.min_keys_per_index_block = 2;
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+
+  Random rnd(301);
+  TableConstructor c(BytewiseComparator());
+  for (int i = 0; i != kNumKeys; ++i) {
+    c.Add("key" + std::to_string(1000 + i), RandomString(&rnd, 100));
+  }
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+
+  auto scan = [&c] {
+    std::unique_ptr<InternalIterator> iter(c.NewIterator());
+    size_t count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++count;
+    }
+    EXPECT_OK(iter->status());
+    return count;
+  };
+
+  ASSERT_EQ(kvmap.size(), scan());
+  const auto metadata_usage = table_options.metadata_block_cache->GetUsage();
+  ASSERT_GT(metadata_usage, 0);
+  ASSERT_GT(table_options.block_cache->GetUsage(), 0);
+  ASSERT_GT(options.block_based_table_metadata_mem_tracker->consumption(), 0);
+
+  // Evicting data blocks does not affect index blocks.
+  table_options.block_cache->SetCapacity(0);
+  ASSERT_EQ(0, table_options.block_cache->GetUsage());
+  ASSERT_EQ(metadata_usage, table_options.metadata_block_cache->GetUsage());
+
+  table_options.block_cache = NewLRUCache(kCacheSize);
+  table_options.metadata_block_cache = NewLRUCache(kCacheSize);
+  table_options.pin_top_level_index = true;
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  const ImmutableCFOptions ioptions2(options);
+  ASSERT_OK(c.Reopen(ioptions2));
+
+  ASSERT_EQ(kvmap.size(), scan());
+  auto* reader = dynamic_cast<BlockBasedTable*>(c.GetTableReader());
+  ASSERT_TRUE(reader->TEST_index_reader_loaded());
+  // Only lower levels of index are cached now.
+  ASSERT_GT(table_options.metadata_block_cache->GetUsage(), 0);
+  ASSERT_LT(table_options.metadata_block_cache->GetUsage(), metadata_usage);
+}
+
 void ValidateBlockSizeDeviation(int value, int expected) {
   BlockBasedTableOptions table_options;
   table_options.block_size_deviation = value;
@@ -382,6 +382,11 @@ DEFINE_int32(new_table_reader_for_compaction_inputs, true,
 
 DEFINE_int32(compaction_readahead_size, 0, "Compaction readahead size");
 
+DEFINE_bool(use_direct_io_for_compaction, false,
+            "Read compaction inputs and write compaction outputs with direct I/O. Use with "
+            "readwhilewriting to compare latency percentiles of foreground reads during "
+            "compactions");
+
 DEFINE_int32(random_access_max_buffer_size, 1024 * 1024,
              "Maximum windows randomaccess buffer size");
 
@@ -669,6 +674,8 @@ DEFINE_int32(rate_limit_delay_max_milliseconds, 1000,
 
 DEFINE_uint64(rate_limiter_bytes_per_sec, 0, "Set options.rate_limiter value.");
 
+DEFINE_uint64(flush_rate_limiter_bytes_per_sec, 0, "Set options.flush_rate_limiter value.");
+
 DEFINE_uint64(
     benchmark_write_rate_limit, 0,
     "If non-zero, db_bench will rate-limit the writes going into RocksDB. This "
@@ -2378,6 +2385,7 @@ class Benchmark {
     options.new_table_reader_for_compaction_inputs =
         FLAGS_new_table_reader_for_compaction_inputs;
     options.compaction_readahead_size = FLAGS_compaction_readahead_size;
+    options.use_direct_io_for_compaction = FLAGS_use_direct_io_for_compaction;
     options.random_access_max_buffer_size = FLAGS_random_access_max_buffer_size;
     options.writable_file_max_buffer_size = FLAGS_writable_file_max_buffer_size;
     options.statistics = dbstats;
@@ -2614,6 +2622,10 @@ class Benchmark {
       options.rate_limiter.reset(
           NewGenericRateLimiter(FLAGS_rate_limiter_bytes_per_sec));
     }
+    if (FLAGS_flush_rate_limiter_bytes_per_sec > 0) {
+      options.flush_rate_limiter.reset(
+          NewGenericRateLimiter(FLAGS_flush_rate_limiter_bytes_per_sec));
+    }
 
 #ifndef ROCKSDB_LITE
     if (FLAGS_readonly && FLAGS_transaction_db) {
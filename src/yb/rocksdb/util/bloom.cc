@@ -30,6 +30,7 @@
 #include "yb/rocksdb/table/fixed_size_filter_block.h"
 #include "yb/rocksdb/util/hash.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/util/hash_util.h"
 #include "yb/util/slice.h"
 #include "yb/util/math_util.h"
 
@@ -534,6 +535,205 @@ class FixedSizeFilterPolicy : public FilterPolicy {
   Logger* logger_;
 };
 
+// Blocked Bloom filter where all bits of a key are located in a single 64-byte line, so probe
+// touches exactly one cache line. Line consists of kBlockedBloomLineWords 64-bit words and each key
+// sets exactly one bit in each word. So probe is a fixed number of independent AND/compare
+// operations over the whole line without data dependent branches, which compiler vectorizes.
+//
+// Line size does not depend on CACHE_LINE_SIZE, so filters could be read on any architecture.
+//
+// Encoding:
+// +----------------------------------------------------------------+
+// |              num_lines * kBlockedBloomLineBytes bytes          |
+// +----------------------------------------------------------------+
+// | ...                | num_words : 1 byte  | num_lines : 4 bytes |
+// +----------------------------------------------------------------+
+constexpr size_t kBlockedBloomLineWords = 8;
+constexpr size_t kBlockedBloomLineBytes = kBlockedBloomLineWords * sizeof(uint64_t);
+constexpr size_t kBlockedBloomMetaDataSize = 5;
+constexpr uint64_t kBlockedBloomHashSeed = 0x4bc5ba2d9c2b3f17ULL;
+
+// Odd multipliers used to derive bit position in each word of the line from the same hash.
+constexpr uint32_t kBlockedBloomSalts[kBlockedBloomLineWords] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+inline uint64_t BlockedBloomHash(const Slice& key) {
+  return yb::HashUtil::MurmurHash2_64(key.data(), static_cast<int>(key.size()),
+                                      kBlockedBloomHashSeed);
+}
+
+// Lower half of the hash selects line, upper half selects bits inside the line.
+inline size_t BlockedBloomLineOffset(uint64_t hash, uint32_t num_lines) {
+  return FastRange32(static_cast<uint32_t>(hash), num_lines) * kBlockedBloomLineBytes;
+}
+
+inline void BlockedBloomMasks(uint64_t hash, uint64_t* masks) {
+  const uint32_t h = static_cast<uint32_t>(hash >> 32);
+  for (size_t i = 0; i != kBlockedBloomLineWords; ++i) {
+    masks[i] = 1ULL << ((h * kBlockedBloomSalts[i]) >> 26);
+  }
+}
+
+// Returns average number of keys per line, such that expected false positive rate does not exceed
+// error_rate. Number of keys in a line follows Poisson distribution, and false positive rate for
+// a line with j keys is (1 - (1 - 1/64)^j)^kBlockedBloomLineWords.
+double BlockedBloomKeysPerLine(double error_rate) {
+  constexpr int kBitsPerWord = 64;
+  auto false_positive_rate = [](double keys_per_line) {
+    double result = 0;
+    double probability = exp(-keys_per_line);
+    const int max_keys = static_cast<int>(4 * keys_per_line) + 100;
+    for (int j = 0; j <= max_keys; ++j) {
+      if (j) {
+        probability *= keys_per_line / j;
+      }
+      const double bit_set = 1 - pow(1 - 1.0 / kBitsPerWord, j);
+      result += probability * pow(bit_set, kBlockedBloomLineWords);
+    }
+    return result;
+  };
+  double low = 0;
+  double high = kBlockedBloomLineBytes * 8;
+  for (int i = 0; i != 50; ++i) {
+    const double middle = (low + high) / 2;
+    if (false_positive_rate(middle) <= error_rate) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+class FixedSizeBlockedBloomBitsBuilder : public FilterBitsBuilder {
+ public:
+  FixedSizeBlockedBloomBitsBuilder(const FixedSizeBlockedBloomBitsBuilder&) = delete;
+  void operator=(const FixedSizeBlockedBloomBitsBuilder&) = delete;
+
+  FixedSizeBlockedBloomBitsBuilder(uint32_t num_lines, size_t max_keys)
+      : num_lines_(num_lines), max_keys_(max_keys), data_(new char[FilterSize()]) {
+    DCHECK_GT(num_lines_, 0);
+    memset(data_.get(), 0, FilterSize());
+  }
+
+  void AddKey(const Slice& key) override {
+    ++keys_added_;
+    const uint64_t hash = BlockedBloomHash(key);
+    char* line = data_.get() + BlockedBloomLineOffset(hash, num_lines_);
+    uint64_t masks[kBlockedBloomLineWords];
+    BlockedBloomMasks(hash, masks);
+    for (size_t i = 0; i != kBlockedBloomLineWords; ++i) {
+      char* word = line + i * sizeof(uint64_t);
+      EncodeFixed64(word, DecodeFixed64(word) | masks[i]);
+    }
+  }
+
+  bool IsFull() const override { return keys_added_ >= max_keys_; }
+
+  Slice Finish(std::unique_ptr<const char[]>* buf) override {
+    char* meta = data_.get() + num_lines_ * kBlockedBloomLineBytes;
+    meta[0] = static_cast<char>(kBlockedBloomLineWords);
+    EncodeFixed32(meta + 1, num_lines_);
+    buf->reset(data_.release());
+    return Slice(buf->get(), FilterSize());
+  }
+
+ private:
+  size_t FilterSize() const {
+    return num_lines_ * kBlockedBloomLineBytes + kBlockedBloomMetaDataSize;
+  }
+
+  const uint32_t num_lines_;
+  const size_t max_keys_;
+  size_t keys_added_ = 0;
+  std::unique_ptr<char[]> data_;
+};
+
+class FixedSizeBlockedBloomBitsReader : public FilterBitsReader {
+ public:
+  FixedSizeBlockedBloomBitsReader(const FixedSizeBlockedBloomBitsReader&) = delete;
+  void operator=(const FixedSizeBlockedBloomBitsReader&) = delete;
+
+  FixedSizeBlockedBloomBitsReader(const Slice& contents, Logger* logger)
+      : data_(contents.cdata()) {
+    if (contents.size() <= kBlockedBloomMetaDataSize) {
+      return;
+    }
+    const char* meta = contents.cdata() + contents.size() - kBlockedBloomMetaDataSize;
+    num_lines_ = DecodeFixed32(meta + 1);
+    if (static_cast<uint8_t>(meta[0]) != kBlockedBloomLineWords ||
+        contents.size() != num_lines_ * kBlockedBloomLineBytes + kBlockedBloomMetaDataSize) {
+      RLOG(InfoLogLevel::ERROR_LEVEL, logger,
+           "Blocked bloom filter data is broken, won't be used.");
+      FAIL_IF_NOT_PRODUCTION();
+      num_lines_ = 0;
+      broken_ = true;
+    }
+  }
+
+  bool MayMatch(const Slice& entry) override {
+    if (num_lines_ == 0) {
+      // Empty filter does not match anything, while broken filter should match everything.
+      return broken_;
+    }
+    const uint64_t hash = BlockedBloomHash(entry);
+    const char* line = data_ + BlockedBloomLineOffset(hash, num_lines_);
+    uint64_t masks[kBlockedBloomLineWords];
+    BlockedBloomMasks(hash, masks);
+    bool result = true;
+    for (size_t i = 0; i != kBlockedBloomLineWords; ++i) {
+      result &= (DecodeFixed64(line + i * sizeof(uint64_t)) & masks[i]) == masks[i];
+    }
+    return result;
+  }
+
+ private:
+  const char* data_;
+  uint32_t num_lines_ = 0;
+  bool broken_ = false;
+};
+
+class FixedSizeBlockedBloomFilterPolicy : public FilterPolicy {
+ public:
+  FixedSizeBlockedBloomFilterPolicy(uint32_t total_bits, double error_rate, Logger* logger)
+      : num_lines_(std::max<uint32_t>(total_bits / (kBlockedBloomLineBytes * 8), 1)),
+        max_keys_(std::max<size_t>(
+            static_cast<size_t>(BlockedBloomKeysPerLine(error_rate) * num_lines_), 1)),
+        logger_(logger) {
+    DCHECK_GT(error_rate, 0);
+  }
+
+  FilterType GetFilterType() const override { return FilterType::kFixedSizeFilter; }
+
+  const char* Name() const override {
+    return "rocksdb.FixedSizeBlockedBloomFilter";
+  }
+
+  // Not used in FixedSizeFilter. GetFilterBitsBuilder/Reader interface should be used.
+  void CreateFilter(const Slice* keys, int n, std::string* dst) const override {
+    assert(!"FixedSizeBlockedBloomFilterPolicy::CreateFilter is not supported");
+  }
+
+  bool KeyMayMatch(const Slice& key, const Slice& filter) const override {
+    assert(!"FixedSizeBlockedBloomFilterPolicy::KeyMayMatch is not supported");
+    return true;
+  }
+
+  FilterBitsBuilder* GetFilterBitsBuilder() const override {
+    return new FixedSizeBlockedBloomBitsBuilder(num_lines_, max_keys_);
+  }
+
+  FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override {
+    return new FixedSizeBlockedBloomBitsReader(contents, logger_);
+  }
+
+ private:
+  const uint32_t num_lines_;
+  const size_t max_keys_;
+  Logger* logger_;
+};
+
 }  // namespace
 
 const FilterPolicy* NewBloomFilterPolicy(int bits_per_key,
@@ -548,4 +748,10 @@ const FilterPolicy* NewFixedSizeFilterPolicy(uint32_t total_bits,
   return new FixedSizeFilterPolicy(total_bits, error_rate, logger);
 }
 
+const FilterPolicy* NewFixedSizeBlockedBloomFilterPolicy(uint32_t total_bits,
+                                                         double error_rate,
+                                                         Logger* logger) {
+  return new FixedSizeBlockedBloomFilterPolicy(total_bits, error_rate, logger);
+}
+
 }  // namespace rocksdb
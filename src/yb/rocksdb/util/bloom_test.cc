@@ -29,6 +29,7 @@ int main() {
 }
 #else
 
+#include <chrono>
 #include <vector>
 #include <gflags/gflags.h>
 
@@ -42,6 +43,7 @@ int main() {
 using GFLAGS::ParseCommandLineFlags;
 
 DEFINE_int32(bits_per_key, 10, "");
+DEFINE_int32(bloom_probe_count, 1000000, "Number of probes in filter probe benchmark.");
 
 namespace rocksdb {
 
@@ -215,8 +217,16 @@ class FullFilterBloomTestContext : public BloomTestContext {
       NewBloomFilterPolicy(FLAGS_bits_per_key, false)};
 };
 
+typedef const FilterPolicy* (*FixedSizeFilterPolicyFactory)(
+    uint32_t total_bits, double error_rate, Logger* logger);
+
 class FixedSizeFilterBloomTestContext : public BloomTestContext {
  public:
+  explicit FixedSizeFilterBloomTestContext(FixedSizeFilterPolicyFactory factory)
+      : filter_policy_(factory(
+            FilterPolicy::kDefaultFixedSizeFilterBits,
+            FilterPolicy::kDefaultFixedSizeFilterErrorRate, nullptr)) {}
+
   const FilterPolicy& filter_policy() const override { return *filter_policy_.get(); }
 
   // For fixed-size filter we limit maximum number of keys depending on total bits in test itself
@@ -228,13 +238,11 @@ class FixedSizeFilterBloomTestContext : public BloomTestContext {
   }
 
  private:
-  std::unique_ptr<const FilterPolicy> filter_policy_{
-      NewFixedSizeFilterPolicy(
-          FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
-          nullptr)};
+  std::unique_ptr<const FilterPolicy> filter_policy_;
 };
 
-YB_DEFINE_ENUM(BuilderReaderBloomTestType, (kFullFilter)(kFixedSizeFilter));
+YB_DEFINE_ENUM(BuilderReaderBloomTestType,
+    (kFullFilter)(kFixedSizeFilter)(kFixedSizeBlockedBloomFilter)(kFixedSizeRibbonFilter));
 
 namespace {
 
@@ -243,7 +251,12 @@ std::unique_ptr<const BloomTestContext> CreateContext(BuilderReaderBloomTestType
     case BuilderReaderBloomTestType::kFullFilter:
       return std::make_unique<FullFilterBloomTestContext>();
     case BuilderReaderBloomTestType::kFixedSizeFilter:
-      return std::make_unique<FixedSizeFilterBloomTestContext>();
+      return std::make_unique<FixedSizeFilterBloomTestContext>(&NewFixedSizeFilterPolicy);
+    case BuilderReaderBloomTestType::kFixedSizeBlockedBloomFilter:
+      return std::make_unique<FixedSizeFilterBloomTestContext>(
+          &NewFixedSizeBlockedBloomFilterPolicy);
+    case BuilderReaderBloomTestType::kFixedSizeRibbonFilter:
+      return std::make_unique<FixedSizeFilterBloomTestContext>(&NewFixedSizeRibbonFilterPolicy);
   }
   FATAL_INVALID_ENUM_VALUE(BuilderReaderBloomTestType, type);
 }
@@ -370,9 +383,90 @@ TEST_P(BuilderReaderBloomTest, FullVaryingLengths) {
   ASSERT_LE(mediocre_filters, good_filters/5);
 }
 
+// Fills filter up to its capacity and measures throughput of probes, half of which are for keys
+// that were not added, so false positive rate is measured at the same time.
+TEST_P(BuilderReaderBloomTest, ProbeBenchmark) {
+  char buffer[sizeof(size_t)];
+
+  size_t num_keys = 0;
+  while (!ShouldFlush() && num_keys < context_->max_keys() && num_keys < 10000) {
+    Add(Key(num_keys, buffer));
+    ++num_keys;
+  }
+  Build();
+
+  const size_t num_probes = FLAGS_bloom_probe_count;
+  size_t matches = 0;
+  size_t false_positives = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < num_probes; i++) {
+    // Even probes are for added keys, odd probes are for keys that were not added.
+    const bool added = (i & 1) == 0;
+    const size_t key = added ? (i >> 1) % num_keys : i + 1000000000;
+    if (Matches(Key(key, buffer))) {
+      ++matches;
+      if (!added) {
+        ++false_positives;
+      }
+    }
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  const size_t negative_probes = num_probes / 2;
+  const double rate = static_cast<double>(false_positives) / negative_probes;
+  LOG(INFO) << StringPrintf(
+      "%s: keys = %zu ; bits/key = %.2f ; false positives = %5.3f%% ; %.0f probes/s",
+      ToString(GetParam()).c_str(), num_keys, FilterSize() * 8.0 / num_keys, rate * 100.0,
+      num_probes / elapsed.count());
+
+  ASSERT_EQ(matches, num_probes - negative_probes + false_positives);
+  ASSERT_LE(rate, 0.02);
+}
+
+// Ribbon filter should be built with the default DocDB filter block size (64KB, about 69K keys)
+// instead of falling back to filter that matches any key.
+TEST(RibbonFilterTest, DefaultDocDbFilterBlockSize) {
+  constexpr uint32_t kFilterBlockSizeBits = 64 * 1024 * 8;
+  constexpr size_t kNumKeySets = 10;
+  char buffer[sizeof(size_t)];
+
+  std::unique_ptr<const FilterPolicy> policy(NewFixedSizeRibbonFilterPolicy(
+      kFilterBlockSizeBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate, nullptr));
+  const auto fallbacks_before = NumFixedSizeRibbonFilterFallbacks();
+  for (size_t key_set = 0; key_set != kNumKeySets; ++key_set) {
+    const size_t first_key = key_set * 1000000;
+    std::unique_ptr<FilterBitsBuilder> builder(policy->GetFilterBitsBuilder());
+    size_t num_keys = 0;
+    while (!builder->IsFull()) {
+      builder->AddKey(Key(first_key + num_keys, buffer));
+      ++num_keys;
+    }
+    ASSERT_GE(num_keys, 65000U);
+
+    std::unique_ptr<const char[]> buf;
+    Slice filter = builder->Finish(&buf);
+    ASSERT_LE(filter.size(), kFilterBlockSizeBits / 8);
+    std::unique_ptr<FilterBitsReader> reader(policy->GetFilterBitsReader(filter));
+    for (size_t i = 0; i != num_keys; ++i) {
+      ASSERT_TRUE(reader->MayMatch(Key(first_key + i, buffer))) << "key " << i;
+    }
+    size_t false_positives = 0;
+    constexpr size_t kNumProbes = 100000;
+    for (size_t i = 0; i != kNumProbes; ++i) {
+      if (reader->MayMatch(Key(i + 1000000000, buffer))) {
+        ++false_positives;
+      }
+    }
+    ASSERT_LE(false_positives, kNumProbes * 0.02) << "key set " << key_set;
+  }
+  ASSERT_EQ(fallbacks_before, NumFixedSizeRibbonFilterFallbacks());
+}
+
 INSTANTIATE_TEST_CASE_P(, BuilderReaderBloomTest, ::testing::Values(
     BuilderReaderBloomTestType::kFullFilter,
-    BuilderReaderBloomTestType::kFixedSizeFilter));
+    BuilderReaderBloomTestType::kFixedSizeFilter,
+    BuilderReaderBloomTestType::kFixedSizeBlockedBloomFilter,
+    BuilderReaderBloomTestType::kFixedSizeRibbonFilter));
 
 }  // namespace rocksdb
 
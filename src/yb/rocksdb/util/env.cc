@@ -421,6 +421,29 @@ EnvOptions Env::OptimizeForManifestWrite(const EnvOptions& env_options) const {
   return env_options;
 }
 
+EnvOptions Env::OptimizeForCompactionTableWrite(const EnvOptions& env_options,
+                                                const DBOptions& db_options) const {
+  EnvOptions optimized_env_options(env_options);
+  optimized_env_options.use_direct_writes = db_options.use_direct_io_for_compaction;
+  return optimized_env_options;
+}
+
+EnvOptions Env::OptimizeForCompactionTableRead(const EnvOptions& env_options,
+                                               const DBOptions& db_options) const {
+  EnvOptions optimized_env_options(env_options);
+  optimized_env_options.use_direct_reads = db_options.use_direct_io_for_compaction;
+  return optimized_env_options;
+}
+
+EnvOptions Env::OptimizeForFlushTableWrite(const EnvOptions& env_options,
+                                           const DBOptions& db_options) const {
+  EnvOptions optimized_env_options(env_options);
+  if (db_options.flush_rate_limiter) {
+    optimized_env_options.rate_limiter = db_options.flush_rate_limiter.get();
+  }
+  return optimized_env_options;
+}
+
 EnvOptions::EnvOptions(const DBOptions& options) {
   AssignEnvOptions(this, options);
 }
@@ -64,6 +64,7 @@
 #include "yb/rocksdb/util/thread_local.h"
 #include "yb/rocksdb/util/thread_status_updater.h"
 
+#include "yb/util/logging.h"
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
 
@@ -137,6 +138,29 @@ void SetFD_CLOEXEC(int fd, const EnvOptions* options) {
   }
 }
 
+// Opens file with O_DIRECT when *direct_io is true. Falls back to buffered I/O and resets
+// *direct_io when file system does not support O_DIRECT.
+int OpenMaybeDirect(const std::string& fname, int flags, mode_t mode, bool* direct_io) {
+  int fd = -1;
+#ifdef __linux__
+  if (*direct_io) {
+    do {
+      fd = open(fname.c_str(), flags | O_DIRECT, mode);
+    } while (fd < 0 && errno == EINTR);
+    if (fd >= 0 || errno != EINVAL) {
+      return fd;
+    }
+    YB_LOG_EVERY_N_SECS(WARNING, 60)
+        << "Direct I/O is not supported for " << fname << ", using buffered I/O";
+  }
+#endif
+  *direct_io = false;
+  do {
+    fd = open(fname.c_str(), flags, mode);
+  } while (fd < 0 && errno == EINTR);
+  return fd;
+}
+
 class PosixFileLock : public FileLock {
  public:
   int fd_;
@@ -613,13 +637,16 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
     result->reset();
     Status s;
     int fd;
+    bool direct_io = options.use_direct_reads;
     {
       IOSTATS_TIMER_GUARD(open_nanos);
-      fd = open(fname.c_str(), O_RDONLY);
+      fd = OpenMaybeDirect(fname, O_RDONLY, 0, &direct_io);
     }
     SetFD_CLOEXEC(fd, &options);
     if (fd < 0) {
       s = STATUS_IO_ERROR(fname, errno);
+    } else if (direct_io) {
+      *result = std::make_unique<PosixDirectIORandomAccessFile>(fname, fd, options);
     } else if (options.use_mmap_reads && sizeof(void*) >= 8) {
       // Use of mmap for random reads has been removed because it
       // kills performance when storage is fast.
@@ -647,12 +674,19 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
     result->reset();
     Status s;
     int fd = -1;
-    do {
+    bool direct_io = options.use_direct_writes;
+    {
       IOSTATS_TIMER_GUARD(open_nanos);
-      fd = open(fname.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
-    } while (fd < 0 && errno == EINTR);
+      fd = OpenMaybeDirect(fname, O_CREAT | O_RDWR | O_TRUNC, 0644, &direct_io);
+    }
     if (fd < 0) {
       s = STATUS_IO_ERROR(fname, errno);
+    } else if (direct_io) {
+      SetFD_CLOEXEC(fd, &options);
+      // Direct I/O writes are aligned by WritableFileWriter, so mmap is not used.
+      EnvOptions direct_io_options = options;
+      direct_io_options.use_mmap_writes = false;
+      *result = std::make_unique<PosixWritableFile>(fname, fd, direct_io_options);
     } else {
       SetFD_CLOEXEC(fd, &options);
       if (options.use_mmap_writes) {
@@ -671,6 +705,7 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
         // disable mmap writes
         EnvOptions no_mmap_writes_options = options;
         no_mmap_writes_options.use_mmap_writes = false;
+        no_mmap_writes_options.use_direct_writes = false;
         *result = std::make_unique<PosixWritableFile>(fname, fd, no_mmap_writes_options);
       }
     }
@@ -714,6 +749,7 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
         // disable mmap writes
         EnvOptions no_mmap_writes_options = options;
         no_mmap_writes_options.use_mmap_writes = false;
+        no_mmap_writes_options.use_direct_writes = false;
 
         *result = std::make_unique<PosixWritableFile>(fname, fd, no_mmap_writes_options);
       }
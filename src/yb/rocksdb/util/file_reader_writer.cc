@@ -248,7 +248,8 @@ Status WritableFileWriter::Sync(bool use_fsync) {
     return s;
   }
   TEST_KILL_RANDOM("WritableFileWriter::Sync:0", rocksdb_kill_odds);
-  if (!direct_io_ && pending_sync_) {
+  // Direct I/O bypasses OS page cache, but file metadata and device cache still have to be synced.
+  if (pending_sync_) {
     s = SyncInternal(use_fsync);
     if (!s.ok()) {
       return s;
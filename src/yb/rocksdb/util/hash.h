@@ -45,6 +45,11 @@ inline uint32_t GetSliceHash(const Slice& s) {
   return Hash(s.data(), s.size(), 397);
 }
 
+// Maps uniformly distributed 32-bit hash to [0, n) using multiplication instead of modulo.
+inline uint32_t FastRange32(uint32_t hash, uint32_t n) {
+  return static_cast<uint32_t>((static_cast<uint64_t>(hash) * n) >> 32);
+}
+
 }  // namespace rocksdb
 
 #endif // ROCKSDB_UTIL_HASH_H
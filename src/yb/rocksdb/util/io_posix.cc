@@ -40,7 +40,13 @@
 #include <sys/statfs.h>
 #include <sys/syscall.h>
 #endif
+
+#include <algorithm>
+
+#include <gflags/gflags.h>
+
 #include "yb/rocksdb/port/port.h"
+#include "yb/rocksdb/util/aligned_buffer.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/posix_logger.h"
 #include "yb/rocksdb/util/sync_point.h"
@@ -51,6 +57,8 @@
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
 
+DECLARE_int32(o_direct_block_alignment_bytes);
+
 namespace rocksdb {
 
 // A wrapper for fadvise, if the platform doesn't support fadvise,
@@ -63,6 +71,49 @@ int Fadvise(int fd, off_t offset, size_t len, int advice) {
 #endif
 }
 
+size_t DirectIOAlignment() {
+  return std::max(FLAGS_o_direct_block_alignment_bytes, 512);
+}
+
+/*
+ * PosixDirectIORandomAccessFile
+ */
+Status PosixDirectIORandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
+                                           uint8_t* scratch) const {
+  const size_t alignment = DirectIOAlignment();
+  const uint64_t aligned_offset = TruncateToPageBoundary(alignment, offset);
+  const size_t prefix = offset - aligned_offset;
+  const size_t aligned_size = Roundup(prefix + n, alignment);
+
+  AlignedBuffer buffer;
+  buffer.Alignment(alignment);
+  buffer.AllocateNewBuffer(aligned_size);
+
+  char* dest = buffer.Destination();
+  size_t read = 0;
+  while (read < aligned_size) {
+    ssize_t r = pread(fd(), dest + read, aligned_size - read,
+                      static_cast<off_t>(aligned_offset + read));
+    if (r < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      *result = Slice(scratch, static_cast<size_t>(0));
+      return STATUS_IO_ERROR(filename(), errno);
+    }
+    if (r == 0) {
+      // End of file.
+      break;
+    }
+    read += r;
+  }
+
+  const size_t available = read > prefix ? std::min(read - prefix, n) : 0;
+  memcpy(scratch, dest + prefix, available);
+  *result = Slice(scratch, available);
+  return Status::OK();
+}
+
 /*
  * PosixMmapReadableFile
  *
@@ -357,7 +408,7 @@ Status PosixMmapFile::Allocate(uint64_t offset, uint64_t len) {
  */
 PosixWritableFile::PosixWritableFile(const std::string& fname, int fd,
                                      const EnvOptions& options)
-    : filename_(fname), fd_(fd), filesize_(0) {
+    : filename_(fname), fd_(fd), filesize_(0), use_direct_io_(options.use_direct_writes) {
 #ifdef ROCKSDB_FALLOCATE_PRESENT
   allow_fallocate_ = options.allow_fallocate;
   fallocate_with_keep_size_ = options.fallocate_with_keep_size;
@@ -389,6 +440,45 @@ Status PosixWritableFile::Append(const Slice& data) {
   return Status::OK();
 }
 
+Status PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset) {
+  if (!use_direct_io_) {
+    return STATUS(NotSupported, "PositionedAppend is supported only with direct I/O");
+  }
+  assert(offset % DirectIOAlignment() == 0);
+  assert(data.size() % DirectIOAlignment() == 0);
+  const char* src = data.cdata();
+  size_t left = data.size();
+  while (left != 0) {
+    ssize_t done = pwrite(fd_, src, left, static_cast<off_t>(offset));
+    if (done < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return STATUS_IO_ERROR(filename_, errno);
+    }
+    left -= done;
+    src += done;
+    offset += done;
+  }
+  filesize_ = std::max<uint64_t>(filesize_, offset);
+  return Status::OK();
+}
+
+size_t PosixWritableFile::GetRequiredBufferAlignment() const {
+  return use_direct_io_ ? DirectIOAlignment() : WritableFile::GetRequiredBufferAlignment();
+}
+
+Status PosixWritableFile::Truncate(uint64_t size) {
+  if (!use_direct_io_) {
+    return Status::OK();
+  }
+  if (ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  filesize_ = size;
+  return Status::OK();
+}
+
 Status PosixWritableFile::Close() {
   Status s;
 
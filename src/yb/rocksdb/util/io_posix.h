@@ -27,6 +27,8 @@
 #include <unistd.h>
 #include "yb/rocksdb/env.h"
 
+#include "yb/util/file_system_posix.h"
+
 // For non linux platform, the following macros are used only as place
 // holder.
 #if !(defined __linux__) && !(defined CYGWIN)
@@ -41,11 +43,27 @@ namespace rocksdb {
 
 #define STATUS_IO_ERROR(context, err_number) STATUS(IOError, (context), strerror(err_number))
 
+// Required alignment of offsets, sizes and buffers used with files opened with O_DIRECT.
+size_t DirectIOAlignment();
+
+// Random access file opened with O_DIRECT. Reads of arbitrary ranges are served through aligned
+// temporary buffer, so read data does not get into OS page cache.
+class PosixDirectIORandomAccessFile : public yb::PosixRandomAccessFile {
+ public:
+  PosixDirectIORandomAccessFile(const std::string& fname, int fd, const EnvOptions& options)
+      : yb::PosixRandomAccessFile(fname, fd, options) {}
+
+  using yb::PosixRandomAccessFile::Read;
+  Status Read(uint64_t offset, size_t n, Slice* result, uint8_t* scratch) const override;
+};
+
 class PosixWritableFile : public WritableFile {
  private:
   const std::string filename_;
   int fd_;
   uint64_t filesize_;
+  // File was opened with O_DIRECT, so only aligned positioned writes are allowed.
+  const bool use_direct_io_;
 #ifdef ROCKSDB_FALLOCATE_PRESENT
   bool allow_fallocate_;
   bool fallocate_with_keep_size_;
@@ -56,11 +74,17 @@ class PosixWritableFile : public WritableFile {
                     const EnvOptions& options);
   ~PosixWritableFile();
 
-  // Means Close() will properly take care of truncate
-  // and it does not need any additional information
-  virtual Status Truncate(uint64_t size) override { return Status::OK(); }
+  virtual bool UseOSBuffer() const override { return !use_direct_io_; }
+  virtual bool UseDirectIO() const override { return use_direct_io_; }
+  virtual size_t GetRequiredBufferAlignment() const override;
+
+  // With buffered I/O means Close() will properly take care of truncate
+  // and it does not need any additional information.
+  // With direct I/O trims padding written after the last aligned block.
+  virtual Status Truncate(uint64_t size) override;
   virtual Status Close() override;
   virtual Status Append(const Slice& data) override;
+  virtual Status PositionedAppend(const Slice& data, uint64_t offset) override;
   virtual Status Flush() override;
   virtual Status Sync() override;
   virtual Status Fsync() override;
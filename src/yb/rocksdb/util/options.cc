@@ -93,7 +93,9 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       row_cache(options.row_cache),
       mem_tracker(options.mem_tracker),
       block_based_table_mem_tracker(options.block_based_table_mem_tracker),
-      iterator_replacer(options.iterator_replacer) {}
+      block_based_table_metadata_mem_tracker(options.block_based_table_metadata_mem_tracker),
+      iterator_replacer(options.iterator_replacer),
+      compaction_output_path_selector(options.compaction_output_path_selector) {}
 
 ColumnFamilyOptions::ColumnFamilyOptions()
     : comparator(BytewiseComparator()),
@@ -231,6 +233,7 @@ DBOptions::DBOptions()
       env(Env::Default()),
       checkpoint_env(nullptr),
       rate_limiter(nullptr),
+      flush_rate_limiter(nullptr),
       sst_file_manager(nullptr),
       info_log(nullptr),
 #ifdef NDEBUG
@@ -274,6 +277,7 @@ DBOptions::DBOptions()
       access_hint_on_compaction_start(NORMAL),
       new_table_reader_for_compaction_inputs(false),
       compaction_readahead_size(0),
+      use_direct_io_for_compaction(false),
       random_access_max_buffer_size(1024 * 1024),
       writable_file_max_buffer_size(1024 * 1024),
       use_adaptive_mutex(false),
@@ -375,6 +379,8 @@ void DBOptions::Dump(Logger* log) const {
       "               Options.compaction_readahead_size: %" ROCKSDB_PRIszt
          "d",
          compaction_readahead_size);
+  RHEADER(log, "            Options.use_direct_io_for_compaction: %d",
+      use_direct_io_for_compaction);
   RHEADER(
       log,
       "               Options.random_access_max_buffer_size: %" ROCKSDB_PRIszt
@@ -388,6 +394,8 @@ void DBOptions::Dump(Logger* log) const {
       use_adaptive_mutex);
   RHEADER(log, "                            Options.rate_limiter: %p",
       rate_limiter.get());
+  RHEADER(log, "                      Options.flush_rate_limiter: %p",
+      flush_rate_limiter.get());
   RHEADER(
       log, "     Options.sst_file_manager.rate_bytes_per_sec: %" PRIi64,
       sst_file_manager ? sst_file_manager->GetDeleteRateBytesPerSecond() : 0);
@@ -224,6 +224,9 @@ static std::unordered_map<std::string, OptionTypeInfo> db_options_type_info = {
     {"compaction_readahead_size",
      {offsetof(struct DBOptions, compaction_readahead_size), OptionType::kSizeT,
       OptionVerificationType::kNormal}},
+    {"use_direct_io_for_compaction",
+     {offsetof(struct DBOptions, use_direct_io_for_compaction), OptionType::kBoolean,
+      OptionVerificationType::kNormal}},
     {"random_access_max_buffer_size",
      {offsetof(struct DBOptions, random_access_max_buffer_size),
       OptionType::kSizeT, OptionVerificationType::kNormal}},
@@ -515,6 +518,7 @@ static std::unordered_map<std::string,
     /* currently not supported
       std::shared_ptr<Cache> block_cache = nullptr;
       std::shared_ptr<Cache> block_cache_compressed = nullptr;
+      std::shared_ptr<Cache> metadata_block_cache = nullptr;
      */
     {"flush_block_policy_factory",
      {offsetof(struct BlockBasedTableOptions, flush_block_policy_factory),
@@ -522,6 +526,9 @@ static std::unordered_map<std::string,
     {"cache_index_and_filter_blocks",
      {offsetof(struct BlockBasedTableOptions, cache_index_and_filter_blocks),
       OptionType::kBoolean, OptionVerificationType::kNormal}},
+    {"pin_top_level_index",
+     {offsetof(struct BlockBasedTableOptions, pin_top_level_index),
+      OptionType::kBoolean, OptionVerificationType::kNormal}},
     {"index_type",
      {offsetof(struct BlockBasedTableOptions, index_type),
       OptionType::kBlockBasedTableIndexType, OptionVerificationType::kNormal}},
@@ -564,6 +571,12 @@ static std::unordered_map<std::string,
     {"skip_table_builder_flush",
      {offsetof(struct BlockBasedTableOptions, skip_table_builder_flush),
       OptionType::kBoolean, OptionVerificationType::kNormal}},
+    {"initial_auto_readahead_size",
+     {offsetof(struct BlockBasedTableOptions, initial_auto_readahead_size), OptionType::kSizeT,
+      OptionVerificationType::kNormal}},
+    {"max_auto_readahead_size",
+     {offsetof(struct BlockBasedTableOptions, max_auto_readahead_size), OptionType::kSizeT,
+      OptionVerificationType::kNormal}},
     {"format_version",
      {offsetof(struct BlockBasedTableOptions, format_version),
       OptionType::kUInt32T, OptionVerificationType::kNormal}}};
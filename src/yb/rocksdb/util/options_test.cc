@@ -1613,13 +1613,14 @@ void InitDefault(BlockBasedTableOptions*) {}
 
 Status GetFromString(BlockBasedTableOptions* source, BlockBasedTableOptions* destination) {
   const char* const kOptionsString =
-      "cache_index_and_filter_blocks=1;index_type=kHashSearch;"
+      "cache_index_and_filter_blocks=1;pin_top_level_index=1;index_type=kHashSearch;"
       "checksum=kxxHash;hash_index_allow_collision=1;no_block_cache=1;"
       "block_cache=1M;block_cache_compressed=1k;block_size=1024;filter_block_size=16384;"
       "block_size_deviation=8;block_restart_interval=4; "
       "index_block_restart_interval=4;index_block_size=16384;min_keys_per_index_block=16;"
       "filter_policy=bloomfilter:4:true;whole_key_filtering=1;"
       "skip_table_builder_flush=1;format_version=1;"
+      "initial_auto_readahead_size=4096;max_auto_readahead_size=65536;"
       "hash_index_allow_collision=false;";
 
   RETURN_NOT_OK(GetBlockBasedTableOptionsFromString(*source, kOptionsString, destination));
@@ -1654,6 +1655,7 @@ Status GetFromString(DBOptions* source, DBOptions* destination) {
       "use_adaptive_mutex=true;"
       "max_total_wal_size=4295005604;"
       "compaction_readahead_size=0;"
+      "use_direct_io_for_compaction=true;"
       "new_table_reader_for_compaction_inputs=true;"
       "keep_log_file_num=4890;"
       "skip_stats_update_on_db_open=true;"
@@ -1890,6 +1892,7 @@ TEST_F(OptionsParserTest, BlockBasedTableOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(BlockBasedTableOptions, flush_block_policy_factory),
       BLACKLIST_ENTRY(BlockBasedTableOptions, block_cache),
       BLACKLIST_ENTRY(BlockBasedTableOptions, block_cache_compressed),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, metadata_block_cache),
       BLACKLIST_ENTRY(BlockBasedTableOptions, filter_policy),
       BLACKLIST_ENTRY(BlockBasedTableOptions, supported_filter_policies),
   };
@@ -1916,6 +1919,7 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, checkpoint_env),
       BLACKLIST_ENTRY(DBOptions, priority_thread_pool_for_compactions_and_flushes),
       BLACKLIST_ENTRY(DBOptions, rate_limiter),
+      BLACKLIST_ENTRY(DBOptions, flush_rate_limiter),
       BLACKLIST_ENTRY(DBOptions, sst_file_manager),
       BLACKLIST_ENTRY(DBOptions, info_log),
       BLACKLIST_ENTRY(DBOptions, statistics),
@@ -1931,7 +1935,10 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, log_prefix),
       BLACKLIST_ENTRY(DBOptions, mem_tracker),
       BLACKLIST_ENTRY(DBOptions, block_based_table_mem_tracker),
+      BLACKLIST_ENTRY(DBOptions, block_based_table_metadata_mem_tracker),
       BLACKLIST_ENTRY(DBOptions, iterator_replacer),
+      BLACKLIST_ENTRY(DBOptions, compaction_output_path_selector),
+      BLACKLIST_ENTRY(DBOptions, sst_files_write_stall_trigger),
   };
 
   TestAllFieldsSettable<DBOptions>(kDBOptionsBlacklist);
@@ -0,0 +1,351 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+
+#include <inttypes.h>
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/filter_policy.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/hash.h"
+
+#include "yb/util/hash_util.h"
+#include "yb/util/logging.h"
+
+// Standard Ribbon filter (https://arxiv.org/abs/2103.02515) of fixed size.
+//
+// Filter is a solution Z of the linear system over GF(2): for each key, dot product of the key's
+// 64-bit coefficient row with slots [start, start + 64) of Z is equal to the key's r-bit
+// fingerprint. Query evaluates the same dot product and compares it with the fingerprint, so false
+// positive rate is 2^-r while filter uses about r / load_factor bits per key, instead of
+// 1.44 * log2(1 / error_rate) bits per key used by Bloom filter.
+//
+// System is solved during Finish by Gaussian elimination on banded matrix ("banding") followed by
+// back substitution. Banding could fail with small probability, in this case it is retried with
+// another seed that is stored in the filter.
+//
+// Solution is stored interleaved: for each block of 64 slots there are r 64-bit words, word k
+// contains bit k of each slot of the block. So query touches at most 2 adjacent blocks.
+//
+// Encoding:
+// +-----------------------------------------------------------------------------------+
+// |                   num_blocks * result_bits * 8 bytes                              |
+// +-----------------------------------------------------------------------------------+
+// | ...       | result_bits : 1 byte | seed : 1 byte | num_blocks : 4 bytes           |
+// +-----------------------------------------------------------------------------------+
+// num_blocks == 0 means empty filter that does not match anything, or, if result_bits is also 0,
+// filter that matches everything (used when banding failed for all seeds).
+
+namespace rocksdb {
+
+namespace {
+
+// Number of slots covered by coefficient row of each key.
+constexpr uint32_t kRibbonWidth = 64;
+// Fraction of slots that could be used by keys. Leaves enough room for banding to succeed with
+// the first seed in almost all cases for filter blocks up to 64KB.
+constexpr double kRibbonLoadFactor = 0.92;
+constexpr uint32_t kRibbonMaxResultBits = 16;
+constexpr uint32_t kRibbonMaxSeeds = 64;
+constexpr size_t kRibbonMetaDataSize = 6;
+constexpr uint64_t kRibbonHashSeed = 0x2f8a4e51c3b7d693ULL;
+
+std::atomic<uint64_t> num_ribbon_match_all_fallbacks{0};
+
+inline uint64_t RibbonHash(const Slice& key) {
+  return yb::HashUtil::MurmurHash2_64(key.data(), static_cast<int>(key.size()), kRibbonHashSeed);
+}
+
+// Remixes key hash with seed, so each seed produces independent rows.
+inline uint64_t RibbonRemix(uint64_t hash, uint64_t seed) {
+  uint64_t x = hash + seed * 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+struct RibbonRow {
+  uint32_t start;
+  // Bit i corresponds to slot start + i. Bit 0 is always set.
+  uint64_t coeff;
+  uint32_t result;
+};
+
+inline RibbonRow MakeRibbonRow(
+    uint64_t hash, uint32_t seed, uint32_t num_blocks, uint32_t result_bits) {
+  const uint64_t x = RibbonRemix(hash, seed);
+  const uint32_t num_starts = num_blocks * kRibbonWidth - kRibbonWidth + 1;
+  return RibbonRow {
+    FastRange32(static_cast<uint32_t>(x >> 32), num_starts),
+    RibbonRemix(x, 1) | 1,
+    static_cast<uint32_t>(x) & ((1U << result_bits) - 1)
+  };
+}
+
+inline uint32_t Parity(uint64_t value) {
+  return static_cast<uint32_t>(__builtin_parityll(value));
+}
+
+class FixedSizeRibbonBitsBuilder : public FilterBitsBuilder {
+ public:
+  FixedSizeRibbonBitsBuilder(const FixedSizeRibbonBitsBuilder&) = delete;
+  void operator=(const FixedSizeRibbonBitsBuilder&) = delete;
+
+  FixedSizeRibbonBitsBuilder(
+      uint32_t result_bits, uint32_t num_blocks, size_t max_keys, Logger* logger)
+      : result_bits_(result_bits), num_blocks_(num_blocks), max_keys_(max_keys), logger_(logger) {
+    hashes_.reserve(max_keys_);
+  }
+
+  void AddKey(const Slice& key) override {
+    hashes_.push_back(RibbonHash(key));
+  }
+
+  bool IsFull() const override { return hashes_.size() >= max_keys_; }
+
+  Slice Finish(std::unique_ptr<const char[]>* buf) override {
+    if (hashes_.empty()) {
+      return Encode(result_bits_, /* seed= */ 0, /* num_blocks= */ 0, buf);
+    }
+    for (uint32_t seed = 0; seed != kRibbonMaxSeeds; ++seed) {
+      if (Band(seed)) {
+        return BackSubstitute(seed, buf);
+      }
+    }
+    const auto num_fallbacks = num_ribbon_match_all_fallbacks.fetch_add(1) + 1;
+    RLOG(InfoLogLevel::WARN_LEVEL, logger_,
+         "Failed to build ribbon filter for %zu keys, filter will match any key. Total filters "
+         "that match any key: %" PRIu64,
+         hashes_.size(), num_fallbacks);
+    return Encode(/* result_bits= */ 0, /* seed= */ 0, /* num_blocks= */ 0, buf);
+  }
+
+ private:
+  size_t NumSlots() const { return num_blocks_ * kRibbonWidth; }
+
+  // Performs Gaussian elimination, so that each non empty slot i contains row with the lowest set
+  // bit at i. Returns false if system is inconsistent.
+  bool Band(uint32_t seed) {
+    coeffs_.assign(NumSlots(), 0);
+    results_.assign(NumSlots(), 0);
+    for (auto hash : hashes_) {
+      auto row = MakeRibbonRow(hash, seed, num_blocks_, result_bits_);
+      size_t i = row.start;
+      for (;;) {
+        if (coeffs_[i] == 0) {
+          coeffs_[i] = row.coeff;
+          results_[i] = row.result;
+          break;
+        }
+        row.coeff ^= coeffs_[i];
+        row.result ^= results_[i];
+        if (row.coeff == 0) {
+          // Row is linear combination of already added rows, i.e. duplicate key in most cases.
+          if (row.result != 0) {
+            return false;
+          }
+          break;
+        }
+        const int shift = __builtin_ctzll(row.coeff);
+        i += shift;
+        row.coeff >>= shift;
+      }
+    }
+    return true;
+  }
+
+  Slice BackSubstitute(uint32_t seed, std::unique_ptr<const char[]>* buf) {
+    std::unique_ptr<char[]> data(new char[FilterSize(result_bits_, num_blocks_)]);
+    // state[k] contains bit k of solution for the last 64 processed slots, the lowest bit
+    // corresponds to the current slot.
+    uint64_t state[kRibbonMaxResultBits] = {0};
+    for (size_t i = NumSlots(); i-- > 0;) {
+      const uint64_t coeff = coeffs_[i];
+      // Slot without row could have arbitrary value, use pseudo random one to avoid false
+      // positives of keys whose rows mostly cover empty slots.
+      const uint32_t result = coeff ? results_[i] : static_cast<uint32_t>(RibbonRemix(i, seed));
+      for (uint32_t k = 0; k != result_bits_; ++k) {
+        const uint64_t shifted = state[k] << 1;
+        state[k] = shifted | (((result >> k) & 1) ^ Parity(coeff & shifted));
+      }
+      if (i % kRibbonWidth == 0) {
+        char* block = data.get() + (i / kRibbonWidth) * result_bits_ * sizeof(uint64_t);
+        for (uint32_t k = 0; k != result_bits_; ++k) {
+          EncodeFixed64(block + k * sizeof(uint64_t), state[k]);
+        }
+      }
+    }
+    coeffs_.clear();
+    coeffs_.shrink_to_fit();
+    results_.clear();
+    results_.shrink_to_fit();
+    buf->reset(data.release());
+    return Encode(result_bits_, seed, num_blocks_, buf);
+  }
+
+  static size_t FilterSize(uint32_t result_bits, uint32_t num_blocks) {
+    return num_blocks * result_bits * sizeof(uint64_t) + kRibbonMetaDataSize;
+  }
+
+  // Appends metadata to the filter data in buf, allocating buf if there is no filter data.
+  static Slice Encode(uint32_t result_bits, uint32_t seed, uint32_t num_blocks,
+                      std::unique_ptr<const char[]>* buf) {
+    const size_t size = FilterSize(result_bits, num_blocks);
+    char* data;
+    if (num_blocks == 0) {
+      data = new char[size];
+      buf->reset(data);
+    } else {
+      data = const_cast<char*>(buf->get());
+    }
+    char* meta = data + size - kRibbonMetaDataSize;
+    meta[0] = static_cast<char>(result_bits);
+    meta[1] = static_cast<char>(seed);
+    EncodeFixed32(meta + 2, num_blocks);
+    return Slice(data, size);
+  }
+
+  const uint32_t result_bits_;
+  const uint32_t num_blocks_;
+  const size_t max_keys_;
+  Logger* logger_;
+  std::vector<uint64_t> hashes_;
+  std::vector<uint64_t> coeffs_;
+  std::vector<uint32_t> results_;
+};
+
+class FixedSizeRibbonBitsReader : public FilterBitsReader {
+ public:
+  FixedSizeRibbonBitsReader(const FixedSizeRibbonBitsReader&) = delete;
+  void operator=(const FixedSizeRibbonBitsReader&) = delete;
+
+  FixedSizeRibbonBitsReader(const Slice& contents, Logger* logger) : data_(contents.cdata()) {
+    if (contents.size() < kRibbonMetaDataSize) {
+      return;
+    }
+    const char* meta = contents.cdata() + contents.size() - kRibbonMetaDataSize;
+    result_bits_ = static_cast<uint8_t>(meta[0]);
+    seed_ = static_cast<uint8_t>(meta[1]);
+    num_blocks_ = DecodeFixed32(meta + 2);
+    match_all_ = num_blocks_ == 0 && result_bits_ == 0;
+    if (result_bits_ > kRibbonMaxResultBits ||
+        (num_blocks_ != 0 && result_bits_ == 0) ||
+        contents.size() !=
+            num_blocks_ * result_bits_ * sizeof(uint64_t) + kRibbonMetaDataSize) {
+      RLOG(InfoLogLevel::ERROR_LEVEL, logger, "Ribbon filter data is broken, won't be used.");
+      FAIL_IF_NOT_PRODUCTION();
+      result_bits_ = 0;
+      num_blocks_ = 0;
+      match_all_ = true;
+    }
+  }
+
+  bool MayMatch(const Slice& entry) override {
+    if (num_blocks_ == 0) {
+      // Empty filter does not match anything, filter without result bits matches everything.
+      return match_all_;
+    }
+    const auto row = MakeRibbonRow(RibbonHash(entry), seed_, num_blocks_, result_bits_);
+    const size_t block_size = result_bits_ * sizeof(uint64_t);
+    const char* block = data_ + (row.start / kRibbonWidth) * block_size;
+    const uint32_t offset = row.start % kRibbonWidth;
+    uint32_t result = 0;
+    if (offset == 0) {
+      for (uint32_t k = 0; k != result_bits_; ++k) {
+        const uint64_t segment = DecodeFixed64(block + k * sizeof(uint64_t));
+        result |= Parity(segment & row.coeff) << k;
+      }
+    } else {
+      // Row spans 2 adjacent blocks, the last block is never used as the first one in this case.
+      const char* next_block = block + block_size;
+      for (uint32_t k = 0; k != result_bits_; ++k) {
+        const uint64_t segment = (DecodeFixed64(block + k * sizeof(uint64_t)) >> offset) |
+                                 (DecodeFixed64(next_block + k * sizeof(uint64_t)) <<
+                                     (kRibbonWidth - offset));
+        result |= Parity(segment & row.coeff) << k;
+      }
+    }
+    return result == row.result;
+  }
+
+ private:
+  const char* data_;
+  uint32_t result_bits_ = 0;
+  uint32_t seed_ = 0;
+  uint32_t num_blocks_ = 0;
+  bool match_all_ = false;
+};
+
+class FixedSizeRibbonFilterPolicy : public FilterPolicy {
+ public:
+  FixedSizeRibbonFilterPolicy(uint32_t total_bits, double error_rate, Logger* logger)
+      : result_bits_(std::min<uint32_t>(
+            std::max<uint32_t>(static_cast<uint32_t>(std::ceil(-std::log2(error_rate))), 1),
+            kRibbonMaxResultBits)),
+        num_blocks_(std::max<uint32_t>(total_bits / (kRibbonWidth * result_bits_), 1)),
+        max_keys_(static_cast<size_t>(num_blocks_ * kRibbonWidth * kRibbonLoadFactor)),
+        logger_(logger) {
+    DCHECK_GT(error_rate, 0);
+  }
+
+  FilterType GetFilterType() const override { return FilterType::kFixedSizeFilter; }
+
+  const char* Name() const override {
+    return "rocksdb.FixedSizeRibbonFilter";
+  }
+
+  // Not used in FixedSizeFilter. GetFilterBitsBuilder/Reader interface should be used.
+  void CreateFilter(const Slice* keys, int n, std::string* dst) const override {
+    assert(!"FixedSizeRibbonFilterPolicy::CreateFilter is not supported");
+  }
+
+  bool KeyMayMatch(const Slice& key, const Slice& filter) const override {
+    assert(!"FixedSizeRibbonFilterPolicy::KeyMayMatch is not supported");
+    return true;
+  }
+
+  FilterBitsBuilder* GetFilterBitsBuilder() const override {
+    return new FixedSizeRibbonBitsBuilder(result_bits_, num_blocks_, max_keys_, logger_);
+  }
+
+  FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override {
+    return new FixedSizeRibbonBitsReader(contents, logger_);
+  }
+
+ private:
+  const uint32_t result_bits_;
+  const uint32_t num_blocks_;
+  const size_t max_keys_;
+  Logger* logger_;
+};
+
+} // namespace
+
+uint64_t NumFixedSizeRibbonFilterFallbacks() {
+  return num_ribbon_match_all_fallbacks.load(std::memory_order_relaxed);
+}
+
+const FilterPolicy* NewFixedSizeRibbonFilterPolicy(uint32_t total_bits,
+                                                   double error_rate,
+                                                   Logger* logger) {
+  return new FixedSizeRibbonFilterPolicy(total_bits, error_rate, logger);
+}
+
+}  // namespace rocksdb
@@ -32,6 +32,7 @@
 #include <inttypes.h>
 #include <algorithm>
 #include <string>
+#include <unordered_set>
 #include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/db/wal_manager.h"
 #include "yb/rocksdb/db.h"
@@ -45,6 +46,22 @@
 namespace rocksdb {
 namespace checkpoint {
 
+namespace {
+
+// Returns directory that contains the specified table file, that could be placed to any of
+// db_paths.
+std::string TableFileDir(DB* db, const std::string& fname) {
+  const auto& db_paths = db->GetDBOptions().db_paths;
+  for (size_t path_id = 1; path_id < db_paths.size(); ++path_id) {
+    if (db->GetCheckpointEnv()->FileExists(db_paths[path_id].path + fname).ok()) {
+      return db_paths[path_id].path;
+    }
+  }
+  return db->GetName();
+}
+
+} // namespace
+
 // Builds an openable snapshot of RocksDB on the same disk, which
 // accepts an output directory on the same disk, and under the directory
 // (1) hard-linked SST files pointing to existing live SST files
@@ -59,7 +76,9 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
   std::vector<std::string> live_files;
   uint64_t manifest_file_size = 0;
   uint64_t sequence_number = db->GetLatestSequenceNumber();
-  bool same_fs = true;
+  // Source directories, whose files could not be hard linked to the checkpoint directory, since
+  // they are located on another filesystem. Table files could be located in any of db_paths.
+  std::unordered_set<std::string> copy_dirs;
   VectorLogPtr live_wal_files;
   bool delete_checkpoint_dir = false;
 
@@ -115,20 +134,26 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
     // * if it's kTableFile or kTableSBlockFile, then it's shared
     // * if it's kDescriptorFile, limit the size to manifest_file_size
     // * always copy if cross-device link
+    // Table files from all db_paths are placed to the checkpoint directory, and their paths are
+    // resolved when the checkpoint is opened. So files from slow db_paths end up in the first
+    // (fast) path of the DB opened from the checkpoint, until they are compacted again.
     bool is_table_file = type == kTableFile || type == kTableSBlockFile;
-    if (is_table_file && same_fs) {
+    const std::string src_dir = is_table_file ? TableFileDir(db, src_fname) : db->GetName();
+    bool link = is_table_file && copy_dirs.count(src_dir) == 0;
+    if (link) {
       RLOG(db->GetOptions().info_log, "Hard Linking %s", src_fname.c_str());
-      s = db->GetCheckpointEnv()->LinkFile(db->GetName() + src_fname,
+      s = db->GetCheckpointEnv()->LinkFile(src_dir + src_fname,
                                  full_private_path + src_fname);
       if (s.IsNotSupported()) {
-        same_fs = false;
+        copy_dirs.insert(src_dir);
+        link = false;
         s = Status::OK();
       }
     }
-    if (!is_table_file || !same_fs) {
+    if (!link) {
       RLOG(db->GetOptions().info_log, "Copying %s", src_fname.c_str());
       std::string dest_name = full_private_path + src_fname;
-      s = CopyFile(db->GetCheckpointEnv(), db->GetName() + src_fname, dest_name,
+      s = CopyFile(db->GetCheckpointEnv(), src_dir + src_fname, dest_name,
                    type == kDescriptorFile ? manifest_file_size : 0);
     }
   }
@@ -149,19 +174,22 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
                      live_wal_files[i]->SizeFileBytes());
         break;
       }
-      if (same_fs) {
+      const auto& wal_dir = db->GetOptions().wal_dir;
+      bool link = copy_dirs.count(wal_dir) == 0;
+      if (link) {
         // we only care about live log files
         RLOG(db->GetOptions().info_log, "Hard Linking %s",
              live_wal_files[i]->PathName().c_str());
         s = db->GetCheckpointEnv()->LinkFile(
-             db->GetOptions().wal_dir + live_wal_files[i]->PathName(),
+             wal_dir + live_wal_files[i]->PathName(),
              full_private_path + live_wal_files[i]->PathName());
         if (s.IsNotSupported()) {
-          same_fs = false;
+          copy_dirs.insert(wal_dir);
+          link = false;
           s = Status::OK();
         }
       }
-      if (!same_fs) {
+      if (!link) {
         RLOG(db->GetOptions().info_log, "Copying %s",
              live_wal_files[i]->PathName().c_str());
         s = CopyFile(db->GetCheckpointEnv(),
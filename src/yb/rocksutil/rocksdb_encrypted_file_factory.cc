@@ -134,8 +134,12 @@ class RocksDBEncryptedFileFactory : public rocksdb::RocksDBFileFactoryWrapper {
 
   Status NewWritableFile(const std::string& fname, std::unique_ptr<rocksdb::WritableFile>* result,
                          const rocksdb::EnvOptions& options) override {
+    // Encrypted file appends header and data at unaligned offsets, so it cannot use direct I/O.
+    auto buffered_options = options;
+    buffered_options.use_direct_writes = false;
     std::unique_ptr<rocksdb::WritableFile> underlying;
-    RETURN_NOT_OK(RocksDBFileFactoryWrapper::NewWritableFile(fname, &underlying, options));
+    RETURN_NOT_OK(RocksDBFileFactoryWrapper::NewWritableFile(
+        fname, &underlying, buffered_options));
     return RocksDBEncryptedWritableFile::Create(
         result, header_manager_.get(), std::move(underlying));
   }
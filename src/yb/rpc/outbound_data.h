@@ -43,6 +43,10 @@ class OutboundData : public std::enable_shared_from_this<OutboundData> {
   // Serializes the data to be sent out via the RPC framework.
   virtual void Serialize(boost::container::small_vector_base<RefCntBuffer>* output) = 0;
 
+  // Already serialized data that is sent right after the buffers produced by Serialize, without
+  // being copied into them. The memory it refers to should be kept alive by this object.
+  virtual Slice SerializedTail() const { return Slice(); }
+
   virtual std::string ToString() const = 0;
 
   virtual bool DumpPB(const DumpRunningRpcsRequestPB& req, RpcCallInProgressPB* resp) = 0;
@@ -354,6 +354,8 @@ class SecureStream : public Stream, public StreamContext {
   static int VerifyCallback(int preverified, X509_STORE_CTX* store_context);
   bool Verify(bool preverified, X509_STORE_CTX* store_context);
   CHECKED_STATUS SendEncrypted(OutboundDataPtr data);
+  // Passes slice to SSL, writing out encrypted data when SSL buffer is full.
+  CHECKED_STATUS Encrypt(Slice slice);
   Result<bool> WriteEncrypted(OutboundDataPtr data);
   CHECKED_STATUS ReadDecrypted();
   Result<size_t> SslRead(void* buf, int num);
@@ -404,29 +406,36 @@ Status SecureStream::SendEncrypted(OutboundDataPtr data) {
   boost::container::small_vector<RefCntBuffer, 10> queue;
   data->Serialize(&queue);
   for (const auto& buf : queue) {
-    Slice slice(buf.data(), buf.size());
-    for (;;) {
-      auto len = SSL_write(ssl_.get(), slice.data(), slice.size());
-      if (len == slice.size()) {
-        break;
-      }
-      auto error = len <= 0 ? SSL_get_error(ssl_.get(), len) : SSL_ERROR_NONE;
-      VLOG_WITH_PREFIX(4) << "SSL_write was not full: " << slice.size() << ", written: " << len
-                          << ", error: " << error;
-      if (error != SSL_ERROR_NONE) {
-        if (error != SSL_ERROR_WANT_WRITE || !VERIFY_RESULT(WriteEncrypted(nullptr))) {
-          return STATUS_FORMAT(
-              NetworkError, "SSL write failed: $0 ($1)", SSLErrorMessage(error), error);
-        }
-      } else {
-        RETURN_NOT_OK(WriteEncrypted(nullptr));
-      }
-      if (len > 0) {
-        slice.remove_prefix(len);
+    RETURN_NOT_OK(Encrypt(buf.AsSlice()));
+  }
+  const auto tail = data->SerializedTail();
+  if (!tail.empty()) {
+    RETURN_NOT_OK(Encrypt(tail));
+  }
+  return ResultToStatus(WriteEncrypted(std::move(data)));
+}
+
+Status SecureStream::Encrypt(Slice slice) {
+  for (;;) {
+    auto len = SSL_write(ssl_.get(), slice.data(), slice.size());
+    if (len == slice.size()) {
+      return Status::OK();
+    }
+    auto error = len <= 0 ? SSL_get_error(ssl_.get(), len) : SSL_ERROR_NONE;
+    VLOG_WITH_PREFIX(4) << "SSL_write was not full: " << slice.size() << ", written: " << len
+                        << ", error: " << error;
+    if (error != SSL_ERROR_NONE) {
+      if (error != SSL_ERROR_WANT_WRITE || !VERIFY_RESULT(WriteEncrypted(nullptr))) {
+        return STATUS_FORMAT(
+            NetworkError, "SSL write failed: $0 ($1)", SSLErrorMessage(error), error);
       }
+    } else {
+      RETURN_NOT_OK(WriteEncrypted(nullptr));
+    }
+    if (len > 0) {
+      slice.remove_prefix(len);
     }
   }
-  return ResultToStatus(WriteEncrypted(std::move(data)));
 }
 
 Result<size_t> SecureStream::Send(OutboundDataPtr data) {
@@ -175,6 +175,19 @@ TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
         return FillIovResult{index, only_heartbeats};
       }
     }
+    if (data.tail.empty()) {
+      continue;
+    }
+    if (offset >= data.tail.size()) {
+      offset -= data.tail.size();
+      continue;
+    }
+    out[index].iov_base = const_cast<uint8_t*>(data.tail.data()) + offset;
+    out[index].iov_len = data.tail.size() - offset;
+    offset = 0;
+    if (++index == kMaxIov) {
+      return FillIovResult{index, only_heartbeats};
+    }
   }
 
   return FillIovResult{index, only_heartbeats};
@@ -510,6 +523,7 @@ StreamFactoryPtr TcpStream::Factory() {
 TcpStreamSendingData::TcpStreamSendingData(OutboundDataPtr data_, const MemTrackerPtr& mem_tracker)
     : data(std::move(data_)) {
   data->Serialize(&bytes);
+  tail = data->SerializedTail();
   if (mem_tracker) {
     size_t memory_used = sizeof(*this);
     memory_used += DynamicMemoryUsageOf(data);
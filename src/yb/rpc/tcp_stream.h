@@ -35,16 +35,19 @@ struct TcpStreamSendingData {
     for (const auto& entry : bytes) {
       result += entry.size();
     }
-    return result;
+    return result + tail.size();
   }
 
   void ClearBytes() {
     bytes.clear();
+    tail = Slice();
     consumption = ScopedTrackedConsumption();
   }
 
   OutboundDataPtr data;
   SendingBytes bytes;
+  // See OutboundData::SerializedTail, owned by data.
+  Slice tail;
   ScopedTrackedConsumption consumption;
   bool skipped = false;
 };
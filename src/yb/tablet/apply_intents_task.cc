@@ -15,6 +15,8 @@
 
 #include "yb/docdb/docdb.h"
 
+#include "yb/rocksdb/write_batch.h"
+
 #include "yb/tablet/running_transaction.h"
 
 #include "yb/util/flag_tags.h"
@@ -25,14 +27,65 @@ DEFINE_int64(apply_intents_task_injected_delay_ms, 0,
              "Inject such delay before applying intents for large transactions. "
              "Could be used to throttle the apply speed.");
 
+DEFINE_bool(txn_pipelined_apply, true,
+            "Prepare the next batch of intents of a large transaction while the previous batch "
+            "is being written to regular DB.");
+TAG_FLAG(txn_pipelined_apply, runtime);
+TAG_FLAG(txn_pipelined_apply, advanced);
+
 namespace yb {
 namespace tablet {
 
+// Writes batch of applied intents to regular DB in the thread pool, while the next batch is being
+// prepared. If the next batch is already prepared when the write is done, the task is enqueued to
+// the participant strand to continue the apply there.
+class WriteAppliedIntentsTask : public rpc::StrandTask {
+ public:
+  WriteAppliedIntentsTask(ApplyIntentsTask* apply_task, RunningTransactionPtr transaction)
+      : apply_task_(*apply_task), transaction_(std::move(transaction)),
+        operation_(&apply_task->running_transaction_context_.applying_intents()) {}
+
+  virtual ~WriteAppliedIntentsTask() = default;
+
+  void Run() override {
+    if (continuing_) {
+      if (apply_task_.StepApplied(transaction_)) {
+        apply_task_.ApplyBatches(transaction_);
+      }
+      return;
+    }
+    apply_task_.applier_.WriteAppliedIntents(apply_task_.apply_data_, &apply_task_.batch_);
+  }
+
+  void Done(const Status& status) override {
+    if (!continuing_) {
+      // Status is not OK when the task was rejected by the thread pool, so nothing was written.
+      apply_task_.write_status_ = status;
+      if (apply_task_.StepPartDone()) {
+        continuing_ = true;
+        apply_task_.participant_context_.StrandEnqueue(this);
+        return;
+      }
+    }
+    delete this;
+  }
+
+ private:
+  ApplyIntentsTask& apply_task_;
+  // Keeps the transaction, and so the apply task, alive until the apply is continued.
+  RunningTransactionPtr transaction_;
+  // Participant shutdown waits until the write and the continuation of the apply are done.
+  ScopedOperation operation_;
+  // Whether the batch is written and the task was enqueued to the strand to continue the apply.
+  bool continuing_ = false;
+};
+
 ApplyIntentsTask::ApplyIntentsTask(TransactionIntentApplier* applier,
+                                   TransactionParticipantContext* participant_context,
                                    RunningTransactionContext* running_transaction_context,
                                    const TransactionApplyData* apply_data)
-    : applier_(*applier), running_transaction_context_(*running_transaction_context),
-      apply_data_(*apply_data) {}
+    : applier_(*applier), participant_context_(*participant_context),
+      running_transaction_context_(*running_transaction_context), apply_data_(*apply_data) {}
 
 bool ApplyIntentsTask::Prepare(RunningTransactionPtr transaction) {
   bool expected = false;
@@ -47,29 +100,73 @@ bool ApplyIntentsTask::Prepare(RunningTransactionPtr transaction) {
 void ApplyIntentsTask::Run() {
   VLOG_WITH_PREFIX(4) << __func__;
 
+  state_ = applier_.PrepareApplyIntents(apply_data_, apply_data_.apply_state, &batch_);
+  ApplyBatches(transaction_);
+}
+
+void ApplyIntentsTask::ApplyBatches(const RunningTransactionPtr& transaction) {
+  // Batch for the next portion of intents is prepared before the current one is written, so with
+  // pipelining enabled iteration over intents DB overlaps with writes to regular DB.
+  // Nobody waits for the write, so the apply is continued by whoever finishes last, always in the
+  // participant strand.
+  ScopedOperation operation(&running_transaction_context_.applying_intents());
   for (;;) {
     AtomicFlagSleepMs(&FLAGS_apply_intents_task_injected_delay_ms);
 
     if (running_transaction_context_.Closing()) {
-      VLOG_WITH_PREFIX(1) << "Abort because of shutdown";
-      break;
+      VLOG(1) << transaction->LogPrefix() << "Abort because of shutdown";
+      return;
     }
-    auto result = applier_.ApplyIntents(apply_data_);
-    if (!result.ok()) {
-      LOG_WITH_PREFIX(DFATAL)
-          << "Failed to apply intents " << apply_data_.ToString() << ": " << result.status();
-      break;
+    if (!state_.ok()) {
+      LOG(DFATAL) << transaction->LogPrefix() << "Failed to apply intents "
+                  << apply_data_.ToString() << ": " << state_.status();
+      return;
     }
 
-    transaction_->SetApplyData(*result);
-    VLOG_WITH_PREFIX(2) << "Performed next apply step: " << result->ToString();
+    applied_state_ = std::move(*state_);
+    next_batch_.Clear();
+    if (applied_state_.active() && FLAGS_txn_pipelined_apply) {
+      pending_step_parts_.store(2, std::memory_order_release);
+      participant_context_.Enqueue(new WriteAppliedIntentsTask(this, transaction));
+      state_ = applier_.PrepareApplyIntents(apply_data_, &applied_state_, &next_batch_);
+      if (!StepPartDone()) {
+        return;
+      }
+    } else {
+      applier_.WriteAppliedIntents(apply_data_, &batch_);
+      if (applied_state_.active()) {
+        state_ = applier_.PrepareApplyIntents(apply_data_, &applied_state_, &next_batch_);
+      }
+    }
 
-    if (!result->active()) {
-      break;
+    if (!StepApplied(transaction)) {
+      return;
     }
   }
 }
 
+bool ApplyIntentsTask::StepPartDone() {
+  return pending_step_parts_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+}
+
+bool ApplyIntentsTask::StepApplied(const RunningTransactionPtr& transaction) {
+  if (!write_status_.ok()) {
+    // Intents that were not applied are applied again after restart.
+    LOG(WARNING) << transaction->LogPrefix() << "Abort apply, failed to write batch: "
+                 << write_status_;
+    return false;
+  }
+  transaction->SetApplyData(applied_state_);
+  VLOG(2) << transaction->LogPrefix() << "Performed next apply step: "
+          << applied_state_.ToString();
+
+  if (!applied_state_.active()) {
+    return false;
+  }
+  std::swap(batch_, next_batch_);
+  return true;
+}
+
 void ApplyIntentsTask::Done(const Status& status) {
   WARN_NOT_OK(status, "Apply intents task failed");
   transaction_.reset();
@@ -14,6 +14,10 @@
 #ifndef YB_TABLET_APPLY_INTENTS_TASK_H
 #define YB_TABLET_APPLY_INTENTS_TASK_H
 
+#include "yb/docdb/docdb.h"
+
+#include "yb/rocksdb/write_batch.h"
+
 #include "yb/rpc/strand.h"
 
 #include "yb/tablet/running_transaction_context.h"
@@ -21,10 +25,13 @@
 namespace yb {
 namespace tablet {
 
+class WriteAppliedIntentsTask;
+
 // Used by RunningTransaction to apply its intents.
 class ApplyIntentsTask : public rpc::StrandTask {
  public:
   ApplyIntentsTask(TransactionIntentApplier* applier,
+                   TransactionParticipantContext* participant_context,
                    RunningTransactionContext* running_transaction_context,
                    const TransactionApplyData* apply_data);
 
@@ -36,9 +43,25 @@ class ApplyIntentsTask : public rpc::StrandTask {
   virtual ~ApplyIntentsTask() = default;
 
  private:
+  friend class WriteAppliedIntentsTask;
+
   std::string LogPrefix() const;
 
+  // Applies batch_, whose preparation resulted in state_, and the following batches.
+  // Returns early when the current batch is still being written in background. In this case the
+  // apply is continued by the write task.
+  void ApplyBatches(const RunningTransactionPtr& transaction);
+
+  // Invoked when writing the current batch or preparing the next one is done, while those are
+  // performed in parallel. Returns true when both are done.
+  bool StepPartDone();
+
+  // Publishes state of the completed step. Returns true if there are more intents to apply.
+  // Invoked in the participant strand.
+  bool StepApplied(const RunningTransactionPtr& transaction);
+
   TransactionIntentApplier& applier_;
+  TransactionParticipantContext& participant_context_;
   RunningTransactionContext& running_transaction_context_;
   const TransactionApplyData& apply_data_;
 
@@ -47,6 +70,16 @@ class ApplyIntentsTask : public rpc::StrandTask {
   // The task can be submitted only once, so this flag never reverts its state to false.
   std::atomic<bool> used_{false};
   RunningTransactionPtr transaction_;
+
+  // Batch that is being written to regular DB and result of its preparation.
+  rocksdb::WriteBatch batch_;
+  Result<docdb::ApplyTransactionState> state_{docdb::ApplyTransactionState()};
+  // State after batch_ is applied, next_batch_ is prepared from it.
+  docdb::ApplyTransactionState applied_state_;
+  rocksdb::WriteBatch next_batch_;
+  std::atomic<int> pending_step_parts_{0};
+  // Result of writing batch_ in background, published by decrementing pending_step_parts_.
+  Status write_status_;
 };
 
 } // namespace tablet
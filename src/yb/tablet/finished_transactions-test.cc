@@ -0,0 +1,85 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/tablet/finished_transactions.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tablet {
+
+class FinishedTransactionsTest : public YBTest {
+};
+
+TEST_F(FinishedTransactionsTest, MaxSize) {
+  FinishedTransactions transactions(2);
+  ASSERT_TRUE(transactions.Add(TransactionId::GenerateRandom(), HybridTime(1), OpId::Min()));
+  ASSERT_TRUE(transactions.Add(TransactionId::GenerateRandom(), HybridTime(2), OpId::Min()));
+  auto rejected = TransactionId::GenerateRandom();
+  ASSERT_FALSE(transactions.Add(rejected, HybridTime(3), OpId::Min()));
+  ASSERT_FALSE(transactions.Contains(rejected));
+  ASSERT_EQ(2, transactions.size());
+}
+
+TEST_F(FinishedTransactionsTest, FullCompaction) {
+  FinishedTransactions transactions(10);
+  auto flushed = TransactionId::GenerateRandom();
+  auto not_flushed = TransactionId::GenerateRandom();
+  ASSERT_TRUE(transactions.Add(flushed, HybridTime(5), OpId::Min()));
+  ASSERT_TRUE(transactions.Add(not_flushed, HybridTime(10), OpId::Min()));
+
+  auto snapshot = transactions.Snapshot();
+  ASSERT_EQ(2, snapshot->size());
+  // Snapshot is reused while there are no changes.
+  ASSERT_EQ(snapshot, transactions.Snapshot());
+
+  // Transaction added after compaction was started is not affected by it.
+  auto added_later = TransactionId::GenerateRandom();
+  ASSERT_TRUE(transactions.Add(added_later, HybridTime(3), OpId::Min()));
+  ASSERT_NE(snapshot, transactions.Snapshot());
+
+  transactions.FullCompactionDone(*snapshot, HybridTime(7), OpId::Min());
+  ASSERT_FALSE(transactions.Contains(flushed));
+  ASSERT_TRUE(transactions.Contains(not_flushed));
+  ASSERT_TRUE(transactions.Contains(added_later));
+  ASSERT_EQ(2, transactions.Snapshot()->size());
+}
+
+TEST_F(FinishedTransactionsTest, RegularDbFlush) {
+  FinishedTransactions transactions(10);
+  auto aborted = TransactionId::GenerateRandom();
+  auto applied = TransactionId::GenerateRandom();
+  auto applied_later = TransactionId::GenerateRandom();
+  ASSERT_TRUE(transactions.Add(aborted, HybridTime(1), OpId::Min()));
+  ASSERT_TRUE(transactions.Add(applied, HybridTime(2), OpId(1, 5)));
+  ASSERT_TRUE(transactions.Add(applied_later, HybridTime(3), OpId(1, 10)));
+
+  auto snapshot = transactions.Snapshot();
+  const OpId regular_flushed_op_id(1, 5);
+  ASSERT_TRUE(snapshot->at(aborted).CanDrop(regular_flushed_op_id));
+  ASSERT_TRUE(snapshot->at(applied).CanDrop(regular_flushed_op_id));
+  // Intents are required to replay apply, that is not flushed to regular DB yet.
+  ASSERT_FALSE(snapshot->at(applied_later).CanDrop(regular_flushed_op_id));
+
+  transactions.FullCompactionDone(*snapshot, HybridTime(10), regular_flushed_op_id);
+  ASSERT_FALSE(transactions.Contains(aborted));
+  ASSERT_FALSE(transactions.Contains(applied));
+  ASSERT_TRUE(transactions.Contains(applied_later));
+
+  transactions.FullCompactionDone(*transactions.Snapshot(), HybridTime(10), OpId(2, 1));
+  ASSERT_EQ(0, transactions.size());
+}
+
+} // namespace tablet
+} // namespace yb
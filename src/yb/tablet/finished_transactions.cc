@@ -0,0 +1,66 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/finished_transactions.h"
+
+namespace yb {
+namespace tablet {
+
+bool FinishedTransactions::Add(
+    const TransactionId& id, HybridTime removal_time, const OpId& apply_op_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (transactions_.size() >= max_size_) {
+    return false;
+  }
+  transactions_.emplace(id, Entry{removal_time, apply_op_id});
+  snapshot_.reset();
+  return true;
+}
+
+bool FinishedTransactions::Contains(const TransactionId& id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return transactions_.count(id) != 0;
+}
+
+FinishedTransactions::MapPtr FinishedTransactions::Snapshot() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!snapshot_) {
+    snapshot_ = std::make_shared<Map>(transactions_);
+  }
+  return snapshot_;
+}
+
+void FinishedTransactions::FullCompactionDone(
+    const Map& snapshot, HybridTime flushed_time, const OpId& regular_flushed_op_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bool erased = false;
+  for (const auto& id_and_entry : snapshot) {
+    // Intents written after the flushed time could be in memtable when compaction started, so
+    // compaction did not see them.
+    if (id_and_entry.second.removal_time <= flushed_time &&
+        id_and_entry.second.CanDrop(regular_flushed_op_id)) {
+      erased = transactions_.erase(id_and_entry.first) != 0 || erased;
+    }
+  }
+  if (erased) {
+    snapshot_.reset();
+  }
+}
+
+size_t FinishedTransactions::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return transactions_.size();
+}
+
+} // namespace tablet
+} // namespace yb
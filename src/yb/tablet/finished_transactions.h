@@ -0,0 +1,97 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_FINISHED_TRANSACTIONS_H
+#define YB_TABLET_FINISHED_TRANSACTIONS_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/common/hybrid_time.h"
+#include "yb/common/transaction.h"
+
+#include "yb/util/opid.h"
+#include "yb/util/thread_annotations.h"
+
+namespace yb {
+namespace tablet {
+
+// Aborted or applied transactions that were removed from the transaction participant, but whose
+// intents were not removed explicitly. Such intents are dropped by intents DB compaction instead,
+// avoiding delete records in the intents DB.
+//
+// Intents of applied transaction are required to replay its apply during bootstrap, until apply
+// is flushed to regular DB. So such intents are dropped only when flushed op id of regular DB is
+// not less than op id of the apply.
+//
+// Transaction is forgotten after a full compaction of intents DB, that was started when all
+// intents of this transaction were already flushed and could be dropped, since such compaction
+// dropped all of them. Operations are applied to intents DB in hybrid time order, so intents of
+// transaction are flushed when flushed hybrid time of intents DB is not less than hybrid time of
+// transaction removal.
+//
+// Thread safe.
+class FinishedTransactions {
+ public:
+  struct Entry {
+    // Hybrid time when transaction was removed. All intents of the transaction were written before
+    // this time.
+    HybridTime removal_time;
+    // Op id of apply operation, OpId::Min() for aborted transaction.
+    OpId apply_op_id;
+
+    // Whether intents of transaction could be dropped, when regular DB is flushed up to
+    // regular_flushed_op_id.
+    bool CanDrop(const OpId& regular_flushed_op_id) const {
+      return apply_op_id <= regular_flushed_op_id;
+    }
+  };
+
+  using Map = std::unordered_map<TransactionId, Entry, TransactionIdHash>;
+  using MapPtr = std::shared_ptr<const Map>;
+
+  explicit FinishedTransactions(size_t max_size) : max_size_(max_size) {}
+
+  FinishedTransactions(const FinishedTransactions&) = delete;
+  void operator=(const FinishedTransactions&) = delete;
+
+  // Returns false when there are too many transactions waiting for compaction. Intents of such
+  // transaction should be removed explicitly.
+  bool Add(const TransactionId& id, HybridTime removal_time, const OpId& apply_op_id);
+
+  bool Contains(const TransactionId& id) const;
+
+  // Returns transactions whose intents should be dropped by the compaction that is being started.
+  MapPtr Snapshot();
+
+  // Invoked after full compaction of intents DB that used snapshot, and was started when intents
+  // DB was flushed up to flushed_time and regular DB was flushed up to regular_flushed_op_id.
+  void FullCompactionDone(
+      const Map& snapshot, HybridTime flushed_time, const OpId& regular_flushed_op_id);
+
+  size_t size() const;
+
+ private:
+  const size_t max_size_;
+
+  mutable std::mutex mutex_;
+  Map transactions_ GUARDED_BY(mutex_);
+  // Cached snapshot of transactions_, reset when transactions_ is modified.
+  MapPtr snapshot_ GUARDED_BY(mutex_);
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_FINISHED_TRANSACTIONS_H
@@ -0,0 +1,233 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/tablet/index_write_batcher.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/client/error.h"
+#include "yb/client/session.h"
+#include "yb/client/yb_op.h"
+
+#include "yb/rpc/scheduler.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/thread_annotations.h"
+
+DEFINE_bool(enable_index_write_batching, false,
+            "Coalesce non-transactional index writes produced by concurrent writes to indexed "
+            "tables of all tablets of the node into shared batches.");
+TAG_FLAG(enable_index_write_batching, runtime);
+TAG_FLAG(enable_index_write_batching, advanced);
+
+DEFINE_int32(index_write_batch_window_usec, 200,
+             "Time during which non-transactional index writes are accumulated before being "
+             "flushed as a single batch.");
+TAG_FLAG(index_write_batch_window_usec, runtime);
+TAG_FLAG(index_write_batch_window_usec, advanced);
+
+METRIC_DEFINE_counter(server, index_writes_batched,
+                      "Batched Index Writes", yb::MetricUnit::kRequests,
+                      "Number of index write operations sent through the node level batcher.");
+
+METRIC_DEFINE_counter(server, index_write_batches,
+                      "Index Write Batches", yb::MetricUnit::kRequests,
+                      "Number of batches flushed by the node level index write batcher.");
+
+namespace yb {
+namespace tablet {
+
+class IndexWriteBatcher::Impl : public std::enable_shared_from_this<Impl> {
+ public:
+  Impl(const std::shared_future<client::YBClient*>& client_future, rpc::Scheduler* scheduler,
+       const scoped_refptr<MetricEntity>& metric_entity)
+      : client_future_(client_future), scheduler_(*scheduler) {
+    if (metric_entity) {
+      writes_metric_ = METRIC_index_writes_batched.Instantiate(metric_entity);
+      batches_metric_ = METRIC_index_write_batches.Instantiate(metric_entity);
+    }
+  }
+
+  void Shutdown() {
+    Batch batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closing_) {
+        return;
+      }
+      closing_ = true;
+      batch.swap(pending_);
+    }
+    for (auto& entry : batch) {
+      entry.callback(STATUS(Aborted, "Index write batcher is shutting down"));
+    }
+  }
+
+  void Write(std::vector<client::YBqlWriteOpPtr> ops, IndexWriteCallback callback) {
+    const auto window = std::chrono::microseconds(
+        std::max(FLAGS_index_write_batch_window_usec, 0));
+    const bool batching = FLAGS_enable_index_write_batching && window.count() != 0;
+    bool schedule_flush = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (closing_) {
+        lock.unlock();
+        callback(STATUS(Aborted, "Index write batcher is shutting down"));
+        return;
+      }
+      if (batching) {
+        schedule_flush = pending_.empty();
+        pending_.push_back(Entry{std::move(ops), std::move(callback)});
+      }
+    }
+    if (!batching) {
+      auto batch = std::make_shared<Batch>();
+      batch->push_back(Entry{std::move(ops), std::move(callback)});
+      Send(batch);
+      return;
+    }
+    if (schedule_flush) {
+      scheduler_.Schedule(
+          [self = shared_from_this()](const Status& status) {
+            self->Flush(status);
+          },
+          window);
+    }
+  }
+
+ private:
+  struct Entry {
+    std::vector<client::YBqlWriteOpPtr> ops;
+    IndexWriteCallback callback;
+  };
+
+  using Batch = std::vector<Entry>;
+  using BatchPtr = std::shared_ptr<Batch>;
+
+  void Flush(const Status& status) {
+    auto batch = std::make_shared<Batch>();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      // Pending writes were already failed by Shutdown.
+      if (closing_) {
+        return;
+      }
+      batch->swap(pending_);
+    }
+    if (batch->empty()) {
+      return;
+    }
+    if (!status.ok()) {
+      // Scheduler is shutting down, so this batch would never be sent.
+      for (auto& entry : *batch) {
+        entry.callback(status);
+      }
+      return;
+    }
+    Send(batch);
+  }
+
+  void Send(const BatchPtr& batch) {
+    auto session = std::make_shared<client::YBSession>(client_future_.get());
+    size_t num_ops = 0;
+    for (auto it = batch->begin(); it != batch->end();) {
+      auto status = ApplyEntry(*it, session.get());
+      if (status.ok()) {
+        num_ops += it->ops.size();
+        ++it;
+        continue;
+      }
+      auto callback = std::move(it->callback);
+      it = batch->erase(it);
+      callback(status);
+    }
+    if (batch->empty()) {
+      return;
+    }
+    if (writes_metric_) {
+      writes_metric_->IncrementBy(num_ops);
+    }
+    IncrementCounter(batches_metric_);
+    VLOG(4) << "Flushing " << num_ops << " index writes of " << batch->size() << " writes";
+    session->FlushAsync([batch, session](const Status& status) {
+      BatchFlushed(status, session.get(), batch.get());
+    });
+  }
+
+  static Status ApplyEntry(const Entry& entry, client::YBSession* session) {
+    for (const auto& op : entry.ops) {
+      RETURN_NOT_OK(session->Apply(op));
+    }
+    return Status::OK();
+  }
+
+  // Splits the result of the shared flush into results of the original writes.
+  static void BatchFlushed(const Status& status, client::YBSession* session, Batch* batch) {
+    // When any operation fails, the session returns IOError and keeps per operation errors.
+    std::unordered_map<const client::YBOperation*, Status> op_errors;
+    if (status.IsIOError()) {
+      for (const auto& error : session->GetAndClearPendingErrors()) {
+        op_errors.emplace(&error->failed_op(), error->status());
+      }
+    }
+    for (auto& entry : *batch) {
+      auto entry_status = status;
+      if (status.IsIOError()) {
+        entry_status = Status::OK();
+        for (const auto& op : entry.ops) {
+          auto it = op_errors.find(op.get());
+          if (it != op_errors.end()) {
+            entry_status = it->second;
+            break;
+          }
+        }
+      }
+      entry.callback(entry_status);
+    }
+  }
+
+  const std::shared_future<client::YBClient*> client_future_;
+  rpc::Scheduler& scheduler_;
+  scoped_refptr<Counter> writes_metric_;
+  scoped_refptr<Counter> batches_metric_;
+
+  std::mutex mutex_;
+  bool closing_ GUARDED_BY(mutex_) = false;
+  Batch pending_ GUARDED_BY(mutex_);
+};
+
+IndexWriteBatcher::IndexWriteBatcher(
+    const std::shared_future<client::YBClient*>& client_future, rpc::Scheduler* scheduler,
+    const scoped_refptr<MetricEntity>& metric_entity)
+    : impl_(std::make_shared<Impl>(client_future, scheduler, metric_entity)) {
+}
+
+IndexWriteBatcher::~IndexWriteBatcher() {
+  Shutdown();
+}
+
+void IndexWriteBatcher::Shutdown() {
+  impl_->Shutdown();
+}
+
+void IndexWriteBatcher::Write(
+    std::vector<client::YBqlWriteOpPtr> ops, IndexWriteCallback callback) {
+  impl_->Write(std::move(ops), std::move(callback));
+}
+
+} // namespace tablet
+} // namespace yb
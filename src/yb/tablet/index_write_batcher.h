@@ -0,0 +1,68 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#ifndef YB_TABLET_INDEX_WRITE_BATCHER_H
+#define YB_TABLET_INDEX_WRITE_BATCHER_H
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/metrics.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace tablet {
+
+using IndexWriteCallback = std::function<void(const Status&)>;
+
+// Coalesces non-transactional index write operations produced by concurrent writes to indexed
+// tables on all tablets of the node. Operations are accumulated for
+// FLAGS_index_write_batch_window_usec and flushed through a single session, so operations for the
+// same index tablet are sent in one RPC instead of one RPC per original write.
+//
+// Only the synchronous path is implemented: the original write still waits for its index writes.
+// Transactional index writes are not batched here, since they are performed in a child
+// transaction of the original write. Deferring them to the commit of the parent transaction, and
+// completing user enforced writes before their index writes are flushed, are not supported.
+//
+// Batching is off by default, see FLAGS_enable_index_write_batching. When it is off, each write
+// is sent in its own batch right away.
+class IndexWriteBatcher {
+ public:
+  IndexWriteBatcher(
+      const std::shared_future<client::YBClient*>& client_future, rpc::Scheduler* scheduler,
+      const scoped_refptr<MetricEntity>& metric_entity);
+  ~IndexWriteBatcher();
+
+  void Shutdown();
+
+  // Applies ops as part of the next batch and invokes callback when all of them are flushed.
+  // Callback status is the first error of these ops, if any. Responses are available in the ops.
+  void Write(std::vector<client::YBqlWriteOpPtr> ops, IndexWriteCallback callback);
+
+ private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_INDEX_WRITE_BATCHER_H
@@ -17,6 +17,8 @@
 
 #include "yb/common/pgsql_error.h"
 
+#include "yb/tablet/transaction_status_batcher.h"
+
 #include "yb/util/flag_tags.h"
 #include "yb/util/tsan_util.h"
 #include "yb/util/yb_pg_errcodes.h"
@@ -49,7 +51,8 @@ RunningTransaction::RunningTransaction(TransactionMetadata metadata,
                            metadata_.transaction_id),
       get_status_handle_(context->rpcs_.InvalidHandle()),
       abort_handle_(context->rpcs_.InvalidHandle()),
-      apply_intents_task_(&context->applier_, context, &apply_data_),
+      apply_intents_task_(
+          &context->applier_, &context->participant_context_, context, &apply_data_),
       abort_check_ht_(base_time_for_abort_check_ht_calculation.AddDelta(
                           1ms * FLAGS_transaction_abort_check_interval_ms)) {
 }
@@ -199,6 +202,21 @@ boost::optional<TransactionStatus> RunningTransaction::GetStatusAt(
 
 void RunningTransaction::SendStatusRequest(
     int64_t serial_no, const RunningTransactionPtr& shared_self) {
+  auto callback = std::bind(
+      &RunningTransaction::StatusReceived, this, _1, _2, serial_no, shared_self);
+  auto* batcher = context_.participant_context_.transaction_status_batcher();
+  if (batcher) {
+    context_.rpcs_.RegisterAndStart(
+        batcher->GetTransactionStatus(
+            TransactionRpcDeadline(),
+            metadata_.status_tablet,
+            metadata_.transaction_id,
+            context_.participant_context_.Now(),
+            std::move(callback)),
+        &get_status_handle_);
+    return;
+  }
+
   tserver::GetTransactionStatusRequestPB req;
   req.set_tablet_id(metadata_.status_tablet);
   req.add_transaction_id()->assign(
@@ -210,7 +228,7 @@ void RunningTransaction::SendStatusRequest(
           nullptr /* tablet */,
           context_.participant_context_.client_future().get(),
           &req,
-          std::bind(&RunningTransaction::StatusReceived, this, _1, _2, serial_no, shared_self)),
+          std::move(callback)),
       &get_status_handle_);
 }
 
@@ -425,8 +443,12 @@ Status MakeAbortedStatus(const TransactionId& id) {
 
 void RunningTransaction::SetApplyData(const docdb::ApplyTransactionState& apply_state,
                                       const TransactionApplyData* data) {
+  bool was_active = apply_state_.active();
   apply_state_ = apply_state;
   bool active = apply_state_.active();
+  if (active != was_active) {
+    UpdateApplyMetrics(active);
+  }
 
   if (data) {
     apply_data_ = *data;
@@ -451,6 +473,23 @@ void RunningTransaction::SetApplyData(const docdb::ApplyTransactionState& apply_
   }
 }
 
+void RunningTransaction::UpdateApplyMetrics(bool started) {
+  if (started) {
+    if (context_.metric_transactions_applying_) {
+      context_.metric_transactions_applying_->Increment();
+    }
+    return;
+  }
+  if (context_.metric_transactions_applying_) {
+    context_.metric_transactions_applying_->Decrement();
+  }
+  if (context_.metric_transaction_apply_lag_ && local_commit_time_.is_valid()) {
+    auto now = context_.participant_context_.Now();
+    context_.metric_transaction_apply_lag_->Increment(
+        std::max<int64_t>(now.PhysicalDiff(local_commit_time_) / 1000, 0));
+  }
+}
+
 bool RunningTransaction::ProcessingApply() const {
   return apply_state_.active();
 }
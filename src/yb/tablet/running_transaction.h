@@ -80,6 +80,16 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
   }
 
   void SetLocalCommitTime(HybridTime time);
+
+  // Op id of the operation that applied this transaction, invalid if it is unknown, for instance
+  // when transaction was loaded in the middle of apply.
+  const OpId& apply_op_id() const {
+    return apply_op_id_;
+  }
+
+  void SetApplyOpId(const OpId& op_id) {
+    apply_op_id_ = op_id;
+  }
   void AddReplicatedBatch(
       size_t batch_idx, boost::container::small_vector_base<uint8_t>* encoded_replicated_batches);
   void BatchReplicated(const TransactionalBatchData& value);
@@ -114,6 +124,9 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
 
   void SendStatusRequest(int64_t serial_no, const RunningTransactionPtr& shared_self);
 
+  // Updates background apply metrics when this transaction starts or finishes applying intents.
+  void UpdateApplyMetrics(bool started);
+
   void StatusReceived(const Status& status,
                       const tserver::GetTransactionStatusResponsePB& response,
                       int64_t serial_no,
@@ -148,6 +161,7 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
   RunningTransactionContext& context_;
   RemoveIntentsTask remove_intents_task_;
   HybridTime local_commit_time_ = HybridTime::kInvalid;
+  OpId apply_op_id_ = OpId::Invalid();
 
   TransactionStatus last_known_status_ = TransactionStatus::CREATED;
   HybridTime last_known_status_hybrid_time_ = HybridTime::kMin;
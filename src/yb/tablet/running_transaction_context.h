@@ -19,6 +19,8 @@
 #include "yb/tablet/transaction_participant.h"
 
 #include "yb/util/delayer.h"
+#include "yb/util/metrics.h"
+#include "yb/util/operation_counter.h"
 
 namespace yb {
 namespace tablet {
@@ -49,7 +51,8 @@ class RunningTransactionContext {
  public:
   RunningTransactionContext(TransactionParticipantContext* participant_context,
                             TransactionIntentApplier* applier)
-      : participant_context_(*participant_context), applier_(*applier) {
+      : participant_context_(*participant_context), applier_(*applier),
+        applying_intents_(participant_context->LogPrefix()) {
   }
 
   virtual ~RunningTransactionContext() {}
@@ -73,7 +76,18 @@ class RunningTransactionContext {
 
   virtual bool Closing() const = 0;
 
+  // Counts applies of intents in progress, including batches being written in background.
+  OperationCounter& applying_intents() {
+    return applying_intents_;
+  }
+
  protected:
+  // Number of committed transactions whose intents are being applied in background.
+  scoped_refptr<AtomicGauge<uint64_t>> metric_transactions_applying_;
+  // Time between transaction commit and the moment all of its intents were applied, recorded for
+  // transactions applied in background.
+  scoped_refptr<Histogram> metric_transaction_apply_lag_;
+
   friend class RunningTransaction;
 
   rpc::Rpcs rpcs_;
@@ -81,6 +95,8 @@ class RunningTransactionContext {
   TransactionIntentApplier& applier_;
   int64_t request_serial_ = 0;
   std::mutex mutex_;
+  // Shutdown waits until it drops to zero, so intents are not written to a closed DB.
+  OperationCounter applying_intents_;
 
   // Used only in tests.
   Delayer delayer_;
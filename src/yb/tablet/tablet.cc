@@ -40,6 +40,7 @@
 #include <memory>
 #include <mutex>
 #include <ostream>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -99,11 +100,13 @@
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/numbers.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/walltime.h"
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 #include "yb/server/hybrid_clock.h"
 
 #include "yb/tablet/tablet_fwd.h"
+#include "yb/tablet/index_write_batcher.h"
 #include "yb/tablet/maintenance_manager.h"
 #include "yb/tablet/snapshot_coordinator.h"
 #include "yb/tablet/tablet_snapshots.h"
@@ -222,6 +225,53 @@ DEFINE_test_flag(bool, export_intentdb_metrics, false,
 DEFINE_test_flag(bool, pause_before_post_split_compation, false,
                  "Pause before triggering post split compaction.");
 
+DEFINE_double(post_split_compaction_defer_ops_per_sec, 0,
+              "Post split compaction is deferred while tablet serves more requests per second "
+              "than this value, so it does not overlap with foreground load peaks. "
+              "0 disables deferring.");
+TAG_FLAG(post_split_compaction_defer_ops_per_sec, runtime);
+TAG_FLAG(post_split_compaction_defer_ops_per_sec, advanced);
+
+DEFINE_int32(post_split_compaction_max_defer_ms, 10 * 60 * 1000,
+             "Max time (in milliseconds) post split compaction could be deferred because of high "
+             "tablet load.");
+TAG_FLAG(post_split_compaction_max_defer_ms, runtime);
+TAG_FLAG(post_split_compaction_max_defer_ms, advanced);
+
+DEFINE_int32(txn_max_apply_batch_records, 100000,
+             "Max number of apply records allowed in single RocksDB batch. "
+             "When a transaction's data in one tablet does not fit into specified number of "
+             "records, it will be applied using multiple RocksDB write batches.");
+
+DEFINE_int32(txn_max_inline_apply_batch_records, 100000,
+             "Max number of intent records applied to regular DB by the transaction apply "
+             "operation itself. Remaining intents of a larger transaction are applied in "
+             "background, so the apply does not block the following operations of the tablet.");
+TAG_FLAG(txn_max_inline_apply_batch_records, runtime);
+TAG_FLAG(txn_max_inline_apply_batch_records, advanced);
+
+DEFINE_bool(enable_wait_queues, false,
+            "Make a write of a transaction that conflicts with higher priority transactions wait "
+            "until they finish and then resolve conflicts again, instead of failing with a "
+            "conflict error that is retried by the client. Since transactions only wait for "
+            "transactions with higher priority, waits could not form a deadlock.");
+TAG_FLAG(enable_wait_queues, runtime);
+TAG_FLAG(enable_wait_queues, advanced);
+
+DEFINE_int32(wait_queue_max_wait_ms, 2000,
+             "Max time a write could wait for conflicting transactions to finish, when wait queues "
+             "are enabled. Conflict error is returned after this time.");
+TAG_FLAG(wait_queue_max_wait_ms, runtime);
+TAG_FLAG(wait_queue_max_wait_ms, advanced);
+
+DEFINE_int64(tablet_slow_tier_data_age_sec, 7 * 24 * 60 * 60,
+             "Compactions of a tablet that has slow data dir (see fs_slow_data_dirs) place their "
+             "output to the slow data dir when the max hybrid time of the compacted data is older "
+             "than this number of seconds. Flushes and other compactions write to the regular "
+             "data dir. Non-positive value disables placement to the slow data dir.");
+TAG_FLAG(tablet_slow_tier_data_age_sec, runtime);
+TAG_FLAG(tablet_slow_tier_data_age_sec, advanced);
+
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 DECLARE_int64(apply_intents_task_injected_delay_ms);
@@ -435,6 +485,7 @@ Tablet::Tablet(const TabletInitData& data)
       pending_op_counter_("RocksDB"),
       write_ops_being_submitted_counter_("Tablet schema"),
       client_future_(data.client_future),
+      index_write_batcher_(data.index_write_batcher),
       local_tablet_filter_(data.local_tablet_filter),
       log_prefix_suffix_(data.log_prefix_suffix),
       is_sys_catalog_(data.is_sys_catalog),
@@ -608,6 +659,41 @@ auto MakeMemTableFlushFilterFactory(const F& f) {
   return std::make_shared<MemTableFlushFilterFactoryType>(f);
 }
 
+namespace {
+
+constexpr uint32_t kFastTierPathId = 0;
+constexpr uint32_t kSlowTierPathId = 1;
+
+uint32_t SelectCompactionOutputTier(const rocksdb::UserFrontier* largest) {
+  const auto age_sec = FLAGS_tablet_slow_tier_data_age_sec;
+  if (!largest || age_sec <= 0) {
+    return kFastTierPathId;
+  }
+  const auto hybrid_time = down_cast<const docdb::ConsensusFrontier&>(*largest).hybrid_time();
+  if (!hybrid_time.is_valid()) {
+    return kFastTierPathId;
+  }
+  const auto age_us = static_cast<int64_t>(GetCurrentTimeMicros()) -
+                      static_cast<int64_t>(hybrid_time.GetPhysicalValueMicros());
+  return age_us > age_sec * MonoTime::kMicrosecondsPerSecond ? kSlowTierPathId : kFastTierPathId;
+}
+
+} // namespace
+
+void Tablet::InitRegularDbPaths(rocksdb::Options* options) const {
+  const auto slow_rocksdb_dir = metadata()->slow_rocksdb_dir();
+  if (slow_rocksdb_dir.empty()) {
+    return;
+  }
+  constexpr auto kUnlimitedSize = std::numeric_limits<uint64_t>::max();
+  options->db_paths = {
+      rocksdb::DbPath(metadata()->rocksdb_dir(), kUnlimitedSize),
+      rocksdb::DbPath(slow_rocksdb_dir, kUnlimitedSize),
+  };
+  options->compaction_output_path_selector =
+      std::make_shared<rocksdb::CompactionOutputPathSelector>(&SelectCompactionOutputTier);
+}
+
 Result<bool> Tablet::IntentsDbFlushFilter(const rocksdb::MemTable& memtable) {
   VLOG_WITH_PREFIX(4) << __func__;
 
@@ -686,6 +772,7 @@ std::string Tablet::LogPrefix(docdb::StorageDbType db_type) const {
 Status Tablet::OpenKeyValueTablet() {
   static const std::string kRegularDB = "RegularDB"s;
   static const std::string kIntentsDB = "IntentsDB"s;
+  static const std::string kMetadata = "Metadata"s;
 
   rocksdb::Options rocksdb_options;
   InitRocksDBOptions(&rocksdb_options, LogPrefix(docdb::StorageDbType::kRegular));
@@ -694,10 +781,16 @@ Status Tablet::OpenKeyValueTablet() {
       MemTracker::FindOrCreateTracker(
           Format("$0-$1", kRegularDB, tablet_id()), block_based_table_mem_tracker_,
           AddToParent::kTrue, CreateMetrics::kFalse);
+  // Index and filter blocks are tracked separately, so metadata memory of each tablet is visible.
+  rocksdb_options.block_based_table_metadata_mem_tracker = MemTracker::FindOrCreateTracker(
+      kMetadata, rocksdb_options.block_based_table_mem_tracker, AddToParent::kTrue,
+      CreateMetrics::kFalse);
   // We may not have a metrics_entity_ instantiated in tests.
   if (metric_entity_) {
     rocksdb_options.block_based_table_mem_tracker->SetMetricEntity(metric_entity_,
         Format("$0_$1", "BlockBasedTable", kRegularDB));
+    rocksdb_options.block_based_table_metadata_mem_tracker->SetMetricEntity(metric_entity_,
+        Format("$0_$1", "BlockBasedTableMetadata", kRegularDB));
   }
 
   key_bounds_ = docdb::KeyBounds(metadata()->lower_bound_key(), metadata()->upper_bound_key());
@@ -705,7 +798,8 @@ Status Tablet::OpenKeyValueTablet() {
   // Install the history cleanup handler. Note that TabletRetentionPolicy is going to hold a raw ptr
   // to this tablet. So, we ensure that rocksdb_ is reset before this tablet gets destroyed.
   rocksdb_options.compaction_filter_factory = make_shared<DocDBCompactionFilterFactory>(
-      retention_policy_, &key_bounds_);
+      retention_policy_, &key_bounds_,
+      docdb::MayHaveMergeRecords(table_type_ == TableType::REDIS_TABLE_TYPE));
 
   rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
     if (mem_table_flush_filter_factory_) {
@@ -721,9 +815,21 @@ Status Tablet::OpenKeyValueTablet() {
   rocksdb::Options regular_rocksdb_options(rocksdb_options);
   regular_rocksdb_options.listeners.push_back(
       std::make_shared<RegularRocksDbListener>(this, regular_rocksdb_options.log_prefix));
+  InitRegularDbPaths(&regular_rocksdb_options);
+  if (tablet_options_.sst_files_write_stall_trigger) {
+    regular_rocksdb_options.sst_files_write_stall_trigger =
+        std::make_shared<rocksdb::SstFilesWriteStallTrigger>(
+            tablet_options_.sst_files_write_stall_trigger);
+  }
 
   const string db_dir = metadata()->rocksdb_dir();
   RETURN_NOT_OK(CreateTabletDirectories(db_dir, metadata()->fs_manager()));
+  const auto slow_rocksdb_dir = metadata()->slow_rocksdb_dir();
+  if (!slow_rocksdb_dir.empty()) {
+    RETURN_NOT_OK_PREPEND(
+        metadata()->fs_manager()->env()->CreateDirs(slow_rocksdb_dir),
+        Format("Failed to create RocksDB tablet slow data directory $0", slow_rocksdb_dir));
+  }
 
   LOG(INFO) << "Opening RocksDB at: " << db_dir;
   rocksdb::DB* db = nullptr;
@@ -743,6 +849,7 @@ Status Tablet::OpenKeyValueTablet() {
     LOG_WITH_PREFIX(INFO) << "Opening intents DB at: " << db_dir + kIntentsDBSuffix;
     rocksdb::Options intents_rocksdb_options(rocksdb_options);
     docdb::SetLogPrefix(&intents_rocksdb_options, LogPrefix(docdb::StorageDbType::kIntents));
+    docdb::SetMemTableFactory(&intents_rocksdb_options, docdb::StorageDbType::kIntents);
 
     intents_rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
       return std::bind(&Tablet::IntentsDbFlushFilter, this, _1);
@@ -757,10 +864,16 @@ Status Tablet::OpenKeyValueTablet() {
         MemTracker::FindOrCreateTracker(
             Format("$0-$1", kIntentsDB, tablet_id()), block_based_table_mem_tracker_,
             AddToParent::kTrue, CreateMetrics::kFalse);
+    intents_rocksdb_options.block_based_table_metadata_mem_tracker =
+        MemTracker::FindOrCreateTracker(
+            kMetadata, intents_rocksdb_options.block_based_table_mem_tracker, AddToParent::kTrue,
+            CreateMetrics::kFalse);
     // We may not have a metrics_entity_ instantiated in tests.
     if (metric_entity_) {
       intents_rocksdb_options.block_based_table_mem_tracker->SetMetricEntity(metric_entity_,
         Format("$0_$1", "BlockBasedTable", kIntentsDB));
+      intents_rocksdb_options.block_based_table_metadata_mem_tracker->SetMetricEntity(
+        metric_entity_, Format("$0_$1", "BlockBasedTableMetadata", kIntentsDB));
     }
     intents_rocksdb_options.statistics = intentsdb_statistics_;
 
@@ -935,6 +1048,10 @@ bool Tablet::StartShutdown() {
   }
 
   if (post_split_compaction_task_pool_token_) {
+    {
+      std::lock_guard<std::mutex> lock(post_split_compaction_mutex_);
+      post_split_compaction_cond_.notify_all();
+    }
     post_split_compaction_task_pool_token_->Shutdown();
   }
 
@@ -1013,8 +1130,14 @@ Status Tablet::ResetRocksDBs(Destroy destroy, DisableFlushOnShutdown disable_flu
     InitRocksDBOptions(&rocksdb_options, LogPrefix());
   }
 
+  // Regular DB files could also be placed to the slow data dir.
+  rocksdb::Options regular_rocksdb_options(rocksdb_options);
+  if (destroy) {
+    InitRegularDbPaths(&regular_rocksdb_options);
+  }
+
   Status intents_status = ResetRocksDB(destroy, rocksdb_options, &intents_db_);
-  Status regular_status = ResetRocksDB(destroy, rocksdb_options, &regular_db_);
+  Status regular_status = ResetRocksDB(destroy, regular_rocksdb_options, &regular_db_);
   key_bounds_ = docdb::KeyBounds();
 
   return regular_status.ok() ? intents_status : regular_status;
@@ -1334,6 +1457,12 @@ Status Tablet::HandleQLReadRequest(
   RETURN_NOT_OK(scoped_read_operation);
   ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
 
+  if (ql_read_request.has_hash_code() && !ql_read_request.hashed_column_values().empty()) {
+    load_tracker_.RecordHashAccess(ql_read_request.hash_code());
+  } else {
+    load_tracker_.RecordKeylessAccess();
+  }
+
   if (metadata()->schema_version() != ql_read_request.schema_version()) {
     DVLOG(1) << "Setting status for read as YQL_STATUS_SCHEMA_VERSION_MISMATCH";
     result->response.set_status(QLResponsePB::YQL_STATUS_SCHEMA_VERSION_MISMATCH);
@@ -1513,8 +1642,8 @@ void Tablet::UpdateQLIndexes(std::unique_ptr<WriteOperation> operation) {
     }
     if (!client) {
       client = client_future_.get();
-      session = std::make_shared<YBSession>(client);
       if (write_op->request().has_child_transaction_data()) {
+        session = std::make_shared<YBSession>(client);
         child_transaction_data = &write_op->request().child_transaction_data();
         if (!transaction_manager_) {
           WriteOperation::StartSynchronization(
@@ -1532,6 +1661,10 @@ void Tablet::UpdateQLIndexes(std::unique_ptr<WriteOperation> operation) {
         session->SetTransaction(txn);
       } else {
         child_transaction_data = nullptr;
+        // Non-transactional index writes are coalesced with index writes of other operations.
+        if (!index_write_batcher_) {
+          session = std::make_shared<YBSession>(client);
+        }
       }
     } else if (write_op->request().has_child_transaction_data()) {
       DCHECK_ONLY_NOTNULL(child_transaction_data);
@@ -1564,20 +1697,34 @@ void Tablet::UpdateQLIndexes(std::unique_ptr<WriteOperation> operation) {
       shared_ptr<client::YBqlWriteOp> index_op(index_table->NewQLWrite());
       index_op->mutable_request()->Swap(&pair.second);
       index_op->mutable_request()->MergeFrom(pair.second);
-      status = session->Apply(index_op);
-      if (!status.ok()) {
-        WriteOperation::StartSynchronization(std::move(operation), status);
-        return;
+      if (session) {
+        status = session->Apply(index_op);
+        if (!status.ok()) {
+          WriteOperation::StartSynchronization(std::move(operation), status);
+          return;
+        }
       }
       index_ops.emplace_back(std::move(index_op), write_op);
     }
   }
 
-  if (!session) {
+  if (index_ops.empty()) {
     CompleteQLWriteBatch(std::move(operation), Status::OK());
     return;
   }
 
+  if (!session) {
+    std::vector<client::YBqlWriteOpPtr> ops;
+    ops.reserve(index_ops.size());
+    for (const auto& pair : index_ops) {
+      ops.push_back(pair.first);
+    }
+    index_write_batcher_->Write(std::move(ops), std::bind(
+        &Tablet::UpdateQLIndexesFlushed, this, operation.release(), nullptr /* session */,
+        nullptr /* txn */, std::move(index_ops), _1));
+    return;
+  }
+
   session->FlushAsync(std::bind(
       &Tablet::UpdateQLIndexesFlushed, this, operation.release(), session, txn,
       std::move(index_ops), _1));
@@ -1591,7 +1738,8 @@ void Tablet::UpdateQLIndexesFlushed(
   if (PREDICT_FALSE(!status.ok())) {
     // When any error occurs during the dispatching of YBOperation, YBSession saves the error and
     // returns IOError. When it happens, retrieves the errors and discard the IOError.
-    if (status.IsIOError()) {
+    // Batched index writes are completed with the error of the operation itself.
+    if (status.IsIOError() && session) {
       for (const auto& error : session->GetAndClearPendingErrors()) {
         // return just the first error seen.
         operation->state()->CompleteWithStatus(error->status());
@@ -1648,6 +1796,13 @@ Status Tablet::HandlePgsqlReadRequest(
   // TODO(neil) Work on metrics for PGSQL.
   // ScopedTabletMetricsTracker metrics_tracker(metrics_->pgsql_read_latency);
 
+  if (pgsql_read_request.has_hash_code() &&
+      !pgsql_read_request.partition_column_values().empty()) {
+    load_tracker_.RecordHashAccess(pgsql_read_request.hash_code());
+  } else {
+    load_tracker_.RecordKeylessAccess();
+  }
+
   const shared_ptr<tablet::TableInfo> table_info =
       VERIFY_RESULT(metadata_->GetTableInfo(pgsql_read_request.table_id()));
   // Assert the table is a Postgres table.
@@ -1868,6 +2023,8 @@ void Tablet::AcquireLocksAndPerformDocOperations(std::unique_ptr<WriteOperation>
     operation->UseSubmitToken(std::move(write_permit));
   }
 
+  RecordWriteLoad(*key_value_write_request);
+
   if (!key_value_write_request->redis_write_batch().empty()) {
     KeyValueBatchFromRedisWriteBatch(std::move(operation));
     return;
@@ -1909,6 +2066,26 @@ void Tablet::AcquireLocksAndPerformDocOperations(std::unique_ptr<WriteOperation>
   operation->state()->CompleteWithStatus(Status::OK());
 }
 
+void Tablet::RecordWriteLoad(const WriteRequestPB& write_request) {
+  for (const auto& ql_write_request : write_request.ql_write_batch()) {
+    if (ql_write_request.has_hash_code()) {
+      load_tracker_.RecordHashAccess(ql_write_request.hash_code());
+    } else {
+      load_tracker_.RecordKeylessAccess();
+    }
+  }
+  for (const auto& pgsql_write_request : write_request.pgsql_write_batch()) {
+    if (pgsql_write_request.has_hash_code()) {
+      load_tracker_.RecordHashAccess(pgsql_write_request.hash_code());
+    } else {
+      load_tracker_.RecordKeylessAccess();
+    }
+  }
+  for (int i = 0; i != write_request.redis_write_batch_size(); ++i) {
+    load_tracker_.RecordKeylessAccess();
+  }
+}
+
 Status Tablet::Flush(FlushMode mode, FlushFlags flags, int64_t ignore_if_flushed_after_tick) {
   TRACE_EVENT0("tablet", "Tablet::Flush");
 
@@ -1965,10 +2142,31 @@ Result<docdb::ApplyTransactionState> Tablet::ApplyIntents(const TransactionApply
   VLOG_WITH_PREFIX(4) << __func__ << ": " << data.transaction_id;
 
   rocksdb::WriteBatch regular_write_batch;
-  auto new_apply_state = VERIFY_RESULT(docdb::PrepareApplyIntentsBatch(
-      data.transaction_id, data.commit_ht, &key_bounds_, data.apply_state,
-      &regular_write_batch, intents_db_.get(), nullptr /* intents_write_batch */));
+  auto new_apply_state = VERIFY_RESULT(DoPrepareApplyIntents(
+      data, data.apply_state,
+      std::min(FLAGS_txn_max_inline_apply_batch_records, FLAGS_txn_max_apply_batch_records),
+      &regular_write_batch));
+  WriteAppliedIntents(data, &regular_write_batch);
+  return new_apply_state;
+}
+
+Result<docdb::ApplyTransactionState> Tablet::PrepareApplyIntents(
+    const TransactionApplyData& data, const docdb::ApplyTransactionState* apply_state,
+    rocksdb::WriteBatch* regular_write_batch) {
+  return DoPrepareApplyIntents(
+      data, apply_state, FLAGS_txn_max_apply_batch_records, regular_write_batch);
+}
 
+Result<docdb::ApplyTransactionState> Tablet::DoPrepareApplyIntents(
+    const TransactionApplyData& data, const docdb::ApplyTransactionState* apply_state,
+    int32_t max_records, rocksdb::WriteBatch* regular_write_batch) {
+  return docdb::PrepareApplyIntentsBatch(
+      data.transaction_id, data.commit_ht, &key_bounds_, apply_state, std::max(max_records, 1),
+      regular_write_batch, intents_db_.get(), nullptr /* intents_write_batch */);
+}
+
+void Tablet::WriteAppliedIntents(
+    const TransactionApplyData& data, rocksdb::WriteBatch* regular_write_batch) {
   // data.hybrid_time contains transaction commit time.
   // We don't set transaction field of put_batch, otherwise we would write another bunch of intents.
   docdb::ConsensusFrontiers frontiers;
@@ -1977,8 +2175,7 @@ Result<docdb::ApplyTransactionState> Tablet::ApplyIntents(const TransactionApply
     InitFrontiers(data, &frontiers);
     frontiers_ptr = &frontiers;
   }
-  WriteToRocksDB(frontiers_ptr, &regular_write_batch, StorageDbType::kRegular);
-  return new_apply_state;
+  WriteToRocksDB(frontiers_ptr, regular_write_batch, StorageDbType::kRegular);
 }
 
 template <class Ids>
@@ -1992,7 +2189,8 @@ CHECKED_STATUS Tablet::RemoveIntentsImpl(const RemoveIntentsData& data, const Id
     for (;;) {
       auto new_apply_state = VERIFY_RESULT(docdb::PrepareApplyIntentsBatch(
           id, HybridTime() /* commit_ht */, &key_bounds_, apply_state.get_ptr(),
-          nullptr /* regular_write_batch */, intents_db_.get(), &intents_write_batch));
+          std::max(FLAGS_txn_max_apply_batch_records, 1), nullptr /* regular_write_batch */,
+          intents_db_.get(), &intents_write_batch));
       if (new_apply_state.key.empty()) {
         break;
       }
@@ -2717,6 +2915,21 @@ Result<HybridTime> Tablet::MaxPersistentHybridTime() const {
   return result;
 }
 
+Result<HybridTime> Tablet::IntentsDbMaxPersistentHybridTime() const {
+  ScopedRWOperation scoped_read_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_read_operation);
+
+  if (!intents_db_) {
+    return HybridTime::kMin;
+  }
+
+  auto frontier = intents_db_->GetFlushedFrontier();
+  if (!frontier) {
+    return HybridTime::kMin;
+  }
+  return down_cast<docdb::ConsensusFrontier*>(frontier.get())->hybrid_time();
+}
+
 Result<HybridTime> Tablet::OldestMutableMemtableWriteHybridTime() const {
   ScopedRWOperation scoped_read_operation(&pending_op_counter_);
   RETURN_NOT_OK(scoped_read_operation);
@@ -2844,8 +3057,11 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
       return Status::OK();
     }
 
+    // Read pairs could be already added if this is a retry after waiting for conflicting
+    // transactions.
     if (isolation_level_ == IsolationLevel::SERIALIZABLE_ISOLATION &&
-        prepare_result_.need_read_snapshot) {
+        prepare_result_.need_read_snapshot && !read_pairs_added_) {
+      read_pairs_added_ = true;
       boost::container::small_vector<RefCntPrefix, 16> paths;
       for (const auto& doc_op : operation_->doc_ops()) {
         paths.clear();
@@ -2868,9 +3084,12 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
         read_time_ ? read_time_.read : HybridTime::kMax,
         tablet_.doc_db(), partial_range_key_intents,
         transaction_participant, tablet_.metrics()->transaction_conflicts.get(),
+        FLAGS_enable_wait_queues ? &blockers_ : nullptr,
         [self = shared_from_this()](const Result<HybridTime>& result) {
           if (!result.ok()) {
-            self->InvokeCallback(result.status());
+            if (!self->WaitForBlockers(result.status())) {
+              self->InvokeCallback(result.status());
+            }
             return;
           }
           self->TransactionalConflictsResolved();
@@ -2880,6 +3099,53 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
   }
 
  private:
+  // Releases locks and waits until any of the higher priority transactions that we conflict with
+  // finishes, then starts the operation again. Returns false if waiting is not possible, so
+  // conflict_status should be returned to the client.
+  bool WaitForBlockers(const Status& conflict_status) {
+    if (blockers_.empty()) {
+      return false;
+    }
+    auto blockers = std::move(blockers_);
+    blockers_.clear();
+
+    auto now = CoarseMonoClock::now();
+    if (wait_deadline_ == CoarseTimePoint()) {
+      wait_deadline_ = std::min(
+          operation_->deadline(), now + FLAGS_wait_queue_max_wait_ms * 1ms);
+    }
+    if (now >= wait_deadline_) {
+      return false;
+    }
+
+    // Do not hold locks while waiting, otherwise blocking transaction could not write the same
+    // keys again and would have to wait for us.
+    // Also do not register the request and do not prevent tablet shutdown while waiting, they are
+    // acquired again when the operation is resumed.
+    prepare_result_.lock_batch.Reset();
+    request_scope_ = RequestScope();
+    scoped_read_operation_.Reset();
+    return tablet_.transaction_participant()->WaitForAnyFinished(
+        blockers, wait_deadline_,
+        [self = shared_from_this(), conflict_status](const Status& status) {
+          self->Resume(status, conflict_status);
+        });
+  }
+
+  void Resume(const Status& wait_status, const Status& conflict_status) {
+    if (!wait_status.ok()) {
+      InvokeCallback(conflict_status);
+      return;
+    }
+    scoped_read_operation_ = ScopedRWOperation(
+        &tablet_.pending_op_counter_, operation_->deadline());
+    if (!scoped_read_operation_.ok()) {
+      InvokeCallback(MoveStatus(scoped_read_operation_));
+      return;
+    }
+    Start();
+  }
+
   void NonTransactionalConflictsResolved(HybridTime now, HybridTime result) {
     if (now != result) {
       tablet_.clock()->Update(result);
@@ -2971,6 +3237,10 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
       }
     }
 
+    if (isolation_level_ == IsolationLevel::NON_TRANSACTIONAL) {
+      DiscardWriteBatchIfPgsqlOpFailed();
+    }
+
     operation_->SetRestartReadHt(restart_read_ht);
 
     if (allow_immediate_read_restart() &&
@@ -2988,6 +3258,25 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
     return Status::OK();
   }
 
+  // Non-transactional YSQL write with multiple rows is a whole statement committed as a single
+  // shard write. If one of its rows failed, e.g. because of a duplicate key, the statement fails,
+  // so the other rows should not be written either.
+  void DiscardWriteBatchIfPgsqlOpFailed() {
+    if (operation_->doc_ops().size() < 2) {
+      return;
+    }
+    for (const auto& doc_op : operation_->doc_ops()) {
+      if (doc_op->OpType() != docdb::DocOperation::Type::PGSQL_WRITE_OPERATION) {
+        return;
+      }
+      const auto* response = down_cast<docdb::PgsqlWriteOperation*>(doc_op.get())->response();
+      if (response->status() != PgsqlResponsePB::PGSQL_STATUS_OK) {
+        operation_->request()->mutable_write_batch()->clear_write_pairs();
+        return;
+      }
+    }
+  }
+
   Tablet& tablet_;
   const bool txns_enabled_;
   std::unique_ptr<WriteOperation> operation_;
@@ -2998,6 +3287,12 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
   docdb::PrepareDocWriteOperationResult prepare_result_;
   RequestScope request_scope_;
   ReadHybridTime read_time_;
+
+  // Higher priority transactions that this operation conflicts with, when wait queues are enabled.
+  std::vector<TransactionId> blockers_;
+  // Time until which this operation could wait for conflicting transactions.
+  CoarseTimePoint wait_deadline_;
+  bool read_pairs_added_ = false;
 };
 
 void Tablet::StartDocWriteOperation(
@@ -3335,6 +3630,31 @@ Result<std::string> Tablet::GetEncodedMiddleSplitKey() const {
   return middle_key;
 }
 
+Result<std::string> Tablet::GetEncodedLoadSplitKey() const {
+  auto sampled_key = load_tracker_.SampledMedianKey();
+  if (!sampled_key || !metadata()->partition_schema()->IsHashPartitioning()) {
+    // Access keys are only sampled for hash partitioned tables.
+    return GetEncodedMiddleSplitKey();
+  }
+  const auto hash = VERIFY_RESULT(docdb::DecodeDocKeyHash(*sampled_key));
+  if (!hash) {
+    return GetEncodedMiddleSplitKey();
+  }
+  // Split key should be strictly inside the tablet, otherwise one of the children would be empty.
+  const auto partition_key = PartitionSchema::EncodeMultiColumnHashValue(*hash);
+  const auto& partition = *metadata()->partition();
+  const Slice sampled_key_slice(*sampled_key);
+  if (partition_key <= partition.partition_key_start() ||
+      (!partition.partition_key_end().empty() && partition_key >= partition.partition_key_end()) ||
+      sampled_key_slice.compare(key_bounds_.lower) <= 0 ||
+      (!key_bounds_.upper.empty() && sampled_key_slice.compare(key_bounds_.upper) >= 0)) {
+    VLOG_WITH_PREFIX(1) << "Sampled split key " << Slice(*sampled_key).ToDebugHexString()
+                        << " is outside of the tablet, falling back to the middle key";
+    return GetEncodedMiddleSplitKey();
+  }
+  return std::move(*sampled_key);
+}
+
 Status Tablet::TriggerPostSplitCompactionIfNeeded(
     std::function<std::unique_ptr<ThreadPoolToken>()> get_token_for_compaction) {
   if (post_split_compaction_task_pool_token_) {
@@ -3343,14 +3663,44 @@ Status Tablet::TriggerPostSplitCompactionIfNeeded(
   }
   if (StillHasParentDataAfterSplit()) {
     post_split_compaction_task_pool_token_ = get_token_for_compaction();
-    return post_split_compaction_task_pool_token_->SubmitFunc(
-        std::bind(&Tablet::TriggerPostSplitCompactionSync, this));
+    post_split_compaction_defer_deadline_ = CoarseMonoClock::Now() +
+        MonoDelta::FromMilliseconds(FLAGS_post_split_compaction_max_defer_ms);
+    return SubmitPostSplitCompaction();
   }
   return Status::OK();
 }
 
+Status Tablet::SubmitPostSplitCompaction() {
+  return post_split_compaction_task_pool_token_->SubmitFunc(
+      std::bind(&Tablet::TriggerPostSplitCompactionSync, this));
+}
+
 void Tablet::TriggerPostSplitCompactionSync() {
   TEST_PAUSE_IF_FLAG(TEST_pause_before_post_split_compation);
+  if (IsShutdownRequested()) {
+    return;
+  }
+  // Post split compaction rewrites the whole tablet, so try to run it outside of the load peaks.
+  const auto defer_ops_per_sec = FLAGS_post_split_compaction_defer_ops_per_sec;
+  if (defer_ops_per_sec > 0 && CoarseMonoClock::Now() < post_split_compaction_defer_deadline_ &&
+      load_tracker_.OpsPerSec() >= defer_ops_per_sec) {
+    YB_LOG_EVERY_N_SECS(INFO, 60) << LogPrefix() << "Deferring post split compaction, load: "
+                                  << load_tracker_.OpsPerSec() << " ops/s";
+    // Wait a bit and resubmit the task instead of looping here, so the shared pool thread is
+    // released between checks and compactions of other tablets are not blocked.
+    {
+      std::unique_lock<std::mutex> lock(post_split_compaction_mutex_);
+      post_split_compaction_cond_.wait_for(lock, 1s, [this] { return IsShutdownRequested(); });
+    }
+    if (IsShutdownRequested()) {
+      return;
+    }
+    auto status = SubmitPostSplitCompaction();
+    if (status.ok() || IsShutdownRequested()) {
+      return;
+    }
+    LOG_WITH_PREFIX(WARNING) << "Failed to resubmit deferred post split compaction: " << status;
+  }
   WARN_NOT_OK(ForceFullRocksDBCompact(), "Failed to compact post-split tablet.");
 }
 
@@ -32,6 +32,7 @@
 #ifndef YB_TABLET_TABLET_H_
 #define YB_TABLET_TABLET_H_
 
+#include <condition_variable>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -70,6 +71,7 @@
 #include "yb/tablet/mvcc.h"
 #include "yb/tablet/operations/snapshot_operation.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
+#include "yb/tablet/tablet_load_tracker.h"
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/transaction_participant.h"
@@ -250,6 +252,13 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   Result<docdb::ApplyTransactionState> ApplyIntents(const TransactionApplyData& data) override;
 
+  Result<docdb::ApplyTransactionState> PrepareApplyIntents(
+      const TransactionApplyData& data, const docdb::ApplyTransactionState* apply_state,
+      rocksdb::WriteBatch* regular_write_batch) override;
+
+  void WriteAppliedIntents(
+      const TransactionApplyData& data, rocksdb::WriteBatch* regular_write_batch) override;
+
   CHECKED_STATUS RemoveIntents(const RemoveIntentsData& data, const TransactionId& id) override;
 
   CHECKED_STATUS RemoveIntents(
@@ -359,6 +368,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   CHECKED_STATUS PreparePgsqlWriteOperations(WriteOperation* operation);
   void KeyValueBatchFromPgsqlWriteBatch(std::unique_ptr<WriteOperation> operation);
 
+  // Accounts rows written by the request in the load tracker.
+  void RecordWriteLoad(const WriteRequestPB& write_request);
+
   // Create a new row iterator which yields the rows as of the current MVCC
   // state of this tablet.
   // The returned iterator is not initialized.
@@ -460,6 +472,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Returns the maximum persistent hybrid_time across all SSTables in RocksDB.
   Result<HybridTime> MaxPersistentHybridTime() const;
 
+  // Returns the maximum persistent hybrid_time across SSTables of intents DB.
+  Result<HybridTime> IntentsDbMaxPersistentHybridTime() const;
+
   // Returns oldest mutable memtable write hybrid time in RocksDB or HybridTime::kMax if memtable
   // is empty.
   Result<HybridTime> OldestMutableMemtableWriteHybridTime() const;
@@ -538,6 +553,15 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // - for range-based partitions: encoded doc key in order to split by row.
   Result<std::string> GetEncodedMiddleSplitKey() const;
 
+  // Returns split key for load based tablet split: median of the recently sampled access keys
+  // when enough of them are available and it is inside the tablet key range, approximate middle
+  // key otherwise.
+  Result<std::string> GetEncodedLoadSplitKey() const;
+
+  TabletLoadTracker& load_tracker() {
+    return load_tracker_;
+  }
+
   std::string TEST_DocDBDumpStr(IncludeIntents include_intents = IncludeIntents::kFalse);
 
   void TEST_DocDBDumpToContainer(
@@ -640,6 +664,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   void InitRocksDBOptions(rocksdb::Options* options, const std::string& log_prefix);
 
+  // Configures regular DB to place output of compactions of old data to the slow data dir, when
+  // this tablet has one.
+  void InitRegularDbPaths(rocksdb::Options* options) const;
+
   TabletRetentionPolicy* RetentionPolicy() override {
     return retention_policy_.get();
   }
@@ -652,6 +680,7 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
     std::function<std::unique_ptr<ThreadPoolToken>()> get_token_for_compaction);
 
  private:
+  friend class DocWriteOperation;
   friend class Iterator;
   friend class TabletPeerTest;
   friend class ScopedReadOperation;
@@ -713,6 +742,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // atomically to avoid race conditions.
   std::shared_ptr<client::YBMetaDataCache> YBMetaDataCache();
 
+  CHECKED_STATUS SubmitPostSplitCompaction();
+
   void TriggerPostSplitCompactionSync();
 
   const Schema key_schema_;
@@ -815,6 +846,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::shared_future<client::YBClient*> client_future_;
 
+  // Node level batcher for non-transactional index writes, could be null.
+  IndexWriteBatcher* index_write_batcher_;
+
   // Created only when secondary indexes are present.
   boost::optional<client::TransactionManager> transaction_manager_;
 
@@ -847,6 +881,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   template <class Ids>
   CHECKED_STATUS RemoveIntentsImpl(const RemoveIntentsData& data, const Ids& ids);
 
+  Result<docdb::ApplyTransactionState> DoPrepareApplyIntents(
+      const TransactionApplyData& data, const docdb::ApplyTransactionState* apply_state,
+      int32_t max_records, rocksdb::WriteBatch* regular_write_batch);
+
   // Tries to find intent .SST files that could be deleted and remove them.
   void CleanupIntentFiles();
   void DoCleanupIntentFiles();
@@ -894,6 +932,16 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // compaction has already been triggered for this instance.
   std::unique_ptr<ThreadPoolToken> post_split_compaction_task_pool_token_ = nullptr;
 
+  // Time until which post split compaction could be deferred because of tablet load.
+  CoarseTimePoint post_split_compaction_defer_deadline_;
+
+  // Used to interrupt wait of deferred post split compaction on shutdown.
+  std::mutex post_split_compaction_mutex_;
+  std::condition_variable post_split_compaction_cond_;
+
+  // Request rate and access key distribution used by load based tablet splitting.
+  mutable TabletLoadTracker load_tracker_;
+
   DISALLOW_COPY_AND_ASSIGN(Tablet);
 };
 
@@ -38,6 +38,8 @@ typedef std::shared_ptr<TableInfo> TableInfoPtr;
 class TabletPeer;
 typedef std::shared_ptr<TabletPeer> TabletPeerPtr;
 
+class FinishedTransactions;
+class IndexWriteBatcher;
 class SnapshotCoordinator;
 class SnapshotOperationState;
 class SplitOperationState;
@@ -50,6 +52,7 @@ class TransactionCoordinator;
 class TransactionCoordinatorContext;
 class TransactionParticipant;
 class TransactionParticipantContext;
+class TransactionStatusBatcher;
 class UpdateTxnOperationState;
 class WriteOperationState;
 
@@ -0,0 +1,73 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/docdb/doc_key.h"
+#include "yb/tablet/tablet_load_tracker.h"
+#include "yb/util/test_util.h"
+
+DECLARE_int32(tablet_split_load_sample_interval);
+DECLARE_int32(tablet_split_load_num_samples);
+DECLARE_int32(tablet_split_load_rate_window_ms);
+
+namespace yb {
+namespace tablet {
+
+class TabletLoadTrackerTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    FLAGS_tablet_split_load_sample_interval = 1;
+    FLAGS_tablet_split_load_num_samples = 100;
+  }
+};
+
+TEST_F(TabletLoadTrackerTest, MedianFollowsHotRange) {
+  TabletLoadTracker tracker;
+  ASSERT_FALSE(tracker.SampledMedianKey());
+
+  // Cold accesses to the lower half, which are pushed out of the window by the hot range.
+  for (uint16_t hash = 0; hash != 100; ++hash) {
+    tracker.RecordHashAccess(hash);
+  }
+  for (int i = 0; i != 100; ++i) {
+    tracker.RecordHashAccess(0xf000 + i);
+  }
+
+  auto median = tracker.SampledMedianKey();
+  ASSERT_TRUE(median);
+  auto hash = ASSERT_RESULT(docdb::DecodeDocKeyHash(*median));
+  ASSERT_TRUE(hash);
+  ASSERT_EQ(0xf000 + 50, *hash);
+
+  tracker.Reset();
+  ASSERT_FALSE(tracker.SampledMedianKey());
+}
+
+TEST_F(TabletLoadTrackerTest, OpsPerSec) {
+  FLAGS_tablet_split_load_rate_window_ms = 100;
+  TabletLoadTracker tracker;
+  for (int i = 0; i != 1000; ++i) {
+    tracker.RecordKeylessAccess();
+  }
+  SleepFor(MonoDelta::FromMilliseconds(200));
+  const auto ops_per_sec = tracker.OpsPerSec();
+  ASSERT_GT(ops_per_sec, 0);
+  ASSERT_LE(ops_per_sec, 1000 / 0.2);
+  // Rate is not recomputed inside the window.
+  ASSERT_EQ(ops_per_sec, tracker.OpsPerSec());
+}
+
+} // namespace tablet
+} // namespace yb
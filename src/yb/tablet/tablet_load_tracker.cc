@@ -0,0 +1,109 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/tablet_load_tracker.h"
+
+#include <algorithm>
+
+#include "yb/docdb/key_bytes.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(tablet_split_load_sample_interval, 16,
+             "Every N-th access to a tablet records its key into the sample used to pick the "
+             "split key for load based tablet splitting.");
+TAG_FLAG(tablet_split_load_sample_interval, advanced);
+
+DEFINE_int32(tablet_split_load_num_samples, 512,
+             "Number of most recent access keys kept per tablet to pick the split key for load "
+             "based tablet splitting.");
+TAG_FLAG(tablet_split_load_num_samples, advanced);
+
+DEFINE_int32(tablet_split_load_rate_window_ms, 10000,
+             "Minimal interval (in milliseconds) over which tablet request rate is computed for "
+             "load based tablet splitting.");
+TAG_FLAG(tablet_split_load_rate_window_ms, advanced);
+
+namespace yb {
+namespace tablet {
+
+TabletLoadTracker::TabletLoadTracker() : rate_updated_at_(MonoTime::Now()) {
+}
+
+bool TabletLoadTracker::ShouldSample() {
+  const uint64_t interval = std::max(FLAGS_tablet_split_load_sample_interval, 1);
+  return num_accesses_.fetch_add(1, std::memory_order_relaxed) % interval == 0;
+}
+
+void TabletLoadTracker::RecordHashAccess(uint16_t hash_code) {
+  if (!ShouldSample()) {
+    return;
+  }
+  docdb::KeyBytes key;
+  key.AppendValueType(docdb::ValueType::kUInt16Hash);
+  key.AppendUInt16(hash_code);
+  RecordAccess(key.AsSlice());
+}
+
+void TabletLoadTracker::RecordAccess(Slice encoded_split_key) {
+  const size_t capacity = std::max(FLAGS_tablet_split_load_num_samples, 1);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (samples_.size() < capacity) {
+    samples_.push_back(encoded_split_key.ToBuffer());
+    return;
+  }
+  next_sample_idx_ %= samples_.size();
+  samples_[next_sample_idx_].assign(encoded_split_key.cdata(), encoded_split_key.size());
+  ++next_sample_idx_;
+}
+
+double TabletLoadTracker::OpsPerSec() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto now = MonoTime::Now();
+  const auto passed = now.GetDeltaSince(rate_updated_at_);
+  if (passed.ToMilliseconds() < FLAGS_tablet_split_load_rate_window_ms) {
+    return ops_per_sec_;
+  }
+  const auto num_accesses = num_accesses_.load(std::memory_order_relaxed);
+  ops_per_sec_ = (num_accesses - rate_num_accesses_) / passed.ToSeconds();
+  rate_num_accesses_ = num_accesses;
+  rate_updated_at_ = now;
+  return ops_per_sec_;
+}
+
+boost::optional<std::string> TabletLoadTracker::SampledMedianKey() {
+  std::vector<std::string> samples;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Do not trust the distribution until the sample window was filled at least by half.
+    if (samples_.empty() ||
+        samples_.size() * 2 < static_cast<size_t>(FLAGS_tablet_split_load_num_samples)) {
+      return boost::none;
+    }
+    samples = samples_;
+  }
+  auto middle = samples.begin() + samples.size() / 2;
+  std::nth_element(samples.begin(), middle, samples.end());
+  return std::move(*middle);
+}
+
+void TabletLoadTracker::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  samples_.clear();
+  next_sample_idx_ = 0;
+  rate_updated_at_ = MonoTime::Now();
+  rate_num_accesses_ = num_accesses_.load(std::memory_order_relaxed);
+  ops_per_sec_ = 0;
+}
+
+} // namespace tablet
+} // namespace yb
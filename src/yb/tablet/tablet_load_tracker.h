@@ -0,0 +1,84 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TABLET_LOAD_TRACKER_H
+#define YB_TABLET_TABLET_LOAD_TRACKER_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "yb/util/monotime.h"
+#include "yb/util/slice.h"
+#include "yb/util/thread_annotations.h"
+
+namespace yb {
+namespace tablet {
+
+// Tracks the request rate of a tablet and keeps a sliding window of sampled access keys, so that
+// the tablet could be proposed for a load-based split and split at the median of recent accesses
+// rather than at the middle of its on-disk key range.
+//
+// Keys are recorded as split key prefixes (i.e. encoded doc key up to the hash code for hash
+// partitioned tables), so the resulting median could be used as split_encoded_key directly.
+//
+// Thread safe. Recording an access is a single atomic increment, only every
+// FLAGS_tablet_split_load_sample_interval-th access takes the mutex to store its key.
+class TabletLoadTracker {
+ public:
+  TabletLoadTracker();
+
+  // Records an access to the row with the specified hash code.
+  void RecordHashAccess(uint16_t hash_code);
+
+  // Records an access to the row with the specified encoded split key prefix.
+  void RecordAccess(Slice encoded_split_key);
+
+  // Records an access without a key, i.e. only accounts it in the request rate.
+  void RecordKeylessAccess() {
+    num_accesses_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Returns requests per second observed since the previous rate update. The rate is updated at
+  // most once per FLAGS_tablet_split_load_rate_window_ms, previously computed value is returned
+  // otherwise.
+  double OpsPerSec();
+
+  // Returns median of the sampled keys, or none if not enough keys were sampled yet.
+  boost::optional<std::string> SampledMedianKey();
+
+  // Drops all sampled keys and rate history.
+  void Reset();
+
+ private:
+  bool ShouldSample();
+
+  std::atomic<uint64_t> num_accesses_{0};
+
+  std::mutex mutex_;
+  // Ring buffer of the most recent sampled keys.
+  std::vector<std::string> samples_ GUARDED_BY(mutex_);
+  size_t next_sample_idx_ GUARDED_BY(mutex_) = 0;
+
+  MonoTime rate_updated_at_ GUARDED_BY(mutex_);
+  uint64_t rate_num_accesses_ GUARDED_BY(mutex_) = 0;
+  double ops_per_sec_ GUARDED_BY(mutex_) = 0;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TABLET_LOAD_TRACKER_H
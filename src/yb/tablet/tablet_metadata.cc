@@ -198,6 +198,7 @@ Status KvStoreInfo::LoadTablesFromPB(
 Status KvStoreInfo::LoadFromPB(const KvStoreInfoPB& pb, TableId primary_table_id) {
   kv_store_id = KvStoreId(pb.kv_store_id());
   rocksdb_dir = pb.rocksdb_dir();
+  slow_rocksdb_dir = pb.slow_rocksdb_dir();
   lower_bound_key = pb.lower_bound_key();
   upper_bound_key = pb.upper_bound_key();
   has_been_fully_compacted = pb.has_been_fully_compacted();
@@ -207,6 +208,11 @@ Status KvStoreInfo::LoadFromPB(const KvStoreInfoPB& pb, TableId primary_table_id
 void KvStoreInfo::ToPB(TableId primary_table_id, KvStoreInfoPB* pb) const {
   pb->set_kv_store_id(kv_store_id.ToString());
   pb->set_rocksdb_dir(rocksdb_dir);
+  if (slow_rocksdb_dir.empty()) {
+    pb->clear_slow_rocksdb_dir();
+  } else {
+    pb->set_slow_rocksdb_dir(slow_rocksdb_dir);
+  }
   if (lower_bound_key.empty()) {
     pb->clear_lower_bound_key();
   } else {
@@ -302,6 +308,12 @@ Status RaftGroupMetadata::CreateNew(FsManager* fs_manager,
                                                        schema_version,
                                                        initial_tablet_data_state,
                                                        colocated));
+  auto slow_data_root_dirs = fs_manager->GetSlowDataRootDirs();
+  if (!slow_data_root_dirs.empty()) {
+    ret->kv_store_.slow_rocksdb_dir = JoinPathSegments(
+        slow_data_root_dirs[rand.Uniform(slow_data_root_dirs.size())], FsManager::kRocksDBDirName,
+        table_dir_name, tablet_dir_name);
+  }
   RETURN_NOT_OK(ret->Flush());
   metadata->swap(ret);
   return Status::OK();
@@ -425,6 +437,13 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
     LOG_IF(WARNING, !s.ok()) << "Unable to delete rocksdb data directory " << rocksdb_dir;
   }
 
+  const auto slow_rocksdb_dir = this->slow_rocksdb_dir();
+  if (!slow_rocksdb_dir.empty() && fs_manager_->env()->FileExists(slow_rocksdb_dir)) {
+    auto s = fs_manager_->env()->DeleteRecursively(slow_rocksdb_dir);
+    LOG_IF(WARNING, !s.ok()) << "Unable to delete rocksdb slow data directory "
+                             << slow_rocksdb_dir;
+  }
+
   const auto intents_dir = this->intents_rocksdb_dir();
   if (fs_manager_->env()->FileExists(intents_dir)) {
     status = rocksdb::DestroyDB(intents_dir, rocksdb_options);
@@ -465,9 +484,11 @@ bool RaftGroupMetadata::IsTombstonedWithNoRocksDBData() const {
   std::lock_guard<MutexType> lock(data_mutex_);
   const auto& rocksdb_dir = kv_store_.rocksdb_dir;
   const auto intents_dir = rocksdb_dir + kIntentsDBSuffix;
+  const auto& slow_rocksdb_dir = kv_store_.slow_rocksdb_dir;
   return tablet_data_state_ == TABLET_DATA_TOMBSTONED &&
       !fs_manager_->env()->FileExists(rocksdb_dir) &&
-      !fs_manager_->env()->FileExists(intents_dir);
+      !fs_manager_->env()->FileExists(intents_dir) &&
+      (slow_rocksdb_dir.empty() || !fs_manager_->env()->FileExists(slow_rocksdb_dir));
 }
 
 Status RaftGroupMetadata::DeleteSuperBlock() {
@@ -880,6 +901,14 @@ std::string RaftGroupMetadata::GetSubRaftGroupDataDir(const RaftGroupId& raft_gr
   return JoinPathSegments(DirName(kv_store_.rocksdb_dir), MakeTabletDirName(raft_group_id));
 }
 
+std::string RaftGroupMetadata::GetSubRaftGroupSlowDataDir(
+    const RaftGroupId& raft_group_id) const {
+  if (kv_store_.slow_rocksdb_dir.empty()) {
+    return std::string();
+  }
+  return JoinPathSegments(DirName(kv_store_.slow_rocksdb_dir), MakeTabletDirName(raft_group_id));
+}
+
 Result<RaftGroupMetadataPtr> RaftGroupMetadata::CreateSubtabletMetadata(
     const RaftGroupId& raft_group_id, const Partition& partition,
     const std::string& lower_bound_key, const std::string& upper_bound_key) const {
@@ -893,6 +922,7 @@ Result<RaftGroupMetadataPtr> RaftGroupMetadata::CreateSubtabletMetadata(
   metadata->kv_store_.lower_bound_key = lower_bound_key;
   metadata->kv_store_.upper_bound_key = upper_bound_key;
   metadata->kv_store_.rocksdb_dir = GetSubRaftGroupDataDir(raft_group_id);
+  metadata->kv_store_.slow_rocksdb_dir = GetSubRaftGroupSlowDataDir(raft_group_id);
   metadata->kv_store_.has_been_fully_compacted = false;
   *metadata->partition_ = partition;
   metadata->state_ = kInitialized;
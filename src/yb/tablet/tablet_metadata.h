@@ -143,6 +143,10 @@ struct KvStoreInfo {
   // `rocksdb_dir + kIntentsDBSuffix` path.
   std::string rocksdb_dir;
 
+  // Optional directory on slow storage for SST files of the regular RocksDB that contain only old
+  // data. See FLAGS_fs_slow_data_dirs.
+  std::string slow_rocksdb_dir;
+
   // Optional inclusive lower bound and exclusive upper bound for keys served by this KV-store.
   // See docdb::KeyBounds.
   std::string lower_bound_key;
@@ -336,6 +340,7 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
   std::string rocksdb_dir() const { return kv_store_.rocksdb_dir; }
   std::string intents_rocksdb_dir() const { return kv_store_.rocksdb_dir + kIntentsDBSuffix; }
   std::string snapshots_dir() const { return kv_store_.rocksdb_dir + kSnapshotsDirSuffix; }
+  std::string slow_rocksdb_dir() const { return kv_store_.slow_rocksdb_dir; }
 
   std::string lower_bound_key() const { return kv_store_.lower_bound_key; }
   std::string upper_bound_key() const { return kv_store_.upper_bound_key; }
@@ -458,6 +463,10 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
   // Uses the same root dir as for `this` Raft group.
   std::string GetSubRaftGroupDataDir(const RaftGroupId& raft_group_id) const;
 
+  // The same as GetSubRaftGroupDataDir, but for the slow data dir. Returns empty string when this
+  // Raft group does not have slow data dir.
+  std::string GetSubRaftGroupSlowDataDir(const RaftGroupId& raft_group_id) const;
+
   // Creates a new Raft group metadata for the part of existing tablet contained in this Raft group.
   // Assigns specified Raft group ID, partition and key bounds for a new tablet.
   Result<RaftGroupMetadataPtr> CreateSubtabletMetadata(
@@ -134,6 +134,18 @@ METRIC_DEFINE_counter(tablet, restart_read_requests,
   yb::MetricUnit::kRequests,
   "Number of read requests that require restart.");
 
+METRIC_DEFINE_histogram(tablet, read_safe_time_wait_duration,
+  "Time Waiting For Safe Time",
+  yb::MetricUnit::kMicroseconds,
+  "Time spent by reads with specified read time waiting for tablet safe time to reach it.",
+  60000000LU, 2);
+
+METRIC_DEFINE_counter(tablet, restart_free_read_requests,
+  "Read Requests Without Uncertainty Window",
+  yb::MetricUnit::kRequests,
+  "Number of read requests with specified read time and no uncertainty window, i.e. reads "
+  "that cannot require restart.");
+
 METRIC_DEFINE_counter(tablet, consistent_prefix_read_requests,
     "Consistent Prefix Read Requests",
     yb::MetricUnit::kRequests,
@@ -161,7 +173,9 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(majority_sst_files_rejections),
     MINIT(transaction_conflicts),
     MINIT(expired_transactions),
+    MINIT(read_safe_time_wait_duration),
     MINIT(restart_read_requests),
+    MINIT(restart_free_read_requests),
     MINIT(consistent_prefix_read_requests),
     MINIT(pgsql_consistent_prefix_read_rows),
     MINIT(rows_inserted) {
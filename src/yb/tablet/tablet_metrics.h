@@ -59,6 +59,7 @@ struct TabletMetrics {
   scoped_refptr<Histogram> write_lock_latency;
   scoped_refptr<Histogram> write_op_duration_client_propagated_consistency;
   scoped_refptr<Histogram> write_op_duration_commit_wait_consistency;
+  scoped_refptr<Histogram> read_safe_time_wait_duration;
 
   scoped_refptr<Counter> not_leader_rejections;
   scoped_refptr<Counter> leader_memory_pressure_rejections;
@@ -66,6 +67,7 @@ struct TabletMetrics {
   scoped_refptr<Counter> transaction_conflicts;
   scoped_refptr<Counter> expired_transactions;
   scoped_refptr<Counter> restart_read_requests;
+  scoped_refptr<Counter> restart_free_read_requests;
   scoped_refptr<Counter> consistent_prefix_read_requests;
   scoped_refptr<Counter> pgsql_consistent_prefix_read_rows;
 
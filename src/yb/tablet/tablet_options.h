@@ -13,6 +13,7 @@
 #ifndef YB_TABLET_TABLET_OPTIONS_H
 #define YB_TABLET_TABLET_OPTIONS_H
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -29,6 +30,7 @@ namespace rocksdb {
 class Cache;
 class EventListener;
 class MemoryMonitor;
+class RateLimiter;
 class Env;
 }
 
@@ -49,8 +51,15 @@ YB_STRONGLY_TYPED_BOOL(IsDropTable);
 
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  // Separate cache for index and filter blocks, if set.
+  std::shared_ptr<rocksdb::Cache> metadata_block_cache;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
+  // Rate limiters shared by all tablets of the server, if set.
+  std::shared_ptr<rocksdb::RateLimiter> rate_limiter;
+  std::shared_ptr<rocksdb::RateLimiter> flush_rate_limiter;
+  // Number of SST files of regular DB, at which writes to the tablet start being rejected.
+  std::function<uint64_t()> sst_files_write_stall_trigger;
   yb::Env* env = Env::Default();
   rocksdb::Env* rocksdb_env = rocksdb::Env::Default();
 };
@@ -72,6 +81,7 @@ struct TabletInitData {
   IsSysCatalogTablet is_sys_catalog = IsSysCatalogTablet::kFalse;
   SnapshotCoordinator* snapshot_coordinator = nullptr;
   TabletSplitter* tablet_splitter = nullptr;
+  IndexWriteBatcher* index_write_batcher = nullptr;
 };
 
 } // namespace tablet
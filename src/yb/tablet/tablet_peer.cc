@@ -155,7 +155,8 @@ TabletPeer::TabletPeer(
     Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     MetricRegistry* metric_registry,
     TabletSplitter* tablet_splitter,
-    const std::shared_future<client::YBClient*>& client_future)
+    const std::shared_future<client::YBClient*>& client_future,
+    TransactionStatusBatcher* transaction_status_batcher)
     : meta_(meta),
       tablet_id_(meta->raft_group_id()),
       local_peer_pb_(local_peer_pb),
@@ -169,7 +170,8 @@ TabletPeer::TabletPeer(
       preparing_operations_counter_(operation_tracker_.LogPrefix()),
       metric_registry_(metric_registry),
       tablet_splitter_(tablet_splitter),
-      client_future_(client_future) {}
+      client_future_(client_future),
+      transaction_status_batcher_(transaction_status_batcher) {}
 
 TabletPeer::~TabletPeer() {
   std::lock_guard<simple_spinlock> lock(lock_);
@@ -141,6 +141,8 @@ class TabletPeer : public consensus::ConsensusContext,
 
   // Creates TabletPeer.
   // `tablet_splitter` will be used for applying split tablet Raft operation.
+  // `transaction_status_batcher` will be used by transaction participant to request transaction
+  // statuses, could be null.
   TabletPeer(
       const RaftGroupMetadataPtr& meta,
       const consensus::RaftPeerPB& local_peer_pb,
@@ -149,7 +151,8 @@ class TabletPeer : public consensus::ConsensusContext,
       Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
       MetricRegistry* metric_registry,
       TabletSplitter* tablet_splitter,
-      const std::shared_future<client::YBClient*>& client_future);
+      const std::shared_future<client::YBClient*>& client_future,
+      TransactionStatusBatcher* transaction_status_batcher = nullptr);
 
   ~TabletPeer();
 
@@ -324,13 +327,17 @@ class TabletPeer : public consensus::ConsensusContext,
     return clock_;
   }
 
-  void Enqueue(rpc::ThreadPoolTask* task);
+  void Enqueue(rpc::ThreadPoolTask* task) override;
   void StrandEnqueue(rpc::StrandTask* task) override;
 
   const std::shared_future<client::YBClient*>& client_future() const override {
     return client_future_;
   }
 
+  TransactionStatusBatcher* transaction_status_batcher() const override {
+    return transaction_status_batcher_;
+  }
+
   int64_t LeaderTerm() const override;
   consensus::LeaderStatus LeaderStatus(bool allow_stale = false) const;
 
@@ -507,6 +514,8 @@ class TabletPeer : public consensus::ConsensusContext,
 
   std::shared_future<client::YBClient*> client_future_;
 
+  TransactionStatusBatcher* transaction_status_batcher_;
+
   rpc::Messenger* messenger_;
 
   DISALLOW_COPY_AND_ASSIGN(TabletPeer);
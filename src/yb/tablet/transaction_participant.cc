@@ -41,15 +41,18 @@
 #include "yb/rpc/poller.h"
 #include "yb/rpc/rpc.h"
 #include "yb/rpc/rpc_context.h"
+#include "yb/rpc/scheduler.h"
 #include "yb/rpc/thread_pool.h"
 
 #include "yb/tablet/cleanup_aborts_task.h"
 #include "yb/tablet/cleanup_intents_task.h"
+#include "yb/tablet/finished_transactions.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/running_transaction.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/transaction_loader.h"
 #include "yb/tablet/transaction_status_resolver.h"
+#include "yb/tablet/wait_queue.h"
 
 #include "yb/tserver/tserver_service.pb.h"
 #include "yb/tserver/service_util.h"
@@ -96,6 +99,18 @@ DEFINE_uint64(transactions_status_poll_interval_ms, 500 * yb::kTimeMultiplier,
 
 DEFINE_bool(transactions_poll_check_aborted, true, "Check aborted transactions during poll.");
 
+DEFINE_bool(cleanup_intents_by_compaction, false,
+            "Do not remove intents of aborted and applied transactions explicitly, but let intents "
+            "DB compaction drop them.");
+TAG_FLAG(cleanup_intents_by_compaction, runtime);
+TAG_FLAG(cleanup_intents_by_compaction, advanced);
+
+DEFINE_uint64(max_transactions_cleaned_by_compaction, 100000,
+              "Max number of finished transactions per tablet, whose intents are waiting to be "
+              "dropped by intents DB compaction. Intents of other finished transactions are "
+              "removed explicitly.");
+TAG_FLAG(max_transactions_cleaned_by_compaction, advanced);
+
 DECLARE_int64(transaction_abort_check_timeout_ms);
 
 METRIC_DEFINE_simple_counter(
@@ -106,6 +121,14 @@ METRIC_DEFINE_simple_gauge_uint64(
     tablet, transactions_running,
     "Total number of transactions running in participant",
     yb::MetricUnit::kTransactions);
+METRIC_DEFINE_simple_gauge_uint64(
+    tablet, transactions_applying,
+    "Number of committed transactions whose intents are being applied in background",
+    yb::MetricUnit::kTransactions);
+METRIC_DEFINE_histogram(
+    tablet, transaction_apply_lag, "Transaction Apply Lag", yb::MetricUnit::kMilliseconds,
+    "Time between commit of a large transaction and the moment all of its intents were applied "
+    "to regular DB", 60000000LU, 2);
 
 namespace yb {
 namespace tablet {
@@ -114,6 +137,38 @@ namespace {
 
 YB_STRONGLY_TYPED_BOOL(PostApplyCleanup);
 
+// Invokes callbacks of waiters in the thread pool, so they are not invoked while holding the
+// participant mutex.
+class NotifyWaitersTask : public rpc::ThreadPoolTask {
+ public:
+  NotifyWaitersTask(WaitQueue::Callbacks callbacks, OperationCounter* counter)
+      : callbacks_(std::move(callbacks)), operation_(counter) {}
+
+  virtual ~NotifyWaitersTask() = default;
+
+  void Run() override {
+    Invoke(Status::OK());
+  }
+
+  void Done(const Status& status) override {
+    // Callbacks are still present if the task was rejected by the thread pool.
+    Invoke(status);
+    delete this;
+  }
+
+ private:
+  void Invoke(const Status& status) {
+    for (auto& callback : callbacks_) {
+      callback(status);
+    }
+    callbacks_.clear();
+  }
+
+  WaitQueue::Callbacks callbacks_;
+  // Waiting operations do not prevent tablet shutdown, so shutdown waits for their notification.
+  ScopedOperation operation_;
+};
+
 } // namespace
 
 std::string TransactionApplyData::ToString() const {
@@ -128,11 +183,14 @@ class TransactionParticipant::Impl
        const scoped_refptr<MetricEntity>& entity)
       : RunningTransactionContext(context, applier),
         log_prefix_(context->LogPrefix()),
+        notifying_waiters_(log_prefix_),
         loader_(this, entity),
         poller_(log_prefix_, std::bind(&Impl::Poll, this)) {
     LOG_WITH_PREFIX(INFO) << "Create";
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
     metric_transaction_not_found_ = METRIC_transaction_not_found.Instantiate(entity);
+    metric_transactions_applying_ = METRIC_transactions_applying.Instantiate(entity, 0);
+    metric_transaction_apply_lag_ = METRIC_transaction_apply_lag.Instantiate(entity);
   }
 
   ~Impl() {
@@ -151,6 +209,7 @@ class TransactionParticipant::Impl
     }
 
     poller_.Shutdown();
+    wait_queue_timer_.Shutdown();
 
     if (start_latch_.count()) {
       start_latch_.CountDown();
@@ -163,14 +222,24 @@ class TransactionParticipant::Impl
   void CompleteShutdown() {
     LOG_IF_WITH_PREFIX(DFATAL, !closing_.load()) << __func__ << " w/o StartShutdown";
 
+    // Applies check closing_ between batches, so wait for batches that are being written.
+    applying_intents_.Shutdown();
+
     decltype(status_resolvers_) status_resolvers;
+    WaitQueue::Callbacks waiters;
     {
       MinRunningNotifier min_running_notifier(nullptr /* applier */);
       std::lock_guard<std::mutex> lock(mutex_);
       transactions_.clear();
       TransactionsModifiedUnlocked(&min_running_notifier);
       status_resolvers.swap(status_resolvers_);
+      wait_queue_.ExtractAll(&waiters);
+    }
+
+    for (auto& waiter : waiters) {
+      waiter(STATUS(Aborted, "Transaction participant is shutting down"));
     }
+    notifying_waiters_.Shutdown();
 
     rpcs_.Shutdown();
     loader_.Shutdown();
@@ -383,7 +452,7 @@ class TransactionParticipant::Impl
       const auto& id = front.transaction_id;
       auto it = transactions_.find(id);
       if (it != transactions_.end()) {
-        (**it).ScheduleRemoveIntents(*it);
+        RemoveIntentsUnlocked(*it);
         RemoveTransaction(it, min_running_notifier);
       }
       VLOG_WITH_PREFIX(2) << "Cleaned from queue: " << id;
@@ -522,6 +591,7 @@ class TransactionParticipant::Impl
       } else {
         transactions_.modify(lock_and_iterator.iterator, [&data](auto& txn) {
           txn->SetLocalCommitTime(data.commit_ht);
+          txn->SetApplyOpId(OpId::FromPB(data.op_id));
         });
 
         LOG_IF_WITH_PREFIX(DFATAL, data.log_ht < last_safe_time_)
@@ -947,6 +1017,8 @@ class TransactionParticipant::Impl
 
     {
       std::lock_guard<std::mutex> lock(mutex_);
+      wait_queue_timer_.Bind(&participant_context_.scheduler());
+      wait_queue_started_ = true;
       for (const auto& p : pending_applies) {
         auto it = transactions_.find(p.first);
         if (it == transactions_.end()) {
@@ -1071,8 +1143,12 @@ class TransactionParticipant::Impl
   bool RemoveUnlocked(
       const Transactions::iterator& it, const std::string& reason,
       MinRunningNotifier* min_running_notifier) REQUIRES(mutex_) {
+    // Transaction is removed after it was applied or its intents were cleaned up after abort, so
+    // it does not block writes of other transactions anymore.
+    NotifyWaitersUnlocked((**it).id());
+
     if (running_requests_.empty()) {
-      (**it).ScheduleRemoveIntents(*it);
+      RemoveIntentsUnlocked(*it);
       TransactionId txn_id = (**it).id();
       RemoveTransaction(it, min_running_notifier);
       VLOG_WITH_PREFIX(2) << "Cleaned transaction: " << txn_id << ", reason: " << reason
@@ -1095,6 +1171,26 @@ class TransactionParticipant::Impl
     return false;
   }
 
+  // Intents of removed transaction are left to be dropped by intents DB compaction, unless there
+  // are too many transactions waiting for it. In this case intents are removed explicitly.
+  // Intents of applied transaction are also removed explicitly when op id of its apply is unknown,
+  // since compaction cannot tell when the apply is flushed to regular DB.
+  void RemoveIntentsUnlocked(const RunningTransactionPtr& transaction) REQUIRES(mutex_) {
+    const auto apply_op_id = transaction->local_commit_time().is_valid()
+        ? transaction->apply_op_id() : OpId::Min();
+    if (GetAtomicFlag(&FLAGS_cleanup_intents_by_compaction) && !transaction->ProcessingApply() &&
+        apply_op_id.valid() &&
+        finished_transactions_.Add(transaction->id(), participant_context_.Now(), apply_op_id)) {
+      VLOG_WITH_PREFIX(2) << "Intents will be dropped by compaction: " << transaction->id();
+      return;
+    }
+    transaction->ScheduleRemoveIntents(transaction);
+  }
+
+  FinishedTransactions& finished_transactions() {
+    return finished_transactions_;
+  }
+
   struct LockAndFindResult {
     static Transactions::const_iterator UninitializedIterator() {
       static const Transactions empty_transactions;
@@ -1126,6 +1222,9 @@ class TransactionParticipant::Impl
       }
       recently_removed = WasTransactionRecentlyRemoved(id);
     }
+    // Intents of finished transaction are expected to be found until they are dropped by
+    // compaction, so there is no need to log or schedule their cleanup.
+    recently_removed = recently_removed || finished_transactions_.Contains(id);
     if (recently_removed) {
       VLOG_WITH_PREFIX(1)
           << "Attempt to load recently removed transaction: " << id << ", for: " << reason;
@@ -1322,6 +1421,7 @@ class TransactionParticipant::Impl
   }
 
   void Poll() {
+    WaitQueue::Callbacks expired_waiters;
     {
       MinRunningNotifier min_running_notifier(&applier_);
       std::lock_guard<std::mutex> lock(mutex_);
@@ -1330,10 +1430,79 @@ class TransactionParticipant::Impl
       if (ANNOTATE_UNPROTECTED_READ(FLAGS_transactions_poll_check_aborted)) {
         CheckForAbortedTransactions();
       }
+      ExpireWaitersUnlocked(&expired_waiters);
     }
+    InvokeExpiredWaiters(&expired_waiters);
     CleanupStatusResolvers();
   }
 
+  void ExpireWaiters() {
+    WaitQueue::Callbacks expired_waiters;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ExpireWaitersUnlocked(&expired_waiters);
+    }
+    InvokeExpiredWaiters(&expired_waiters);
+  }
+
+  void ExpireWaitersUnlocked(WaitQueue::Callbacks* expired_waiters) REQUIRES(mutex_) {
+    auto next_deadline = wait_queue_.ExpireWaiters(CoarseMonoClock::now(), expired_waiters);
+    wait_queue_timer_deadline_ = CoarseTimePoint::max();
+    ScheduleWaitQueueTimerUnlocked(next_deadline);
+  }
+
+  void InvokeExpiredWaiters(WaitQueue::Callbacks* expired_waiters) {
+    for (auto& waiter : *expired_waiters) {
+      waiter(STATUS(TimedOut, "Timed out waiting for conflicting transaction"));
+    }
+  }
+
+  // Makes sure that waiters are expired not later than deadline, instead of waiting for the next
+  // poll.
+  void ScheduleWaitQueueTimerUnlocked(CoarseTimePoint deadline) REQUIRES(mutex_) {
+    if (deadline >= wait_queue_timer_deadline_) {
+      return;
+    }
+    wait_queue_timer_deadline_ = deadline;
+    wait_queue_timer_.Schedule([this](const Status& status) {
+      // Aborted timer was either rescheduled or the participant is shutting down.
+      if (status.ok()) {
+        ExpireWaiters();
+      }
+    }, ToSteady(deadline));
+  }
+
+  bool WaitForAnyFinished(
+      const std::vector<TransactionId>& ids, CoarseTimePoint deadline,
+      StdStatusCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (Closing() || !wait_queue_started_) {
+      return false;
+    }
+    for (const auto& id : ids) {
+      // Finish of transaction that is not tracked by this participant would not be noticed.
+      if (transactions_.find(id) == transactions_.end()) {
+        VLOG_WITH_PREFIX(4) << "Cannot wait for not running transaction: " << id;
+        return false;
+      }
+    }
+    wait_queue_.Add(ids, deadline, std::move(callback));
+    ScheduleWaitQueueTimerUnlocked(deadline);
+    return true;
+  }
+
+  void NotifyWaitersUnlocked(const TransactionId& id) REQUIRES(mutex_) {
+    if (wait_queue_.num_waiters() == 0) {
+      return;
+    }
+    WaitQueue::Callbacks ready;
+    wait_queue_.TransactionFinished(id, &ready);
+    if (!ready.empty()) {
+      VLOG_WITH_PREFIX(4) << "Wake up " << ready.size() << " waiters of " << id;
+      participant_context_.Enqueue(new NotifyWaitersTask(std::move(ready), &notifying_waiters_));
+    }
+  }
+
   void CheckForAbortedTransactions() REQUIRES(mutex_) {
     if (transactions_.empty()) {
       return;
@@ -1452,6 +1621,19 @@ class TransactionParticipant::Impl
   };
   std::deque<RecentlyRemovedTransaction> recently_removed_transactions_cleanup_queue_;
 
+  WaitQueue wait_queue_ GUARDED_BY(mutex_);
+  // Set when transactions are loaded, waiting for a transaction that was not loaded yet would not
+  // be possible.
+  bool wait_queue_started_ GUARDED_BY(mutex_) = false;
+  // Fails waiters of wait_queue_ when their deadline has passed.
+  rpc::ScheduledTaskTracker wait_queue_timer_;
+  // Time when wait_queue_timer_ is scheduled to fire.
+  CoarseTimePoint wait_queue_timer_deadline_ GUARDED_BY(mutex_) = CoarseTimePoint::max();
+  // Counts waiters that were woken up but not yet notified.
+  OperationCounter notifying_waiters_;
+
+  FinishedTransactions finished_transactions_{FLAGS_max_transactions_cleaned_by_compaction};
+
   std::mutex status_resolvers_mutex_;
   std::deque<TransactionStatusResolver> status_resolvers_ GUARDED_BY(status_resolvers_mutex_);
 
@@ -1551,6 +1733,12 @@ Status TransactionParticipant::CheckAborted(const TransactionId& id) {
   return impl_->CheckAborted(id);
 }
 
+bool TransactionParticipant::WaitForAnyFinished(
+    const std::vector<TransactionId>& ids, CoarseTimePoint deadline,
+    StdStatusCallback callback) {
+  return impl_->WaitForAnyFinished(ids, deadline, std::move(callback));
+}
+
 void TransactionParticipant::FillPriorities(
     boost::container::small_vector_base<std::pair<TransactionId, uint64_t>>* inout) {
   return impl_->FillPriorities(inout);
@@ -1575,6 +1763,10 @@ TransactionParticipantContext* TransactionParticipant::context() const {
   return impl_->participant_context();
 }
 
+FinishedTransactions& TransactionParticipant::finished_transactions() {
+  return impl_->finished_transactions();
+}
+
 HybridTime TransactionParticipant::MinRunningHybridTime() const {
   return impl_->MinRunningHybridTime();
 }
@@ -41,6 +41,7 @@
 #include "yb/util/async_util.h"
 #include "yb/util/opid.pb.h"
 #include "yb/util/result.h"
+#include "yb/util/status_callback.h"
 
 namespace rocksdb {
 
@@ -87,7 +88,21 @@ struct RemoveIntentsData {
 // Interface to object that should apply intents in RocksDB when transaction is applying.
 class TransactionIntentApplier {
  public:
+  // Applies intents of the transaction as part of its apply operation. Only a limited number of
+  // intents is applied, if some intents are left then returned state is active and the rest should
+  // be applied in background using PrepareApplyIntents and WriteAppliedIntents.
   virtual Result<docdb::ApplyTransactionState> ApplyIntents(const TransactionApplyData& data) = 0;
+
+  // Fills regular_write_batch with the next portion of intents of the transaction, starting from
+  // apply_state. Does not write anything, so could be invoked while the previous portion is being
+  // written by WriteAppliedIntents.
+  virtual Result<docdb::ApplyTransactionState> PrepareApplyIntents(
+      const TransactionApplyData& data, const docdb::ApplyTransactionState* apply_state,
+      rocksdb::WriteBatch* regular_write_batch) = 0;
+
+  // Writes portion of intents prepared by PrepareApplyIntents to regular DB.
+  virtual void WriteAppliedIntents(
+      const TransactionApplyData& data, rocksdb::WriteBatch* regular_write_batch) = 0;
   virtual CHECKED_STATUS RemoveIntents(
       const RemoveIntentsData& data, const TransactionId& transaction_id) = 0;
   virtual CHECKED_STATUS RemoveIntents(
@@ -110,11 +125,17 @@ class TransactionParticipantContext {
   virtual const server::ClockPtr& clock_ptr() const = 0;
   virtual rpc::Scheduler& scheduler() const = 0;
 
+  // Returns node level batcher of transaction status requests, or null if there is none.
+  virtual TransactionStatusBatcher* transaction_status_batcher() const = 0;
+
   // Fills RemoveIntentsData with information about replicated state.
   virtual void GetLastReplicatedData(RemoveIntentsData* data) = 0;
 
   // Enqueue task to participant context strand.
   virtual void StrandEnqueue(rpc::StrandTask* task) = 0;
+
+  // Enqueue task to thread pool used by participant context strand.
+  virtual void Enqueue(rpc::ThreadPoolTask* task) = 0;
   virtual void UpdateClock(HybridTime hybrid_time) = 0;
   virtual bool IsLeader() = 0;
   virtual void SubmitUpdateTransaction(
@@ -207,6 +228,14 @@ class TransactionParticipant : public TransactionStatusManager {
   void FillPriorities(
       boost::container::small_vector_base<std::pair<TransactionId, uint64_t>>* inout) override;
 
+  // Invokes callback when any of the specified transactions is finished in this tablet, i.e. it was
+  // applied or its intents were removed after abort, or with TimedOut status when deadline passes.
+  // Returns false without registering callback if some of transactions are not running in this
+  // tablet, so their finish could not be tracked.
+  bool WaitForAnyFinished(
+      const std::vector<TransactionId>& ids, CoarseTimePoint deadline,
+      StdStatusCallback callback);
+
   void GetStatus(const TransactionId& transaction_id,
                  size_t required_num_replicated_batches,
                  int64_t term,
@@ -215,6 +244,9 @@ class TransactionParticipant : public TransactionStatusManager {
 
   TransactionParticipantContext* context() const;
 
+  // Finished transactions whose intents should be dropped by intents DB compaction.
+  FinishedTransactions& finished_transactions();
+
   HybridTime MinRunningHybridTime() const override;
 
   // When minimal start hybrid time of running transaction will be at least `ht` applier
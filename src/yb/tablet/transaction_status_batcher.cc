@@ -0,0 +1,437 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/transaction_status_batcher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/gutil/casts.h"
+
+#include "yb/rpc/rpc.h"
+#include "yb/rpc/scheduler.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/thread_annotations.h"
+
+DEFINE_bool(enable_transaction_status_batching, true,
+            "Coalesce transaction status requests from all transaction participants of the node "
+            "to the same status tablet into a single RPC.");
+TAG_FLAG(enable_transaction_status_batching, runtime);
+TAG_FLAG(enable_transaction_status_batching, advanced);
+
+DEFINE_int32(transaction_status_batch_interval_ms, 10,
+             "Max time during which transaction status requests to a status tablet are "
+             "accumulated while a previous batch to this tablet is in flight. When no batch is in "
+             "flight, requests are sent right away.");
+TAG_FLAG(transaction_status_batch_interval_ms, runtime);
+TAG_FLAG(transaction_status_batch_interval_ms, advanced);
+
+DECLARE_uint64(max_transactions_in_status_request);
+
+METRIC_DEFINE_counter(server, transaction_status_requests_batched,
+                      "Batched Transaction Status Requests", yb::MetricUnit::kRequests,
+                      "Number of transaction status requests from local transaction participants "
+                      "sent through the node level batcher.");
+
+METRIC_DEFINE_counter(server, transaction_status_batch_rpcs,
+                      "Transaction Status Batch RPCs", yb::MetricUnit::kRequests,
+                      "Number of GetTransactionStatus RPCs sent by the node level batcher. "
+                      "transaction_status_requests_batched divided by this value is the "
+                      "coalescing ratio.");
+
+METRIC_DEFINE_histogram(server, transaction_status_batch_size,
+                        "Transaction Status Batch Size", yb::MetricUnit::kTransactions,
+                        "Number of distinct transactions in GetTransactionStatus RPC sent by the "
+                        "node level batcher.",
+                        10000, 2);
+
+namespace yb {
+namespace tablet {
+
+class TransactionStatusBatcher::Impl : public std::enable_shared_from_this<Impl> {
+ public:
+  // Status request of a single transaction, queued in the batcher until the batch is sent.
+  class Request : public rpc::RpcCommand {
+   public:
+    Request(std::shared_ptr<Impl> impl, CoarseTimePoint deadline, const TabletId& status_tablet,
+            const TransactionId& transaction_id, HybridTime propagated_hybrid_time,
+            client::GetTransactionStatusCallback callback)
+        : impl_(std::move(impl)), deadline_(deadline), status_tablet_(status_tablet),
+          transaction_id_(transaction_id), propagated_hybrid_time_(propagated_hybrid_time),
+          callback_(std::move(callback)) {}
+
+    void SendRpc() override {
+      impl_->Add(std::static_pointer_cast<Request>(shared_from_this()));
+    }
+
+    std::string ToString() const override {
+      return Format("BatchedGetTransactionStatus: { status_tablet: $0 transaction_id: $1 }",
+                    status_tablet_, transaction_id_);
+    }
+
+    void Finished(const Status& status) override {
+      Complete(status, tserver::GetTransactionStatusResponsePB());
+    }
+
+    void Abort() override {
+      Finished(STATUS(Aborted, "Transaction status request aborted"));
+    }
+
+    CoarseTimePoint deadline() const override {
+      return deadline_;
+    }
+
+    // Invokes callback, unless it was already invoked, i.e. request was aborted while batch
+    // containing it was in flight.
+    void Complete(const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+      if (completed_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+      }
+      auto callback = std::move(callback_);
+      callback(status, response);
+    }
+
+    bool completed() const {
+      return completed_.load(std::memory_order_acquire);
+    }
+
+    const TabletId& status_tablet() const {
+      return status_tablet_;
+    }
+
+    const TransactionId& transaction_id() const {
+      return transaction_id_;
+    }
+
+    HybridTime propagated_hybrid_time() const {
+      return propagated_hybrid_time_;
+    }
+
+   private:
+    std::shared_ptr<Impl> impl_;
+    const CoarseTimePoint deadline_;
+    const TabletId status_tablet_;
+    const TransactionId transaction_id_;
+    const HybridTime propagated_hybrid_time_;
+    client::GetTransactionStatusCallback callback_;
+    std::atomic<bool> completed_{false};
+  };
+
+  using RequestPtr = std::shared_ptr<Request>;
+
+  Impl(const std::shared_future<client::YBClient*>& client_future, rpc::Scheduler* scheduler,
+       const scoped_refptr<MetricEntity>& metric_entity)
+      : client_future_(client_future), scheduler_(*scheduler) {
+    if (metric_entity) {
+      requests_metric_ = METRIC_transaction_status_requests_batched.Instantiate(metric_entity);
+      rpcs_metric_ = METRIC_transaction_status_batch_rpcs.Instantiate(metric_entity);
+      batch_size_metric_ = METRIC_transaction_status_batch_size.Instantiate(metric_entity);
+    }
+  }
+
+  client::YBClient* client() const {
+    return client_future_.get();
+  }
+
+  void Shutdown() {
+    std::vector<RequestPtr> requests;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closing_) {
+        return;
+      }
+      closing_ = true;
+      for (auto& id_and_tablet : tablets_) {
+        for (auto& id_and_requests : id_and_tablet.second.queue) {
+          for (auto& request : id_and_requests.second) {
+            requests.push_back(std::move(request));
+          }
+        }
+      }
+      tablets_.clear();
+    }
+    for (const auto& request : requests) {
+      request->Abort();
+    }
+    rpcs_.Shutdown();
+  }
+
+  void Add(const RequestPtr& request) {
+    bool added = false;
+    bool flush = false;
+    bool schedule_flush = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!closing_) {
+        auto& tablet = tablets_[request->status_tablet()];
+        tablet.queue[request->transaction_id()].push_back(request);
+        added = true;
+        // Requests are accumulated only while a previous batch is in flight, so a single request
+        // does not wait for anything.
+        if (tablet.rpcs_in_flight == 0) {
+          flush = true;
+        } else if (!tablet.flush_scheduled) {
+          tablet.flush_scheduled = true;
+          schedule_flush = true;
+        }
+      }
+    }
+    if (!added) {
+      request->Abort();
+      return;
+    }
+    IncrementCounter(requests_metric_);
+    if (flush) {
+      Flush(request->status_tablet());
+    } else if (schedule_flush) {
+      auto interval = std::chrono::milliseconds(
+          std::max(FLAGS_transaction_status_batch_interval_ms, 0));
+      scheduler_.Schedule(
+          [self = shared_from_this(), status_tablet = request->status_tablet()](
+              const Status& status) {
+            self->Flush(status_tablet);
+          },
+          interval);
+    }
+  }
+
+ private:
+  // Requests waiting to be sent to status tablet, grouped by transaction.
+  using TabletQueue = std::unordered_map<
+      TransactionId, std::vector<RequestPtr>, TransactionIdHash>;
+
+  struct TabletState {
+    TabletQueue queue;
+    // Number of batches sent to the status tablet whose responses were not received yet.
+    size_t rpcs_in_flight = 0;
+    bool flush_scheduled = false;
+  };
+
+  struct Batch {
+    std::vector<std::pair<TransactionId, std::vector<RequestPtr>>> entries;
+  };
+
+  using BatchPtr = std::shared_ptr<Batch>;
+
+  // Sends all requests queued for the status tablet, splitting them into RPCs of at most
+  // FLAGS_max_transactions_in_status_request transactions.
+  void Flush(const TabletId& status_tablet) {
+    const size_t max_transactions = std::max<uint64_t>(
+        FLAGS_max_transactions_in_status_request, 1);
+    for (;;) {
+      auto batch = std::make_shared<Batch>();
+      bool last = false;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = tablets_.find(status_tablet);
+        if (it == tablets_.end()) {
+          return;
+        }
+        auto& tablet = it->second;
+        tablet.flush_scheduled = false;
+        auto& queue = tablet.queue;
+        while (!queue.empty() && batch->entries.size() < max_transactions) {
+          auto entry = queue.begin();
+          auto& requests = entry->second;
+          // Requests that were aborted while queued do not need status anymore.
+          requests.erase(std::remove_if(requests.begin(), requests.end(), [](const auto& request) {
+            return request->completed();
+          }), requests.end());
+          if (!requests.empty()) {
+            batch->entries.emplace_back(entry->first, std::move(requests));
+          }
+          queue.erase(entry);
+        }
+        last = queue.empty();
+        if (!batch->entries.empty()) {
+          ++tablet.rpcs_in_flight;
+        } else if (last && tablet.rpcs_in_flight == 0) {
+          tablets_.erase(it);
+        }
+      }
+      if (!batch->entries.empty()) {
+        Send(status_tablet, batch);
+      }
+      if (last) {
+        return;
+      }
+    }
+  }
+
+  void Send(const TabletId& status_tablet, const BatchPtr& batch) {
+    tserver::GetTransactionStatusRequestPB req;
+    req.set_tablet_id(status_tablet);
+    auto propagated_hybrid_time = HybridTime::kMin;
+    auto deadline = CoarseTimePoint::min();
+    for (const auto& entry : batch->entries) {
+      const auto& id = entry.first;
+      req.add_transaction_id()->assign(pointer_cast<const char*>(id.data()), id.size());
+      for (const auto& request : entry.second) {
+        propagated_hybrid_time.MakeAtLeast(request->propagated_hybrid_time());
+        deadline = std::max(deadline, request->deadline());
+      }
+    }
+    req.set_propagated_hybrid_time(propagated_hybrid_time.ToUint64());
+
+    IncrementCounter(rpcs_metric_);
+    if (batch_size_metric_) {
+      batch_size_metric_->Increment(batch->entries.size());
+    }
+
+    auto* client = this->client();
+    auto handle = rpcs_.Prepare();
+    if (!client || handle == rpcs_.InvalidHandle()) {
+      CompleteBatch(*batch, STATUS(Aborted, "Aborted because cannot start RPC"),
+                    tserver::GetTransactionStatusResponsePB());
+      BatchDone(status_tablet);
+      return;
+    }
+    *handle = client::GetTransactionStatus(
+        deadline,
+        nullptr /* tablet */,
+        client,
+        &req,
+        [self = shared_from_this(), handle, batch, status_tablet](
+            const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+          self->rpcs_.Unregister(handle);
+          self->BatchReceived(status, response, *batch);
+          self->BatchDone(status_tablet);
+        });
+    (**handle).SendRpc();
+  }
+
+  // Sends requests that were accumulated while the batch was in flight.
+  void BatchDone(const TabletId& status_tablet) {
+    bool flush = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = tablets_.find(status_tablet);
+      if (it == tablets_.end()) {
+        return;
+      }
+      auto& tablet = it->second;
+      --tablet.rpcs_in_flight;
+      if (!tablet.queue.empty()) {
+        flush = true;
+      } else if (tablet.rpcs_in_flight == 0) {
+        tablets_.erase(it);
+      }
+    }
+    if (flush) {
+      Flush(status_tablet);
+    }
+  }
+
+  // Splits response to the batched RPC into per transaction responses.
+  void BatchReceived(Status status, const tserver::GetTransactionStatusResponsePB& response,
+                     const Batch& batch) {
+    VLOG(4) << "Batched statuses of " << batch.entries.size() << " transactions received: "
+            << status << ", " << response.ShortDebugString();
+
+    if (status.ok() && !response.has_error() &&
+        static_cast<size_t>(response.status().size()) != batch.entries.size()) {
+      status = STATUS_FORMAT(
+          IllegalState, "Bad response size, expected $0 entries, but found: $1",
+          batch.entries.size(), response.ShortDebugString());
+    }
+
+    tserver::GetTransactionStatusResponsePB single_response;
+    if (response.has_propagated_hybrid_time()) {
+      single_response.set_propagated_hybrid_time(response.propagated_hybrid_time());
+    }
+    if (!status.ok() || response.has_error()) {
+      if (response.has_error()) {
+        *single_response.mutable_error() = response.error();
+      }
+      CompleteBatch(batch, status, single_response);
+      return;
+    }
+
+    for (size_t i = 0; i != batch.entries.size(); ++i) {
+      single_response.clear_status();
+      single_response.clear_status_hybrid_time();
+      single_response.clear_num_replicated_batches();
+      single_response.add_status(response.status(i));
+      if (i < static_cast<size_t>(response.status_hybrid_time().size())) {
+        single_response.add_status_hybrid_time(response.status_hybrid_time(i));
+      }
+      if (i < static_cast<size_t>(response.num_replicated_batches().size())) {
+        single_response.add_num_replicated_batches(response.num_replicated_batches(i));
+      }
+      for (const auto& request : batch.entries[i].second) {
+        request->Complete(status, single_response);
+      }
+    }
+  }
+
+  void CompleteBatch(const Batch& batch, const Status& status,
+                     const tserver::GetTransactionStatusResponsePB& response) {
+    for (const auto& entry : batch.entries) {
+      for (const auto& request : entry.second) {
+        request->Complete(status, response);
+      }
+    }
+  }
+
+  std::shared_future<client::YBClient*> client_future_;
+  rpc::Scheduler& scheduler_;
+  rpc::Rpcs rpcs_;
+
+  scoped_refptr<Counter> requests_metric_;
+  scoped_refptr<Counter> rpcs_metric_;
+  scoped_refptr<Histogram> batch_size_metric_;
+
+  std::mutex mutex_;
+  bool closing_ GUARDED_BY(mutex_) = false;
+  std::unordered_map<TabletId, TabletState> tablets_ GUARDED_BY(mutex_);
+};
+
+TransactionStatusBatcher::TransactionStatusBatcher(
+    const std::shared_future<client::YBClient*>& client_future, rpc::Scheduler* scheduler,
+    const scoped_refptr<MetricEntity>& metric_entity)
+    : impl_(std::make_shared<Impl>(client_future, scheduler, metric_entity)) {
+}
+
+TransactionStatusBatcher::~TransactionStatusBatcher() {
+  Shutdown();
+}
+
+void TransactionStatusBatcher::Shutdown() {
+  impl_->Shutdown();
+}
+
+rpc::RpcCommandPtr TransactionStatusBatcher::GetTransactionStatus(
+    CoarseTimePoint deadline, const TabletId& status_tablet, const TransactionId& transaction_id,
+    HybridTime propagated_hybrid_time, client::GetTransactionStatusCallback callback) {
+  if (!FLAGS_enable_transaction_status_batching) {
+    tserver::GetTransactionStatusRequestPB req;
+    req.set_tablet_id(status_tablet);
+    req.add_transaction_id()->assign(
+        pointer_cast<const char*>(transaction_id.data()), transaction_id.size());
+    req.set_propagated_hybrid_time(propagated_hybrid_time.ToUint64());
+    return client::GetTransactionStatus(
+        deadline, nullptr /* tablet */, impl_->client(), &req, std::move(callback));
+  }
+  return std::make_shared<Impl::Request>(
+      impl_, deadline, status_tablet, transaction_id, propagated_hybrid_time, std::move(callback));
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,69 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TRANSACTION_STATUS_BATCHER_H
+#define YB_TABLET_TRANSACTION_STATUS_BATCHER_H
+
+#include <future>
+#include <memory>
+
+#include "yb/client/client_fwd.h"
+#include "yb/client/transaction_rpc.h"
+
+#include "yb/common/entity_ids.h"
+#include "yb/common/hybrid_time.h"
+#include "yb/common/transaction.h"
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/metrics.h"
+
+namespace yb {
+namespace tablet {
+
+// Coalesces transaction status requests sent by all transaction participants of the node to the
+// same status tablet. When no batch to the status tablet is in flight, a request is sent right
+// away. Otherwise requests are accumulated until the batch in flight completes, but at most for
+// FLAGS_transaction_status_batch_interval_ms, deduplicated by transaction id, and sent as a single
+// GetTransactionStatus RPC. The response is then split into per transaction responses for the
+// original requesters.
+//
+// So when a status tablet leader moves, the new leader receives one request per node instead of
+// one request per running transaction of each participant.
+class TransactionStatusBatcher {
+ public:
+  TransactionStatusBatcher(
+      const std::shared_future<client::YBClient*>& client_future, rpc::Scheduler* scheduler,
+      const scoped_refptr<MetricEntity>& metric_entity);
+  ~TransactionStatusBatcher();
+
+  void Shutdown();
+
+  // Returns RPC command that requests status of transaction from its status tablet and invokes
+  // callback with the response that contains only status of this transaction.
+  // The command should be started and tracked by the caller, the same way as RPC command returned
+  // by client::GetTransactionStatus.
+  // Falls back to a separate RPC when batching is disabled.
+  MUST_USE_RESULT rpc::RpcCommandPtr GetTransactionStatus(
+      CoarseTimePoint deadline, const TabletId& status_tablet, const TransactionId& transaction_id,
+      HybridTime propagated_hybrid_time, client::GetTransactionStatusCallback callback);
+
+ private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TRANSACTION_STATUS_BATCHER_H
@@ -0,0 +1,103 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/tablet/wait_queue.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace tablet {
+
+class WaitQueueTest : public YBTest {
+ protected:
+  void InvokeAll(WaitQueue::Callbacks* callbacks, const Status& status) {
+    for (auto& callback : *callbacks) {
+      callback(status);
+    }
+    callbacks->clear();
+  }
+};
+
+TEST_F(WaitQueueTest, WakeUpOnAnyBlocker) {
+  WaitQueue queue;
+  auto blocker1 = TransactionId::GenerateRandom();
+  auto blocker2 = TransactionId::GenerateRandom();
+  auto deadline = CoarseMonoClock::now() + 1h;
+
+  int woken = 0;
+  queue.Add({blocker1, blocker2}, deadline, [&woken](const Status& status) {
+    ASSERT_OK(status);
+    ++woken;
+  });
+  queue.Add({blocker2}, deadline, [&woken](const Status& status) {
+    ASSERT_OK(status);
+    ++woken;
+  });
+  ASSERT_EQ(2, queue.num_waiters());
+
+  WaitQueue::Callbacks ready;
+  queue.TransactionFinished(TransactionId::GenerateRandom(), &ready);
+  ASSERT_TRUE(ready.empty());
+
+  queue.TransactionFinished(blocker1, &ready);
+  ASSERT_EQ(1, ready.size());
+  ASSERT_EQ(1, queue.num_waiters());
+  InvokeAll(&ready, Status::OK());
+  ASSERT_EQ(1, woken);
+
+  // First waiter was already woken up, so only the second one should be notified.
+  queue.TransactionFinished(blocker2, &ready);
+  ASSERT_EQ(1, ready.size());
+  ASSERT_EQ(0, queue.num_waiters());
+  InvokeAll(&ready, Status::OK());
+  ASSERT_EQ(2, woken);
+}
+
+TEST_F(WaitQueueTest, Expire) {
+  WaitQueue queue;
+  auto blocker = TransactionId::GenerateRandom();
+  auto now = CoarseMonoClock::now();
+
+  int expired_count = 0;
+  auto callback = [&expired_count](const Status& status) {
+    ASSERT_TRUE(status.IsTimedOut()) << status;
+    ++expired_count;
+  };
+  queue.Add({blocker}, now + 1s, callback);
+  queue.Add({blocker}, now + 1h, callback);
+
+  WaitQueue::Callbacks expired;
+  ASSERT_EQ(now + 1s, queue.ExpireWaiters(now, &expired));
+  ASSERT_TRUE(expired.empty());
+
+  ASSERT_EQ(now + 1h, queue.ExpireWaiters(now + 1min, &expired));
+  ASSERT_EQ(1, expired.size());
+  ASSERT_EQ(1, queue.num_waiters());
+  InvokeAll(&expired, STATUS(TimedOut, "Wait timed out"));
+  ASSERT_EQ(1, expired_count);
+
+  queue.ExtractAll(&expired);
+  ASSERT_EQ(1, expired.size());
+  ASSERT_EQ(0, queue.num_waiters());
+  InvokeAll(&expired, STATUS(TimedOut, "Wait timed out"));
+  ASSERT_EQ(2, expired_count);
+
+  ASSERT_EQ(CoarseTimePoint::max(), queue.ExpireWaiters(now + 2h, &expired));
+  ASSERT_TRUE(expired.empty());
+}
+
+} // namespace tablet
+} // namespace yb
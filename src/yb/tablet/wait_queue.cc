@@ -0,0 +1,76 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/wait_queue.h"
+
+#include <algorithm>
+
+namespace yb {
+namespace tablet {
+
+void WaitQueue::Add(const std::vector<TransactionId>& blockers, CoarseTimePoint deadline,
+                    StdStatusCallback callback) {
+  auto waiter = std::make_shared<Waiter>(Waiter {
+    .deadline = deadline,
+    .callback = std::move(callback),
+  });
+  for (const auto& blocker : blockers) {
+    waiters_.emplace(blocker, waiter);
+  }
+  ++num_waiters_;
+}
+
+void WaitQueue::ExtractCallback(Waiter* waiter, Callbacks* out) {
+  if (!waiter->callback) {
+    return;
+  }
+  out->push_back(std::move(waiter->callback));
+  waiter->callback = nullptr;
+  --num_waiters_;
+}
+
+void WaitQueue::TransactionFinished(const TransactionId& id, Callbacks* ready) {
+  auto range = waiters_.equal_range(id);
+  for (auto it = range.first; it != range.second; ++it) {
+    ExtractCallback(it->second.get(), ready);
+  }
+  waiters_.erase(range.first, range.second);
+}
+
+CoarseTimePoint WaitQueue::ExpireWaiters(CoarseTimePoint now, Callbacks* expired) {
+  auto next_deadline = CoarseTimePoint::max();
+  for (auto it = waiters_.begin(); it != waiters_.end();) {
+    auto& waiter = *it->second;
+    if (waiter.deadline <= now) {
+      ExtractCallback(&waiter, expired);
+    }
+    // Also drop entries of waiters that were already woken up by another blocker.
+    if (!waiter.callback) {
+      it = waiters_.erase(it);
+    } else {
+      next_deadline = std::min(next_deadline, waiter.deadline);
+      ++it;
+    }
+  }
+  return next_deadline;
+}
+
+void WaitQueue::ExtractAll(Callbacks* out) {
+  for (auto& entry : waiters_) {
+    ExtractCallback(entry.second.get(), out);
+  }
+  waiters_.clear();
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,85 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_WAIT_QUEUE_H
+#define YB_TABLET_WAIT_QUEUE_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/transaction.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/status_callback.h"
+
+namespace yb {
+namespace tablet {
+
+// Write operations of transactions that conflict with higher priority transactions, waiting for
+// those transactions to finish in this tablet, i.e. to be applied or to have their intents removed
+// after abort. The waiting operation then resolves its conflicts again, instead of failing and
+// being retried by the client.
+//
+// Not thread safe, access is guarded by the transaction participant mutex. Callbacks are not
+// invoked by the queue itself, but extracted, so they could be invoked without holding the mutex.
+class WaitQueue {
+ public:
+  using Callbacks = std::vector<StdStatusCallback>;
+
+  WaitQueue() = default;
+
+  WaitQueue(const WaitQueue&) = delete;
+  void operator=(const WaitQueue&) = delete;
+
+  // Adds waiter, whose callback should be invoked when any of blockers is finished or when deadline
+  // is passed.
+  void Add(const std::vector<TransactionId>& blockers, CoarseTimePoint deadline,
+           StdStatusCallback callback);
+
+  // Extracts callbacks of waiters blocked by the finished transaction into ready.
+  void TransactionFinished(const TransactionId& id, Callbacks* ready);
+
+  // Extracts callbacks of waiters whose deadline is before now into expired.
+  // Returns the earliest deadline of the remaining waiters, or CoarseTimePoint::max() if there are
+  // no such waiters.
+  CoarseTimePoint ExpireWaiters(CoarseTimePoint now, Callbacks* expired);
+
+  // Extracts callbacks of all waiters into out.
+  void ExtractAll(Callbacks* out);
+
+  size_t num_waiters() const {
+    return num_waiters_;
+  }
+
+ private:
+  struct Waiter {
+    CoarseTimePoint deadline;
+    StdStatusCallback callback;
+  };
+
+  using WaiterPtr = std::shared_ptr<Waiter>;
+
+  // Moves callback of waiter to out, unless it was already extracted while processing another
+  // blocker of the same waiter.
+  void ExtractCallback(Waiter* waiter, Callbacks* out);
+
+  // The same waiter is present once for each of its blockers.
+  std::unordered_multimap<TransactionId, WaiterPtr, TransactionIdHash> waiters_;
+  size_t num_waiters_ = 0;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_WAIT_QUEUE_H
@@ -62,6 +62,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/net/tunnel.h"
+#include "yb/util/path_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
 
@@ -109,6 +110,10 @@ MiniTabletServer::MiniTabletServer(const string& fs_root,
   }
   opts_.fs_opts.wal_paths = { fs_root };
   opts_.fs_opts.data_paths = { fs_root };
+  // Slow data dirs are not shared between tablet servers, so each one uses its own subdir.
+  for (auto& slow_data_path : opts_.fs_opts.slow_data_paths) {
+    slow_data_path = JoinPathSegments(slow_data_path, Format("ts-$0", index_));
+  }
 }
 
 MiniTabletServer::~MiniTabletServer() {
@@ -263,6 +263,7 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
   // Clear fields rocksdb_dir and wal_dir so we get an error if we try to use them without setting
   // them to the right path.
   kv_store->clear_rocksdb_dir();
+  kv_store->clear_slow_rocksdb_dir();
   superblock_->clear_wal_dir();
 
   superblock_->set_tablet_data_state(tablet::TABLET_DATA_COPYING);
@@ -299,6 +300,11 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
     }
     // Replace rocksdb_dir in the received superblock with our rocksdb_dir.
     kv_store->set_rocksdb_dir(meta_->rocksdb_dir());
+    // Slow data dir of the source is not valid here, so use our own one, if any. SST files are
+    // downloaded to rocksdb_dir and RocksDB resolves their paths on open.
+    if (!meta_->slow_rocksdb_dir().empty()) {
+      kv_store->set_slow_rocksdb_dir(meta_->slow_rocksdb_dir());
+    }
 
     // Replace wal_dir in the received superblock with our assigned wal_dir.
     superblock_->set_wal_dir(meta_->wal_dir());
@@ -369,6 +375,10 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
 
     // Replace rocksdb_dir in the received superblock with our rocksdb_dir.
     kv_store->set_rocksdb_dir(meta_->rocksdb_dir());
+    // The same for slow_rocksdb_dir.
+    if (!meta_->slow_rocksdb_dir().empty()) {
+      kv_store->set_slow_rocksdb_dir(meta_->slow_rocksdb_dir());
+    }
 
     // Replace wal_dir in the received superblock with our assigned wal_dir.
     superblock_->set_wal_dir(meta_->wal_dir());
@@ -320,6 +320,49 @@ bool RejectWrite(tablet::TabletPeer* tablet_peer, const std::string& message, do
   return false;
 }
 
+// Responds to UpdateTransactions RPC when updates of all its transaction states are completed.
+class UpdateTransactionsResponder {
+ public:
+  UpdateTransactionsResponder(
+      rpc::RpcContext context, UpdateTransactionsResponsePB* resp, int num_states,
+      const server::ClockPtr& clock)
+      : context_(std::move(context)), resp_(resp), clock_(clock), pending_(num_states) {
+    // Preallocate all statuses, so they could be filled concurrently.
+    for (int i = 0; i != num_states; ++i) {
+      resp_->add_statuses();
+    }
+  }
+
+  void Completed(int idx, const Status& status) {
+    StatusToPB(status, resp_->mutable_statuses(idx));
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      resp_->set_propagated_hybrid_time(clock_->Now().ToUint64());
+      context_.RespondSuccess();
+    }
+  }
+
+ private:
+  rpc::RpcContext context_;
+  UpdateTransactionsResponsePB* const resp_;
+  server::ClockPtr clock_;
+  std::atomic<int> pending_;
+};
+
+class UpdateTransactionsCompletionCallback : public OperationCompletionCallback {
+ public:
+  UpdateTransactionsCompletionCallback(
+      std::shared_ptr<UpdateTransactionsResponder> responder, int idx)
+      : responder_(std::move(responder)), idx_(idx) {}
+
+  void OperationCompleted() override {
+    responder_->Completed(idx_, status_);
+  }
+
+ private:
+  std::shared_ptr<UpdateTransactionsResponder> responder_;
+  const int idx_;
+};
+
 void AdjustYsqlOperationTransactionality(
     size_t ysql_batch_size,
     const TabletPeer* tablet_peer,
@@ -972,6 +1015,61 @@ void TabletServiceImpl::UpdateTransaction(const UpdateTransactionRequestPB* req,
   }
 }
 
+void TabletServiceImpl::UpdateTransactions(const UpdateTransactionsRequestPB* req,
+                                           UpdateTransactionsResponsePB* resp,
+                                           rpc::RpcContext context) {
+  TRACE("UpdateTransactions");
+
+  VLOG(1) << "UpdateTransactions: " << req->ShortDebugString()
+          << ", context: " << context.ToString();
+  UpdateClock(*req, server_->Clock());
+
+  for (const auto& state : req->states()) {
+    if (state.status() != TransactionStatus::CREATED &&
+        state.status() != TransactionStatus::PENDING) {
+      SetupErrorAndRespond(
+          resp->mutable_error(),
+          STATUS_FORMAT(InvalidArgument, "Unexpected status in batched transaction update: $0",
+                        state.ShortDebugString()),
+          TabletServerErrorPB::UNKNOWN_ERROR, &context);
+      return;
+    }
+  }
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+
+  auto* transaction_coordinator = tablet.tablet->transaction_coordinator();
+  if (!transaction_coordinator) {
+    SetupErrorAndRespond(
+        resp->mutable_error(),
+        STATUS_FORMAT(InvalidArgument, "No transaction coordinator at tablet $0", req->tablet_id()),
+        TabletServerErrorPB::UNKNOWN_ERROR, &context);
+    return;
+  }
+
+  if (req->states().empty()) {
+    resp->set_propagated_hybrid_time(server_->Clock()->Now().ToUint64());
+    context.RespondSuccess();
+    return;
+  }
+
+  // Request could be destroyed as soon as the last state is handled, so do not access it after.
+  const int num_states = req->states().size();
+  auto responder = std::make_shared<UpdateTransactionsResponder>(
+      std::move(context), resp, num_states, server_->Clock());
+  for (int i = 0; i != num_states; ++i) {
+    auto state = std::make_unique<tablet::UpdateTxnOperationState>(
+        tablet.tablet.get(), &req->states(i));
+    state->set_completion_callback(
+        std::make_unique<UpdateTransactionsCompletionCallback>(responder, i));
+    transaction_coordinator->Handle(std::move(state), tablet.leader_term);
+  }
+}
+
 template <class Req, class Resp, class Action>
 void TabletServiceImpl::PerformAtLeader(
     const Req& req, Resp* resp, rpc::RpcContext* context, const Action& action) {
@@ -1678,8 +1776,15 @@ struct ReadContext {
         read_time.global_limit = read_time.read;
       }
     } else {
-      safe_ht_to_read = VERIFY_RESULT(tablet->SafeTime(
-          require_lease, read_time.read, context->GetClientDeadline()));
+      auto* metrics = down_cast<Tablet*>(tablet.get())->metrics();
+      {
+        tablet::ScopedTabletMetricsTracker tracker(metrics->read_safe_time_wait_duration);
+        safe_ht_to_read = VERIFY_RESULT(tablet->SafeTime(
+            require_lease, read_time.read, context->GetClientDeadline()));
+      }
+      if (read_time.global_limit <= read_time.read) {
+        metrics->restart_free_read_requests->Increment();
+      }
     }
     return Status::OK();
   }
@@ -106,6 +106,10 @@ class TabletServiceImpl : public TabletServerServiceIf {
                          UpdateTransactionResponsePB* resp,
                          rpc::RpcContext context) override;
 
+  void UpdateTransactions(const UpdateTransactionsRequestPB* req,
+                          UpdateTransactionsResponsePB* resp,
+                          rpc::RpcContext context) override;
+
   void GetTransactionStatus(const GetTransactionStatusRequestPB* req,
                             GetTransactionStatusResponsePB* resp,
                             rpc::RpcContext context) override;
@@ -13,40 +13,95 @@
 
 #include "yb/tserver/tablet_split_heartbeat_data_provider.h"
 
+#include <set>
+
 #include "yb/master/master.pb.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/service_util.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 
 DEFINE_int32(tablet_split_monitor_heartbeat_interval_ms, 5000,
              "Interval (in milliseconds) at which tserver check tablets and sends a list of "
              "tablets to split in a heartbeat to master.");
 
+DEFINE_int32(tablet_split_max_outstanding_per_node, 1,
+             "Max number of splits, whose children are led by a tserver and are still waiting "
+             "for post split compaction. No more tablets are proposed for split by load until "
+             "they are compacted. Size based splits are not limited.");
+TAG_FLAG(tablet_split_max_outstanding_per_node, runtime);
+
 using namespace std::literals;
 
 namespace yb {
 namespace tserver {
 
+namespace {
+
+// Returns the number of splits whose children are led by this tserver and still wait for post
+// split compaction. Both children of a split led by this tserver are counted as one split.
+int NumOutstandingSplits(const std::vector<tablet::TabletPeerPtr>& tablet_peers) {
+  // Children of the same split share the split key, as the upper bound of the first child and
+  // the lower bound of the second one.
+  std::set<std::pair<TableId, std::string>> split_keys;
+  int result = 0;
+  for (const auto& tablet_peer : tablet_peers) {
+    if (!LeaderTerm(*tablet_peer).ok()) {
+      continue;
+    }
+    const auto tablet = tablet_peer->shared_tablet();
+    if (!tablet || !tablet->metadata() || !tablet->StillHasParentDataAfterSplit()) {
+      continue;
+    }
+    const auto table_id = tablet->metadata()->table_id();
+    const auto lower_bound_key = tablet->metadata()->lower_bound_key();
+    const auto upper_bound_key = tablet->metadata()->upper_bound_key();
+    if ((!lower_bound_key.empty() && split_keys.count({table_id, lower_bound_key})) ||
+        (!upper_bound_key.empty() && split_keys.count({table_id, upper_bound_key}))) {
+      // Sibling was already counted.
+      continue;
+    }
+    ++result;
+    split_keys.emplace(table_id, lower_bound_key);
+    split_keys.emplace(table_id, upper_bound_key);
+  }
+  return result;
+}
+
+} // namespace
+
 TabletSplitHeartbeatDataProvider::TabletSplitHeartbeatDataProvider(TabletServer* server) :
   PeriodicalHeartbeatDataProvider(server,
       MonoDelta::FromMilliseconds(FLAGS_tablet_split_monitor_heartbeat_interval_ms)) {}
 
 void TabletSplitHeartbeatDataProvider::DoAddData(
     const master::TSHeartbeatResponsePB& last_resp, master::TSHeartbeatRequestPB* req) {
-  if (!last_resp.has_tablet_split_size_threshold_bytes()) {
-    return;
-  }
-  const auto split_size_threshold = last_resp.tablet_split_size_threshold_bytes();
-  VLOG_WITH_FUNC(2) << "split_size_threshold: " << split_size_threshold;
-  if (split_size_threshold <= 0) {
+  const auto split_size_threshold = last_resp.has_tablet_split_size_threshold_bytes()
+      ? last_resp.tablet_split_size_threshold_bytes() : 0;
+  const auto split_ops_per_sec_threshold = last_resp.has_tablet_split_ops_per_sec_threshold()
+      ? last_resp.tablet_split_ops_per_sec_threshold() : 0;
+  VLOG_WITH_FUNC(2) << "split_size_threshold: " << split_size_threshold
+                    << ", split_ops_per_sec_threshold: " << split_ops_per_sec_threshold;
+  if (split_size_threshold <= 0 && split_ops_per_sec_threshold <= 0) {
     return;
   }
 
   const auto tablet_peers = server().tablet_manager()->GetTabletPeers();
 
+  // Tablets that were split but not yet compacted are still rewriting their data, limit the
+  // number of load based splits per node so they do not pile up compaction load. Size based splits
+  // are not limited, since the tablet would only grow further while waiting.
+  const auto num_outstanding_splits = NumOutstandingSplits(tablet_peers);
+  const bool allow_split_by_load =
+      num_outstanding_splits < FLAGS_tablet_split_max_outstanding_per_node;
+  if (!allow_split_by_load) {
+    VLOG_WITH_FUNC(2) << "Outstanding splits: " << num_outstanding_splits
+                      << ", not splitting tablets by load";
+  }
+
   for (const auto& tablet_peer : tablet_peers) {
     if (!tablet_peer->CheckRunning().ok() || !LeaderTerm(*tablet_peer).ok()) {
       // Only check tablets for which current tserver is leader.
@@ -59,33 +114,46 @@ void TabletSplitHeartbeatDataProvider::DoAddData(
         // TODO(tsplit): Tablet splitting for colocated tables is not supported.
         tablet->metadata()->colocated() ||
         tablet->metadata()->tablet_data_state() != tablet::TabletDataState::TABLET_DATA_READY ||
-        tablet->GetCurrentVersionSstFilesSize() < split_size_threshold ||
         // TODO(tsplit): We don't split not yet fully compacted post-split tablets for now, since
         // detecting effective middle key and tablet size for such tablets is not yet implemented.
         tablet->StillHasParentDataAfterSplit()) {
       VLOG_WITH_FUNC(3) << Format(
-          "Skipping tablet: $0, data state: $1, SST files size: $2, has key bounds: $3, has been "
-          "fully compacted: $4",
+          "Skipping tablet: $0, data state: $1, has key bounds: $2, has been fully compacted: $3",
           tablet->tablet_id(),
           tablet->metadata() ? AsString(tablet->metadata()->tablet_data_state()) : "NONE",
-          tablet->GetCurrentVersionSstFilesSize(), tablet->doc_db().key_bounds->IsInitialized(),
+          tablet->doc_db().key_bounds->IsInitialized(),
           tablet->metadata()->has_been_fully_compacted());
       continue;
     }
 
+    const auto sst_files_size = tablet->GetCurrentVersionSstFilesSize();
+    const auto ops_per_sec = tablet->load_tracker().OpsPerSec();
+    const bool split_by_size =
+        split_size_threshold > 0 && sst_files_size >= static_cast<uint64_t>(split_size_threshold);
+    const bool split_by_load = allow_split_by_load &&
+        split_ops_per_sec_threshold > 0 && ops_per_sec >= split_ops_per_sec_threshold;
+    if (!split_by_size && !split_by_load) {
+      VLOG_WITH_FUNC(3) << Format(
+          "Skipping tablet: $0, SST files size: $1, ops/s: $2", tablet->tablet_id(),
+          sst_files_size, ops_per_sec);
+      continue;
+    }
+
     const auto& tablet_id = tablet->tablet_id();
-    const auto split_encoded_key = tablet->GetEncodedMiddleSplitKey();
+    // Hot ranges are separated by splitting at the median of sampled accesses, while size based
+    // split keeps the children equal by size.
+    const auto split_encoded_key = split_by_size ? tablet->GetEncodedMiddleSplitKey()
+                                                 : tablet->GetEncodedLoadSplitKey();
     if (!split_encoded_key.ok()) {
       LOG(WARNING) << Format(
-          "Failed to get middle split key for tablet $0: $1", tablet_id,
-          split_encoded_key.status());
+          "Failed to get split key for tablet $0: $1", tablet_id, split_encoded_key.status());
       continue;
     }
 
     const auto doc_key_hash = docdb::DecodeDocKeyHash(*split_encoded_key);
     if (!doc_key_hash.ok()) {
       LOG(ERROR) << Format(
-          "Failed to decode hash code from the middle split key for tablet $0: $1", tablet_id,
+          "Failed to decode hash code from the split key for tablet $0: $1", tablet_id,
           doc_key_hash.status());
       continue;
     }
@@ -100,8 +168,8 @@ void TabletSplitHeartbeatDataProvider::DoAddData(
       tablet_for_split->set_split_partition_key(*split_encoded_key);
     }
     VLOG_WITH_FUNC(1) << Format(
-        "Found tablet to split: $0, size: $1", tablet->tablet_id(),
-        tablet->GetCurrentVersionSstFilesSize());
+        "Found tablet to split: $0, size: $1, ops/s: $2, split by load: $3", tablet->tablet_id(),
+        sst_files_size, ops_per_sec, !split_by_size);
     // TODO(tsplit): remove this return after issue with splitting more than one tablet "at once"
     // is fixed.
     return;
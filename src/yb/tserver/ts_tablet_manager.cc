@@ -58,6 +58,7 @@
 #include "yb/consensus/raft_consensus.h"
 
 #include "yb/docdb/consensus_frontier.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 
 #include "yb/fs/fs_manager.h"
 
@@ -82,6 +83,8 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_options.h"
+#include "yb/tablet/index_write_batcher.h"
+#include "yb/tablet/transaction_status_batcher.h"
 #include "yb/tablet/operations/split_operation.h"
 
 #include "yb/tserver/heartbeater.h"
@@ -211,6 +214,12 @@ DEFINE_int32(db_block_cache_size_percentage, 50,
              "Default percentage of total available memory to use as block cache size, if not "
              "asking for a raw number, through FLAGS_db_block_cache_size_bytes.");
 
+DEFINE_int32(db_metadata_block_cache_percentage, 0,
+             "Percentage of block cache size that is used for a separate cache of index and "
+             "filter blocks, so they are not evicted by data blocks. 0 means that index and filter "
+             "blocks share block cache with data blocks.");
+TAG_FLAG(db_metadata_block_cache_percentage, advanced);
+
 DEFINE_int32(read_pool_max_threads, 128,
              "The maximum number of threads allowed for read_pool_. This pool is used "
              "to run multiple read operations, that are part of the same tablet rpc, "
@@ -242,6 +251,8 @@ DEFINE_int32(tserver_yb_client_default_timeout_ms, kTServerYbClientDefaultTimeou
 DEFINE_bool(enable_restart_transaction_status_tablets_first, true,
             "Set to true to prioritize bootstrapping transaction status tablets first.");
 
+DECLARE_uint64(sst_files_soft_limit);
+
 namespace yb {
 namespace tserver {
 
@@ -475,6 +486,12 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                   server_->metric_entity(), post_split_trigger_compaction_pool))
               .Build(&post_split_trigger_compaction_pool_));
 
+  docdb::InitSharedRateLimiters(&tablet_options_);
+  // Writes are rejected starting from this number of SST files, see tablet_service.cc.
+  tablet_options_.sst_files_write_stall_trigger = [] {
+    return FLAGS_sst_files_soft_limit;
+  };
+
   int64_t block_cache_size_bytes = FLAGS_db_block_cache_size_bytes;
   int64_t total_ram_avail = MemTracker::GetRootTracker()->limit();
   // Auto-compute size of block cache if asked to.
@@ -493,6 +510,24 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
       block_cache_size_bytes, "BlockBasedTable", server_->mem_tracker());
 
   if (FLAGS_db_block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
+    CHECK(FLAGS_db_metadata_block_cache_percentage >= 0 &&
+          FLAGS_db_metadata_block_cache_percentage < 100)
+        << "Flag db_metadata_block_cache_percentage must be between 0 and 99. Current value: "
+        << FLAGS_db_metadata_block_cache_percentage;
+    // Metadata cache is carved out of block cache, so total memory used by caches is the same.
+    const int64_t metadata_block_cache_size_bytes =
+        block_cache_size_bytes * FLAGS_db_metadata_block_cache_percentage / 100;
+    if (metadata_block_cache_size_bytes > 0) {
+      block_cache_size_bytes -= metadata_block_cache_size_bytes;
+      tablet_options_.metadata_block_cache = rocksdb::NewLRUCache(
+          metadata_block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits);
+      // Reported together with the data block cache, so block cache metrics keep covering all
+      // cached blocks.
+      tablet_options_.metadata_block_cache->SetMetrics(server_->metric_entity());
+      metadata_block_cache_gc_ = std::make_shared<LRUCacheGC>(
+          tablet_options_.metadata_block_cache);
+      block_based_table_mem_tracker_->AddGarbageCollector(metadata_block_cache_gc_);
+    }
     tablet_options_.block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
                                                        FLAGS_db_block_cache_num_shard_bits);
     tablet_options_.block_cache->SetMetrics(server_->metric_entity());
@@ -552,6 +587,14 @@ Status TSTabletManager::Init() {
     }
   });
 
+  transaction_status_batcher_ = std::make_unique<tablet::TransactionStatusBatcher>(
+      async_client_init_->get_client_future(), &server_->messenger()->scheduler(),
+      server_->metric_entity());
+
+  index_write_batcher_ = std::make_unique<tablet::IndexWriteBatcher>(
+      async_client_init_->get_client_future(), &server_->messenger()->scheduler(),
+      server_->metric_entity());
+
   tablet_options_.env = server_->GetEnv();
   tablet_options_.rocksdb_env = server_->GetRocksDBEnv();
   tablet_options_.listeners = server_->options().listeners;
@@ -1254,7 +1297,8 @@ Result<TabletPeerPtr> TSTabletManager::CreateAndRegisterTabletPeer(
       Bind(&TSTabletManager::ApplyChange, Unretained(this), meta->raft_group_id()),
       metric_registry_,
       this,
-      async_client_init_->get_client_future()));
+      async_client_init_->get_client_future(),
+      transaction_status_batcher_.get()));
   RETURN_NOT_OK(RegisterTablet(meta->raft_group_id(), tablet_peer, mode));
   return tablet_peer;
 }
@@ -1471,6 +1515,7 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
       .is_sys_catalog = tablet::IsSysCatalogTablet::kFalse,
       .snapshot_coordinator = nullptr,
       .tablet_splitter = this,
+      .index_write_batcher = index_write_batcher_.get(),
     };
     tablet::BootstrapTabletData data = {
       .tablet_init_data = tablet_init_data,
@@ -1610,6 +1655,14 @@ void TSTabletManager::CompleteShutdown() {
     peer->CompleteShutdown();
   }
 
+  if (transaction_status_batcher_) {
+    transaction_status_batcher_->Shutdown();
+  }
+
+  if (index_write_batcher_) {
+    index_write_batcher_->Shutdown();
+  }
+
   // Shut down the apply pool.
   apply_pool_->Shutdown();
 
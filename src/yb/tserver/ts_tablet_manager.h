@@ -574,9 +574,16 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   boost::optional<yb::client::AsyncClientInitialiser> async_client_init_;
 
+  // Coalesces transaction status requests of all transaction participants on this server.
+  std::unique_ptr<tablet::TransactionStatusBatcher> transaction_status_batcher_;
+
+  // Coalesces non-transactional index writes of all tablets on this server.
+  std::unique_ptr<tablet::IndexWriteBatcher> index_write_batcher_;
+
   TabletPeers shutting_down_peers_;
 
   std::shared_ptr<GarbageCollector> block_based_table_gc_;
+  std::shared_ptr<GarbageCollector> metadata_block_cache_gc_;
   std::shared_ptr<GarbageCollector> log_cache_gc_;
 
   std::shared_ptr<MemTracker> block_based_table_mem_tracker_;
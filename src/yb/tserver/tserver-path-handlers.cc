@@ -42,6 +42,7 @@
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/quorum_util.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
@@ -56,6 +57,7 @@
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/url-coding.h"
 #include "yb/util/version_info.h"
 #include "yb/util/version_info.pb.h"
@@ -369,6 +371,10 @@ Status TabletServerPathHandlers::Register(Webserver* server) {
       "/maintenance-manager", "",
       std::bind(&TabletServerPathHandlers::HandleMaintenanceManagerPage, this, _1, _2),
       true /* styled */, false /* is_on_nav_bar */);
+  server->RegisterPathHandler(
+      "/compactions", "",
+      std::bind(&TabletServerPathHandlers::HandleCompactionsPage, this, _1, _2),
+      true /* styled */, false /* is_on_nav_bar */);
   server->RegisterPathHandler(
       "/api/v1/health-check", "TServer Health Check",
       std::bind(&TabletServerPathHandlers::HandleHealthCheck, this, _1, _2),
@@ -693,6 +699,8 @@ void TabletServerPathHandlers::HandleDashboardsPage(const Webserver::WebRequest&
   *output << GetDashboardLine("maintenance-manager", "Maintenance Manager",
                               "List of operations that are currently running and those "
                               "that are registered.");
+  *output << GetDashboardLine("compactions", "Compactions",
+                              "List of compactions and flushes that are running or queued.");
 }
 
 string TabletServerPathHandlers::GetDashboardLine(const std::string& link,
@@ -763,6 +771,39 @@ void TabletServerPathHandlers::HandleMaintenanceManagerPage(const Webserver::Web
   *output << "</table>\n";
 }
 
+void TabletServerPathHandlers::HandleCompactionsPage(const Webserver::WebRequest& req,
+                                                     Webserver::WebResponse* resp) {
+  std::stringstream *output = &resp->output;
+  auto* thread_pool = docdb::GetGlobalPriorityThreadPool();
+  if (thread_pool == nullptr) {
+    *output << "Priority thread pool is not initialized yet";
+    return;
+  }
+  if (ContainsKey(req.parsed_args, "raw")) {
+    *output << EscapeForHtmlToString(thread_pool->StateToString());
+    return;
+  }
+
+  auto task_infos = thread_pool->TaskInfos();
+  *output << "<h1>Compactions and flushes</h1>\n";
+  for (auto running : {true, false}) {
+    *output << (running ? "<h3>Running tasks</h3>\n" : "<h3>Queued and paused tasks</h3>\n");
+    *output << "<table class='table table-striped'>\n";
+    *output << "  <tr><th>Serial no</th><th>Priority</th><th>State</th><th>Task</th>"
+            << "<th>Progress</th></tr>\n";
+    for (const auto& info : task_infos) {
+      if ((info.state == PriorityThreadPoolTaskState::kRunning) != running) {
+        continue;
+      }
+      *output << Substitute(
+          "  <tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td><td>$4</td></tr>\n",
+          info.serial_no, info.priority, EscapeForHtmlToString(yb::ToString(info.state)),
+          EscapeForHtmlToString(info.description), EscapeForHtmlToString(info.progress));
+    }
+    *output << "</table>\n";
+  }
+}
+
 void TabletServerPathHandlers::HandleHealthCheck(const Webserver::WebRequest& req,
                                                  Webserver::WebResponse* resp) {
   std::stringstream *output = &resp->output;
@@ -51,6 +51,10 @@ class EncryptedRandomAccessFile : public RandomAccessFileWrapper {
     return VERIFY_RESULT(RandomAccessFileWrapper::Size()) - header_size_;
   }
 
+  void Readahead(uint64_t offset, size_t length) override {
+    RandomAccessFileWrapper::Readahead(offset + header_size_, length);
+  }
+
   virtual bool IsEncrypted() const override {
     return true;
   }
@@ -176,6 +176,11 @@ class RandomAccessFile : public FileWithUniqueId {
 
   virtual void Hint(AccessPattern pattern) {}
 
+  // Asks the platform to start loading the range from offset to offset+length of this file in
+  // background, so subsequent reads of this range don't block on I/O.
+  // If the platform does not support it, then this is a noop.
+  virtual void Readahead(uint64_t offset, size_t length) {}
+
   // Remove any kind of caching of data from the offset to offset+length
   // of this file. If the length is 0, then it refers to the end of file.
   // If the system is not caching the file contents, then this is a noop.
@@ -238,6 +243,10 @@ class RandomAccessFileWrapper : public RandomAccessFile {
 
   void Hint(AccessPattern pattern) override { return target_->Hint(pattern); }
 
+  void Readahead(uint64_t offset, size_t length) override {
+    return target_->Readahead(offset, length);
+  }
+
   Status InvalidateCache(size_t offset, size_t length) override {
     return target_->InvalidateCache(offset, length);
   }
@@ -252,6 +252,14 @@ void PosixRandomAccessFile::Hint(AccessPattern pattern) {
   }
 }
 
+void PosixRandomAccessFile::Readahead(uint64_t offset, size_t length) {
+  if (!use_os_buffer_) {
+    return;
+  }
+  // Kernel only schedules reading of the pages, so it does not block on I/O.
+  Fadvise(fd_, offset, length, POSIX_FADV_WILLNEED);
+}
+
 Status PosixRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
 #ifndef __linux__
   return Status::OK();
@@ -62,8 +62,12 @@ class PosixRandomAccessFile : public RandomAccessFile {
   virtual size_t GetUniqueId(char* id) const override;
 #endif
   virtual void Hint(AccessPattern pattern) override;
+  virtual void Readahead(uint64_t offset, size_t length) override;
   virtual CHECKED_STATUS InvalidateCache(size_t offset, size_t length) override;
 
+ protected:
+  int fd() const { return fd_; }
+
  private:
   std::string filename_;
   int fd_;
@@ -290,4 +290,44 @@ TEST(PriorityThreadPoolTest, ChangePriority) {
   ASSERT_EQ(running, std::vector<int>({2, 5, 6}));
 }
 
+TEST(PriorityThreadPoolTest, TaskInfos) {
+  const int kMaxRunningTasks = 2;
+  PriorityThreadPool thread_pool(kMaxRunningTasks);
+  Share share;
+  std::vector<int> running;
+
+  auto se = ScopeExit([&share, &thread_pool] {
+    thread_pool.StartShutdown();
+    share.StopAll();
+    thread_pool.CompleteShutdown();
+  });
+
+  SubmitTask(1, &share, &thread_pool);
+  SubmitTask(2, &share, &thread_pool);
+  share.FillRunningTaskPriorities(&running);
+  ASSERT_EQ(running, std::vector<int>({1, 2}));
+  auto task3 = SubmitTask(3, &share, &thread_pool);
+  SubmitTask(0, &share, &thread_pool);
+
+  share.FillRunningTaskPriorities(&running);
+  ASSERT_EQ(running, std::vector<int>({2, 3}));
+
+  auto infos = thread_pool.TaskInfos();
+  LOG(INFO) << "Task infos: " << thread_pool.StateToString();
+  ASSERT_EQ(infos.size(), 4U);
+  std::vector<int> priorities;
+  std::vector<PriorityThreadPoolTaskState> states;
+  for (const auto& info : infos) {
+    priorities.push_back(info.priority);
+    states.push_back(info.state);
+  }
+  ASSERT_EQ(priorities, std::vector<int>({3, 2, 1, 0}));
+  ASSERT_EQ(states, std::vector<PriorityThreadPoolTaskState>({
+      PriorityThreadPoolTaskState::kRunning, PriorityThreadPoolTaskState::kRunning,
+      PriorityThreadPoolTaskState::kPaused, PriorityThreadPoolTaskState::kNotStarted}));
+  ASSERT_EQ(infos[0].serial_no, task3);
+  ASSERT_EQ(infos[0].description, "{ index: 3 }");
+  ASSERT_EQ(infos[0].progress, "");
+}
+
 } // namespace yb
@@ -49,8 +49,6 @@ static constexpr int kEmptyQueuePriority = -1;
 
 YB_STRONGLY_TYPED_BOOL(PickTask);
 
-YB_DEFINE_ENUM(PriorityThreadPoolTaskState, (kPaused)(kNotStarted)(kRunning));
-
 class PriorityThreadPoolInternalTask {
  public:
   PriorityThreadPoolInternalTask(int priority, TaskPtr task, PriorityThreadPoolWorker* worker)
@@ -107,6 +105,12 @@ class PriorityThreadPoolInternalTask {
                   TaskToString(), worker_, state(), priority(), serial_no_);
   }
 
+  PriorityThreadPoolTaskInfo Info() const {
+    return PriorityThreadPoolTaskInfo {
+      serial_no_, priority(), state(), TaskToString(), task_->ProgressToString()
+    };
+  }
+
  private:
   const std::string& TaskToString() const {
     if (!task_to_string_ready_.load(std::memory_order_acquire)) {
@@ -504,6 +508,16 @@ class PriorityThreadPool::Impl : public PriorityThreadPoolWorkerContext {
     return DoStateToString();
   }
 
+  std::vector<PriorityThreadPoolTaskInfo> TaskInfos() {
+    std::vector<PriorityThreadPoolTaskInfo> result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.reserve(tasks_.size());
+    for (const auto& task : tasks_) {
+      result.push_back(task.Info());
+    }
+    return result;
+  }
+
  private:
   std::string DoStateToString() REQUIRES(mutex_) {
     return Format(
@@ -717,6 +731,10 @@ std::string PriorityThreadPool::StateToString() {
   return impl_->StateToString();
 }
 
+std::vector<PriorityThreadPoolTaskInfo> PriorityThreadPool::TaskInfos() {
+  return impl_->TaskInfos();
+}
+
 bool PriorityThreadPool::ChangeTaskPriority(size_t serial_no, int priority) {
   return impl_->ChangeTaskPriority(serial_no, priority);
 }
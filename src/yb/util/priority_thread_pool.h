@@ -15,6 +15,7 @@
 #define YB_UTIL_PRIORITY_THREAD_POOL_H
 
 #include <memory>
+#include <vector>
 
 #include "yb/util/locks.h"
 #include "yb/util/status.h"
@@ -22,6 +23,8 @@
 
 namespace yb {
 
+YB_DEFINE_ENUM(PriorityThreadPoolTaskState, (kPaused)(kNotStarted)(kRunning));
+
 // PriorityThreadPoolSuspender is provided to task ran by thread pool, task could use it to check
 // whether is should be preempted in favor of another task with higher priority.
 class PriorityThreadPoolSuspender {
@@ -46,6 +49,12 @@ class PriorityThreadPoolTask {
 
   virtual std::string ToString() const = 0;
 
+  // Returns human readable progress of the task, empty when task does not report progress.
+  // Could be invoked concurrently with Run, while task is owned by the pool.
+  virtual std::string ProgressToString() const {
+    return std::string();
+  }
+
   size_t SerialNo() const {
     return serial_no_;
   }
@@ -54,6 +63,15 @@ class PriorityThreadPoolTask {
   const size_t serial_no_;
 };
 
+// Snapshot of the task state, used for monitoring.
+struct PriorityThreadPoolTaskInfo {
+  size_t serial_no;
+  int priority;
+  PriorityThreadPoolTaskState state;
+  std::string description;
+  std::string progress;
+};
+
 // Tasks submitted to this pool have assigned priority and are picked from queue using it.
 class PriorityThreadPool {
  public:
@@ -99,6 +117,10 @@ class PriorityThreadPool {
   // Dumps state to string, useful for debugging.
   std::string StateToString();
 
+  // Returns info about all tasks that are running, paused or waiting in the queue, ordered by
+  // priority.
+  std::vector<PriorityThreadPoolTaskInfo> TaskInfos();
+
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
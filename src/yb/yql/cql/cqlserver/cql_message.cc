@@ -945,6 +945,9 @@ void CQLResponse::Serialize(const CompressionScheme compression_scheme, faststri
   if (compress) {
     faststring body;
     SerializeBody(&body);
+    if (const auto payload = Payload()) {
+      body.append(*payload);
+    }
     switch (compression_scheme) {
       case CQLMessage::CompressionScheme::kLz4: {
         SerializeInt(static_cast<int32_t>(body.size()), mesg);
@@ -975,11 +978,23 @@ void CQLResponse::Serialize(const CompressionScheme compression_scheme, faststri
     }
   } else {
     SerializeBody(mesg);
+    if (const auto payload = Payload()) {
+      mesg->append(*payload);
+    }
   }
   SERIALIZE_INT(
       mesg->data(), start_pos + kHeaderPosLength, mesg->size() - start_pos - kMessageHeaderLength);
 }
 
+void CQLResponse::SerializeWithoutPayload(size_t payload_size, faststring* mesg) const {
+  const size_t start_pos = mesg->size(); // save the start position
+  SerializeHeader(false /* compress */, mesg);
+  SerializeBody(mesg);
+  SERIALIZE_INT(
+      mesg->data(), start_pos + kHeaderPosLength,
+      mesg->size() + payload_size - start_pos - kMessageHeaderLength);
+}
+
 void CQLResponse::SerializeHeader(const bool compress, faststring* mesg) const {
   uint8_t buffer[kMessageHeaderLength];
   SERIALIZE_BYTE(buffer, kHeaderPosVersion, version());
@@ -1533,7 +1548,10 @@ void RowsResultResponse::SerializeResultBody(faststring* mesg) const {
   SerializeRowsMetadata(
       RowsMetadata(result_->table_name(), result_->column_schemas(),
                    result_->paging_state(), skip_metadata_), mesg);
-  mesg->append(result_->rows_data());
+}
+
+std::shared_ptr<const std::string> RowsResultResponse::Payload() const {
+  return std::shared_ptr<const std::string>(result_, &result_->rows_data());
 }
 
 //----------------------------------------------------------------------------------------
@@ -481,6 +481,15 @@ class CQLResponse : public CQLMessage {
   virtual ~CQLResponse();
   virtual void Serialize(CompressionScheme compression_scheme, faststring* mesg) const;
 
+  // Serialize the uncompressed response except for its payload of payload_size bytes, which is
+  // sent after the message without being copied into it. The message length in the header
+  // accounts for the payload.
+  void SerializeWithoutPayload(size_t payload_size, faststring* mesg) const;
+
+  // Already encoded data that ends the response body, or null if there is no such data. Shares
+  // ownership of the data with the response, so it could outlive the response until it is sent.
+  virtual std::shared_ptr<const std::string> Payload() const { return nullptr; }
+
   Events registered_events() const { return registered_events_; }
   void set_registered_events(Events events) { registered_events_ = events; }
 
@@ -755,6 +764,9 @@ class RowsResultResponse : public ResultResponse {
 
   virtual ~RowsResultResponse() override;
 
+  // Rows data is already in the CQL wire format, so it is returned as the payload.
+  virtual std::shared_ptr<const std::string> Payload() const override;
+
  protected:
   virtual void SerializeResultBody(faststring* mesg) const override;
 
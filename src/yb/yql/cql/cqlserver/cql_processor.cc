@@ -23,6 +23,8 @@
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_context.h"
 
+#include "yb/util/flag_tags.h"
+
 #include "yb/yql/cql/cqlserver/cql_service.h"
 
 METRIC_DEFINE_histogram_with_percentiles(
@@ -79,6 +81,19 @@ METRIC_DEFINE_counter(server, cql_parsers_created,
                       yb::MetricUnit::kUnits,
                       "Number of created CQL Parsers.");
 
+METRIC_DEFINE_histogram_with_percentiles(
+    server, cql_request_memory_usage,
+    "Memory used by a CQL request", yb::MetricUnit::kBytes,
+    "Memory used by a CQL request: its serialized request and response and the parse trees of "
+    "its not prepared statements.", 60000000LU, 2);
+
+DEFINE_int64(cql_separate_response_payload_min_size, 4096,
+             "Minimal size of the rows data in an uncompressed CQL response to send it as a "
+             "separate buffer after the response message, instead of copying it into the "
+             "message. Negative value disables sending the rows data separately.");
+TAG_FLAG(cql_separate_response_payload_min_size, runtime);
+TAG_FLAG(cql_separate_response_payload_min_size, advanced);
+
 DECLARE_bool(use_cassandra_authentication);
 DECLARE_bool(ycql_cache_login_info);
 
@@ -140,6 +155,7 @@ CQLMetrics::CQLMetrics(const scoped_refptr<yb::MetricEntity>& metric_entity)
   cql_processors_created_ = METRIC_cql_processors_created.Instantiate(metric_entity);
   parsers_alive_ = METRIC_cql_parsers_alive.Instantiate(metric_entity, 0);
   parsers_created_ = METRIC_cql_parsers_created.Instantiate(metric_entity);
+  request_memory_usage_ = METRIC_cql_request_memory_usage.Instantiate(metric_entity);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -156,6 +172,7 @@ CQLProcessor::CQLProcessor(CQLServiceImpl* service_impl, const CQLProcessorListP
       consumption_(service_impl->processors_mem_tracker(), sizeof(*this)) {
   IncrementCounter(cql_metrics_->cql_processors_created_);
   IncrementGauge(cql_metrics_->cql_processors_alive_);
+  run_async_mem_tracker_ = service_impl->requests_mem_tracker();
 }
 
 CQLProcessor::~CQLProcessor() {
@@ -205,6 +222,7 @@ void CQLProcessor::Release() {
   request_ = nullptr;
   stmts_.clear();
   parse_trees_.clear();
+  reset_run_async_memory_usage();
   SetCurrentSession(nullptr);
   audit_logger_.SetConnection(nullptr);
   service_impl_->ReturnProcessor(pos_);
@@ -225,9 +243,24 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   MonoTime response_begin = MonoTime::Now();
   const auto& context = static_cast<const CQLConnectionContext&>(call_->connection()->context());
   const auto compression_scheme = context.compression_scheme();
+  const size_t request_memory_usage = RequestMemoryUsage();
   faststring msg;
-  response.Serialize(compression_scheme, &msg);
-  call_->RespondSuccess(RefCntBuffer(msg), cql_metrics_->rpc_method_metrics_);
+  const auto payload_min_size = FLAGS_cql_separate_response_payload_min_size;
+  auto payload = response.Payload();
+  if (compression_scheme == CQLMessage::CompressionScheme::kNone && payload_min_size >= 0 &&
+      payload && payload->size() >= static_cast<size_t>(payload_min_size)) {
+    // Rows data is already encoded by the tablet server, so the call takes shared ownership of it
+    // and sends it as is after the message, rather than copying it into a response buffer.
+    const auto payload_size = payload->size();
+    response.SerializeWithoutPayload(payload_size, &msg);
+    call_->RespondSuccess(RefCntBuffer(msg), std::move(payload), cql_metrics_->rpc_method_metrics_);
+    cql_metrics_->request_memory_usage_->Increment(
+        request_memory_usage + msg.size() + payload_size);
+  } else {
+    response.Serialize(compression_scheme, &msg);
+    call_->RespondSuccess(RefCntBuffer(msg), cql_metrics_->rpc_method_metrics_);
+    cql_metrics_->request_memory_usage_->Increment(request_memory_usage + msg.size());
+  }
 
   MonoTime response_done = MonoTime::Now();
   cql_metrics_->time_to_process_request_->Increment(
@@ -242,6 +275,14 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   Release();
 }
 
+size_t CQLProcessor::RequestMemoryUsage() const {
+  size_t result = call_->serialized_request().size() + run_async_memory_usage();
+  for (const auto& parse_tree : parse_trees_) {
+    result += parse_tree->memory_usage();
+  }
+  return result;
+}
+
 bool CQLProcessor::CheckAuthentication(const CQLRequest& req) const {
   return call_->ql_session()->is_user_authenticated() ||
       // CQL requests which do not need authorization.
@@ -422,7 +463,8 @@ unique_ptr<CQLResponse> CQLProcessor::ProcessRequest(const BatchRequest& req) {
     } else {
       VLOG(1) << "BATCH QUERY " << query.query;
       ParseTree::UniPtr parse_tree;
-      s = Prepare(query.query, &parse_tree);
+      s = Prepare(query.query, &parse_tree, false /* reparsed */,
+                  service_impl_->requests_mem_tracker());
       if (PREDICT_FALSE(!s.ok())) {
         result = ProcessError(s);
         break;
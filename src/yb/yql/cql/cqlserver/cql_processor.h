@@ -53,6 +53,8 @@ class CQLMetrics : public ql::QLMetrics {
 
   scoped_refptr<AtomicGauge<int64_t>> parsers_alive_;
   scoped_refptr<Counter> parsers_created_;
+
+  scoped_refptr<yb::Histogram> request_memory_usage_;
 };
 
 
@@ -112,6 +114,9 @@ class CQLProcessor : public ql::QLProcessor {
   void PrepareAndSendResponse(const std::unique_ptr<CQLResponse>& response);
   void SendResponse(const CQLResponse& response);
 
+  // Memory used by the current request, excluding its response.
+  size_t RequestMemoryUsage() const;
+
   // Pointer to the containing CQL service implementation.
   CQLServiceImpl* const service_impl_;
 
@@ -226,6 +226,16 @@ void CQLInboundCall::RespondSuccess(const RefCntBuffer& buffer,
   QueueResponse(/* is_success */ true);
 }
 
+void CQLInboundCall::RespondSuccess(const RefCntBuffer& buffer,
+                                    std::shared_ptr<const std::string> payload,
+                                    const yb::rpc::RpcMethodMetrics& metrics) {
+  RecordHandlingCompleted(metrics.handler_latency);
+  response_msg_buf_ = buffer;
+  response_payload_ = std::move(payload);
+
+  QueueResponse(/* is_success */ true);
+}
+
 void CQLInboundCall::GetCallDetails(rpc::RpcCallInProgressPB *call_in_progress_pb) const {
   std::shared_ptr<const CQLRequest> request =
 #ifdef THREAD_SANITIZER
@@ -129,6 +129,9 @@ class CQLInboundCall : public rpc::InboundCall {
   const std::string& method_name() const override;
   void RespondFailure(rpc::ErrorStatusPB::RpcErrorCodePB error_code, const Status& status) override;
   void RespondSuccess(const RefCntBuffer& buffer, const yb::rpc::RpcMethodMetrics& metrics);
+  // Responds with the message followed by the payload, which is sent from its own memory.
+  void RespondSuccess(const RefCntBuffer& buffer, std::shared_ptr<const std::string> payload,
+                      const yb::rpc::RpcMethodMetrics& metrics);
   void GetCallDetails(rpc::RpcCallInProgressPB *call_in_progress_pb) const;
   void SetRequest(std::shared_ptr<const CQLRequest> request, CQLServiceImpl* service_impl) {
     service_impl_ = service_impl;
@@ -143,11 +146,18 @@ class CQLInboundCall : public rpc::InboundCall {
 
   size_t DynamicMemoryUsage() const override {
     // TODO - who is tracking request_ memory usage ?
-    return DynamicMemoryUsageOf(response_msg_buf_);
+    return DynamicMemoryUsageOf(response_msg_buf_) +
+           (response_payload_ ? response_payload_->capacity() : 0);
+  }
+
+  Slice SerializedTail() const override {
+    return response_payload_ ? Slice(*response_payload_) : Slice();
   }
 
  private:
   RefCntBuffer response_msg_buf_;
+  // Optional part of the response that is sent right after response_msg_buf_.
+  std::shared_ptr<const std::string> response_payload_;
   const ql::QLSession::SharedPtr ql_session_;
   uint16_t stream_id_;
   std::shared_ptr<const CQLRequest> request_;
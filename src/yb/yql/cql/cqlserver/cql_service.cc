@@ -37,7 +37,7 @@
 
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/crypt.h"
-
+#include "yb/util/flag_tags.h"
 #include "yb/util/mem_tracker.h"
 
 using namespace std::placeholders;
@@ -58,6 +58,12 @@ DEFINE_int64(cql_processors_limit, -4000,
              "Limit number of CQL processors. Positive means absolute limit. "
              "Negative means number of processors per 1GB of root mem tracker memory limit. "
              "0 - unlimited.");
+DEFINE_int64(cql_requests_memory_limit, 0,
+             "Limit of memory used by in-flight CQL requests, i.e. their parse trees of not "
+             "prepared statements. New requests are rejected as overloaded while the limit is "
+             "exceeded. 0 or negative means unlimited.");
+TAG_FLAG(cql_requests_memory_limit, runtime);
+TAG_FLAG(cql_requests_memory_limit, advanced);
 
 namespace yb {
 namespace cqlserver {
@@ -133,6 +139,9 @@ CQLServiceImpl::CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts)
   LOG(INFO) << "CQL processors limit: " << CQLProcessorsLimit();
 
   processors_mem_tracker_ = MemTracker::CreateTracker("CQL processors", server->mem_tracker());
+  // The limit is checked against cql_requests_memory_limit in GetProcessor(), so it could be
+  // changed at runtime.
+  requests_mem_tracker_ = MemTracker::CreateTracker("CQL requests", server->mem_tracker());
 
   auth_prepared_stmt_ = std::make_shared<ql::Statement>(
       "",
@@ -210,6 +219,13 @@ void CQLServiceImpl::Handle(yb::rpc::InboundCallPtr inbound_call) {
 }
 
 Result<CQLProcessor*> CQLServiceImpl::GetProcessor() {
+  const auto requests_memory_limit = FLAGS_cql_requests_memory_limit;
+  if (requests_memory_limit > 0 && requests_mem_tracker_->consumption() > requests_memory_limit) {
+    return STATUS_FORMAT(ServiceUnavailable,
+                         "CQL requests memory limit exceeded: $0 of $1",
+                         requests_mem_tracker_->consumption(), requests_memory_limit);
+  }
+
   CQLProcessorListPos pos;
   {
     // Retrieve the next available processor. If none is available, allocate a new slot in the list.
@@ -92,6 +92,11 @@ class CQLServiceImpl : public CQLServerServiceIf,
     return processors_mem_tracker_;
   }
 
+  // Return the memory tracker for the parse trees of in-flight requests.
+  const MemTrackerPtr& requests_mem_tracker() const {
+    return requests_mem_tracker_;
+  }
+
   // Return the YBClient to communicate with either master or tserver.
   client::YBClient* client() const;
 
@@ -164,6 +169,9 @@ class CQLServiceImpl : public CQLServerServiceIf,
 
   MemTrackerPtr processors_mem_tracker_;
 
+  // Tracker to measure and limit memory usage of in-flight requests.
+  MemTrackerPtr requests_mem_tracker_;
+
   // Password and hash cache. Stores each password-hash pair as a compound key;
   // see implementation for rationale.
   boost::compute::detail::lru_cache<std::string, bool> password_cache_
@@ -29,6 +29,7 @@
 #include "yb/util/test_util.h"
 
 DECLARE_bool(cql_server_always_send_events);
+DECLARE_int64(cql_separate_response_payload_min_size);
 DECLARE_bool(use_cassandra_authentication);
 
 namespace yb {
@@ -47,6 +48,8 @@ class TestCQLService : public YBTableTestBase {
 
   void TestSchemaChangeEvent();
 
+  void TestReadSystemTable();
+
  protected:
   void SendRequestAndExpectTimeout(const string& cmd);
 
@@ -425,7 +428,7 @@ TEST_F(TestCQLServiceWithGFlag, TestSchemaChangeEventWithGFlag) {
   TestSchemaChangeEvent();
 }
 
-TEST_F(TestCQLService, TestReadSystemTable) {
+void TestCQLService::TestReadSystemTable() {
   // Send STARTUP request using version V4.
   SendRequestAndExpectResponse(
       BINARY_STRING("\x04\x00\x00\x00\x01" "\x00\x00\x00\x16"
@@ -453,6 +456,23 @@ TEST_F(TestCQLService, TestReadSystemTable) {
                     "\x00\x00\x00\x05" "local"));
 }
 
+TEST_F(TestCQLService, TestReadSystemTable) {
+  TestReadSystemTable();
+}
+
+class TestCQLServiceWithSeparatePayload : public TestCQLService {
+ public:
+  void SetUp() override {
+    FLAGS_cql_separate_response_payload_min_size = 0;
+    TestCQLService::SetUp();
+  }
+};
+
+// Rows data sent as a separate buffer should produce exactly the same response.
+TEST_F(TestCQLServiceWithSeparatePayload, TestReadSystemTable) {
+  TestReadSystemTable();
+}
+
 class TestCQLServiceWithCassAuth : public TestCQLService {
  public:
   void SetUp() override {
@@ -33,11 +33,18 @@
 
 #include "yb/rpc/thread_pool.h"
 #include "yb/util/decimal.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/random_util.h"
 #include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
 
+DEFINE_bool(ycql_use_read_request_template, true,
+            "Build the select list part of the read request once per prepared statement and "
+            "reuse it on the following executions.");
+TAG_FLAG(ycql_use_read_request_template, advanced);
+TAG_FLAG(ycql_use_read_request_template, runtime);
+
 namespace yb {
 namespace ql {
 
@@ -85,8 +92,7 @@ Executor::~Executor() {
 
 void Executor::ExecuteAsync(const ParseTree& parse_tree, const StatementParameters& params,
                             StatementExecutedCallback cb) {
-  DCHECK(cb_.is_null()) << "Another execution is in progress.";
-  cb_ = std::move(cb);
+  StartRequest(std::move(cb));
   session_->SetForceConsistentRead(client::ForceConsistentRead::kFalse);
   auto read_time = params.read_time();
   if (read_time) {
@@ -99,8 +105,7 @@ void Executor::ExecuteAsync(const ParseTree& parse_tree, const StatementParamete
 }
 
 void Executor::ExecuteAsync(const StatementBatch& batch, StatementExecutedCallback cb) {
-  DCHECK(cb_.is_null()) << "Another execution is in progress.";
-  cb_ = std::move(cb);
+  StartRequest(std::move(cb));
   session_->SetForceConsistentRead(client::ForceConsistentRead::kFalse);
   session_->SetReadPoint(client::Restart::kFalse);
 
@@ -131,16 +136,16 @@ void Executor::ExecuteAsync(const StatementBatch& batch, StatementExecutedCallba
                             "supported yet"));
           }
 
-          if (!returns_status_batch_opt_) {
-            returns_status_batch_opt_ = stmt->returns_status();
-          } else if (stmt->returns_status() != *returns_status_batch_opt_) {
+          if (!request_->returns_status_batch_opt) {
+            request_->returns_status_batch_opt = stmt->returns_status();
+          } else if (stmt->returns_status() != *request_->returns_status_batch_opt) {
             return StatementExecuted(
                 ErrorStatus(ErrorCode::CQL_STATEMENT_INVALID,
                             "batch execution mixing statements with and without RETURNS STATUS "
                             "AS ROW is not supported"));
           }
 
-          if (*returns_status_batch_opt_) {
+          if (*request_->returns_status_batch_opt) {
             if (dml_batch_table == nullptr) {
               dml_batch_table = stmt->table();
             } else if (dml_batch_table->id() != stmt->table()->id()) {
@@ -178,8 +183,8 @@ void Executor::ExecuteAsync(const StatementBatch& batch, StatementExecutedCallba
 
 Status Executor::Execute(const ParseTree& parse_tree, const StatementParameters& params) {
   // Prepare execution context and execute the parse tree's root node.
-  exec_contexts_.emplace_back(parse_tree, params);
-  exec_context_ = &exec_contexts_.back();
+  request_->exec_contexts.emplace_back(parse_tree, params);
+  exec_context_ = &request_->exec_contexts.back();
   auto root_node = parse_tree.root().get();
   RETURN_NOT_OK(PreExecTreeNode(root_node));
   RETURN_NOT_OK(audit_logger_.LogStatement(root_node, exec_context_->stmt(),
@@ -336,7 +341,7 @@ Status Executor::ExecPTNode(const PTCreateRole *tnode) {
       return Status::OK();
     }
 
-    // TODO (Bristy) : Set result_ properly.
+    // TODO (Bristy) : Set result properly.
     return exec_context_->Error(tnode, s, error_code);
   }
 
@@ -371,7 +376,7 @@ Status Executor::ExecPTNode(const PTGrantRevokeRole* tnode) {
     } else if (s.IsNotFound()) {
       error_code = ErrorCode::ROLE_NOT_FOUND;
     }
-    // TODO (Bristy) : Set result_ properly.
+    // TODO (Bristy) : Set result properly.
     return exec_context_->Error(tnode, s, error_code);
   }
   return Status::OK();
@@ -420,7 +425,8 @@ Status Executor::ExecPTNode(const PTCreateType *tnode) {
     return exec_context_->Error(tnode->type_name(), s, error_code);
   }
 
-  result_ = std::make_shared<SchemaChangeResult>("CREATED", "TYPE", keyspace_name, type_name);
+  request_->result = std::make_shared<SchemaChangeResult>(
+      "CREATED", "TYPE", keyspace_name, type_name);
   return Status::OK();
 }
 
@@ -564,10 +570,10 @@ Status Executor::ExecPTNode(const PTCreateTable *tnode) {
     // Clean-up table cache AFTER op (the cache is used by other processor threads).
     ql_env_->RemoveCachedTableDesc(indexed_table_name);
 
-    result_ = std::make_shared<SchemaChangeResult>(
+    request_->result = std::make_shared<SchemaChangeResult>(
         "UPDATED", "TABLE", indexed_table_name.namespace_name(), indexed_table_name.table_name());
   } else {
-    result_ = std::make_shared<SchemaChangeResult>(
+    request_->result = std::make_shared<SchemaChangeResult>(
         "CREATED", "TABLE", table_name.namespace_name(), table_name.table_name());
   }
   return Status::OK();
@@ -630,7 +636,7 @@ Status Executor::ExecPTNode(const PTAlterTable *tnode) {
     return exec_context_->Error(tnode, s, ErrorCode::EXEC_ERROR);
   }
 
-  result_ = std::make_shared<SchemaChangeResult>(
+  request_->result = std::make_shared<SchemaChangeResult>(
       "UPDATED", "TABLE", table_name.namespace_name(), table_name.table_name());
 
   // Clean-up table cache AFTER op (the cache is used by other processor threads).
@@ -653,7 +659,7 @@ Status Executor::ExecPTNode(const PTDropStmt *tnode) {
 
       s = ql_env_->DeleteTable(table_name);
       error_not_found = ErrorCode::OBJECT_NOT_FOUND;
-      result_ = std::make_shared<SchemaChangeResult>(
+      request_->result = std::make_shared<SchemaChangeResult>(
           "DROPPED", "TABLE", table_name.namespace_name(), table_name.table_name());
 
       // Clean-up table cache AFTER op (the cache is used by other processor threads).
@@ -670,7 +676,7 @@ Status Executor::ExecPTNode(const PTDropStmt *tnode) {
       YBTableName indexed_table_name;
       s = ql_env_->DeleteIndexTable(table_name, &indexed_table_name);
       error_not_found = ErrorCode::OBJECT_NOT_FOUND;
-      result_ = std::make_shared<SchemaChangeResult>(
+      request_->result = std::make_shared<SchemaChangeResult>(
           "UPDATED", "TABLE", indexed_table_name.namespace_name(), indexed_table_name.table_name());
 
       // Clean-up table cache AFTER op (the cache is used by other processor threads).
@@ -684,7 +690,7 @@ Status Executor::ExecPTNode(const PTDropStmt *tnode) {
       const string keyspace_name(tnode->name()->last_name().c_str());
       s = ql_env_->DeleteKeyspace(keyspace_name);
       error_not_found = ErrorCode::KEYSPACE_NOT_FOUND;
-      result_ = std::make_shared<SchemaChangeResult>("DROPPED", "KEYSPACE", keyspace_name);
+      request_->result = std::make_shared<SchemaChangeResult>("DROPPED", "KEYSPACE", keyspace_name);
       break;
     }
 
@@ -694,7 +700,8 @@ Status Executor::ExecPTNode(const PTDropStmt *tnode) {
       const string namespace_name(tnode->name()->first_name().c_str());
       s = ql_env_->DeleteUDType(namespace_name, type_name);
       error_not_found = ErrorCode::TYPE_NOT_FOUND;
-      result_ = std::make_shared<SchemaChangeResult>("DROPPED", "TYPE", namespace_name, type_name);
+      request_->result = std::make_shared<SchemaChangeResult>(
+          "DROPPED", "TYPE", namespace_name, type_name);
       ql_env_->RemoveCachedUDType(namespace_name, type_name);
       break;
     }
@@ -704,7 +711,7 @@ Status Executor::ExecPTNode(const PTDropStmt *tnode) {
       const string role_name(tnode->name()->QLName());
       s = ql_env_->DeleteRole(role_name);
       error_not_found = ErrorCode::ROLE_NOT_FOUND;
-      // TODO (Bristy) : Set result_ properly.
+      // TODO (Bristy) : Set result properly.
       break;
     }
 
@@ -833,13 +840,27 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
     }
   }
 
-  // Create the read request.
+  // Create the read request. For a prepared statement the select list part of the request is
+  // built once and copied from the template on the following executions. Parse trees of
+  // unprepared statements are executed only once, so no template is built for them.
   YBqlReadOpPtr select_op(table->NewQLSelect());
   QLReadRequestPB *req = select_op->mutable_request();
-  // Where clause - Hash, range, and regular columns.
-
-  req->set_is_aggregate(tnode->is_aggregate());
+  const QLReadRequestPB* request_template = tnode->read_request_template();
+  if (request_template != nullptr) {
+    req->MergeFrom(*request_template);
+  } else {
+    RETURN_NOT_OK(SelectListToPB(tnode, req));
+    if (FLAGS_ycql_use_read_request_template && exec_context_->parse_tree().prepared() &&
+        tnode->HasStaticSelectList()) {
+      auto new_template = std::make_unique<QLReadRequestPB>(*req);
+      // Ids are unique per operation.
+      new_template->clear_request_id();
+      new_template->clear_query_id();
+      tnode->SetReadRequestTemplate(std::move(new_template));
+    }
+  }
 
+  // Where clause - Hash, range, and regular columns.
   Result<uint64_t> max_rows_estimate = WhereClauseToPB(req, tnode->key_where_ops(),
                                                        tnode->where_ops(),
                                                        tnode->subscripted_col_where_ops(),
@@ -857,50 +878,18 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
     faststring buffer;
     empty_row_block.Serialize(select_op->request().client(), &buffer);
     *select_op->mutable_rows_data() = buffer.ToString();
-    result_ = std::make_shared<RowsResult>(select_op.get());
+    request_->result = std::make_shared<RowsResult>(select_op.get());
     return Status::OK();
   }
 
-  req->set_is_forward_scan(tnode->is_forward_scan());
-
-  // Specify selected list by adding the expressions to selected_exprs in read request.
-  QLRSRowDescPB *rsrow_desc_pb = req->mutable_rsrow_desc();
-  for (const auto& expr : tnode->selected_exprs()) {
-    if (expr->opcode() == TreeNodeOpcode::kPTAllColumns) {
-      const Status s = PTExprToPB(static_cast<const PTAllColumns*>(expr.get()), req);
-      if (PREDICT_FALSE(!s.ok())) {
-        return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
-      }
-    } else {
-      const Status s = PTExprToPB(expr, req->add_selected_exprs());
-      if (PREDICT_FALSE(!s.ok())) {
-        return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
-      }
-
-      // Add the expression metadata (rsrow descriptor).
-      QLRSColDescPB *rscol_desc_pb = rsrow_desc_pb->add_rscol_descs();
-      rscol_desc_pb->set_name(expr->QLName());
-      expr->rscol_type_PB(rscol_desc_pb->mutable_ql_type());
-    }
-  }
-
-  // Setup the column values that need to be read.
-  Status s = ColumnRefsToPB(tnode, req->mutable_column_refs());
-  if (PREDICT_FALSE(!s.ok())) {
-    return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
-  }
-
   // Set the IF clause.
   if (tnode->if_clause() != nullptr) {
-    s = PTExprToPB(tnode->if_clause(), select_op->mutable_request()->mutable_if_expr());
+    const Status s = PTExprToPB(tnode->if_clause(), req->mutable_if_expr());
     if (PREDICT_FALSE(!s.ok())) {
       return exec_context_->Error(tnode->if_clause(), s, ErrorCode::INVALID_ARGUMENTS);
     }
   }
 
-  // Specify distinct columns or non.
-  req->set_distinct(tnode->distinct());
-
   // Default row count limit is the page size.
   // We should return paging state when page size limit is hit.
   // For system tables, we do not support page size so do nothing.
@@ -989,7 +978,7 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   if (tnode->child_select() && !tnode->child_select()->covers_fully()) {
     req->clear_return_paging_state();
     tnode_context->SetUncoveredSelectOp(select_op);
-    result_ = std::make_shared<RowsResult>(select_op.get());
+    request_->result = std::make_shared<RowsResult>(select_op.get());
     return Status::OK();
   }
 
@@ -997,6 +986,44 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   return AddOperation(select_op, tnode_context);
 }
 
+Status Executor::SelectListToPB(const PTSelectStmt *tnode, QLReadRequestPB *req) {
+  req->set_is_aggregate(tnode->is_aggregate());
+  req->set_is_forward_scan(tnode->is_forward_scan());
+
+  // Specify selected list by adding the expressions to selected_exprs in read request.
+  QLRSRowDescPB *rsrow_desc_pb = req->mutable_rsrow_desc();
+  for (const auto& expr : tnode->selected_exprs()) {
+    if (expr->opcode() == TreeNodeOpcode::kPTAllColumns) {
+      const Status s = PTExprToPB(static_cast<const PTAllColumns*>(expr.get()), req);
+      if (PREDICT_FALSE(!s.ok())) {
+        return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
+      }
+    } else {
+      const Status s = PTExprToPB(expr, req->add_selected_exprs());
+      if (PREDICT_FALSE(!s.ok())) {
+        return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
+      }
+
+      // Add the expression metadata (rsrow descriptor).
+      QLRSColDescPB *rscol_desc_pb = rsrow_desc_pb->add_rscol_descs();
+      rscol_desc_pb->set_name(expr->QLName());
+      expr->rscol_type_PB(rscol_desc_pb->mutable_ql_type());
+    }
+  }
+
+  // Setup the column values that need to be read.
+  const Status s = ColumnRefsToPB(tnode, req->mutable_column_refs());
+  if (PREDICT_FALSE(!s.ok())) {
+    return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+  }
+
+  // Specify distinct columns or non.
+  req->set_distinct(tnode->distinct());
+  return Status::OK();
+}
+
+//--------------------------------------------------------------------------------------------------
+
 Result<bool> Executor::FetchMoreRows(const PTSelectStmt* tnode,
                                      const YBqlReadOpPtr& op,
                                      TnodeContext* tnode_context,
@@ -1354,7 +1381,7 @@ Status Executor::ExecPTNode(const PTCreateKeyspace *tnode) {
     return exec_context_->Error(tnode, s, error_code);
   }
 
-  result_ = std::make_shared<SchemaChangeResult>("CREATED", "KEYSPACE", tnode->name());
+  request_->result = std::make_shared<SchemaChangeResult>("CREATED", "KEYSPACE", tnode->name());
   return Status::OK();
 }
 
@@ -1367,7 +1394,7 @@ Status Executor::ExecPTNode(const PTUseKeyspace *tnode) {
     return exec_context_->Error(tnode, s, error_code);
   }
 
-  result_ = std::make_shared<SetKeyspaceResult>(tnode->name());
+  request_->result = std::make_shared<SetKeyspaceResult>(tnode->name());
   return Status::OK();
 }
 
@@ -1383,7 +1410,7 @@ Status Executor::ExecPTNode(const PTAlterKeyspace *tnode) {
     return exec_context_->Error(tnode, s, error_code);
   }
 
-  result_ = std::make_shared<SchemaChangeResult>("UPDATED", "KEYSPACE", tnode->name());
+  request_->result = std::make_shared<SchemaChangeResult>("UPDATED", "KEYSPACE", tnode->name());
   return Status::OK();
 }
 
@@ -1466,7 +1493,7 @@ Status Executor::ExecPTNode(const PTExplainStmt *tnode) {
     }
   }
   row_block.Serialize(YQL_CLIENT_CQL, &buffer);
-  result_ = std::make_shared<RowsResult>(explainTable, explainColumns, buffer.ToString());
+  request_->result = std::make_shared<RowsResult>(explainTable, explainColumns, buffer.ToString());
   return Status::OK();
 }
 
@@ -1522,13 +1549,13 @@ void Executor::FlushAsync() {
   // FlushAsync() and CommitTransaction(). This is necessary so that only the last callback will
   // correctly detect that all async calls are done invoked before processing the async results
   // exclusively.
-  write_batch_.Clear();
+  request_->write_batch.Clear();
   std::vector<std::pair<YBSessionPtr, ExecContext*>> flush_sessions;
   std::vector<ExecContext*> commit_contexts;
   if (NeedsFlush(session_)) {
     flush_sessions.push_back({session_, nullptr});
   }
-  for (ExecContext& exec_context : exec_contexts_) {
+  for (ExecContext& exec_context : request_->exec_contexts) {
     if (exec_context.HasTransaction()) {
       auto transactional_session = exec_context.transactional_session();
       if (NeedsFlush(transactional_session)) {
@@ -1543,12 +1570,12 @@ void Executor::FlushAsync() {
   }
 
   // Commit transactions first before flushing operations in case some operations are blocked by
-  // prior operations in the uncommitted transactions. num_flushes_ is updated before FlushAsync()
+  // prior operations in the uncommitted transactions. num_flushes is updated before FlushAsync()
   // and CommitTransaction() are called to avoid race condition of recursive FlushAsync() called
   // from FlushAsyncDone() and CommitDone().
   DCHECK_EQ(num_async_calls_, 0);
   num_async_calls_ = flush_sessions.size() + commit_contexts.size();
-  num_flushes_ += flush_sessions.size();
+  request_->num_flushes += flush_sessions.size();
   async_status_ = Status::OK();
   for (auto* exec_context : commit_contexts) {
     exec_context->CommitTransaction([this, exec_context](const Status& s) {
@@ -1572,7 +1599,7 @@ void Executor::FlushAsync() {
     // If this is a batch returning status, append the rows in the user-given order before
     // returning result.
     if (IsReturnsStatusBatch()) {
-      for (ExecContext& exec_context : exec_contexts_) {
+      for (ExecContext& exec_context : request_->exec_contexts) {
         int64_t row_count = 0;
         RETURN_STMT_NOT_OK(ProcessTnodeContexts(
             &exec_context,
@@ -1625,7 +1652,7 @@ void Executor::FlushAsyncDone(Status s, ExecContext* exec_context) {
         async_status_ = s;
       }
     } else {
-      for (auto& exec_context : exec_contexts_) {
+      for (auto& exec_context : request_->exec_contexts) {
         if (!exec_context.HasTransaction()) {
           s = ProcessAsyncStatus(op_errors, &exec_context);
           if (!s.ok()) {
@@ -1686,7 +1713,8 @@ void Executor::ProcessAsyncResults(const bool rescheduled) {
   bool need_flush = false;
   bool has_restart = false;
   const MonoTime now = (ql_metrics_ != nullptr) ? MonoTime::Now() : MonoTime();
-  for (auto exec_itr = exec_contexts_.begin(); exec_itr != exec_contexts_.end(); ) {
+  auto& exec_contexts = request_->exec_contexts;
+  for (auto exec_itr = exec_contexts.begin(); exec_itr != exec_contexts.end(); ) {
 
     // Set current ExecContext.
     exec_context_ = &*exec_itr;
@@ -1697,7 +1725,7 @@ void Executor::ProcessAsyncResults(const bool rescheduled) {
       const TreeNode *root = exec_context_->parse_tree().root().get();
       // Clear partial rows accumulated from the SELECT statement.
       if (root->opcode() == TreeNodeOpcode::kPTSelectStmt) {
-        result_ = nullptr;
+        request_->result = nullptr;
       }
 
       // We should restart read, but read time was specified by caller.
@@ -1821,7 +1849,7 @@ Result<bool> Executor::ProcessTnodeResults(TnodeContext* tnode_context) {
     // Apply any op that has not been applied and executed.
     if (!op->response().has_status()) {
       DCHECK_EQ(op->type(), YBOperation::Type::QL_WRITE);
-      if (write_batch_.Add(std::static_pointer_cast<YBqlWriteOp>(op))) {
+      if (request_->write_batch.Add(std::static_pointer_cast<YBqlWriteOp>(op))) {
         YBSessionPtr session = GetSession(exec_context_);
         TRACE("Apply");
         RETURN_NOT_OK(session->Apply(op));
@@ -2159,7 +2187,7 @@ bool Executor::WriteBatch::Empty() const {
 //--------------------------------------------------------------------------------------------------
 
 Status Executor::AddOperation(const YBqlReadOpPtr& op, TnodeContext *tnode_context) {
-  DCHECK(write_batch_.Empty()) << "Concurrent read and write operations not supported yet";
+  DCHECK(request_->write_batch.Empty()) << "Concurrent read and write operations not supported yet";
 
   op->mutable_request()->set_request_id(exec_context_->params().request_id());
   tnode_context->AddOperation(op);
@@ -2180,7 +2208,7 @@ Status Executor::AddOperation(const YBqlWriteOpPtr& op, TnodeContext *tnode_cont
   // Check for inter-dependency in the current write batch before applying the write operation.
   // Apply it in the transactional session in exec_context for the current statement if there is
   // one. Otherwise, apply to the non-transactional session in the executor.
-  if (write_batch_.Add(op)) {
+  if (request_->write_batch.Add(op)) {
     YBSessionPtr session = GetSession(exec_context_);
     TRACE("Apply");
     RETURN_NOT_OK(session->Apply(op));
@@ -2319,18 +2347,18 @@ Status Executor::AppendRowsResult(RowsResult::SharedPtr&& rows_result) {
   if (!rows_result) {
     return Status::OK();
   }
-  if (!result_) {
-    result_ = std::move(rows_result);
+  if (!request_->result) {
+    request_->result = std::move(rows_result);
     return Status::OK();
   }
-  CHECK(result_->type() == ExecutedResult::Type::ROWS);
-  return std::static_pointer_cast<RowsResult>(result_)->Append(std::move(*rows_result));
+  CHECK(request_->result->type() == ExecutedResult::Type::ROWS);
+  return std::static_pointer_cast<RowsResult>(request_->result)->Append(std::move(*rows_result));
 }
 
 void Executor::StatementExecuted(const Status& s) {
   // Update metrics for all statements executed.
   if (s.ok() && ql_metrics_ != nullptr) {
-    for (auto& exec_context : exec_contexts_) {
+    for (auto& exec_context : request_->exec_contexts) {
       for (auto& tnode_context : exec_context.tnode_contexts()) {
         const TreeNode* tnode = tnode_context.tnode();
         if (tnode != nullptr) {
@@ -2359,25 +2387,26 @@ void Executor::StatementExecuted(const Status& s) {
       }
       ql_metrics_->num_retries_to_execute_ql_->Increment(exec_context.num_retries());
     }
-    ql_metrics_->num_flushes_to_execute_ql_->Increment(num_flushes_);
+    ql_metrics_->num_flushes_to_execute_ql_->Increment(request_->num_flushes);
   }
 
   // Clean up and invoke statement-executed callback.
-  ExecutedResult::SharedPtr result = s.ok() ? std::move(result_) : nullptr;
-  StatementExecutedCallback cb = std::move(cb_);
+  ExecutedResult::SharedPtr result = s.ok() ? std::move(request_->result) : nullptr;
+  StatementExecutedCallback cb = std::move(request_->cb);
   Reset();
   cb.Run(s, result);
 }
 
+void Executor::StartRequest(StatementExecutedCallback cb) {
+  DCHECK(!request_) << "Another execution is in progress.";
+  request_ = std::make_unique<RequestState>();
+  request_->cb = std::move(cb);
+}
+
 void Executor::Reset() {
   exec_context_ = nullptr;
-  exec_contexts_.clear();
-  write_batch_.Clear();
+  request_.reset();
   session_->Reset();
-  num_flushes_ = 0;
-  result_ = nullptr;
-  cb_.Reset();
-  returns_status_batch_opt_ = boost::none;
 }
 
 QLExpressionPB* CreateQLExpression(QLWriteRequestPB *req, const ColumnDesc& col_desc) {
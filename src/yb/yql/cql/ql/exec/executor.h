@@ -248,6 +248,9 @@ class Executor : public QLExprExecutor {
                          DataType data_type,
                          QLValue *ql_value);
 
+  // Create the execution state for a new statement or batch.
+  void StartRequest(StatementExecutedCallback cb);
+
   // Invoke statement executed callback.
   void StatementExecuted(const Status& s);
 
@@ -325,6 +328,10 @@ class Executor : public QLExprExecutor {
   // Convert column references to protobuf.
   CHECKED_STATUS ColumnRefsToPB(const PTDmlStmt *tnode, QLReferencedColumnsPB *columns_pb);
 
+  // Convert the select list (selected expressions, result set descriptors and referenced columns)
+  // to protobuf.
+  CHECKED_STATUS SelectListToPB(const PTSelectStmt *tnode, QLReadRequestPB *req);
+
   // Convert column arguments to protobuf.
   CHECKED_STATUS ColumnArgsToPB(const PTDmlStmt *tnode, QLWriteRequestPB *req);
 
@@ -370,7 +377,7 @@ class Executor : public QLExprExecutor {
 
   // Is this a batch returning status?
   bool IsReturnsStatusBatch() const {
-    return returns_status_batch_opt_ && *returns_status_batch_opt_;
+    return request_->returns_status_batch_opt && *request_->returns_status_batch_opt;
   }
 
   //------------------------------------------------------------------------------------------------
@@ -416,13 +423,33 @@ class Executor : public QLExprExecutor {
   // A rescheduler to reschedule the current call.
   Rescheduler* const rescheduler_;
 
-  // Execution context of the statement currently being executed, and the contexts for all
-  // statements in execution. The contexts are created and destroyed for each execution.
-  ExecContext* exec_context_ = nullptr;
-  std::list<ExecContext> exec_contexts_;
+  // State of the statement or the batch of statements being executed. It is created when the
+  // execution starts and destroyed when the statement executed callback is invoked, so an idle
+  // executor does not hold any memory of the requests it has executed.
+  struct RequestState {
+    // Execution contexts for all statements in execution.
+    std::list<ExecContext> exec_contexts;
+
+    // Batch of outstanding write operations that are being applied.
+    WriteBatch write_batch;
 
-  // Batch of outstanding write operations that are being applied.
-  WriteBatch write_batch_;
+    // The number of FlushAsync called to execute the statements.
+    int64_t num_flushes = 0;
+
+    // Execution result.
+    ExecutedResult::SharedPtr result;
+
+    // Statement executed callback.
+    StatementExecutedCallback cb;
+
+    // Whether this is a batch with statements that returns status.
+    boost::optional<bool> returns_status_batch_opt;
+  };
+
+  std::unique_ptr<RequestState> request_;
+
+  // Execution context of the statement currently being executed. It is owned by request_.
+  ExecContext* exec_context_ = nullptr;
 
   // Session to apply non-transactional read/write operations. Transactional read/write operations
   // are applied using the corresponding transactional session in ExecContext.
@@ -434,21 +461,9 @@ class Executor : public QLExprExecutor {
   std::mutex status_mutex_;
   Status async_status_;
 
-  // The number of FlushAsync called to execute the statements.
-  int64_t num_flushes_ = 0;
-
-  // Execution result.
-  ExecutedResult::SharedPtr result_;
-
-  // Statement executed callback.
-  StatementExecutedCallback cb_;
-
   // QLMetrics to keep track of node parsing etc.
   const QLMetrics* ql_metrics_;
 
-  // Whether this is a batch with statements that returns status.
-  boost::optional<bool> returns_status_batch_opt_;
-
   class ProcessAsyncResultsTask : public rpc::ThreadPoolTask {
    public:
     ProcessAsyncResultsTask& Bind(Executor* executor) {
@@ -92,6 +92,19 @@ class ParseTree {
     return internal_;
   }
 
+  // Access function to prepared_.
+  bool prepared() const {
+    return prepared_;
+  }
+  void set_prepared() {
+    prepared_ = true;
+  }
+
+  // Memory allocated for the parse tree nodes and their semantic analysis results.
+  size_t memory_usage() const {
+    return ptree_mem_.memory_footprint() + psem_mem_.memory_footprint();
+  }
+
   // Add table to the set of tables used during semantic analysis.
   void AddAnalyzedTable(const client::YBTableName& table_name);
 
@@ -140,6 +153,9 @@ class ParseTree {
 
   // Was this generated internally? Used to to bypass authorization enforcement.
   bool internal_ = false;
+
+  // Is this parse tree owned by a prepared statement, so it could be executed multiple times?
+  bool prepared_ = false;
 };
 
 }  // namespace ql
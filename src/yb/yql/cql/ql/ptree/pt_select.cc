@@ -581,6 +581,27 @@ CHECKED_STATUS PTSelectStmt::AnalyzeIndexes(SemContext *sem_context) {
   return Status::OK();
 }
 
+bool PTSelectStmt::HasStaticSelectList() const {
+  // Only plain column references are known to produce the same protobuf regardless of bind
+  // values. Function calls, subscripted and json columns could have bind variables as arguments.
+  for (const auto& expr : selected_exprs()) {
+    if (expr->opcode() != TreeNodeOpcode::kPTAllColumns && expr->expr_op() != ExprOperator::kRef) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const QLReadRequestPB* PTSelectStmt::SetReadRequestTemplate(
+    std::unique_ptr<QLReadRequestPB> request_template) const {
+  std::lock_guard<std::mutex> lock(read_request_template_mutex_);
+  if (!read_request_template_holder_) {
+    read_request_template_holder_ = std::move(request_template);
+    read_request_template_.store(read_request_template_holder_.get(), std::memory_order_release);
+  }
+  return read_request_template_holder_.get();
+}
+
 // Return whether the index covers the read fully.
 // INDEXes that were created before v2.0 are defined by column IDs instead of mangled_names.
 // - Returns TRUE if a list of column refs of a statement is a subset of INDEX columns.
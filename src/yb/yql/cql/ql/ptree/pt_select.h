@@ -18,12 +18,17 @@
 #ifndef YB_YQL_CQL_QL_PTREE_PT_SELECT_H_
 #define YB_YQL_CQL_QL_PTREE_PT_SELECT_H_
 
+#include <atomic>
+#include <mutex>
+
 #include "yb/yql/cql/ql/ptree/list_node.h"
 #include "yb/yql/cql/ql/ptree/tree_node.h"
 #include "yb/yql/cql/ql/ptree/pt_name.h"
 #include "yb/yql/cql/ql/ptree/pt_expr.h"
 #include "yb/yql/cql/ql/ptree/pt_dml.h"
 
+#include "yb/common/ql_protocol.pb.h"
+
 namespace yb {
 namespace ql {
 
@@ -257,6 +262,24 @@ class PTSelectStmt : public PTDmlStmt {
     return child_select_ ? child_select_->hash_col_indices() : PTDmlStmt::hash_col_indices();
   }
 
+  // Whether the part of the read request built from the select list (selected expressions, their
+  // result set descriptors and referenced columns) does not depend on bind variables, so it could
+  // be built once and reused by every execution of the prepared statement.
+  bool HasStaticSelectList() const;
+
+  // Read request template holding the select list part of the read request. It is built on the
+  // first execution of a prepared statement and is null before that, if the statement is not
+  // prepared or if the select list is not static. The bind dependent parts of the request (key
+  // columns, WHERE and IF clauses, limits and paging state) and the partition key hash are still
+  // evaluated on every execution, and tablet routing is done by the client meta cache.
+  const QLReadRequestPB* read_request_template() const {
+    return read_request_template_.load(std::memory_order_acquire);
+  }
+
+  // Sets the read request template if it was not set yet. Returns the template in effect.
+  const QLReadRequestPB* SetReadRequestTemplate(
+      std::unique_ptr<QLReadRequestPB> request_template) const;
+
  private:
   CHECKED_STATUS LookupIndex(SemContext *sem_context);
   CHECKED_STATUS AnalyzeIndexes(SemContext *sem_context);
@@ -305,6 +328,15 @@ class PTSelectStmt : public PTDmlStmt {
   // Name of all columns the SELECT statement is referenced. Similar to the list "column_refs_",
   // but this is a list of column names instead of column ids.
   MCSet<string> referenced_index_colnames_;
+
+  // -- The executor will decorate this node with the following information --
+
+  // Read request template shared by all executions of the statement. The parse tree is read-only
+  // after analysis and could be executed concurrently, so the template is published atomically
+  // and owned by read_request_template_holder_.
+  mutable std::mutex read_request_template_mutex_;
+  mutable std::unique_ptr<QLReadRequestPB> read_request_template_holder_;
+  mutable std::atomic<const QLReadRequestPB*> read_request_template_{nullptr};
 };
 
 }  // namespace ql
@@ -422,10 +422,11 @@ void QLProcessor::ExecuteAsync(const StatementBatch& batch, StatementExecutedCal
 void QLProcessor::RunAsync(const string& stmt, const StatementParameters& params,
                            StatementExecutedCallback cb, const bool reparsed) {
   ParseTree::UniPtr parse_tree;
-  const Status s = Prepare(stmt, &parse_tree, reparsed);
+  const Status s = Prepare(stmt, &parse_tree, reparsed, run_async_mem_tracker_);
   if (PREDICT_FALSE(!s.ok())) {
     return cb.Run(s, nullptr /* result */);
   }
+  run_async_memory_usage_ = parse_tree->memory_usage();
   const ParseTree* ptree = parse_tree.release();
   // Do not make a copy of stmt and params when binding to the RunAsyncDone callback because when
   // error occurs due to stale matadata, the statement needs to be reexecuted. We should pass the
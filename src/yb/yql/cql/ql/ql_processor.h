@@ -93,6 +93,15 @@ class QLProcessor : public Rescheduler {
     ql_env_.set_ql_session(ql_session);
   }
 
+  // Memory used by the parse tree of the last statement run by RunAsync().
+  size_t run_async_memory_usage() const {
+    return run_async_memory_usage_;
+  }
+
+  void reset_run_async_memory_usage() {
+    run_async_memory_usage_ = 0;
+  }
+
   bool NeedReschedule() override { return true; }
   void Reschedule(rpc::ThreadPoolTask* task) override;
 
@@ -117,6 +126,10 @@ class QLProcessor : public Rescheduler {
 
   ThreadSafeObjectPool<Parser>* parser_pool_;
 
+  // Tracker of the memory used by parse trees of statements run by RunAsync(). Such parse trees
+  // live only while the statement is being executed.
+  MemTrackerPtr run_async_mem_tracker_;
+
  private:
   friend class QLTestBase;
   friend class TestQLProcessor;
@@ -163,6 +176,8 @@ class QLProcessor : public Rescheduler {
 
   RunAsyncTask run_async_task_;
 
+  size_t run_async_memory_usage_ = 0;
+
   friend class RunAsyncTask;
 };
 
@@ -42,6 +42,7 @@ Status Statement::Prepare(QLProcessor *processor, const MemTrackerPtr& mem_track
       ParseTree::UniPtr parse_tree;
       RETURN_NOT_OK(processor->Prepare(text_, &parse_tree, false /* reparsed */, mem_tracker,
                                        internal));
+      parse_tree->set_prepared();
       parse_tree_ = std::move(parse_tree);
       prepared_.store(true, std::memory_order_release);
     }
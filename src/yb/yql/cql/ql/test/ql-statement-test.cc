@@ -121,5 +121,53 @@ TEST_F(TestQLStatement, TestPKIndices) {
   LOG(INFO) << "Done.";
 }
 
+TEST_F(TestQLStatement, TestReadRequestTemplate) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("create table t (h1 int primary key, c int);");
+  EXEC_VALID_STMT("insert into t (h1, c) values (1, 2);");
+
+  // Prepare a select statement.
+  Statement stmt(processor->CurrentKeyspace(), "select c, h1 from t where h1 = 1;");
+  CHECK_OK(stmt.Prepare(processor));
+  const auto& parse_tree = ASSERT_RESULT(stmt.GetParseTree());
+  ASSERT_TRUE(parse_tree.prepared());
+  const auto* select = static_cast<const PTSelectStmt*>(parse_tree.root().get());
+  ASSERT_TRUE(select->HasStaticSelectList());
+  ASSERT_EQ(select->read_request_template(), nullptr);
+
+  // The first execution builds the template, the following ones reuse it.
+  for (int i = 0; i != 2; ++i) {
+    Synchronizer sync;
+    CHECK_OK(ExecuteAsync(&stmt, processor, Bind(&Synchronizer::StatusCB, Unretained(&sync))));
+    ASSERT_OK(sync.Wait());
+    const auto* request_template = select->read_request_template();
+    ASSERT_NE(request_template, nullptr);
+    ASSERT_EQ(request_template->selected_exprs_size(), 2);
+    ASSERT_EQ(request_template->rsrow_desc().rscol_descs_size(), 2);
+    ASSERT_FALSE(request_template->has_limit());
+    ASSERT_EQ(request_template->hashed_column_values_size(), 0);
+  }
+
+  // An unprepared statement is executed once, so it does not build the template.
+  ParseTree::UniPtr unprepared_parse_tree;
+  const string unprepared_stmt = "select c, h1 from t where h1 = 1;";
+  ASSERT_OK(processor->Prepare(unprepared_stmt, &unprepared_parse_tree));
+  ASSERT_FALSE(unprepared_parse_tree->prepared());
+  Synchronizer sync;
+  const StatementParameters params;
+  processor->ExecuteAsync(
+      *unprepared_parse_tree, params,
+      Bind(&TestQLStatement::ExecuteAsyncDone, Unretained(this),
+           Bind(&Synchronizer::StatusCB, Unretained(&sync))));
+  ASSERT_OK(sync.Wait());
+  ASSERT_EQ(static_cast<const PTSelectStmt*>(unprepared_parse_tree->root().get())
+                ->read_request_template(), nullptr);
+}
+
 } // namespace ql
 } // namespace yb
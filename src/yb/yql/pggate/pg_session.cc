@@ -943,12 +943,30 @@ void PgSession::StartOperationsBuffering() {
   DCHECK(!buffering_enabled_);
   DCHECK(buffered_keys_.empty());
   buffering_enabled_ = true;
+  single_shard_txn_candidate_ = false;
+  single_shard_txn_fast_path_used_ = false;
 }
 
 Status PgSession::StopOperationsBuffering() {
   DCHECK(buffering_enabled_);
   buffering_enabled_ = false;
-  return FlushBufferedOperations();
+  if (!single_shard_txn_candidate_) {
+    return FlushBufferedOperations();
+  }
+  single_shard_txn_candidate_ = false;
+  return FlushBufferedOperationsImpl([this](auto ops, auto transactional) -> Status {
+    if (transactional && VERIFY_RESULT(CanUseSingleShardTxnFastPath(ops))) {
+      // All writes of the transaction go to the same tablet, so they are applied atomically by
+      // a single write to that tablet and there is no need for a distributed transaction.
+      for (const auto& buffered_op : ops) {
+        down_cast<client::YBPgsqlWriteOp*>(buffered_op.operation.get())->set_is_single_row_txn(
+            true);
+      }
+      single_shard_txn_fast_path_used_ = true;
+      transactional = false;
+    }
+    return this->FlushOperations(std::move(ops), transactional);
+  });
 }
 
 Status PgSession::ResetOperationsBuffering() {
@@ -956,9 +974,40 @@ Status PgSession::ResetOperationsBuffering() {
          IllegalState,
          Format("Pending operations are not expected, $0 found", buffered_keys_.size()));
   buffering_enabled_ = false;
+  single_shard_txn_candidate_ = false;
   return Status::OK();
 }
 
+Result<bool> PgSession::CanUseSingleShardTxnFastPath(const PgsqlOpBuffer& ops) {
+  // Operations that were flushed before this point have already started a distributed
+  // transaction.
+  if (!FLAGS_ysql_enable_single_shard_txn_fast_path || ops.empty() ||
+      pg_txn_manager_->IsDistributedTxnStarted()) {
+    return false;
+  }
+  const auto table = ops.front().operation->table();
+  if (table->ArePartitionsStale()) {
+    return false;
+  }
+  std::shared_ptr<const std::string> partition_start;
+  std::string partition_key;
+  for (const auto& buffered_op : ops) {
+    const auto& op = *buffered_op.operation;
+    // Colocated tables share a tablet, but that is not visible from their partitions.
+    if (op.type() != YBOperation::Type::PGSQL_WRITE || op.table()->id() != table->id()) {
+      return false;
+    }
+    RETURN_NOT_OK(op.GetPartitionKey(&partition_key));
+    auto op_partition_start = table->FindPartitionStart(partition_key);
+    if (!partition_start) {
+      partition_start = std::move(op_partition_start);
+    } else if (*op_partition_start != *partition_start) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Status PgSession::FlushBufferedOperations() {
   return FlushBufferedOperationsImpl(
       [this](auto ops, auto txn) { return this->FlushOperations(std::move(ops), txn); });
@@ -215,6 +215,18 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   // Drop all pending buffered operations. Buffering mode remain unchanged.
   void DropBufferedOperations();
 
+  // Mark the statement being buffered as the only statement of its transaction that performs
+  // no reads. If all of its writes turn out to target the same tablet when buffering is stopped,
+  // they are flushed as a single non-transactional write to that tablet.
+  void SetSingleShardTxnCandidate() {
+    single_shard_txn_candidate_ = true;
+  }
+
+  // Whether the last buffered statement was committed using the single shard fast path.
+  bool single_shard_txn_fast_path_used() const {
+    return single_shard_txn_fast_path_used_;
+  }
+
   // Run (apply + flush) the given operation to read and write database content.
   // Template is used here to handle all kind of derived operations
   // (shared_ptr<YBPgsqlReadOp>, shared_ptr<YBPgsqlWriteOp>)
@@ -332,6 +344,9 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   using Flusher = std::function<Status(PgsqlOpBuffer, bool)>;
 
   CHECKED_STATUS FlushBufferedOperationsImpl(const Flusher& flusher);
+
+  // Whether the buffered transactional operations could be committed as a single shard write.
+  Result<bool> CanUseSingleShardTxnFastPath(const PgsqlOpBuffer& ops);
   CHECKED_STATUS FlushOperations(PgsqlOpBuffer ops, bool transactional);
   CHECKED_STATUS ApplyOperation(client::YBSession* session,
                                 bool transactional,
@@ -405,6 +420,8 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   PgsqlOpBuffer buffered_ops_;
   PgsqlOpBuffer buffered_txn_ops_;
   std::unordered_set<RowIdentifier, boost::hash<RowIdentifier>> buffered_keys_;
+  bool single_shard_txn_candidate_ = false;
+  bool single_shard_txn_fast_path_used_ = false;
 
   const tserver::TServerSharedObject* const tserver_shared_object_;
   const YBCPgCallbacks& pg_callbacks_;
@@ -186,6 +186,9 @@ Status PgTxnManager::BeginWriteTransactionIfNecessary(bool read_only_op,
     if (defer) {
       // This call is idempotent, meaning it has no affect after the first call.
       session_->DeferReadPoint();
+    } else if (read_only_ && FLAGS_ysql_backdate_read_only_transactions) {
+      // Also idempotent, the uncertainty window is closed after the first call.
+      session_->BackdateReadPoint();
     }
   } else {
     if (tserver_shared_object_) {
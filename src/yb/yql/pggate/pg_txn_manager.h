@@ -75,6 +75,10 @@ class PgTxnManager : public RefCountedThreadSafe<PgTxnManager> {
 
   bool IsDdlMode() const { return ddl_session_.get() != nullptr; }
 
+  // Whether a distributed transaction has been started, i.e. some writes or serializable reads
+  // were already performed by the current transaction.
+  bool IsDistributedTxnStarted() const { return txn_ != nullptr || ddl_txn_ != nullptr; }
+
  private:
   YB_STRONGLY_TYPED_BOOL(NeedsPessimisticLocking);
   YB_STRONGLY_TYPED_BOOL(SavePriority);
@@ -944,6 +944,14 @@ void PgApiImpl::DropBufferedOperations() {
   pg_session_->DropBufferedOperations();
 }
 
+void PgApiImpl::SetSingleShardTxnCandidate() {
+  pg_session_->SetSingleShardTxnCandidate();
+}
+
+bool PgApiImpl::IsSingleShardTxnFastPathUsed() const {
+  return pg_session_->single_shard_txn_fast_path_used();
+}
+
 Status PgApiImpl::DmlExecWriteOp(PgStatement *handle, int32_t *rows_affected_count) {
   switch (handle->stmt_op()) {
     case StmtOp::STMT_INSERT:
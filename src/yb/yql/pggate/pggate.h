@@ -372,6 +372,8 @@ class PgApiImpl {
   CHECKED_STATUS ResetOperationsBuffering();
   CHECKED_STATUS FlushBufferedOperations();
   void DropBufferedOperations();
+  void SetSingleShardTxnCandidate();
+  bool IsSingleShardTxnFastPathUsed() const;
 
   //------------------------------------------------------------------------------------------------
   // Insert.
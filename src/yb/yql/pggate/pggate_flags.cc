@@ -61,6 +61,17 @@ DEFINE_int32(ysql_session_max_batch_size, 512,
 DEFINE_bool(ysql_non_txn_copy, false,
             "Execute COPY inserts non-transactionally.");
 
+DEFINE_bool(ysql_enable_single_shard_txn_fast_path, true,
+            "Commit single statement transactions whose writes all target the same tablet as one "
+            "non-transactional write to that tablet, bypassing the transaction status tablet.");
+TAG_FLAG(ysql_enable_single_shard_txn_fast_path, runtime);
+TAG_FLAG(ysql_enable_single_shard_txn_fast_path, advanced);
+
+DEFINE_bool(ysql_backdate_read_only_transactions, false,
+            "Read in non-deferrable read only transactions at a time in the past by the max clock "
+            "skew, so they never require read restart. Such transactions could miss writes "
+            "committed during the last max clock skew interval before they started.");
+
 DEFINE_int32(ysql_max_read_restart_attempts, 20,
              "How many read restarts can we try transparently before giving up");
 
@@ -28,6 +28,8 @@ DECLARE_int32(ysql_prefetch_limit);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
 DECLARE_int32(ysql_session_max_batch_size);
 DECLARE_bool(ysql_non_txn_copy);
+DECLARE_bool(ysql_enable_single_shard_txn_fast_path);
+DECLARE_bool(ysql_backdate_read_only_transactions);
 DECLARE_int32(ysql_max_read_restart_attempts);
 DECLARE_bool(TEST_ysql_disable_transparent_cache_refresh_retry);
 DECLARE_int32(ysql_output_buffer_size);
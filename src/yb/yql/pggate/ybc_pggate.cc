@@ -611,6 +611,14 @@ void YBCPgDropBufferedOperations() {
   pgapi->DropBufferedOperations();
 }
 
+void YBCPgSetSingleShardTxnCandidate() {
+  pgapi->SetSingleShardTxnCandidate();
+}
+
+bool YBCPgIsSingleShardTxnFastPathUsed() {
+  return pgapi->IsSingleShardTxnFastPathUsed();
+}
+
 YBCStatus YBCPgDmlExecWriteOp(YBCPgStatement handle, int32_t *rows_affected_count) {
   return ToYBCStatus(pgapi->DmlExecWriteOp(handle, rows_affected_count));
 }
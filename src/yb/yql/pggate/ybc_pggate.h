@@ -367,6 +367,10 @@ YBCStatus YBCPgResetOperationsBuffering();
 YBCStatus YBCPgFlushBufferedOperations();
 void YBCPgDropBufferedOperations();
 
+// Single shard transaction fast path for the statement being buffered.
+void YBCPgSetSingleShardTxnCandidate();
+bool YBCPgIsSingleShardTxnFastPathUsed();
+
 // INSERT ------------------------------------------------------------------------------------------
 YBCStatus YBCPgNewInsert(YBCPgOid database_oid,
                          YBCPgOid table_oid,
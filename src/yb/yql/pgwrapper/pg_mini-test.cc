@@ -13,11 +13,21 @@
 
 #include "yb/yql/pgwrapper/pg_mini_test_base.h"
 
+#include <sstream>
+
+#include <boost/algorithm/string/predicate.hpp>
+
 #include "yb/master/catalog_entity_info.h"
 #include "yb/master/catalog_manager.h"
 #include "yb/master/mini_master.h"
 #include "yb/master/sys_catalog_constants.h"
 
+#include "yb/tablet/tablet_metrics.h"
+
+#include "yb/tserver/mini_tablet_server.h"
+#include "yb/tserver/tablet_server.h"
+
+#include "yb/util/curl_util.h"
 #include "yb/util/logging.h"
 #include "yb/yql/pggate/pggate_flags.h"
 
@@ -34,14 +44,25 @@ DECLARE_bool(ysql_enable_manual_sys_table_txn_ctl);
 DECLARE_double(TEST_respond_write_failed_probability);
 DECLARE_double(TEST_transaction_ignore_applying_probability_in_tests);
 DECLARE_int32(history_cutoff_propagation_interval_ms);
+DECLARE_int32(pgsql_proxy_webserver_port);
 DECLARE_int32(timestamp_history_retention_interval_sec);
+DECLARE_int32(rpc_workers_limit);
 DECLARE_int32(txn_max_apply_batch_records);
+DECLARE_int32(txn_max_inline_apply_batch_records);
+DECLARE_bool(txn_pipelined_apply);
+DECLARE_bool(enable_wait_queues);
+DECLARE_int32(wait_queue_max_wait_ms);
+DECLARE_uint64(transactions_status_poll_interval_ms);
 DECLARE_int64(apply_intents_task_injected_delay_ms);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_int64(db_write_buffer_size);
 DECLARE_bool(ysql_enable_manual_sys_table_txn_ctl);
 DECLARE_bool(rocksdb_use_logging_iterator);
 
+METRIC_DECLARE_counter(transaction_status_requests_batched);
+METRIC_DECLARE_counter(transaction_status_batch_rpcs);
+METRIC_DECLARE_histogram(transaction_apply_lag);
+
 namespace yb {
 namespace pgwrapper {
 
@@ -52,7 +73,8 @@ class PgMiniTest : public PgMiniTestBase {
   // expected.
   // Otherwise, the scans are in transactions with snapshot isolation, but we still don't expect any
   // read restarts to be observer because they should be transparently handled on the postgres side.
-  void TestReadRestart(bool deferrable = true);
+  // If read_only is true, then non deferrable scans are in read only transactions.
+  void TestReadRestart(bool deferrable = true, bool read_only = false);
 
   // Run interleaved INSERT, SELECT with specified isolation level and row mark.  Possible isolation
   // levels are SNAPSHOT_ISOLATION and SERIALIZABLE_ISOLATION.  Possible row marks are
@@ -75,8 +97,38 @@ class PgMiniTest : public PgMiniTestBase {
 
   void TestBigInsert(bool restart);
 
+  // Increments a few hot rows from many concurrent transactions and logs throughput, number of
+  // conflicts and commit latency percentiles.
+  void TestContention(bool wait_queues);
+
   void TestConcurrentDeleteRowAndUpdateColumn(bool select_before_update);
 
+  // Returns the number of statements counted by the YSQL SQLProcessor metric with the given name,
+  // e.g. "Transactions".
+  Result<int64_t> GetYsqlStatementCount(const std::string& metric_name) {
+    EasyCurl curl;
+    faststring buf;
+    RETURN_NOT_OK(curl.FetchURL(
+        Format("http://$0:$1/prometheus-metrics", pg_host_port_.host(),
+               FLAGS_pgsql_proxy_webserver_port),
+        &buf));
+    const auto prefix = Format("handler_latency_yb_ysqlserver_SQLProcessor_$0_count", metric_name);
+    std::istringstream input(buf.ToString());
+    std::string line;
+    while (std::getline(input, line)) {
+      if (!boost::starts_with(line, prefix)) {
+        continue;
+      }
+      // Line format: <name>{<attributes>} <value> <timestamp>
+      const auto value_start = line.find("} ");
+      if (value_start == std::string::npos) {
+        return STATUS_FORMAT(Corruption, "Unexpected metric line: $0", line);
+      }
+      return std::stoll(line.substr(value_start + 2));
+    }
+    return STATUS_FORMAT(NotFound, "Metric $0 not found", metric_name);
+  }
+
   void FlushAndCompactTablets() {
     FLAGS_timestamp_history_retention_interval_sec = 0;
     FLAGS_history_cutoff_propagation_interval_ms = 1;
@@ -153,7 +205,7 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(With)) {
       "UPDATE test SET v = 3 WHERE k = 1"));
 }
 
-void PgMiniTest::TestReadRestart(const bool deferrable) {
+void PgMiniTest::TestReadRestart(const bool deferrable, const bool read_only) {
   constexpr CoarseDuration kWaitTime = 60s;
   constexpr int kKeys = 100;
   constexpr int kNumReadThreads = 8;
@@ -176,13 +228,16 @@ void PgMiniTest::TestReadRestart(const bool deferrable) {
 
   // Start read threads
   for (int i = 0; i < kNumReadThreads; ++i) {
-    thread_holder.AddThreadFunctor([this, deferrable, &num_read_restarts, &num_read_successes,
-                                    &stop = thread_holder.stop_flag()] {
+    thread_holder.AddThreadFunctor([this, deferrable, read_only, &num_read_restarts,
+                                    &num_read_successes, &stop = thread_holder.stop_flag()] {
       auto read_conn = ASSERT_RESULT(Connect());
       while (!stop.load(std::memory_order_acquire)) {
         if (deferrable) {
           ASSERT_OK(read_conn.Execute("BEGIN TRANSACTION ISOLATION LEVEL SERIALIZABLE, READ ONLY, "
                                       "DEFERRABLE"));
+        } else if (read_only) {
+          ASSERT_OK(read_conn.Execute("BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ, "
+                                      "READ ONLY"));
         } else {
           ASSERT_OK(read_conn.Execute("BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ"));
         }
@@ -248,6 +303,19 @@ TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_SANITIZERS(ReadRestartSnapshot),
   TestReadRestart(false /* deferrable */);
 }
 
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_SANITIZERS(ReadRestartSnapshotReadOnlyBackdated),
+          PgMiniLargeClockSkewTest) {
+  FLAGS_ysql_backdate_read_only_transactions = true;
+  TestReadRestart(false /* deferrable */, true /* read_only */);
+
+  // Scans were performed at backdated read time, so none of them had an uncertainty window.
+  int64_t restart_free_reads = 0;
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders)) {
+    restart_free_reads += peer->tablet()->metrics()->restart_free_read_requests->value();
+  }
+  ASSERT_GT(restart_free_reads, 0);
+}
+
 void PgMiniTest::TestInsertSelectRowLock(IsolationLevel isolation, RowMarkType row_mark) {
   const std::string isolation_str = (
       isolation == IsolationLevel::SNAPSHOT_ISOLATION ? "REPEATABLE READ" : "SERIALIZABLE");
@@ -1320,11 +1388,262 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BigInsert)) {
   TestBigInsert(/* restart= */ false);
 }
 
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BigInsertWithoutPipelinedApply)) {
+  FLAGS_txn_pipelined_apply = false;
+  TestBigInsert(/* restart= */ false);
+}
+
 TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BigInsertWithRestart)) {
   FLAGS_apply_intents_task_injected_delay_ms = 200;
   TestBigInsert(/* restart= */ true);
 }
 
+class PgMiniFewRpcWorkersTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    FLAGS_rpc_workers_limit = 8;
+    PgMiniTest::SetUp();
+  }
+};
+
+// Applies several large transactions in parallel, while the rpc thread pool, that is used to write
+// pipelined batches of intents, has only a few workers.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(PipelinedApplyWithFewRpcWorkers),
+          PgMiniFewRpcWorkersTest) {
+  constexpr int kNumTables = 4;
+  constexpr int64_t kNumRows = RegularBuildVsSanitizers(20000, 4000);
+  FLAGS_txn_max_apply_batch_records = kNumRows / 10;
+  FLAGS_txn_max_inline_apply_batch_records = kNumRows / 10;
+
+  auto conn = ASSERT_RESULT(Connect());
+  for (int i = 0; i != kNumTables; ++i) {
+    ASSERT_OK(conn.ExecuteFormat("CREATE TABLE t$0 (a int PRIMARY KEY) SPLIT INTO 1 TABLETS", i));
+  }
+
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kNumTables; ++i) {
+    thread_holder.AddThreadFunctor([this, i] {
+      const int64_t num_rows = kNumRows;
+      auto conn = ASSERT_RESULT(Connect());
+      ASSERT_OK(conn.ExecuteFormat("INSERT INTO t$0 SELECT generate_series(1, $1)", i, num_rows));
+    });
+  }
+  thread_holder.JoinAll();
+
+  ASSERT_OK(WaitFor([this] {
+    return CountIntents(cluster_.get()) == 0;
+  }, 60s * kTimeMultiplier, "Intents cleanup", 200ms));
+
+  for (int i = 0; i != kNumTables; ++i) {
+    auto sum = ASSERT_RESULT(conn.FetchValue<int64_t>(Format("SELECT SUM(a) FROM t$0", i)));
+    ASSERT_EQ(sum, kNumRows * (kNumRows + 1) / 2);
+  }
+
+  // Every transaction was applied in background by all replicas of its tablet.
+  uint64_t background_applies = 0;
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+    auto tablet = peer->shared_tablet();
+    if (tablet) {
+      background_applies +=
+          METRIC_transaction_apply_lag.Instantiate(tablet->GetMetricEntity())->TotalCount();
+    }
+  }
+  ASSERT_GE(background_applies, kNumTables);
+}
+
+void PgMiniTest::TestContention(bool wait_queues) {
+  constexpr int kNumRows = 5;
+  constexpr int kNumThreads = 16;
+  constexpr CoarseDuration kDuration = 15s;
+  FLAGS_enable_wait_queues = wait_queues;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO t SELECT generate_series(1, $0), 0", kNumRows));
+
+  TestThreadHolder thread_holder;
+  std::atomic<int> conflicts{0};
+  std::mutex latencies_mutex;
+  std::vector<MonoDelta> latencies;
+  for (int i = 0; i != kNumThreads; ++i) {
+    thread_holder.AddThreadFunctor(
+        [this, &stop = thread_holder.stop_flag(), &conflicts, &latencies_mutex, &latencies] {
+      auto conn = ASSERT_RESULT(Connect());
+      std::vector<MonoDelta> thread_latencies;
+      while (!stop.load(std::memory_order_acquire)) {
+        auto key = RandomUniformInt(1, kNumRows);
+        auto start = MonoTime::Now();
+        // Retry the same increment until it is committed, so latency includes retries.
+        for (;;) {
+          ASSERT_OK(conn.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+          auto status = conn.ExecuteFormat("UPDATE t SET v = v + 1 WHERE k = $0", key);
+          if (status.ok()) {
+            status = conn.CommitTransaction();
+          }
+          if (status.ok()) {
+            thread_latencies.push_back(MonoTime::Now() - start);
+            break;
+          }
+          ++conflicts;
+          ASSERT_OK(conn.RollbackTransaction());
+          if (stop.load(std::memory_order_acquire)) {
+            break;
+          }
+        }
+      }
+      std::lock_guard<std::mutex> lock(latencies_mutex);
+      latencies.insert(latencies.end(), thread_latencies.begin(), thread_latencies.end());
+    });
+  }
+
+  thread_holder.WaitAndStop(kDuration);
+
+  // Every committed increment should be visible, i.e. no updates were lost while waiting.
+  auto sum = ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT SUM(v) FROM t"));
+  ASSERT_EQ(sum, static_cast<int64_t>(latencies.size()));
+  ASSERT_FALSE(latencies.empty());
+
+  std::sort(latencies.begin(), latencies.end());
+  LOG(INFO) << "Wait queues: " << wait_queues
+            << ", committed: " << latencies.size()
+            << ", txn/s: " << latencies.size() / MonoDelta(kDuration).ToSeconds()
+            << ", conflicts: " << conflicts.load()
+            << ", p50: " << latencies[latencies.size() / 2]
+            << ", p99: " << latencies[latencies.size() * 99 / 100];
+}
+
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_SANITIZERS(ContentionWithoutWaitQueues)) {
+  TestContention(/* wait_queues= */ false);
+}
+
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_SANITIZERS(ContentionWithWaitQueues)) {
+  TestContention(/* wait_queues= */ true);
+}
+
+class PgMiniRarePollTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    FLAGS_transactions_status_poll_interval_ms = 60000;
+    PgMiniTest::SetUp();
+  }
+};
+
+// Waiting for a conflicting transaction should time out after wait_queue_max_wait_ms, even when
+// the transaction participant is polled rarely.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(WaitQueueTimeout), PgMiniRarePollTest) {
+  FLAGS_enable_wait_queues = true;
+  FLAGS_wait_queue_max_wait_ms = 1000;
+
+  auto conn1 = ASSERT_RESULT(Connect());
+  auto conn2 = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn1.Execute("CREATE TABLE t (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(conn1.Execute("INSERT INTO t VALUES (1, 0)"));
+
+  // Only a lower priority transaction waits for a higher priority one.
+  ASSERT_OK(conn1.Execute("SET yb_transaction_priority_lower_bound = 0.6"));
+  ASSERT_OK(conn2.Execute("SET yb_transaction_priority_upper_bound = 0.4"));
+
+  ASSERT_OK(conn1.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+  ASSERT_OK(conn1.Execute("UPDATE t SET v = 1 WHERE k = 1"));
+
+  ASSERT_OK(conn2.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+  auto start = MonoTime::Now();
+  ASSERT_NOK(conn2.Execute("UPDATE t SET v = 2 WHERE k = 1"));
+  auto elapsed = MonoTime::Now() - start;
+  LOG(INFO) << "Conflicting update failed after: " << elapsed;
+  ASSERT_LT(elapsed, MonoDelta::FromSeconds(30));
+  ASSERT_OK(conn2.RollbackTransaction());
+
+  ASSERT_OK(conn1.CommitTransaction());
+  ASSERT_EQ(ASSERT_RESULT(conn1.FetchValue<int32_t>("SELECT v FROM t WHERE k = 1")), 1);
+}
+
+TEST_F(PgMiniTest, TransactionStatusBatching) {
+  auto conn1 = ASSERT_RESULT(Connect());
+  auto conn2 = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn1.Execute("CREATE TABLE t (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(conn1.Execute("INSERT INTO t SELECT generate_series(1, 100), 0"));
+
+  ASSERT_OK(conn1.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+  ASSERT_OK(conn1.Execute("UPDATE t SET v = 1"));
+  // Reading provisional records of a pending transaction requires its status from the coordinator.
+  auto sum = ASSERT_RESULT(conn2.FetchValue<int64_t>("SELECT SUM(v) FROM t"));
+  ASSERT_EQ(sum, 0);
+  ASSERT_OK(conn1.CommitTransaction());
+
+  int64_t requests = 0;
+  int64_t rpcs = 0;
+  for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    auto entity = cluster_->mini_tablet_server(i)->server()->metric_entity();
+    requests += METRIC_transaction_status_requests_batched.Instantiate(entity)->value();
+    rpcs += METRIC_transaction_status_batch_rpcs.Instantiate(entity)->value();
+  }
+  LOG(INFO) << "Batched status requests: " << requests << ", RPCs: " << rpcs;
+  ASSERT_GT(requests, 0);
+  ASSERT_GT(rpcs, 0);
+  ASSERT_LE(rpcs, requests);
+}
+
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(SingleShardTxnFastPath)) {
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE single (k INT PRIMARY KEY, v INT) SPLIT INTO 1 TABLETS"));
+  ASSERT_OK(conn.Execute("CREATE TABLE multi (k INT PRIMARY KEY, v INT) SPLIT INTO 3 TABLETS"));
+
+  auto check_counts = [this](int64_t* txns, int64_t* single_shard_txns,
+                             int64_t txns_delta, int64_t single_shard_txns_delta) -> Status {
+    const auto new_txns = VERIFY_RESULT(GetYsqlStatementCount("Transactions"));
+    const auto new_single_shard_txns = VERIFY_RESULT(
+        GetYsqlStatementCount("SingleShardTransactions"));
+    SCHECK_EQ(new_txns - *txns, txns_delta, IllegalState, "Unexpected transactions");
+    SCHECK_EQ(new_single_shard_txns - *single_shard_txns, single_shard_txns_delta, IllegalState,
+              "Unexpected single shard transactions");
+    *txns = new_txns;
+    *single_shard_txns = new_single_shard_txns;
+    return Status::OK();
+  };
+
+  int64_t txns = ASSERT_RESULT(GetYsqlStatementCount("Transactions"));
+  int64_t single_shard_txns = ASSERT_RESULT(GetYsqlStatementCount("SingleShardTransactions"));
+
+  // All rows go to the only tablet, so the insert skips the distributed transaction but is still
+  // counted as a transaction.
+  ASSERT_OK(conn.Execute("INSERT INTO single VALUES (1, 1), (2, 2), (3, 3)"));
+  ASSERT_OK(check_counts(&txns, &single_shard_txns, 1, 1));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM single")), 3);
+  // Reads are counted as before.
+  ASSERT_OK(check_counts(&txns, &single_shard_txns, 1, 0));
+
+  // Rows are spread over several tablets, so a distributed transaction is used.
+  ASSERT_OK(conn.Execute(
+      "INSERT INTO multi SELECT generate_series(1, 100), generate_series(1, 100)"));
+  ASSERT_OK(check_counts(&txns, &single_shard_txns, 1, 0));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM multi")), 100);
+  ASSERT_OK(check_counts(&txns, &single_shard_txns, 1, 0));
+
+  // A duplicate key must fail the whole statement, without applying the other rows.
+  auto status = conn.Execute("INSERT INTO single VALUES (4, 4), (1, 10), (5, 5)");
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "duplicate key");
+  // The same key twice in one statement makes pggate flush in the middle of the statement.
+  status = conn.Execute("INSERT INTO single VALUES (6, 6), (6, 6)");
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "duplicate key");
+  auto rows = ASSERT_RESULT(conn.FetchMatrix("SELECT k, v FROM single ORDER BY k", 3, 2));
+  for (int i = 0; i != 3; ++i) {
+    ASSERT_EQ(ASSERT_RESULT(GetInt32(rows.get(), i, 0)), i + 1);
+    ASSERT_EQ(ASSERT_RESULT(GetInt32(rows.get(), i, 1)), i + 1);
+  }
+  txns = ASSERT_RESULT(GetYsqlStatementCount("Transactions"));
+  single_shard_txns = ASSERT_RESULT(GetYsqlStatementCount("SingleShardTransactions"));
+
+  // Statements of an explicit transaction block never use the fast path, so they are rolled back.
+  ASSERT_OK(conn.Execute("BEGIN"));
+  ASSERT_OK(conn.Execute("INSERT INTO single VALUES (7, 7), (8, 8)"));
+  ASSERT_OK(conn.Execute("ROLLBACK"));
+  ASSERT_EQ(ASSERT_RESULT(GetYsqlStatementCount("SingleShardTransactions")), single_shard_txns);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM single")), 3);
+}
+
 void PgMiniTest::TestConcurrentDeleteRowAndUpdateColumn(bool select_before_update) {
   auto conn1 = ASSERT_RESULT(Connect());
   auto conn2 = ASSERT_RESULT(Connect());